@@ -0,0 +1,81 @@
+# compare the clause encodings of m of n constraints on a simple shift schedule:
+# each shift needs exactly a given number of workers, each worker works at least
+# and at most a given number of shifts and is unavailable for some of them.
+# for each encoding the number of clauses, the encoding time and the solving time
+# are printed.
+
+# number of clauses of the direct encoding of at most k of n
+proc binomial {n k} {
+    set result 1.0
+    for {set i 1} {$i <= $k} {incr i} {
+        set result [expr {$result * ($n - $k + $i) / $i}]
+    }
+    return $result
+}
+
+proc encode_schedule {workers shifts need min_shifts max_shifts cardinality} {
+    # each shift: exactly need of workers
+    for {set i_shift 1} {$i_shift <= $shifts} {incr i_shift} {
+        set lit_list [list]
+
+        for {set i_worker 1} {$i_worker <= $workers} {incr i_worker} {
+            lappend lit_list "work_${i_worker}_${i_shift}"
+        }
+
+        add_encoding -encoding "mofn" -parameter $need -literals $lit_list -cardinality $cardinality
+    }
+
+    # each worker: at least min_shifts, at most max_shifts
+    for {set i_worker 1} {$i_worker <= $workers} {incr i_worker} {
+        set lit_list [list]
+
+        for {set i_shift 1} {$i_shift <= $shifts} {incr i_shift} {
+            lappend lit_list "work_${i_worker}_${i_shift}"
+        }
+
+        add_encoding -encoding "atleast_mofn" -parameter $min_shifts -literals $lit_list -cardinality $cardinality
+        add_encoding -encoding "atmost_mofn"  -parameter $max_shifts -literals $lit_list -cardinality $cardinality
+    }
+
+    # unavailability (same for all encodings)
+    expr {srand(1)}
+    for {set i_worker 1} {$i_worker <= $workers} {incr i_worker} {
+        for {set i_shift 1} {$i_shift <= $shifts} {incr i_shift} {
+            if {rand() < 0.2} {
+                add_clause -clause [list "-work_${i_worker}_${i_shift}"]
+            }
+        }
+    }
+}
+
+proc benchmark {workers shifts need min_shifts max_shifts} {
+    puts "schedule: $workers workers, $shifts shifts, $need workers per shift, $min_shifts ... $max_shifts shifts per worker"
+    puts [format "%-14s %10s %12s %12s %8s" "encoding" "clauses" "encode (ms)" "solve (ms)" "result"]
+
+    foreach cardinality {direct seqcounter totalizer modtotalizer cardnetwork sortnetwork auto} {
+        if {($cardinality eq "direct") &&
+            ([binomial $workers [expr {$need + 1}]] * $shifts + [binomial $shifts [expr {$max_shifts + 1}]] * $workers > 1e6)} {
+            puts [format "%-14s %10s" $cardinality "(skipped)"]
+            continue
+        }
+
+        reset
+
+        set start [clock milliseconds]
+        encode_schedule $workers $shifts $need $min_shifts $max_shifts $cardinality
+        set encode_time [expr {[clock milliseconds] - $start}]
+
+        set n_clauses [llength [get_clauses]]
+
+        set start [clock milliseconds]
+        set result [solve]
+        set solve_time [expr {[clock milliseconds] - $start}]
+
+        puts [format "%-14s %10d %12d %12d %8s" $cardinality $n_clauses $encode_time $solve_time [expr {$result ? "sat" : "unsat"}]]
+    }
+    puts ""
+}
+
+benchmark 10 14  3  3  5
+benchmark 30 28  8  6  9
+benchmark 60 42 15  8 12
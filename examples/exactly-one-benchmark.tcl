@@ -0,0 +1,70 @@
+# compare the exactly one encodings on empty sudoku puzzles of growing size:
+# for each encoding the number of clauses and variables, the encoding time
+# and the solving time are printed.
+
+proc encode_sudoku_groups {sub_size encoding} {
+    set size [expr $sub_size * $sub_size]
+
+    for {set i_a 1} {$i_a <= $size} {incr i_a} {
+        for {set i_b 1} {$i_b <= $size} {incr i_b} {
+            set positions [list]
+            set lines     [list]
+            set columns   [list]
+            set subfields [list]
+
+            for {set i_c 1} {$i_c <= $size} {incr i_c} {
+                # number i_c at column i_a, line i_b
+                lappend positions "field_${i_a}_${i_b}_${i_c}"
+                # number i_b at column i_c, line i_a
+                lappend lines     "field_${i_c}_${i_a}_${i_b}"
+                # number i_b at column i_a, line i_c
+                lappend columns   "field_${i_a}_${i_c}_${i_b}"
+                # number i_b at position i_c of sub-field i_a
+                set col  [expr $sub_size * (($i_a - 1) % $sub_size) + ($i_c - 1) % $sub_size + 1]
+                set line [expr $sub_size * (($i_a - 1) / $sub_size) + ($i_c - 1) / $sub_size + 1]
+                lappend subfields "field_${col}_${line}_${i_b}"
+            }
+
+            foreach lit_list [list $positions $lines $columns $subfields] {
+                add_encoding -encoding $encoding -literals $lit_list
+            }
+        }
+    }
+}
+
+proc count_vars {clauses} {
+    set vars [dict create]
+    foreach clause $clauses {
+        foreach lit $clause {
+            dict set vars [string trimleft $lit "-"] 1
+        }
+    }
+    return [dict size $vars]
+}
+
+proc benchmark {sub_size} {
+    set size [expr $sub_size * $sub_size]
+    puts "sudoku ${size} x ${size}: [expr 4 * $size * $size] groups of $size literals"
+    puts [format "%-16s %10s %10s %12s %12s" "encoding" "clauses" "variables" "encode (ms)" "solve (ms)"]
+
+    foreach encoding {1ofn_order 1ofn_pairwise 1ofn_ladder 1ofn_commander 1ofn_product 1ofn_binary 1ofn_auto} {
+        reset
+
+        set start [clock milliseconds]
+        encode_sudoku_groups $sub_size $encoding
+        set encode_time [expr {[clock milliseconds] - $start}]
+
+        set clauses [get_clauses]
+
+        set start [clock milliseconds]
+        solve
+        set solve_time [expr {[clock milliseconds] - $start}]
+
+        puts [format "%-16s %10d %10d %12d %12d" $encoding [llength $clauses] [count_vars $clauses] $encode_time $solve_time]
+    }
+    puts ""
+}
+
+foreach sub_size {2 3 4 5} {
+    benchmark $sub_size
+}
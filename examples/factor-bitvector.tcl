@@ -0,0 +1,51 @@
+# split a number into two factors (see factor.tcl):
+# the multiplier is encoded by native bit-vector constraints
+# instead of formulas per bit.
+# if unsatisfiable, number must be prime
+
+proc n_bits {number} {
+    set n_bits 0
+
+    while {$number > 0} {
+        incr n_bits
+        set number [expr $number / 2]
+    }
+
+    return $n_bits
+}
+
+proc factor {number {multiplier "wallace"}} {
+    set n_bits_product [n_bits $number]
+
+    # factors: f1 < product, f2 <= sqrt(product)
+    set n_bits_f1 [expr $n_bits_product - 1]
+    set n_bits_f2 [expr int(ceil($n_bits_product / 2.0))]
+
+    declare_bitvector -name "f1" -width $n_bits_f1
+    declare_bitvector -name "f2" -width $n_bits_f2
+
+    # product with full width: no overflow possible
+    add_bitvector_constraint -op mul -operands [list "f1" "f2"] -result "p" \
+                             -width [expr $n_bits_f1 + $n_bits_f2] -multiplier $multiplier
+    add_bitvector_constraint -op eq -operands [list "p" $number]
+
+    # exclude trivial factor 1
+    add_bitvector_constraint -op ugt -operands [list "f1" 1]
+    add_bitvector_constraint -op ugt -operands [list "f2" 1]
+
+    if {[solve]} {
+        set f1 [get_bitvector_result -name "f1"]
+        set f2 [get_bitvector_result -name "f2"]
+
+        puts "$number = $f1 * $f2"
+    } else {
+        puts "$number is possibly prime"
+    }
+
+    reset
+}
+
+set number 2147483729
+#set number 2147483693
+
+factor $number
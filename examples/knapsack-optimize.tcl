@@ -0,0 +1,67 @@
+# pack items into a knapsack of limited capacity:
+# the value of items left behind is minimized first,
+# the number of packed items second (lexicographic objectives).
+# the weight limit is a pseudo-Boolean constraint, each item
+# contributes soft clauses to both objectives.
+
+set capacity 50
+
+# name weight value
+set items {
+    {map        9  150}
+    {compass   13   35}
+    {water     15  200}
+    {sandwich  20  160}
+    {glucose    4   60}
+    {tin       10   45}
+    {banana    11   60}
+    {apple     12   40}
+    {cheese     7   30}
+    {beer       8   10}
+    {camera    10   30}
+    {tshirt     9   15}
+}
+
+proc knapsack {items capacity {timeout 0}} {
+    set literals {}
+    set weights  {}
+
+    foreach item $items {
+        lassign $item name weight value
+
+        lappend literals $name
+        lappend weights  $weight
+
+        # value is lost if item is not packed, each packed item counts
+        add_soft_clause -clause [list $name] -weight $value -objective "lost_value"
+        add_soft_clause -clause [list "-$name"] -objective "n_items"
+    }
+
+    add_encoding -literals $literals -encoding pb -weights $weights -relation "<=" -parameter $capacity
+
+    set result [optimize -objectives {lost_value n_items} -timeout $timeout]
+
+    if {![dict get $result satisfiable]} {
+        puts "no packing found"
+        return
+    }
+
+    set packed {}
+    foreach name $literals {
+        if {[get_var_result -var $name]} {lappend packed $name}
+    }
+
+    lassign [dict get $result costs] lost_value n_items
+    if {[dict get $result optimal]} {
+        puts "optimal packing: $packed (lost value $lost_value, $n_items items)"
+    } else {
+        puts "best packing found: $packed (lost value $lost_value, $n_items items)"
+    }
+
+    # the same problem for external MaxSAT solvers
+    write_wcnf -file "knapsack.wcnf" -objectives {lost_value n_items}
+
+    reset
+}
+
+knapsack $items $capacity
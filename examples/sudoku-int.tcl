@@ -0,0 +1,140 @@
+# encode sudoku puzzle (puzzle example below) with integer variables and solve:
+# same puzzle as sudoku.tcl, but each field is a directly encoded integer variable
+# (literals field_<col>_<line>_<number>) and lines, columns and sub-fields
+# are alldifferent constraints
+
+proc encode_sudoku_constraints {sub_size} {
+    set size [expr $sub_size * $sub_size]
+
+    # positions
+    for {set i_line 1} {$i_line <= $size} {incr i_line} {
+        for {set i_col 1} {$i_col <= $size} {incr i_col} {
+            declare_int -name "field_${i_col}_${i_line}" -min 1 -max $size -encoding "direct"
+        }
+    }
+
+    # lines
+    for {set i_line 1} {$i_line <= $size} {incr i_line} {
+        set field_list [list]
+
+        for {set i_col 1} {$i_col <= $size} {incr i_col} {
+            lappend field_list "field_${i_col}_${i_line}"
+        }
+
+        add_int_constraint -constraint "alldifferent" -operands $field_list
+    }
+
+    # columns
+    for {set i_col 1} {$i_col <= $size} {incr i_col} {
+        set field_list [list]
+
+        for {set i_line 1} {$i_line <= $size} {incr i_line} {
+            lappend field_list "field_${i_col}_${i_line}"
+        }
+
+        add_int_constraint -constraint "alldifferent" -operands $field_list
+    }
+
+    # sub-fields
+    for {set i_sub_line 0} {$i_sub_line < $sub_size} {incr i_sub_line} {
+        for {set i_sub_col 0} {$i_sub_col < $sub_size} {incr i_sub_col} {
+            set field_list [list]
+
+            for {set i_line 1} {$i_line <= $sub_size} {incr i_line} {
+                for {set i_col 1} {$i_col <= $sub_size} {incr i_col} {
+                    set col  [expr $sub_size * $i_sub_col + $i_col]
+                    set line [expr $sub_size * $i_sub_line + $i_line]
+                    lappend field_list "field_${col}_${line}"
+                }
+            }
+
+            add_int_constraint -constraint "alldifferent" -operands $field_list
+        }
+    }
+}
+
+proc encode_fixed_values {sub_size val_list} {
+    set size [expr $sub_size * $sub_size]
+
+    # positions
+    for {set i_line 1} {$i_line <= $size} {incr i_line} {
+        for {set i_col 1} {$i_col <= $size} {incr i_col} {
+            set i_num [lindex $val_list [expr $i_line - 1] [expr $i_col - 1]]
+
+            if {$i_num > 0} {
+                add_clause -clause [list "field_${i_col}_${i_line}_${i_num}"]
+            }
+        }
+    }
+}
+
+proc print_sudoku_result {sub_size} {
+    set size [expr $sub_size * $sub_size]
+    
+    puts -nonewline " +-"
+    for {set i_col 1} {$i_col <= $size} {incr i_col} {
+            if {$i_col % $sub_size == 0} {
+                if {$i_col < $size} {
+                    puts -nonewline "---+-"
+                } else {
+                    puts -nonewline "---+ "
+                }
+            } else {
+                puts -nonewline "----"
+            }
+    }
+    puts ""
+
+    for {set i_line 1} {$i_line <= $size} {incr i_line} {
+        puts -nonewline " | "
+        for {set i_col 1} {$i_col <= $size} {incr i_col} {
+            puts -nonewline [format "%2d" [get_int_result -name "field_${i_col}_${i_line}"]]
+
+            if {$i_col % $sub_size == 0} {
+                puts -nonewline " | "
+            } else {
+                puts -nonewline "  "
+            }
+        }
+        puts ""
+
+        if {$i_line % $sub_size == 0} {
+            puts -nonewline " +-"
+            for {set i_col 1} {$i_col <= $size} {incr i_col} {
+                    if {$i_col % $sub_size == 0} {
+                        if {$i_col < $size} {
+                            puts -nonewline "---+-"
+                        } else {
+                            puts -nonewline "---+ "
+                        }
+                    } else {
+                        puts -nonewline "----"
+                    }
+            }
+            puts ""
+        }
+    }
+}
+
+
+# 3 x 3 x 3 x 3 from wikipedia
+set sub_size 3
+set values [list \
+    {0 3 0  0 0 0  0 0 0} \
+    {0 0 0  1 9 5  0 0 0} \
+    {0 0 8  0 0 0  0 6 0} \
+    \
+    {8 0 0  0 6 0  0 0 0} \
+    {4 0 0  8 0 0  0 0 1} \
+    {0 0 0  0 2 0  0 0 0} \
+    \
+    {0 6 0  0 0 0  2 8 0} \
+    {0 0 0  4 1 9  0 0 5} \
+    {0 0 0  0 0 0  0 7 0} \
+]
+
+encode_sudoku_constraints $sub_size
+encode_fixed_values $sub_size $values
+if {[solve]} {
+    print_sudoku_result $sub_size
+}
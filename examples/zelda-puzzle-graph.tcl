@@ -0,0 +1,134 @@
+# encode puzzle from a game: you have to walk in a room
+# while passing every unblocked square exactly once.
+# same puzzle as zelda-puzzle.tcl, encoded as hamiltonian path
+# over the graph of unblocked squares.
+
+set width 13
+set height 9
+
+# start and end -- 0, 0 = unknown
+set start {13 5}
+set end {0 0}
+
+# list of blockages
+set blocks [list {4 6} {7 3} {7 6} {7 8} {9 6} {7 7}]
+
+# number of route edges at square x, y in solution
+proc zelda_degree {x y} {
+    variable width
+    variable height
+
+    set degree 0
+    if {$x > 1}       {incr degree [get_var_result -var "route_x_[expr $x - 1]_${x}_${y}"]}
+    if {$x < $width}  {incr degree [get_var_result -var "route_x_${x}_[expr $x + 1]_${y}"]}
+    if {$y > 1}       {incr degree [get_var_result -var "route_y_${x}_[expr $y - 1]_${y}"]}
+    if {$y < $height} {incr degree [get_var_result -var "route_y_${x}_${y}_[expr $y + 1]"]}
+
+    return $degree
+}
+
+proc print_zeldaproblem {{solution "false"}} {
+    variable width
+    variable height
+    variable start
+    variable end
+    variable blocks
+
+    for {set y $height} {$y > 0} {set y [expr $y - 1]} {
+        if {$y < $height} {
+            for {set x 1} {$x <= $width} {incr x} {
+                if {! $solution} {
+                    puts -nonewline " "
+                } else {
+                    if {[get_var_result -var "route_y_${x}_${y}_[expr $y + 1]"]} {
+                        puts -nonewline "|"
+                    } else {
+                        puts -nonewline " "
+                    }
+                }
+                if {$x < $width} {
+                    puts -nonewline " "
+                }
+            }
+            puts ""
+        }
+        for {set x 1} {$x <= $width} {incr x} {
+            set coord [list $x $y]
+            if {$coord == $start} {
+                puts -nonewline "S"
+            } elseif {[lsearch $blocks $coord] >= 0} {
+                puts -nonewline "X"
+            } elseif {$coord == $end} {
+                puts -nonewline "E"
+            } elseif {$solution && ([zelda_degree $x $y] == 1)} {
+                puts -nonewline "E"
+            } else {
+                puts -nonewline "#"
+            }
+            if {$x < $width} {
+                if {! $solution} {
+                    puts -nonewline " "
+                } else {
+                    if {[get_var_result -var "route_x_${x}_[expr $x + 1]_${y}"]} {
+                        puts -nonewline "-"
+                    } else {
+                        puts -nonewline " "
+                    }
+                }
+            }
+        }
+        puts ""
+    }
+}
+
+proc zelda_encode {} {
+    variable width
+    variable height
+    variable start
+    variable end
+    variable blocks
+
+    set edges [list]
+
+    for {set y 1} {$y <= $height} {incr y} {
+        for {set x 1} {$x <= $width} {incr x} {
+            set blocked [expr {[lsearch $blocks [list $x $y]] >= 0}]
+
+            # edges to the right and upper neighbours, blocked squares are left out
+            if {$x < $width} {
+                set route "route_x_${x}_[expr $x + 1]_${y}"
+                if {$blocked || ([lsearch $blocks [list [expr $x + 1] $y]] >= 0)} {
+                    add_clause -clause [list "-$route"]
+                } else {
+                    lappend edges [list "${x}_${y}" "[expr $x + 1]_${y}" $route]
+                }
+            }
+            if {$y < $height} {
+                set route "route_y_${x}_${y}_[expr $y + 1]"
+                if {$blocked || ([lsearch $blocks [list $x [expr $y + 1]]] >= 0)} {
+                    add_clause -clause [list "-$route"]
+                } else {
+                    lappend edges [list "${x}_${y}" "${x}_[expr $y + 1]" $route]
+                }
+            }
+        }
+    }
+
+    set args [list -constraint "hamiltonian_path" -edges $edges]
+    if {$start != {0 0}} {
+        lappend args -source [join $start "_"]
+    }
+    if {$end != {0 0}} {
+        lappend args -target [join $end "_"]
+    }
+
+    add_graph_constraint {*}$args
+}
+
+print_zeldaproblem "false"
+
+zelda_encode
+
+if {[solve]} {
+    print_zeldaproblem "true"
+}
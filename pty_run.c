@@ -21,7 +21,10 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
 #include <pty.h>
+#include <signal.h>
 #include <unistd.h>
 #include <sys/wait.h>
 
@@ -37,8 +40,19 @@ struct pty_run_data {
     GString *line_data;
     /* set to true if last character read */
     bool    done;
+    /* monotonic time (microseconds) at which child is stopped, 0 for no limit */
+    gint64  deadline;
+    /* set to true if child has been stopped at deadline */
+    bool    timed_out;
+    /* child is stopped as soon as this flag is set, NULL if unused */
+    const gint *stop;
+    /* set to true if child has been stopped by stop flag */
+    bool    stopped;
 };
 
+/* interval (milliseconds) for checking the stop flag while waiting for output */
+#define PTY_RUN_STOP_POLL_MS 50
+
 /* function run by child after fork, argv = argument list (argv[0] = executable) */
 static void pty_run_child (char *argv[]);
 
@@ -49,6 +63,10 @@ struct pty_run_data * pty_run_new (GSList *exec_arg_list)
     struct pty_run_data *result = g_slice_new (struct pty_run_data);
     result->line_data = NULL;
     result->done = false;
+    result->deadline = 0;
+    result->timed_out = false;
+    result->stop = NULL;
+    result->stopped = false;
     
     /* argument list */
     result->arg_list = g_array_new (true, false, sizeof (char *));
@@ -85,6 +103,77 @@ static void pty_run_child (char *argv[])
     /* not reached */
 }
 
+/* stop child process (SIGKILL) if it is still running after given number of seconds
+ * while lines are read by pty_run_getline, 0 for no limit */
+void pty_run_set_timeout (struct pty_run_data *data, double seconds)
+{
+    if (data == NULL) return;
+
+    data->deadline = (seconds > 0 ? g_get_monotonic_time () + (gint64) (seconds * G_USEC_PER_SEC) : 0);
+}
+
+/* return true if child process has been stopped by the timeout */
+bool pty_run_timed_out (struct pty_run_data *data)
+{
+    if (data == NULL) return false;
+
+    return data->timed_out;
+}
+
+/* stop child process (SIGKILL) as soon as *stop is set (non-zero, e.g. by g_atomic_int_set from another thread)
+ * while lines are read by pty_run_getline, NULL for no stop flag */
+void pty_run_set_stop_flag (struct pty_run_data *data, const gint *stop)
+{
+    if (data == NULL) return;
+
+    data->stop = stop;
+}
+
+/* return true if child process has been stopped by the stop flag */
+bool pty_run_stopped (struct pty_run_data *data)
+{
+    if (data == NULL) return false;
+
+    return data->stopped;
+}
+
+/* wait until child process output can be read, the deadline is reached or the stop flag is set,
+ * in the latter cases the child is stopped. returns false if the child has been stopped. */
+static bool pty_run_wait_readable (struct pty_run_data *data)
+{
+    if ((data->deadline == 0) && (data->stop == NULL)) return true;
+
+    struct pollfd poll_fd = {data->pty_fd, POLLIN, 0};
+
+    while (true) {
+        if ((data->stop != NULL) && g_atomic_int_get (data->stop)) {
+            data->stopped = true;
+            break;
+        }
+
+        int timeout_ms = -1;
+        if (data->deadline != 0) {
+            gint64 remaining = data->deadline - g_get_monotonic_time ();
+            if (remaining <= 0) {
+                data->timed_out = true;
+                break;
+            }
+            timeout_ms = (int) (remaining / 1000) + 1;
+        }
+        if ((data->stop != NULL) && ((timeout_ms < 0) || (timeout_ms > PTY_RUN_STOP_POLL_MS))) {
+            timeout_ms = PTY_RUN_STOP_POLL_MS;
+        }
+
+        int n_ready = poll (&poll_fd, 1, timeout_ms);
+        if (n_ready > 0) return true;
+        if ((n_ready < 0) && (errno != EINTR)) return true;
+    }
+
+    kill (data->child_pid, SIGKILL);
+
+    return false;
+}
+
 /* wait on child an free data */
 void pty_run_finish (struct pty_run_data **data)
 {
@@ -126,7 +215,7 @@ const char * pty_run_getline (struct pty_run_data *data)
     char read_char;
     int  pty_fd = data->pty_fd;
 
-    while (read (pty_fd, &read_char, 1) > 0) {
+    while (pty_run_wait_readable (data) && (read (pty_fd, &read_char, 1) > 0)) {
         if (read_char == '\n') return line->str;
         g_string_append_c (line, read_char);
     }
@@ -19,6 +19,7 @@
 #ifndef __pty_run_h__
 #define __pty_run_h__
 
+#include <stdbool.h>
 #include <glib.h>
 
 typedef struct pty_run_data *PTYRunData;
@@ -27,6 +28,20 @@ typedef struct pty_run_data *PTYRunData;
  * returns data needed for interaction or NULL on failure */
 PTYRunData pty_run_new (GSList *exec_arg_list);
 
+/* stop child process (SIGKILL) if it is still running after given number of seconds
+ * while lines are read by pty_run_getline, 0 for no limit */
+void pty_run_set_timeout (PTYRunData data, double seconds);
+
+/* return true if child process has been stopped by the timeout */
+bool pty_run_timed_out (PTYRunData data);
+
+/* stop child process (SIGKILL) as soon as *stop is set (non-zero, e.g. by g_atomic_int_set from another thread)
+ * while lines are read by pty_run_getline, NULL for no stop flag */
+void pty_run_set_stop_flag (PTYRunData data, const gint *stop);
+
+/* return true if child process has been stopped by the stop flag */
+bool pty_run_stopped (PTYRunData data);
+
 /* wait on child an free data */
 void pty_run_finish (PTYRunData *data);
 
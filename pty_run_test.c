@@ -20,6 +20,78 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
+
+/* run a long-running command with a short timeout and check that it is stopped in time.
+ * returns true on success. */
+static bool pty_run_test_timeout (void)
+{
+    GSList *execlist = NULL;
+    execlist = g_slist_append (execlist, "sleep");
+    execlist = g_slist_append (execlist, "10");
+
+    gint64 start = g_get_monotonic_time ();
+
+    PTYRunData run_data = pty_run_new (execlist);
+    g_slist_free (execlist);
+    if (run_data == NULL) return false;
+
+    pty_run_set_timeout (run_data, 0.2);
+
+    while (pty_run_getline (run_data) != NULL);
+
+    bool timed_out = pty_run_timed_out (run_data);
+    pty_run_finish (&run_data);
+
+    double seconds = (g_get_monotonic_time () - start) / (double) G_USEC_PER_SEC;
+    bool result = timed_out && (seconds < 5.0);
+
+    fprintf (stderr, "%s: timeout 0.2 s, stopped: %s after %.3f s\n", (result ? "OK    " : "FAILED"), (timed_out ? "yes" : "no"), seconds);
+
+    return result;
+}
+
+/* thread function setting the stop flag (gint *) after 0.2 s */
+static gpointer pty_run_test_stop_func (gpointer data)
+{
+    g_usleep (G_USEC_PER_SEC / 5);
+    g_atomic_int_set ((gint *) data, 1);
+
+    return NULL;
+}
+
+/* run a long-running command and check that it is stopped in time once the stop flag
+ * is set by another thread. returns true on success. */
+static bool pty_run_test_stop (void)
+{
+    GSList *execlist = NULL;
+    execlist = g_slist_append (execlist, "sleep");
+    execlist = g_slist_append (execlist, "10");
+
+    gint64 start = g_get_monotonic_time ();
+    gint stop    = 0;
+
+    PTYRunData run_data = pty_run_new (execlist);
+    g_slist_free (execlist);
+    if (run_data == NULL) return false;
+
+    pty_run_set_stop_flag (run_data, &stop);
+    GThread *thread = g_thread_new ("stop", pty_run_test_stop_func, &stop);
+
+    while (pty_run_getline (run_data) != NULL);
+
+    bool stopped   = pty_run_stopped (run_data);
+    bool timed_out = pty_run_timed_out (run_data);
+    pty_run_finish (&run_data);
+    g_thread_join (thread);
+
+    double seconds = (g_get_monotonic_time () - start) / (double) G_USEC_PER_SEC;
+    bool result = stopped && !timed_out && (seconds < 5.0);
+
+    fprintf (stderr, "%s: stop flag set after 0.2 s, stopped: %s after %.3f s\n", (result ? "OK    " : "FAILED"), (stopped ? "yes" : "no"), seconds);
+
+    return result;
+}
 
 int main (int argc, char *argv[])
 {
@@ -27,6 +99,15 @@ int main (int argc, char *argv[])
 
     if (argc <= 1) return -1;
 
+    /* self check of timeout */
+    if (strcmp (argv[1], "--timeout") == 0) {
+        return (pty_run_test_timeout () ? 0 : 1);
+    }
+    /* self check of stop flag */
+    if (strcmp (argv[1], "--stop") == 0) {
+        return (pty_run_test_stop () ? 0 : 1);
+    }
+
     for (int i = 1; i < argc; i++) {
         execlist = g_slist_prepend (execlist, argv[i]);
     }
@@ -17,6 +17,11 @@
  */
 
 #include "sat_base_cnf.h"
+#include "sat_preprocess.h"
+#include "sat_cube.h"
+#include "sat_symmetry.h"
+#include "sat_xor.h"
+#include "sat_pb.h"
 #include "pty_run.h"
 
 #include <stdio.h>
@@ -27,6 +32,48 @@
 #include <glib.h>
 #include <zlib.h>
 
+/* assignments implied by unit and binary clauses for simplifying new clauses */
+struct base_cnf_units {
+    /* number of entries of value: greatest variable + 1 */
+    unsigned long int n_vars;
+    /* value per variable: 0 unassigned, 1 true, -1 false */
+    signed char *value;
+    /* literals (long int) implied by binary clauses per literal index */
+    GArray **implications;
+
+    /* assigned literals (long int) and index of the clause (guint) implying them */
+    GArray *trail;
+    GArray *trail_clause;
+    /* literal indices (guint) whose implications have been appended and index of the clause (guint) */
+    GArray *implication_log;
+    GArray *implication_clause;
+
+    /* true if an empty clause has been derived and index of the clause */
+    bool  unsat;
+    guint unsat_clause;
+
+    /* statistics */
+    unsigned long int n_dropped;
+    unsigned long int n_removed_lits;
+};
+
+/* cardinality constraint stored as descriptor and expanded into clauses when needed */
+struct base_cnf_lazy {
+    SatCardinalityEncoding encoding;
+    /* literals (long int) of the constraint */
+    long int     *lits;
+    unsigned int n;
+    /* at least min and at most max of the literals are true */
+    unsigned int min;
+    unsigned int max;
+    /* literal added to each clause or 0 */
+    long int     guard;
+    /* first auxiliary variable of the encoding */
+    unsigned long int first_var;
+    /* number of clauses of the encoding */
+    unsigned long int n_clauses;
+};
+
 /* base cnf data struct */
 struct base_cnf {
     /* maximum variable */
@@ -34,10 +81,150 @@ struct base_cnf {
 
     /* GQueue containing clauses as 0-terminated arrays of literals as (long int) */
     GQueue *clauses;
+    /* GQueue containing XOR constraints as 0-terminated arrays of at least 3 literals as (long int)
+     * whose exclusive or is true */
+    GQueue *xors;
+    /* GQueue containing cardinality constraints (struct base_cnf_lazy *) expanded into clauses when needed */
+    GQueue *lazy;
+    /* total number of clauses of lazy constraints */
+    unsigned long int lazy_n_clauses;
     /* GSList containing solution literal values as (long int) - NULL if not solved */
     GSList *solution;
+
+    /* clauses already formatted in DIMACS format for writing cnf files without formatting them again,
+     * only built once the clauses are written a second time (e.g. enumeration, incremental runs) */
+    GString *dimacs_cache;
+    /* last element of clauses already contained in dimacs_cache or NULL */
+    GList   *dimacs_cache_last;
+    /* number of clauses contained in dimacs_cache */
+    unsigned long int dimacs_cache_n_clauses;
+    /* number of cnf files written with the clauses */
+    unsigned long int dimacs_n_writes;
+    /* protects dimacs_cache for concurrent solver runs */
+    GMutex   dimacs_cache_mutex;
+
+    /* settings for preprocessing before solving or NULL if disabled */
+    struct sat_preprocess_options *preprocess_options;
+
+    /* implied assignments for simplifying new clauses or NULL if disabled */
+    struct base_cnf_units *units;
+
+    /* solve variable-disjoint components by separate solver runs */
+    bool              split_components;
+    /* number of concurrent solver runs for components (0: number of processors) */
+    unsigned int      split_threads;
+    /* components with less variables are solved together by one run */
+    unsigned long int split_min_vars;
+
+    /* write clauses with compacted variables in locality-aware order */
+    bool              renumber;
+
+    /* add symmetry-breaking clauses before solving */
+    bool              symmetry_breaking;
+    /* symmetry search is skipped for more clauses + literals */
+    unsigned long int symmetry_max_vertices;
+    unsigned int      symmetry_max_generators;
+
+    /* write XOR constraints as native "x" lines instead of clauses */
+    bool              xor_native;
+    /* maximum number of literals per XOR constraint of the clause encoding */
+    unsigned int      xor_cut;
+    /* maximum number of bits of the Gauss-Jordan matrix (0: no elimination) */
+    unsigned long int xor_gauss_max_bits;
+    /* true for temporary copies with XOR constraints already encoded */
+    bool              xor_view;
+
+    /* solver runs are stopped after this number of seconds (0: no limit) */
+    double            solver_timeout;
+    /* solver runs are stopped at this monotonic time including writing the cnf file (0: none) */
+    gint64            solver_deadline;
+    /* set if a solver run has been stopped by solver_timeout since it was last configured */
+    gint              solver_timed_out;
+};
+
+/* clauses of one or more variable-disjoint components solved by one solver run */
+struct base_cnf_component_job {
+    /* clauses in DIMACS format with variables renumbered to 1 ... vars->len */
+    GString           *clauses;
+    unsigned long int n_clauses;
+    /* original variable (long int) of each renumbered variable */
+    GArray            *vars;
+    /* solution of run as GSList of renumbered literals (long int) */
+    GSList            *solution;
+    unsigned int      index;
+};
+
+/* shared data of cube-and-conquer worker threads */
+struct base_cnf_cube_run {
+    struct base_cnf *cnf;
+    const char      *tmp_file_name;
+    const char      *solver_bin;
+    bool            solution_on_stdout;
+    bool            cleanup;
+    bool            cnf_gz;
+    /* assumptions of all cubes (long int) */
+    const long int  *assumptions;
+    unsigned long int n_assumptions;
+    /* GPtrArray of cubes as 0-terminated arrays of literals (long int *) */
+    GPtrArray       *cubes;
+
+    /* set if a run failed or a solution has been found, remaining cubes are skipped */
+    gint            error;
+    gint            satisfiable;
+    /* set together with error or satisfiable, stops the solvers still running */
+    gint            stop;
+
+    /* protects solution and progress counters */
+    GMutex          mutex;
+    GSList          *solution;
+    guint           n_done;
+};
+
+/* shared data of component solver threads */
+struct base_cnf_component_run {
+    struct base_cnf *cnf;
+    const char      *tmp_file_name;
+    const char      *solver_bin;
+    bool            solution_on_stdout;
+    bool            cleanup;
+    bool            cnf_gz;
+    /* set if a run failed or a component is not satisfiable, remaining runs are skipped */
+    gint            error;
+    gint            unsat;
+    /* set together with error or unsat, solvers still running are stopped */
+    gint            stop;
+};
+
+/* size of DIMACS formatted clauses written at once if they are not cached */
+#define BASE_CNF_DIMACS_CHUNK_SIZE 65536
+
+/* maximum number of clauses of the totalizer of an objective in base_cnf_optimize */
+#define BASE_CNF_OPTIMIZE_MAX_TOTALIZER_CLAUSES 1000000
+
+/* minimum number of constraints checked by each concurrent model verification job */
+#define BASE_CNF_VERIFY_MIN_JOB_SIZE 65536
+
+/* shared data of model verification threads */
+struct base_cnf_verify_run {
+    /* clauses followed by XOR constraints as 0-terminated arrays of literals (const long int *) */
+    GPtrArray       *constraints;
+    guint           job_size;
+    /* bit-packed model indexed by variable: variable assigned / variable true */
+    guint64         *assigned;
+    guint64         *value;
+    unsigned long int max_var;
+    /* index of first violated clause or XOR constraint */
+    gint            n_clauses;
+    gint            first_violated;
 };
 
+/* frees a lazy constraint */
+static void base_cnf_lazy_free (struct base_cnf_lazy *lazy);
+
+/* solves cnf under assumptions until *stop is set */
+static bool base_cnf_solve_stoppable (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                      const long int *assumptions, const gint *stop, bool verbose, GSList **solution);
+
 /* returns a newly allocated BaseCNF */
 struct base_cnf * base_cnf_new ()
 {
@@ -47,8 +234,38 @@ struct base_cnf * base_cnf_new ()
     result->max_var = 0;
     result->clauses  = g_queue_new ();
     if (result->clauses == NULL) return NULL;
+    result->xors     = g_queue_new ();
+    result->lazy     = g_queue_new ();
+    result->lazy_n_clauses = 0;
     result->solution = NULL;
 
+    result->dimacs_cache      = g_string_new (NULL);
+    result->dimacs_cache_last = NULL;
+    result->dimacs_cache_n_clauses = 0;
+    result->dimacs_n_writes = 0;
+    g_mutex_init (&(result->dimacs_cache_mutex));
+
+    result->preprocess_options = NULL;
+    result->units              = NULL;
+
+    result->split_components   = false;
+    result->split_threads      = 0;
+    result->split_min_vars     = 0;
+
+    result->renumber                = false;
+    result->symmetry_breaking       = false;
+    result->symmetry_max_vertices   = 0;
+    result->symmetry_max_generators = 0;
+
+    result->xor_native         = false;
+    result->xor_cut            = 4;
+    result->xor_gauss_max_bits = 1UL << 24;
+    result->xor_view           = false;
+
+    result->solver_timeout     = 0;
+    result->solver_deadline    = 0;
+    result->solver_timed_out   = 0;
+
     return result;
 }
 
@@ -77,6 +294,28 @@ void base_cnf_free (struct base_cnf **cnf)
         g_queue_free (rcnf->clauses);
     }
 
+    while (!g_queue_is_empty (rcnf->xors)) {
+        long int *xor = g_queue_pop_tail (rcnf->xors);
+        int len = 0;
+        while (xor[len] != 0) len++;
+        g_slice_free1 (sizeof (long int) * (len + 1), xor);
+    }
+    g_queue_free (rcnf->xors);
+
+    while (!g_queue_is_empty (rcnf->lazy)) {
+        base_cnf_lazy_free (g_queue_pop_tail (rcnf->lazy));
+    }
+    g_queue_free (rcnf->lazy);
+
+    g_string_free (rcnf->dimacs_cache, true);
+    g_mutex_clear (&(rcnf->dimacs_cache_mutex));
+
+    if (rcnf->preprocess_options != NULL) {
+        g_slice_free (struct sat_preprocess_options, rcnf->preprocess_options);
+    }
+
+    base_cnf_set_unit_simplification (rcnf, false);
+
     g_slice_free (struct base_cnf, rcnf);
 
     *cnf = NULL;
@@ -91,6 +330,257 @@ static void base_cnf_clear_solution (struct base_cnf *cnf)
     cnf->solution = NULL;
 }
 
+/* return index of literal for implication lists */
+static inline guint base_cnf_lit_index (long int lit)
+{
+    return (lit > 0 ? 2 * lit : 2 * (-lit) + 1);
+}
+
+/* return value of literal in units: 0 unassigned, 1 true, -1 false */
+static int base_cnf_units_value (struct base_cnf_units *units, long int lit)
+{
+    unsigned long int var = (lit > 0 ? lit : -lit);
+    if (var >= units->n_vars) return 0;
+
+    int val = units->value[var];
+    return (lit > 0 ? val : -val);
+}
+
+/* make room for variable var in units */
+static void base_cnf_units_reserve (struct base_cnf_units *units, unsigned long int var)
+{
+    if (var < units->n_vars) return;
+
+    unsigned long int n_vars = 2 * units->n_vars;
+    if (n_vars <= var) n_vars = var + 1;
+
+    units->value        = g_renew (signed char, units->value, n_vars);
+    units->implications = g_renew (GArray *, units->implications, 2 * n_vars);
+
+    for (unsigned long int i = units->n_vars; i < n_vars; i++) {
+        units->value[i] = 0;
+        units->implications[2 * i]     = NULL;
+        units->implications[2 * i + 1] = NULL;
+    }
+
+    units->n_vars = n_vars;
+}
+
+/* assign literal implied by clause with index ci and propagate it through binary clauses */
+static void base_cnf_units_assign (struct base_cnf_units *units, long int lit, guint ci)
+{
+    guint head = units->trail->len;
+
+    int val = base_cnf_units_value (units, lit);
+    if (val > 0) return;
+    if (val < 0) {
+        if (!units->unsat) units->unsat_clause = ci;
+        units->unsat = true;
+        return;
+    }
+
+    base_cnf_units_reserve (units, (lit > 0 ? lit : -lit));
+    units->value[lit > 0 ? lit : -lit] = (lit > 0 ? 1 : -1);
+    g_array_append_val (units->trail, lit);
+    g_array_append_val (units->trail_clause, ci);
+
+    while (head < units->trail->len) {
+        long int t_lit = g_array_index (units->trail, long int, head);
+        head++;
+
+        GArray *implied = units->implications[base_cnf_lit_index (t_lit)];
+        if (implied == NULL) continue;
+
+        for (guint i = 0; i < implied->len; i++) {
+            long int i_lit = g_array_index (implied, long int, i);
+
+            val = base_cnf_units_value (units, i_lit);
+            if (val > 0) continue;
+            if (val < 0) {
+                if (!units->unsat) units->unsat_clause = ci;
+                units->unsat = true;
+                return;
+            }
+
+            base_cnf_units_reserve (units, (i_lit > 0 ? i_lit : -i_lit));
+            units->value[i_lit > 0 ? i_lit : -i_lit] = (i_lit > 0 ? 1 : -1);
+            g_array_append_val (units->trail, i_lit);
+            g_array_append_val (units->trail_clause, ci);
+        }
+    }
+}
+
+/* append implication from literal lit to literal implied caused by clause with index ci */
+static void base_cnf_units_add_implication (struct base_cnf_units *units, long int lit, long int implied, guint ci)
+{
+    base_cnf_units_reserve (units, (lit > 0 ? lit : -lit));
+
+    guint index = base_cnf_lit_index (lit);
+    if (units->implications[index] == NULL) {
+        units->implications[index] = g_array_new (false, false, sizeof (long int));
+    }
+
+    g_array_append_val (units->implications[index], implied);
+    g_array_append_val (units->implication_log, index);
+    g_array_append_val (units->implication_clause, ci);
+}
+
+/* record assignments and implications of clause with index ci */
+static void base_cnf_units_learn (struct base_cnf_units *units, const long int *clause, guint ci)
+{
+    long int open_lits[2] = {0, 0};
+    unsigned int n_open   = 0;
+
+    for (unsigned int i = 0; clause[i] != 0; i++) {
+        int val = base_cnf_units_value (units, clause[i]);
+        if (val > 0) return;
+        if (val < 0) continue;
+
+        if (n_open < 2) open_lits[n_open] = clause[i];
+        n_open++;
+    }
+
+    if (n_open == 0) {
+        if (!units->unsat) units->unsat_clause = ci;
+        units->unsat = true;
+    } else if (n_open == 1) {
+        base_cnf_units_assign (units, open_lits[0], ci);
+    } else if (n_open == 2) {
+        base_cnf_units_add_implication (units, -open_lits[0], open_lits[1], ci);
+        base_cnf_units_add_implication (units, -open_lits[1], open_lits[0], ci);
+    }
+}
+
+/* appends new_clause with len literals allocated with g_slice to clauses of cnf.
+ * with unit simplification the clause is dropped if satisfied and false literals are removed */
+static void base_cnf_push_clause (struct base_cnf *cnf, long int *new_clause, unsigned int len)
+{
+    struct base_cnf_units *units = cnf->units;
+
+    if (units != NULL) {
+        unsigned int new_len = 0;
+        bool satisfied       = false;
+
+        for (unsigned int i = 0; i < len; i++) {
+            int val = base_cnf_units_value (units, new_clause[i]);
+            if (val > 0) {
+                satisfied = true;
+                break;
+            }
+            if (val == 0) new_len++;
+        }
+
+        if (satisfied) {
+            g_slice_free1 (sizeof (long int) * (len + 1), new_clause);
+            units->n_dropped++;
+            base_cnf_clear_solution (cnf);
+            return;
+        }
+
+        /* an empty clause is stored unchanged to keep the stored formula unsatisfiable */
+        if ((new_len > 0) && (new_len < len)) {
+            long int *short_clause = g_slice_alloc (sizeof (long int) * (new_len + 1));
+            unsigned int j = 0;
+            for (unsigned int i = 0; i < len; i++) {
+                if (base_cnf_units_value (units, new_clause[i]) < 0) continue;
+                short_clause[j] = new_clause[i];
+                j++;
+            }
+            short_clause[new_len] = 0;
+
+            g_slice_free1 (sizeof (long int) * (len + 1), new_clause);
+            units->n_removed_lits += len - new_len;
+            new_clause = short_clause;
+        }
+
+        base_cnf_units_learn (units, new_clause, g_queue_get_length (cnf->clauses));
+    }
+
+    g_queue_push_tail (cnf->clauses, (gpointer) new_clause);
+
+    base_cnf_clear_solution (cnf);
+}
+
+/* enable or disable simplification of new clauses by assignments implied by unit and binary clauses.
+ * when enabled, new clauses are dropped if satisfied and false literals are removed from them. */
+void base_cnf_set_unit_simplification (struct base_cnf *cnf, bool enable)
+{
+    if (cnf == NULL) return;
+
+    struct base_cnf_units *units = cnf->units;
+
+    if (!enable) {
+        if (units == NULL) return;
+
+        for (unsigned long int i = 0; i < 2 * units->n_vars; i++) {
+            if (units->implications[i] != NULL) g_array_free (units->implications[i], true);
+        }
+        g_free (units->implications);
+        g_free (units->value);
+
+        g_array_free (units->trail, true);
+        g_array_free (units->trail_clause, true);
+        g_array_free (units->implication_log, true);
+        g_array_free (units->implication_clause, true);
+
+        g_slice_free (struct base_cnf_units, units);
+        cnf->units = NULL;
+        return;
+    }
+
+    if (units != NULL) return;
+
+    units = g_slice_new (struct base_cnf_units);
+
+    units->n_vars       = 0;
+    units->value        = NULL;
+    units->implications = NULL;
+    base_cnf_units_reserve (units, cnf->max_var);
+
+    units->trail              = g_array_new (false, false, sizeof (long int));
+    units->trail_clause       = g_array_new (false, false, sizeof (guint));
+    units->implication_log    = g_array_new (false, false, sizeof (guint));
+    units->implication_clause = g_array_new (false, false, sizeof (guint));
+
+    units->unsat          = false;
+    units->unsat_clause   = 0;
+    units->n_dropped      = 0;
+    units->n_removed_lits = 0;
+
+    cnf->units = units;
+
+    /* existing clauses are only used for deriving assignments */
+    guint ci = 0;
+    for (GList *cl = cnf->clauses->head; cl != NULL; cl = cl->next, ci++) {
+        base_cnf_units_learn (units, (const long int *) cl->data, ci);
+    }
+}
+
+/* undo assignments and implications of clauses with index n_clauses or greater */
+static void base_cnf_units_truncate (struct base_cnf_units *units, guint n_clauses)
+{
+    while ((units->trail->len > 0) &&
+           (g_array_index (units->trail_clause, guint, units->trail_clause->len - 1) >= n_clauses)) {
+        long int lit = g_array_index (units->trail, long int, units->trail->len - 1);
+        units->value[lit > 0 ? lit : -lit] = 0;
+
+        g_array_set_size (units->trail, units->trail->len - 1);
+        g_array_set_size (units->trail_clause, units->trail_clause->len - 1);
+    }
+
+    while ((units->implication_log->len > 0) &&
+           (g_array_index (units->implication_clause, guint, units->implication_clause->len - 1) >= n_clauses)) {
+        guint index = g_array_index (units->implication_log, guint, units->implication_log->len - 1);
+        GArray *implied = units->implications[index];
+        g_array_set_size (implied, implied->len - 1);
+
+        g_array_set_size (units->implication_log, units->implication_log->len - 1);
+        g_array_set_size (units->implication_clause, units->implication_clause->len - 1);
+    }
+
+    if (units->unsat && (units->unsat_clause >= n_clauses)) units->unsat = false;
+}
+
 /* adds a clause to *cnf given as 0-terminated array of literals as (long int) */
 void base_cnf_add_clause_array (struct base_cnf *cnf, const long int *clause)
 {
@@ -113,9 +603,15 @@ void base_cnf_add_clause_array (struct base_cnf *cnf, const long int *clause)
     }
     new_clause[len] = 0;
 
-    g_queue_push_tail (cnf->clauses, (gpointer) new_clause);
+    base_cnf_push_clause (cnf, new_clause, len);
+}
 
-    base_cnf_clear_solution (cnf);
+/* adds an empty clause to *cnf, making it unsatisfiable */
+void base_cnf_add_empty_clause (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return;
+
+    base_cnf_push_clause (cnf, g_slice_alloc0 (sizeof (long int)), 0);
 }
 
 /* adds a clause to *cnf given as GSList of literals as (long int) */
@@ -140,9 +636,7 @@ void base_cnf_add_clause_gslist (BaseCNF cnf, GSList *clause)
     }
     new_clause[len] = 0;
 
-    g_queue_push_tail (cnf->clauses, (gpointer) new_clause);
-
-    base_cnf_clear_solution (cnf);
+    base_cnf_push_clause (cnf, new_clause, len);
 }
 
 /* adds a clause to *cnf given as GQueue of literals as (long int) */
@@ -167,41 +661,257 @@ void base_cnf_add_clause_gqueue (BaseCNF cnf, GQueue *clause)
     }
     new_clause[len] = 0;
 
-    g_queue_push_tail (cnf->clauses, (gpointer) new_clause);
+    base_cnf_push_clause (cnf, new_clause, len);
+}
+
+/* adds an XOR constraint to *cnf given as 0-terminated array of literals as (long int) whose exclusive or is true.
+ * the constraint is normalized, with unit simplification assigned variables are removed.
+ * constraints with less than 3 variables are added as clauses. */
+void base_cnf_add_xor_array (struct base_cnf *cnf, const long int *xor)
+{
+    if (cnf == NULL) return;
+    if (xor == NULL) return;
+
+    unsigned int len = 0;
+    while (xor[len] != 0) len++;
+
+    long int *lits = g_new (long int, len + 1);
+    for (unsigned int i = 0; i < len; i++) {
+        lits[i] = xor[i];
+
+        unsigned long int var = (xor[i] > 0 ? xor[i] : -xor[i]);
+        if (var > cnf->max_var) cnf->max_var = var;
+    }
+
+    bool parity;
+    const signed char *value = NULL;
+    unsigned long int n_vars = 0;
+    if (cnf->units != NULL) {
+        value  = cnf->units->value;
+        n_vars = cnf->units->n_vars;
+    }
+    unsigned int size = sat_xor_normalize (lits, len, value, (n_vars > 0 ? n_vars - 1 : 0), &parity);
+
+    long int clause[3];
+
+    if (size == 0) {
+        /* false constraint: store empty clause */
+        if (parity) base_cnf_push_clause (cnf, g_slice_alloc0 (sizeof (long int)), 0);
+    } else if (size == 1) {
+        clause[0] = (parity ? lits[0] : -lits[0]);
+        clause[1] = 0;
+        base_cnf_add_clause_array (cnf, clause);
+    } else if (size == 2) {
+        clause[2] = 0;
+        clause[0] = lits[0];
+        clause[1] = (parity ? lits[1] : -lits[1]);
+        base_cnf_add_clause_array (cnf, clause);
+        clause[0] = -lits[0];
+        clause[1] = (parity ? -lits[1] : lits[1]);
+        base_cnf_add_clause_array (cnf, clause);
+    } else {
+        long int *new_xor = g_slice_alloc (sizeof (long int) * (size + 1));
+        memcpy (new_xor, lits, sizeof (long int) * size);
+        if (!parity) new_xor[0] = -new_xor[0];
+        new_xor[size] = 0;
+
+        g_queue_push_tail (cnf->xors, new_xor);
+        base_cnf_clear_solution (cnf);
+    }
+
+    g_free (lits);
+}
+
+/* frees a lazy constraint */
+static void base_cnf_lazy_free (struct base_cnf_lazy *lazy)
+{
+    g_free (lazy->lits);
+    g_slice_free (struct base_cnf_lazy, lazy);
+}
+
+/* appends the clauses of lazy constraint lazy to clauses (GQueue of 0-terminated arrays of literals (long int))
+ * and returns their number */
+static unsigned long int base_cnf_lazy_expand (const struct base_cnf_lazy *lazy, GQueue *clauses)
+{
+    unsigned long int next_var = lazy->first_var;
+
+    if (lazy->guard == 0) {
+        return sat_cardinality_append (lazy->encoding, lazy->lits, lazy->n, lazy->min, lazy->max, &next_var, clauses);
+    }
+
+    GQueue *unguarded = g_queue_new ();
+    unsigned long int result = sat_cardinality_append (lazy->encoding, lazy->lits, lazy->n, lazy->min, lazy->max, &next_var, unguarded);
+
+    while (!g_queue_is_empty (unguarded)) {
+        long int *clause = g_queue_pop_head (unguarded);
+
+        unsigned int len = 0;
+        while (clause[len] != 0) len++;
+
+        long int *guarded_clause = g_slice_alloc (sizeof (long int) * (len + 2));
+        memcpy (guarded_clause, clause, sizeof (long int) * len);
+        guarded_clause[len]     = lazy->guard;
+        guarded_clause[len + 1] = 0;
+        g_queue_push_tail (clauses, guarded_clause);
+
+        g_slice_free1 (sizeof (long int) * (len + 1), clause);
+    }
+    g_queue_free (unguarded);
+
+    return result;
+}
+
+/* adds at least min and at most max of the n literals lits to cnf as descriptor of the given cardinality encoding,
+ * which is only expanded into clauses when they are needed. guard is added to each clause if not 0.
+ * auxiliary variables are numbered from *next_var on, which is incremented accordingly.
+ * returns the number of clauses. */
+unsigned long int base_cnf_add_lazy_cardinality (struct base_cnf *cnf, SatCardinalityEncoding encoding, const long int *lits, unsigned int n,
+                                                 unsigned int min, unsigned int max, long int guard, unsigned long int *next_var)
+{
+    if (cnf == NULL) return 0;
+    if (next_var == NULL) return 0;
+
+    struct base_cnf_lazy *lazy = g_slice_new (struct base_cnf_lazy);
+
+    lazy->encoding  = encoding;
+    lazy->lits      = g_new (long int, n);
+    lazy->n         = n;
+    lazy->min       = min;
+    lazy->max       = max;
+    lazy->guard     = guard;
+    lazy->first_var = *next_var;
+    memcpy (lazy->lits, lits, sizeof (long int) * n);
+
+    /* clauses are only counted, the encoding numbers auxiliary variables in the same way on expansion */
+    lazy->n_clauses = sat_cardinality_append (encoding, lits, n, min, max, next_var, NULL);
+
+    for (unsigned int i = 0; i < n; i++) {
+        unsigned long int var = (lits[i] > 0 ? lits[i] : -lits[i]);
+        if (var > cnf->max_var) cnf->max_var = var;
+    }
+    unsigned long int guard_var = (guard > 0 ? guard : -guard);
+    if (guard_var > cnf->max_var) cnf->max_var = guard_var;
+    if (*next_var - 1 > cnf->max_var) cnf->max_var = *next_var - 1;
+
+    g_queue_push_tail (cnf->lazy, lazy);
+    cnf->lazy_n_clauses += lazy->n_clauses;
 
     base_cnf_clear_solution (cnf);
+
+    return lazy->n_clauses;
 }
 
-/* prints a clause given as 0-terminated array of literals into file in DIMACS format */
-static void base_cnf_print_dimacs_clause (FILE *file, const long int *clause)
+/* appends a clause given as 0-terminated array of literals to str in DIMACS format */
+static void base_cnf_append_dimacs_clause (GString *str, const long int *clause)
 {
-    if (file == NULL) return;
+    if (str == NULL) return;
     if (clause == NULL) return;
 
     int i = 0;
 
     while (clause[i] != 0) {
-        fprintf (file, "%ld ", clause[i]);
+        g_string_append_printf (str, "%ld ", clause[i]);
         i++;
     }
 
-    fprintf (file, "0\n");
+    g_string_append (str, "0\n");
 }
 
-/* prints a clause given as 0-terminated array of literals into gzip file in DIMACS format */
-static void base_cnf_print_dimacs_clause_gz (gzFile file, const long int *clause)
+/* appends the clauses of lazy constraint lazy to str in DIMACS format */
+static void base_cnf_append_dimacs_lazy (GString *str, const struct base_cnf_lazy *lazy)
 {
-    if (file == NULL) return;
-    if (clause == NULL) return;
+    GQueue *clauses = g_queue_new ();
+    base_cnf_lazy_expand (lazy, clauses);
 
-    int i = 0;
+    while (!g_queue_is_empty (clauses)) {
+        long int *clause = g_queue_pop_head (clauses);
+        base_cnf_append_dimacs_clause (str, clause);
 
-    while (clause[i] != 0) {
-        gzprintf (file, "%ld ", clause[i]);
-        i++;
+        unsigned int len = 0;
+        while (clause[len] != 0) len++;
+        g_slice_free1 (sizeof (long int) * (len + 1), clause);
+    }
+    g_queue_free (clauses);
+}
+
+/* counts a cnf file written with the clauses of *cnf and returns true if they are written from the DIMACS cache,
+ * in which case all clauses that are not yet contained in it are formatted. The cache is only built from
+ * the second write on, the first one formats the clauses while writing. */
+static bool base_cnf_update_dimacs_cache (struct base_cnf *cnf)
+{
+    g_mutex_lock (&(cnf->dimacs_cache_mutex));
+
+    cnf->dimacs_n_writes++;
+    if (cnf->dimacs_n_writes < 2) {
+        g_mutex_unlock (&(cnf->dimacs_cache_mutex));
+        return false;
+    }
+
+    GList *cl = (cnf->dimacs_cache_last == NULL ? cnf->clauses->head : cnf->dimacs_cache_last->next);
+
+    for (; cl != NULL; cl = cl->next) {
+        const long int *clause = (long int *) cl->data;
+        base_cnf_append_dimacs_clause (cnf->dimacs_cache, clause);
+        cnf->dimacs_cache_last = cl;
+        cnf->dimacs_cache_n_clauses++;
+    }
+
+    g_mutex_unlock (&(cnf->dimacs_cache_mutex));
+
+    return true;
+}
+
+/* removes clauses, XOR constraints and lazy constraints added last until n_clauses, n_xors and n_lazy remain and
+ * sets greatest variable number to max_var */
+void base_cnf_truncate (struct base_cnf *cnf, unsigned long int n_clauses, unsigned long int n_xors, unsigned long int n_lazy, unsigned long int max_var)
+{
+    if (cnf == NULL) return;
+
+    while (g_queue_get_length (cnf->lazy) > n_lazy) {
+        struct base_cnf_lazy *lazy = g_queue_pop_tail (cnf->lazy);
+        cnf->lazy_n_clauses -= lazy->n_clauses;
+        base_cnf_lazy_free (lazy);
+    }
+
+    while (g_queue_get_length (cnf->xors) > n_xors) {
+        long int *xor = g_queue_pop_tail (cnf->xors);
+        int len = 0;
+        while (xor[len] != 0) len++;
+        g_slice_free1 (sizeof (long int) * (len + 1), xor);
+    }
+
+    GString *temp_str = NULL;
+
+    g_mutex_lock (&(cnf->dimacs_cache_mutex));
+
+    while (g_queue_get_length (cnf->clauses) > n_clauses) {
+        long int *clause = g_queue_pop_tail (cnf->clauses);
+
+        /* remove formatted clause from end of DIMACS cache */
+        if (cnf->dimacs_cache_n_clauses > g_queue_get_length (cnf->clauses)) {
+            if (temp_str == NULL) temp_str = g_string_new (NULL);
+            g_string_truncate (temp_str, 0);
+            base_cnf_append_dimacs_clause (temp_str, clause);
+
+            g_string_truncate (cnf->dimacs_cache, cnf->dimacs_cache->len - temp_str->len);
+            cnf->dimacs_cache_n_clauses--;
+            cnf->dimacs_cache_last = cnf->clauses->tail;
+        }
+
+        int len = 0;
+        while (clause[len] != 0) len++;
+        g_slice_free1 (sizeof (long int) * (len + 1), clause);
     }
 
-    gzprintf (file, "0\n");
+    g_mutex_unlock (&(cnf->dimacs_cache_mutex));
+
+    if (temp_str != NULL) g_string_free (temp_str, true);
+
+    if (cnf->units != NULL) base_cnf_units_truncate (cnf->units, n_clauses);
+
+    if (max_var < cnf->max_var) cnf->max_var = max_var;
+
+    base_cnf_clear_solution (cnf);
 }
 
 /* prints a DIMACS header into file for a formula with max_var variables and num_clauses clauses */
@@ -220,40 +930,129 @@ static void base_cnf_print_dimacs_header_gz (gzFile file, unsigned long int max_
     gzprintf (file, "p cnf %ld %ld\n", max_var, num_clauses);
 }
 
-/* prints a DIMACS file for the formula represented by *cnf */
-static void base_cnf_print_dimacs (struct base_cnf *cnf, FILE *file)
+/* writes a DIMACS file with name file_name (gzipped if cnf_gz) for the formula represented by *cnf.
+ * write_clauses: if false, only extra_clauses are written instead of the clauses of *cnf,
+ * extra_clauses: additional DIMACS formatted clauses appended to the file or NULL,
+ * n_extra_clauses: number of clauses in extra_clauses,
+ * extra_max_var: greatest variable in extra_clauses, without clauses of cnf it is used for the header.
+ * returns true on success, false otherwise */
+static bool base_cnf_write_dimacs (struct base_cnf *cnf, const char *file_name, bool cnf_gz, bool write_clauses,
+                                   GString *extra_clauses, unsigned long int n_extra_clauses, unsigned long int extra_max_var)
 {
-    if (file == NULL) return;
-    if (cnf == NULL) return;
+    if (cnf == NULL) return false;
+    if (file_name == NULL) return false;
 
-    base_cnf_print_dimacs_header (file, cnf->max_var, g_queue_get_length (cnf->clauses));
+    bool cached = (write_clauses && base_cnf_update_dimacs_cache (cnf));
 
-    for (GList *cl = cnf->clauses->head; cl != NULL; cl = cl->next) {
-        const long int *clause = (long int *) cl->data;
-        base_cnf_print_dimacs_clause (file, clause);
+    unsigned long int max_var     = ((write_clauses && (cnf->max_var > extra_max_var)) ? cnf->max_var : extra_max_var);
+    unsigned long int num_clauses = (write_clauses ? g_queue_get_length (cnf->clauses) + cnf->lazy_n_clauses : 0) + n_extra_clauses;
+
+    /* clauses that are not cached are formatted in chunks */
+    GString *clause_lines = ((write_clauses && !cached) ? g_string_new (NULL) : NULL);
+
+    /* clauses of lazy constraints are formatted one constraint at a time */
+    GString *lazy_lines = ((write_clauses && !g_queue_is_empty (cnf->lazy)) ? g_string_new (NULL) : NULL);
+
+    /* native XOR constraints as "x" lines counted as clauses */
+    GString *xor_lines = NULL;
+    if (write_clauses && cnf->xor_native && !g_queue_is_empty (cnf->xors)) {
+        xor_lines = g_string_new (NULL);
+        for (GList *li = cnf->xors->head; li != NULL; li = li->next) {
+            g_string_append_c (xor_lines, 'x');
+            base_cnf_append_dimacs_clause (xor_lines, li->data);
+        }
+        num_clauses += g_queue_get_length (cnf->xors);
     }
-}
 
-/* prints a gzip DIMACS file for the formula represented by *cnf */
-static void base_cnf_print_dimacs_gz (struct base_cnf *cnf, gzFile file)
-{
-    if (file == NULL) return;
-    if (cnf == NULL) return;
+    if (!cnf_gz) {
+        FILE *file = fopen (file_name, "w");
+        if (file == NULL) {
+            printf ("ERROR: could not open file %s\n", file_name);
+            if (xor_lines != NULL) g_string_free (xor_lines, true);
+            if (lazy_lines != NULL) g_string_free (lazy_lines, true);
+            if (clause_lines != NULL) g_string_free (clause_lines, true);
+            return false;
+        }
 
-    base_cnf_print_dimacs_header_gz (file, cnf->max_var, g_queue_get_length (cnf->clauses));
+        base_cnf_print_dimacs_header (file, max_var, num_clauses);
+        if (cached) {
+            fwrite (cnf->dimacs_cache->str, sizeof (char), cnf->dimacs_cache->len, file);
+        }
+        for (GList *li = (clause_lines != NULL ? cnf->clauses->head : NULL); li != NULL; li = li->next) {
+            base_cnf_append_dimacs_clause (clause_lines, li->data);
+            if ((clause_lines->len >= BASE_CNF_DIMACS_CHUNK_SIZE) || (li->next == NULL)) {
+                fwrite (clause_lines->str, sizeof (char), clause_lines->len, file);
+                g_string_truncate (clause_lines, 0);
+            }
+        }
+        for (GList *li = (lazy_lines != NULL ? cnf->lazy->head : NULL); li != NULL; li = li->next) {
+            g_string_truncate (lazy_lines, 0);
+            base_cnf_append_dimacs_lazy (lazy_lines, li->data);
+            fwrite (lazy_lines->str, sizeof (char), lazy_lines->len, file);
+        }
+        if (xor_lines != NULL) {
+            fwrite (xor_lines->str, sizeof (char), xor_lines->len, file);
+        }
+        if (extra_clauses != NULL) {
+            fwrite (extra_clauses->str, sizeof (char), extra_clauses->len, file);
+        }
 
-    for (GList *cl = cnf->clauses->head; cl != NULL; cl = cl->next) {
-        const long int *clause = (long int *) cl->data;
-        base_cnf_print_dimacs_clause_gz (file, clause);
+        fclose (file);
+    } else {
+        gzFile file = gzopen (file_name, "w");
+        if (file == NULL) {
+            printf ("ERROR: could not open file %s\n", file_name);
+            if (xor_lines != NULL) g_string_free (xor_lines, true);
+            if (lazy_lines != NULL) g_string_free (lazy_lines, true);
+            if (clause_lines != NULL) g_string_free (clause_lines, true);
+            return false;
+        }
+
+        base_cnf_print_dimacs_header_gz (file, max_var, num_clauses);
+        if (cached && (cnf->dimacs_cache->len > 0)) {
+            gzwrite (file, cnf->dimacs_cache->str, cnf->dimacs_cache->len);
+        }
+        for (GList *li = (clause_lines != NULL ? cnf->clauses->head : NULL); li != NULL; li = li->next) {
+            base_cnf_append_dimacs_clause (clause_lines, li->data);
+            if ((clause_lines->len >= BASE_CNF_DIMACS_CHUNK_SIZE) || (li->next == NULL)) {
+                gzwrite (file, clause_lines->str, clause_lines->len);
+                g_string_truncate (clause_lines, 0);
+            }
+        }
+        for (GList *li = (lazy_lines != NULL ? cnf->lazy->head : NULL); li != NULL; li = li->next) {
+            g_string_truncate (lazy_lines, 0);
+            base_cnf_append_dimacs_lazy (lazy_lines, li->data);
+            if (lazy_lines->len > 0) gzwrite (file, lazy_lines->str, lazy_lines->len);
+        }
+        if (xor_lines != NULL) {
+            gzwrite (file, xor_lines->str, xor_lines->len);
+        }
+        if ((extra_clauses != NULL) && (extra_clauses->len > 0)) {
+            gzwrite (file, extra_clauses->str, extra_clauses->len);
+        }
+
+        gzclose (file);
     }
+
+    if (xor_lines != NULL) g_string_free (xor_lines, true);
+    if (lazy_lines != NULL) g_string_free (lazy_lines, true);
+    if (clause_lines != NULL) g_string_free (clause_lines, true);
+
+    return true;
 }
 
 /* runs sat solver with binary path given by solver_binary, and cnf file given by filename_cnf
  * solution is written to file given by filename_sol; if solution_on_stdout is true, solver is assumed
  * to print solution onto stdout, otherwise into the file given as second argument.
+ * if verbose is false, output of the solver is not printed.
+ * the solver is stopped after timeout seconds (0: no limit) or as soon as *stop is set (NULL: no stop flag),
+ * which is treated as error. *timed_out is set to true if the solver has been stopped by the timeout.
  * returns true on success, false otherwise */
-static bool base_cnf_run_solver (const char *solver_binary, const char *filename_cnf, const char *filename_sol, bool solution_on_stdout)
+static bool base_cnf_run_solver (const char *solver_binary, const char *filename_cnf, const char *filename_sol, bool solution_on_stdout,
+                                 double timeout, const gint *stop, bool verbose, bool *timed_out)
 {
+    *timed_out = false;
+
     if (solver_binary == NULL) return false;
     if (filename_cnf == NULL) return false;
     if (filename_sol == NULL) return false;
@@ -285,6 +1084,8 @@ static bool base_cnf_run_solver (const char *solver_binary, const char *filename
         if (sol_file != NULL) fclose (sol_file);
         return false;
     }
+    pty_run_set_timeout (solver_run_data, timeout);
+    pty_run_set_stop_flag (solver_run_data, stop);
 
     bool read_on    = true;
     bool write_line = false;
@@ -309,14 +1110,14 @@ static bool base_cnf_run_solver (const char *solver_binary, const char *filename
                     }
                 }
 
-                if (print_line) {
+                if (print_line && verbose) {
                     printf ("SOLVER: %s\n", in_buff);
                 }
                 if (write_line) {
                     fprintf (sol_file, "%s\n", &in_buff[2]);
                 }
 
-            } else {
+            } else if (verbose) {
                 printf ("SOLVER: %s\n", in_buff);
             }
         } else {
@@ -324,19 +1125,24 @@ static bool base_cnf_run_solver (const char *solver_binary, const char *filename
         }
     }
 
+    if (pty_run_timed_out (solver_run_data)) {
+        if (verbose) printf ("ERROR: solver stopped after time limit of %g s\n", timeout);
+        *timed_out = true;
+        result     = false;
+    }
+    if (pty_run_stopped (solver_run_data)) result = false;
+
     pty_run_finish (&solver_run_data);
 
     if (sol_file != NULL) fclose (sol_file);
     return result;
 }
 
-/* read a solution from file into *cnf */
-static void base_cnf_read_sol (struct base_cnf *cnf, FILE *file)
+/* read a solution from file and return it as GSList of literals (long int) or NULL if not satisfiable.
+ * if verbose is false, no info is printed. */
+static GSList * base_cnf_read_sol (FILE *file, bool verbose)
 {
-    if (cnf == NULL) return;
-    if (file == NULL) return;
-
-    base_cnf_clear_solution (cnf);
+    if (file == NULL) return NULL;
 
     /* satisfiable? */
     char *sat_line;
@@ -355,8 +1161,8 @@ static void base_cnf_read_sol (struct base_cnf *cnf, FILE *file)
     }
 
     if (!satisfiable) {
-        printf ("INFO: not satisfiable\n");
-        return;
+        if (verbose) printf ("INFO: not satisfiable\n");
+        return NULL;
     }
 
     /* solution */
@@ -371,58 +1177,39 @@ static void base_cnf_read_sol (struct base_cnf *cnf, FILE *file)
         lit_list = g_slist_prepend (lit_list, GSIZE_TO_POINTER (literal));
     }
 
-    lit_list = g_slist_reverse (lit_list);
-    cnf->solution = lit_list;
+    return g_slist_reverse (lit_list);
 }
 
-/* solves cnf, returns true on successful run, false if an error occurred.
- * temporary files ar prefixed with tmp_file_name, solver binary solver_bin is used,
- * solution_on_stdout: if true it is assumed that solver prints solution on stdout,
- * cleanup: if true remove temporary files when finished,
- * cnf_gz: if true use gzipped dimacs for cnf file */
-bool base_cnf_solve (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz)
+/* writes *cnf with extra_clauses (see base_cnf_write_dimacs, write_clauses), runs the solver and reads the solution.
+ * returns true on successful run, false if an error occurred or the solver has been stopped by *stop (NULL: no stop flag,
+ * see base_cnf_run_solver). *solution is set to the solution as GSList of literals (long int) or NULL if not satisfiable.
+ * other arguments as for base_cnf_solve_assuming. */
+static bool base_cnf_run (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                          bool write_clauses, GString *extra_clauses, unsigned long int n_extra_clauses, unsigned long int extra_max_var,
+                          const gint *stop, bool verbose, GSList **solution)
 {
     if (cnf == NULL) return false;
     if (tmp_file_name == NULL) return false;
+    if (solution == NULL) return false;
+
+    *solution = NULL;
 
     size_t file_name_len = strlen (tmp_file_name) + 8;
 
     /* writing cnf */
     char *cnf_file_name = g_slice_alloc (sizeof (char) * file_name_len);
 
-    FILE  *cnf_file    = NULL;
-    gzFile cnf_file_gz = NULL;
-
     if (!cnf_gz) {
         snprintf (cnf_file_name, file_name_len, "%s.cnf", tmp_file_name);
-
-        cnf_file = fopen (cnf_file_name, "w");
-        if (cnf_file == NULL) {
-            printf ("ERROR: could not open file %s\n", cnf_file_name);
-            g_slice_free1 (sizeof (char) * file_name_len, cnf_file_name);
-            return false;
-        }
     } else {
         snprintf (cnf_file_name, file_name_len, "%s.cnf.gz", tmp_file_name);
-
-        cnf_file_gz = gzopen (cnf_file_name, "w");
-        if (cnf_file_gz == NULL) {
-            printf ("ERROR: could not open file %s\n", cnf_file_name);
-            g_slice_free1 (sizeof (char) * file_name_len, cnf_file_name);
-            return false;
-        }
     }
 
-    printf ("INFO: writing cnf file...\n");
+    if (verbose) printf ("INFO: writing cnf file...\n");
 
-    if (!cnf_gz) {
-        base_cnf_print_dimacs (cnf, cnf_file);
-
-        fclose (cnf_file);
-    } else {
-        base_cnf_print_dimacs_gz (cnf, cnf_file_gz);
-
-        gzclose (cnf_file_gz);
+    if (!base_cnf_write_dimacs (cnf, cnf_file_name, cnf_gz, write_clauses, extra_clauses, n_extra_clauses, extra_max_var)) {
+        g_slice_free1 (sizeof (char) * file_name_len, cnf_file_name);
+        return false;
     }
 
     /* solve */
@@ -434,11 +1221,26 @@ bool base_cnf_solve (struct base_cnf *cnf, const char *tmp_file_name, const char
         solver_bin         = "minisat";
         solution_on_stdout = false;
     }
-    printf ("INFO: running solver (%s)...\n", solver_bin);
-    bool success = base_cnf_run_solver (solver_bin, cnf_file_name, sol_file_name, solution_on_stdout);
+    double timeout = cnf->solver_timeout;
+    bool timed_out = false;
+    bool success   = false;
+
+    if (cnf->solver_deadline > 0) {
+        double remaining = (double) (cnf->solver_deadline - g_get_monotonic_time ()) / G_USEC_PER_SEC;
+        if ((timeout == 0) || (remaining < timeout)) timeout = remaining;
+        timed_out = (timeout <= 0);
+    }
+
+    if (!timed_out) {
+        if (verbose) printf ("INFO: running solver (%s)...\n", solver_bin);
+        success = base_cnf_run_solver (solver_bin, cnf_file_name, sol_file_name, solution_on_stdout, timeout, stop, verbose,
+                                       &timed_out);
+    }
+    if (timed_out) g_atomic_int_set (&(cnf->solver_timed_out), 1);
 
     if (!success) {
         if (cleanup) remove (cnf_file_name);
+        if (cleanup) remove (sol_file_name);
         g_slice_free1 (sizeof (char) * file_name_len, cnf_file_name);
         g_slice_free1 (sizeof (char) * file_name_len, sol_file_name);
         return false;
@@ -454,8 +1256,8 @@ bool base_cnf_solve (struct base_cnf *cnf, const char *tmp_file_name, const char
         return false;
     }
 
-    printf ("INFO: reading solution...\n");
-    base_cnf_read_sol (cnf, sol_file);
+    if (verbose) printf ("INFO: reading solution...\n");
+    *solution = base_cnf_read_sol (sol_file, verbose);
 
     fclose (sol_file);
 
@@ -468,36 +1270,1883 @@ bool base_cnf_solve (struct base_cnf *cnf, const char *tmp_file_name, const char
     return true;
 }
 
-/* make current solution of cnf invalid to optain another one on next solving */
-void base_cnf_cancel_solution (struct base_cnf *cnf)
+/* solves a preprocessed working copy of cnf with assumptions as unit clauses and extends the
+ * solution to all variables, arguments as for base_cnf_solve_assuming. */
+static bool base_cnf_solve_preprocessed (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                         const long int *assumptions, const gint *stop, bool verbose, GSList **solution)
 {
-    if (cnf == NULL) return;
+    if (solution == NULL) return false;
+    *solution = NULL;
 
-    GSList *cancel_clause = NULL;
+    if (verbose) printf ("INFO: preprocessing...\n");
+    if (verbose && cnf->symmetry_breaking) printf ("INFO: symmetry breaking skipped with preprocessing\n");
+    if (verbose && cnf->renumber) printf ("INFO: renumbering skipped with preprocessing\n");
 
-    for (GSList *li = cnf->solution; li != NULL; li = li->next) {
-        long int lit = -GPOINTER_TO_SIZE (li->data);
+    SatPreprocess pre = sat_preprocess_new (cnf->clauses, assumptions, cnf->max_var);
+    if (pre == NULL) return false;
 
-        cancel_clause = g_slist_prepend (cancel_clause, GSIZE_TO_POINTER (lit));
+    bool satisfiable = sat_preprocess_run (pre, cnf->preprocess_options);
+    if (verbose) sat_preprocess_print_info (pre);
+
+    if (!satisfiable) {
+        sat_preprocess_free (&pre);
+        return true;
     }
 
-    base_cnf_add_clause_gslist (cnf, cancel_clause);
+    GString *clauses = g_string_new (NULL);
+    unsigned long int n_clauses = sat_preprocess_append_dimacs (pre, clauses);
 
-    g_slist_free (cancel_clause);
+    bool result = true;
+    GSList *reduced_solution = NULL;
+
+    if (n_clauses > 0) {
+        result = base_cnf_run (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                               false, clauses, n_clauses, sat_preprocess_max_var (pre), stop, verbose, &reduced_solution);
+        satisfiable = (reduced_solution != NULL);
+    } else if (verbose) {
+        printf ("INFO: no clauses remaining - solver not run\n");
+    }
+
+    if (result && satisfiable) {
+        *solution = sat_preprocess_extend_solution (pre, reduced_solution);
+    }
+
+    g_slist_free (reduced_solution);
+    g_string_free (clauses, true);
+    sat_preprocess_free (&pre);
+
+    return result;
 }
 
-/* return internal clauses of cnf as GQueue of 0-terminated arrays of literals as (long int).
- * returned GQueue should not be modified. */
-GQueue* base_cnf_clauses (struct base_cnf *cnf)
+/* solves cnf, returns true on successful run, false if an error occurred.
+ * temporary files ar prefixed with tmp_file_name, solver binary solver_bin is used,
+ * solution_on_stdout: if true it is assumed that solver prints solution on stdout,
+ * cleanup: if true remove temporary files when finished,
+ * cnf_gz: if true use gzipped dimacs for cnf file,
+ * assumptions: 0-terminated array of literals (long int) only valid for this run or NULL */
+bool base_cnf_solve (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                     const long int *assumptions)
 {
-    if (cnf == NULL) return NULL;
-    return cnf->clauses;
+    if (cnf == NULL) return false;
+
+    base_cnf_clear_solution (cnf);
+
+    if (cnf->units != NULL) {
+        printf ("INFO: unit simplification: %u assigned variables, %lu clauses dropped, %lu literals removed\n",
+                cnf->units->trail->len, cnf->units->n_dropped, cnf->units->n_removed_lits);
+    }
+
+    return base_cnf_solve_assuming (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, true, &(cnf->solution));
 }
 
-/* return solution (if satisfiable) or NULL if not or not yet solved as GSList of literals as (long int).
- * returned GSList should not be modified. */
-GSList * base_cnf_solution (struct base_cnf *cnf)
+/* returns true if unit simplification has derived an empty clause, so no solver run is needed */
+static bool base_cnf_trivially_unsat (struct base_cnf *cnf, bool verbose)
 {
-    if (cnf == NULL) return NULL;
-    return cnf->solution;
+    if ((cnf->units == NULL) || (!cnf->units->unsat)) return false;
+
+    if (verbose) printf ("INFO: empty clause derived by unit simplification - skipping solver run\n");
+    return true;
+}
+
+/* search symmetries of clauses (GQueue of 0-terminated arrays of literals (long int)) with assumptions
+ * and n_vars variables and append lex-leader clauses to extra_clauses with auxiliary variables
+ * after *extra_max_var, *n_extra_clauses and *extra_max_var are updated. */
+static void base_cnf_append_symmetry_breaking (struct base_cnf *cnf, GQueue *clauses, const long int *assumptions, unsigned long int n_vars, bool verbose,
+                                               GString *extra_clauses, unsigned long int *n_extra_clauses, unsigned long int *extra_max_var)
+{
+    if (verbose) printf ("INFO: searching symmetries...\n");
+
+    GPtrArray *generators = sat_symmetry_find (clauses, assumptions, n_vars, cnf->symmetry_max_vertices, cnf->symmetry_max_generators);
+
+    if (generators == NULL) {
+        if (verbose) printf ("INFO: problem too large for symmetry search\n");
+        return;
+    }
+
+    unsigned long int next_var = (*extra_max_var > n_vars ? *extra_max_var : n_vars) + 1;
+    unsigned long int n_breaking = sat_symmetry_append_breaking (generators, n_vars, G_MAXUINT, &next_var, extra_clauses);
+    *n_extra_clauses += n_breaking;
+    *extra_max_var    = next_var - 1;
+
+    if (verbose) {
+        sat_symmetry_print_generators (generators, n_vars);
+        printf ("INFO: %u symmetry generators found - %lu symmetry-breaking clauses\n", generators->len, n_breaking);
+    }
+    g_ptr_array_free (generators, true);
+}
+
+/* remove literals of variables greater than n_vars from *solution (GSList of literals (long int)) */
+static void base_cnf_solution_trim (GSList **solution, unsigned long int n_vars)
+{
+    GSList *trimmed = NULL;
+    for (GSList *li = *solution; li != NULL; li = li->next) {
+        long int lit = GPOINTER_TO_SIZE (li->data);
+        if ((unsigned long int) (lit > 0 ? lit : -lit) <= n_vars) trimmed = g_slist_prepend (trimmed, li->data);
+    }
+    g_slist_free (*solution);
+    *solution = g_slist_reverse (trimmed);
+}
+
+/* compare literals (long int) by variable */
+static int base_cnf_lit_var_compare (const void *a, const void *b)
+{
+    long int var_a = *((const long int *) a);
+    long int var_b = *((const long int *) b);
+    if (var_a < 0) var_a = -var_a;
+    if (var_b < 0) var_b = -var_b;
+
+    return (var_a < var_b ? -1 : (var_a > var_b ? 1 : 0));
+}
+
+/* compare clauses (0-terminated arrays of literals (long int) sorted by variable) by first and last variable */
+static gint base_cnf_clause_position_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const long int *clause_a = a;
+    const long int *clause_b = b;
+
+    int cmp = base_cnf_lit_var_compare (&(clause_a[0]), &(clause_b[0]));
+    if (cmp != 0) return cmp;
+
+    unsigned int len_a = 0;
+    unsigned int len_b = 0;
+    while (clause_a[len_a] != 0) len_a++;
+    while (clause_b[len_b] != 0) len_b++;
+    if ((len_a == 0) || (len_b == 0)) return (len_a < len_b ? -1 : (len_a > len_b ? 1 : 0));
+
+    return base_cnf_lit_var_compare (&(clause_a[len_a - 1]), &(clause_b[len_b - 1]));
+}
+
+/* compare variables (long int) by number of occurrences given in user_data (guint *) */
+static gint base_cnf_var_degree_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const guint *degree = user_data;
+    long int var_a = *((const long int *) a);
+    long int var_b = *((const long int *) b);
+
+    if (degree[var_a] != degree[var_b]) return (degree[var_a] < degree[var_b] ? -1 : 1);
+    return (var_a < var_b ? -1 : (var_a > var_b ? 1 : 0));
+}
+
+/* compute a Cuthill-McKee order of variables used in clauses or assumptions: breadth-first search over
+ * variables connected by clauses starting with a variable of least occurrences in each component,
+ * new neighbors are numbered by increasing number of occurrences.
+ * old_to_new: array of n_vars + 1 new variables (long int), 0 for unused variables,
+ * new_to_old: GArray of old variables (long int) for new variables, index 0 is unused.
+ * returns the greatest difference of variables in a clause before renumbering. */
+static unsigned long int base_cnf_renumber_order (GQueue *clauses, const long int *assumptions, unsigned long int n_vars,
+                                                  long int *old_to_new, GArray *new_to_old)
+{
+    /* occurrence lists of variables in compressed form */
+    guint n_clauses = g_queue_get_length (clauses);
+    const long int **clause_array = g_new (const long int *, n_clauses);
+    guint *degree = g_new0 (guint, n_vars + 1);
+    unsigned long int bandwidth = 0;
+
+    guint ci = 0;
+    for (GList *cl = clauses->head; cl != NULL; cl = cl->next, ci++) {
+        const long int *clause = cl->data;
+        clause_array[ci] = clause;
+
+        long int min_var = 0;
+        long int max_var = 0;
+        for (unsigned int i = 0; clause[i] != 0; i++) {
+            long int var = (clause[i] > 0 ? clause[i] : -clause[i]);
+            degree[var]++;
+            if ((min_var == 0) || (var < min_var)) min_var = var;
+            if (var > max_var) max_var = var;
+        }
+        if ((unsigned long int) (max_var - min_var) > bandwidth) bandwidth = max_var - min_var;
+    }
+
+    guint *occ_offset = g_new (guint, n_vars + 2);
+    occ_offset[0] = 0;
+    for (unsigned long int var = 0; var <= n_vars; var++) occ_offset[var + 1] = occ_offset[var] + degree[var];
+
+    guint *occ_fill = g_new (guint, n_vars + 1);
+    memcpy (occ_fill, occ_offset, sizeof (guint) * (n_vars + 1));
+    guint *occ = g_new (guint, occ_offset[n_vars + 1] + 1);
+
+    for (ci = 0; ci < n_clauses; ci++) {
+        for (const long int *lit = clause_array[ci]; *lit != 0; lit++) {
+            occ[occ_fill[*lit > 0 ? *lit : -*lit]++] = ci;
+        }
+    }
+    g_free (occ_fill);
+
+    /* assumed variables without clauses are numbered as well */
+    bool *used = g_new0 (bool, n_vars + 1);
+    for (unsigned long int var = 1; var <= n_vars; var++) used[var] = (degree[var] > 0);
+    for (unsigned int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+        used[assumptions[i] > 0 ? assumptions[i] : -assumptions[i]] = true;
+    }
+
+    /* start candidates by increasing number of occurrences */
+    GArray *starts = g_array_new (false, false, sizeof (long int));
+    for (unsigned long int var = 1; var <= n_vars; var++) {
+        if (!used[var]) continue;
+        long int l_var = var;
+        g_array_append_val (starts, l_var);
+    }
+    g_array_sort_with_data (starts, base_cnf_var_degree_compare, degree);
+
+    bool *expanded = g_new0 (bool, n_clauses + 1);
+    GArray *neighbors = g_array_new (false, false, sizeof (long int));
+
+    long int zero = 0;
+    g_array_set_size (new_to_old, 0);
+    g_array_append_val (new_to_old, zero);
+
+    guint head = 1;
+    for (guint si = 0; si < starts->len; si++) {
+        long int start = g_array_index (starts, long int, si);
+        if (old_to_new[start] != 0) continue;
+
+        old_to_new[start] = new_to_old->len;
+        g_array_append_val (new_to_old, start);
+
+        while (head < new_to_old->len) {
+            long int var = g_array_index (new_to_old, long int, head);
+            head++;
+
+            g_array_set_size (neighbors, 0);
+            for (guint i = occ_offset[var]; i < occ_offset[var + 1]; i++) {
+                if (expanded[occ[i]]) continue;
+                expanded[occ[i]] = true;
+
+                for (const long int *lit = clause_array[occ[i]]; *lit != 0; lit++) {
+                    long int n_var = (*lit > 0 ? *lit : -*lit);
+                    if (old_to_new[n_var] != 0) continue;
+                    /* mark as numbered to avoid duplicates, final number is set below */
+                    old_to_new[n_var] = -1;
+                    g_array_append_val (neighbors, n_var);
+                }
+            }
+            g_array_sort_with_data (neighbors, base_cnf_var_degree_compare, degree);
+
+            for (guint i = 0; i < neighbors->len; i++) {
+                long int n_var = g_array_index (neighbors, long int, i);
+                old_to_new[n_var] = new_to_old->len;
+                g_array_append_val (new_to_old, n_var);
+            }
+        }
+    }
+
+    g_array_free (neighbors, true);
+    g_free (expanded);
+    g_array_free (starts, true);
+    g_free (used);
+    g_free (occ);
+    g_free (occ_offset);
+    g_free (degree);
+    g_free (clause_array);
+
+    return bandwidth;
+}
+
+/* solves cnf with assumptions after renumbering variables by base_cnf_renumber_order and sorting
+ * clauses by their variables, the solution is mapped back and unused variables are assigned false.
+ * arguments as for base_cnf_solve_assuming. */
+static bool base_cnf_solve_renumbered (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                       const long int *assumptions, const gint *stop, bool verbose, GSList **solution)
+{
+    *solution = NULL;
+
+    unsigned long int n_vars = cnf->max_var;
+    unsigned int n_assumptions = 0;
+    for (; (assumptions != NULL) && (assumptions[n_assumptions] != 0); n_assumptions++) {
+        unsigned long int var = (assumptions[n_assumptions] > 0 ? assumptions[n_assumptions] : -assumptions[n_assumptions]);
+        if (var > n_vars) n_vars = var;
+    }
+
+    long int *old_to_new = g_new0 (long int, n_vars + 1);
+    GArray *new_to_old   = g_array_new (false, false, sizeof (long int));
+
+    unsigned long int old_bandwidth = base_cnf_renumber_order (cnf->clauses, assumptions, n_vars, old_to_new, new_to_old);
+    unsigned long int n_new_vars    = new_to_old->len - 1;
+
+    /* renumbered clauses with literals sorted by variable */
+    GQueue *clauses = g_queue_new ();
+    unsigned long int new_bandwidth = 0;
+
+    for (GList *cl = cnf->clauses->head; cl != NULL; cl = cl->next) {
+        const long int *clause = cl->data;
+        unsigned int len = 0;
+        while (clause[len] != 0) len++;
+
+        long int *new_clause = g_new (long int, len + 1);
+        for (unsigned int i = 0; i < len; i++) {
+            new_clause[i] = (clause[i] > 0 ? old_to_new[clause[i]] : -old_to_new[-clause[i]]);
+        }
+        new_clause[len] = 0;
+        qsort (new_clause, len, sizeof (long int), base_cnf_lit_var_compare);
+
+        if (len > 0) {
+            unsigned long int width = labs (new_clause[len - 1]) - labs (new_clause[0]);
+            if (width > new_bandwidth) new_bandwidth = width;
+        }
+
+        g_queue_push_tail (clauses, new_clause);
+    }
+    g_queue_sort (clauses, base_cnf_clause_position_compare, NULL);
+
+    long int *new_assumptions = g_new (long int, n_assumptions + 1);
+    for (unsigned int i = 0; i < n_assumptions; i++) {
+        new_assumptions[i] = (assumptions[i] > 0 ? old_to_new[assumptions[i]] : -old_to_new[-assumptions[i]]);
+    }
+    new_assumptions[n_assumptions] = 0;
+
+    if (verbose) {
+        printf ("INFO: renumbered %lu of %lu variables - greatest variable distance in a clause %lu (before: %lu)\n",
+                n_new_vars, n_vars, new_bandwidth, old_bandwidth);
+    }
+
+    GString *dimacs = g_string_new (NULL);
+    unsigned long int n_clauses = 0;
+    unsigned long int max_var   = n_new_vars;
+
+    for (GList *cl = clauses->head; cl != NULL; cl = cl->next) {
+        for (const long int *lit = cl->data; *lit != 0; lit++) g_string_append_printf (dimacs, "%ld ", *lit);
+        g_string_append (dimacs, "0\n");
+        n_clauses++;
+    }
+    for (unsigned int i = 0; i < n_assumptions; i++) {
+        g_string_append_printf (dimacs, "%ld 0\n", new_assumptions[i]);
+        n_clauses++;
+    }
+
+    if (cnf->symmetry_breaking) {
+        base_cnf_append_symmetry_breaking (cnf, clauses, new_assumptions, n_new_vars, verbose, dimacs, &n_clauses, &max_var);
+    }
+
+    GSList *new_solution = NULL;
+    bool result = base_cnf_run (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                false, dimacs, n_clauses, max_var, stop, verbose, &new_solution);
+
+    if (result && (new_solution != NULL)) {
+        signed char *value = g_new0 (signed char, n_vars + 1);
+
+        for (GSList *li = new_solution; li != NULL; li = li->next) {
+            long int lit = GPOINTER_TO_SIZE (li->data);
+            unsigned long int var = (lit > 0 ? lit : -lit);
+            if ((var == 0) || (var > n_new_vars)) continue;
+
+            value[g_array_index (new_to_old, long int, var)] = (lit > 0 ? 1 : -1);
+        }
+
+        for (unsigned long int var = n_vars; var > 0; var--) {
+            long int lit = (value[var] > 0 ? (long int) var : -((long int) var));
+            *solution = g_slist_prepend (*solution, GSIZE_TO_POINTER (lit));
+        }
+        g_free (value);
+    }
+
+    g_slist_free (new_solution);
+    g_string_free (dimacs, true);
+    g_free (new_assumptions);
+    g_queue_free_full (clauses, g_free);
+    g_array_free (new_to_old, true);
+    g_free (old_to_new);
+
+    return result;
+}
+
+/* solves all clauses of cnf with assumptions as unit clauses by one solver run,
+ * arguments as for base_cnf_solve_assuming. */
+static bool base_cnf_solve_whole (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                  const long int *assumptions, const gint *stop, bool verbose, GSList **solution)
+{
+    if (cnf->renumber) {
+        return base_cnf_solve_renumbered (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, stop, verbose, solution);
+    }
+
+    GString *extra_clauses = g_string_new (NULL);
+    unsigned long int n_extra_clauses = 0;
+    unsigned long int extra_max_var   = 0;
+
+    for (int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+        long int i_lit = assumptions[i];
+        g_string_append_printf (extra_clauses, "%ld 0\n", i_lit);
+        n_extra_clauses++;
+
+        if (i_lit < 0) i_lit = -i_lit;
+        if (i_lit > extra_max_var) extra_max_var = i_lit;
+    }
+
+    unsigned long int n_vars = (extra_max_var > cnf->max_var ? extra_max_var : cnf->max_var);
+
+    if (cnf->symmetry_breaking) {
+        base_cnf_append_symmetry_breaking (cnf, cnf->clauses, assumptions, n_vars, verbose, extra_clauses, &n_extra_clauses, &extra_max_var);
+    }
+
+    bool result = base_cnf_run (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                true, extra_clauses, n_extra_clauses, extra_max_var, stop, verbose, solution);
+
+    g_string_free (extra_clauses, true);
+
+    /* remove auxiliary variables of symmetry breaking */
+    if (extra_max_var > n_vars) base_cnf_solution_trim (solution, n_vars);
+
+    return result;
+}
+
+/* return representative of variable var in union-find forest parent */
+static unsigned long int base_cnf_component_find (unsigned long int *parent, unsigned long int var)
+{
+    while (parent[var] != var) {
+        parent[var] = parent[parent[var]];
+        var = parent[var];
+    }
+    return var;
+}
+
+/* thread pool function for solving a component job (struct base_cnf_component_job *) */
+static void base_cnf_component_solve_func (gpointer data, gpointer user_data)
+{
+    struct base_cnf_component_job *job = data;
+    struct base_cnf_component_run *run = user_data;
+
+    if (g_atomic_int_get (&(run->error)) || g_atomic_int_get (&(run->unsat))) return;
+
+    char *tmp_file_name = g_strdup_printf ("%s_comp_%u", run->tmp_file_name, job->index);
+
+    bool success = base_cnf_run (run->cnf, tmp_file_name, run->solver_bin, run->solution_on_stdout, run->cleanup, run->cnf_gz,
+                                 false, job->clauses, job->n_clauses, job->vars->len, &(run->stop), false, &(job->solution));
+    g_free (tmp_file_name);
+
+    if (!success) {
+        /* stopped runs are no errors */
+        if (!g_atomic_int_get (&(run->stop))) g_atomic_int_set (&(run->error), 1);
+    } else if (job->solution == NULL) {
+        g_atomic_int_set (&(run->unsat), 1);
+    }
+    if (!success || (job->solution == NULL)) g_atomic_int_set (&(run->stop), 1);
+}
+
+/* sort component jobs by decreasing number of clauses */
+static gint base_cnf_component_job_compare (gconstpointer a, gconstpointer b)
+{
+    const struct base_cnf_component_job *job_a = *((struct base_cnf_component_job * const *) a);
+    const struct base_cnf_component_job *job_b = *((struct base_cnf_component_job * const *) b);
+
+    if (job_a->n_clauses > job_b->n_clauses) return -1;
+    if (job_a->n_clauses < job_b->n_clauses) return 1;
+    return 0;
+}
+
+/* solves variable-disjoint components of cnf with assumptions by concurrent solver runs and merges
+ * their solutions, arguments as for base_cnf_solve_assuming. variables without clauses are assigned false.
+ * if there is only one job, the whole cnf is solved by one run. a failed run or an unsatisfiable component
+ * skips the remaining jobs and stops the solvers still running. */
+static bool base_cnf_solve_components (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                       const long int *assumptions, bool verbose, GSList **solution)
+{
+    *solution = NULL;
+
+    unsigned long int n_vars = cnf->max_var;
+    for (int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+        unsigned long int var = (assumptions[i] > 0 ? assumptions[i] : -assumptions[i]);
+        if (var > n_vars) n_vars = var;
+    }
+
+    /* union-find over variables of each clause */
+    unsigned long int *parent = g_new (unsigned long int, n_vars + 1);
+    for (unsigned long int var = 0; var <= n_vars; var++) parent[var] = var;
+
+    for (GList *cl = cnf->clauses->head; cl != NULL; cl = cl->next) {
+        const long int *clause = cl->data;
+
+        if (clause[0] == 0) {
+            if (verbose) printf ("INFO: empty clause - skipping solver run\n");
+            g_free (parent);
+            return true;
+        }
+
+        unsigned long int root = base_cnf_component_find (parent, (clause[0] > 0 ? clause[0] : -clause[0]));
+        for (unsigned int i = 1; clause[i] != 0; i++) {
+            unsigned long int i_root = base_cnf_component_find (parent, (clause[i] > 0 ? clause[i] : -clause[i]));
+            if (i_root != root) parent[i_root] = root;
+        }
+    }
+
+    /* number of variables of each component by its representative */
+    unsigned long int *comp_size = g_new0 (unsigned long int, n_vars + 1);
+    bool *used = g_new0 (bool, n_vars + 1);
+
+    for (GList *cl = cnf->clauses->head; cl != NULL; cl = cl->next) {
+        for (const long int *lit = cl->data; *lit != 0; lit++) used[*lit > 0 ? *lit : -*lit] = true;
+    }
+    for (int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+        used[assumptions[i] > 0 ? assumptions[i] : -assumptions[i]] = true;
+    }
+
+    unsigned long int n_components = 0;
+    for (unsigned long int var = 1; var <= n_vars; var++) {
+        if (!used[var]) continue;
+        unsigned long int root = base_cnf_component_find (parent, var);
+        if (comp_size[root] == 0) n_components++;
+        comp_size[root]++;
+    }
+
+    /* assign components to jobs, small components share one job */
+    GPtrArray *jobs = g_ptr_array_new ();
+    struct base_cnf_component_job **job_of = g_new0 (struct base_cnf_component_job *, n_vars + 1);
+    struct base_cnf_component_job *small_job = NULL;
+    long int *local = g_new0 (long int, n_vars + 1);
+
+    for (unsigned long int var = 1; var <= n_vars; var++) {
+        if (!used[var]) continue;
+        unsigned long int root = base_cnf_component_find (parent, var);
+
+        if (job_of[root] == NULL) {
+            if ((comp_size[root] < cnf->split_min_vars) && (small_job != NULL)) {
+                job_of[root] = small_job;
+            } else {
+                struct base_cnf_component_job *job = g_slice_new (struct base_cnf_component_job);
+                job->clauses   = g_string_new (NULL);
+                job->n_clauses = 0;
+                job->vars      = g_array_new (false, false, sizeof (long int));
+                job->solution  = NULL;
+                job->index     = jobs->len;
+                g_ptr_array_add (jobs, job);
+
+                if (comp_size[root] < cnf->split_min_vars) small_job = job;
+                job_of[root] = job;
+            }
+        }
+
+        struct base_cnf_component_job *job = job_of[root];
+        long int l_var = var;
+        g_array_append_val (job->vars, l_var);
+        local[var] = job->vars->len;
+    }
+
+    bool result = true;
+
+    if (jobs->len <= 1) {
+        result = base_cnf_solve_whole (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, NULL, verbose, solution);
+    } else {
+        /* distribute renumbered clauses */
+        for (GList *cl = cnf->clauses->head; cl != NULL; cl = cl->next) {
+            const long int *clause = cl->data;
+            struct base_cnf_component_job *job = job_of[base_cnf_component_find (parent, (clause[0] > 0 ? clause[0] : -clause[0]))];
+
+            for (unsigned int i = 0; clause[i] != 0; i++) {
+                long int l_lit = local[clause[i] > 0 ? clause[i] : -clause[i]];
+                g_string_append_printf (job->clauses, "%ld ", (clause[i] > 0 ? l_lit : -l_lit));
+            }
+            g_string_append (job->clauses, "0\n");
+            job->n_clauses++;
+        }
+        for (int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+            unsigned long int var = (assumptions[i] > 0 ? assumptions[i] : -assumptions[i]);
+            struct base_cnf_component_job *job = job_of[base_cnf_component_find (parent, var)];
+
+            g_string_append_printf (job->clauses, "%ld 0\n", (assumptions[i] > 0 ? local[var] : -local[var]));
+            job->n_clauses++;
+        }
+
+        g_ptr_array_sort (jobs, base_cnf_component_job_compare);
+
+        unsigned int n_threads = cnf->split_threads;
+        if (n_threads == 0) n_threads = g_get_num_processors ();
+        if (verbose) printf ("INFO: solving %lu components by %u solver runs (%u threads)...\n", n_components, jobs->len, n_threads);
+
+        struct base_cnf_component_run run;
+        run.cnf                = cnf;
+        run.tmp_file_name      = tmp_file_name;
+        run.solver_bin         = solver_bin;
+        run.solution_on_stdout = solution_on_stdout;
+        run.cleanup            = cleanup;
+        run.cnf_gz             = cnf_gz;
+        run.error              = 0;
+        run.unsat              = 0;
+        run.stop               = 0;
+
+        GThreadPool *pool = g_thread_pool_new (base_cnf_component_solve_func, &run, n_threads, false, NULL);
+        for (guint i = 0; i < jobs->len; i++) {
+            g_thread_pool_push (pool, g_ptr_array_index (jobs, i), NULL);
+        }
+        g_thread_pool_free (pool, false, true);
+
+        if (run.error) {
+            result = false;
+        } else if (run.unsat) {
+            if (verbose) printf ("INFO: component not satisfiable\n");
+        } else {
+            /* merge solutions of components */
+            signed char *value = g_new0 (signed char, n_vars + 1);
+
+            for (guint i = 0; i < jobs->len; i++) {
+                struct base_cnf_component_job *job = g_ptr_array_index (jobs, i);
+
+                for (GSList *li = job->solution; li != NULL; li = li->next) {
+                    long int l_lit = GPOINTER_TO_SIZE (li->data);
+                    unsigned long int l_var = (l_lit > 0 ? l_lit : -l_lit);
+                    if ((l_var == 0) || (l_var > job->vars->len)) continue;
+
+                    value[g_array_index (job->vars, long int, l_var - 1)] = (l_lit > 0 ? 1 : -1);
+                }
+            }
+
+            for (unsigned long int var = n_vars; var > 0; var--) {
+                long int lit = (value[var] > 0 ? (long int) var : -((long int) var));
+                *solution = g_slist_prepend (*solution, GSIZE_TO_POINTER (lit));
+            }
+
+            g_free (value);
+            if (verbose) printf ("INFO: merged solutions of %u solver runs\n", jobs->len);
+        }
+    }
+
+    for (guint i = 0; i < jobs->len; i++) {
+        struct base_cnf_component_job *job = g_ptr_array_index (jobs, i);
+        g_string_free (job->clauses, true);
+        g_array_free (job->vars, true);
+        g_slist_free (job->solution);
+        g_slice_free (struct base_cnf_component_job, job);
+    }
+    g_ptr_array_free (jobs, true);
+
+    g_free (local);
+    g_free (job_of);
+    g_free (used);
+    g_free (comp_size);
+    g_free (parent);
+
+    return result;
+}
+
+/* returns a temporary copy of cnf sharing its clauses, in which the XOR constraints are encoded for solving
+ * under assumptions: units and equivalences implied by Gauss-Jordan elimination are added as clauses and
+ * the XOR constraints are added as clauses with auxiliary variables or kept as native constraints for the
+ * solver. In the latter case preprocessing, component splitting, renumbering and symmetry breaking are
+ * disabled as they only see the clauses. *n_vars is set to the number of variables without auxiliary
+ * variables. returns NULL if the XOR constraints are inconsistent. */
+static struct base_cnf * base_cnf_xor_view_new (struct base_cnf *cnf, const long int *assumptions, bool verbose, unsigned long int *n_vars)
+{
+    *n_vars = cnf->max_var;
+    for (int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+        unsigned long int var = (assumptions[i] > 0 ? assumptions[i] : -assumptions[i]);
+        if (var > *n_vars) *n_vars = var;
+    }
+
+    /* values of unit clauses and assumptions */
+    signed char *value = g_new0 (signed char, *n_vars + 1);
+    for (GList *cl = cnf->clauses->head; cl != NULL; cl = cl->next) {
+        const long int *clause = cl->data;
+        if ((clause[0] == 0) || (clause[1] != 0)) continue;
+        value[clause[0] > 0 ? clause[0] : -clause[0]] = (clause[0] > 0 ? 1 : -1);
+    }
+    for (int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+        value[assumptions[i] > 0 ? assumptions[i] : -assumptions[i]] = (assumptions[i] > 0 ? 1 : -1);
+    }
+
+    GArray *units        = g_array_new (false, false, sizeof (long int));
+    GArray *equivalences = g_array_new (false, false, sizeof (long int));
+
+    bool consistent = true;
+    if (cnf->xor_gauss_max_bits > 0) {
+        consistent = sat_xor_gauss (cnf->xors, value, *n_vars, cnf->xor_gauss_max_bits, units, equivalences);
+    }
+    g_free (value);
+
+    if (!consistent) {
+        if (verbose) printf ("INFO: XOR constraints are inconsistent - skipping solver run\n");
+        g_array_free (units, true);
+        g_array_free (equivalences, true);
+        return NULL;
+    }
+
+    struct base_cnf *view = g_slice_new (struct base_cnf);
+    *view = *cnf;
+
+    view->clauses  = g_queue_copy (cnf->clauses);
+    view->solution = NULL;
+    view->units    = NULL;
+    view->xor_view = true;
+
+    view->dimacs_cache      = g_string_new (NULL);
+    view->dimacs_cache_last = NULL;
+    view->dimacs_cache_n_clauses = 0;
+    view->dimacs_n_writes = 0;
+    g_mutex_init (&(view->dimacs_cache_mutex));
+
+    for (guint i = 0; i < units->len; i++) {
+        long int *clause = g_slice_alloc (sizeof (long int) * 2);
+        clause[0] = g_array_index (units, long int, i);
+        clause[1] = 0;
+        g_queue_push_tail (view->clauses, clause);
+    }
+    for (guint i = 0; i + 1 < equivalences->len; i += 2) {
+        long int a = g_array_index (equivalences, long int, i);
+        long int b = g_array_index (equivalences, long int, i + 1);
+
+        for (int sign = 1; sign >= -1; sign -= 2) {
+            long int *clause = g_slice_alloc (sizeof (long int) * 3);
+            clause[0] = sign * a;
+            clause[1] = -sign * b;
+            clause[2] = 0;
+            g_queue_push_tail (view->clauses, clause);
+        }
+    }
+
+    if (cnf->xor_native) {
+        if (verbose) {
+            printf ("INFO: %u native XOR constraints - Gauss-Jordan elimination: %u units, %u equivalences\n",
+                    g_queue_get_length (cnf->xors), units->len, equivalences->len / 2);
+            if ((cnf->preprocess_options != NULL) || cnf->split_components || cnf->renumber || cnf->symmetry_breaking) {
+                printf ("INFO: preprocessing, component splitting, renumbering and symmetry breaking skipped for native XOR constraints\n");
+            }
+        }
+
+        view->preprocess_options = NULL;
+        view->split_components   = false;
+        view->renumber           = false;
+        view->symmetry_breaking  = false;
+    } else {
+        unsigned long int next_var  = *n_vars + 1;
+        unsigned long int n_clauses = 0;
+
+        for (GList *li = cnf->xors->head; li != NULL; li = li->next) {
+            n_clauses += sat_xor_append_clauses (li->data, cnf->xor_cut, &next_var, view->clauses);
+        }
+
+        view->xors    = g_queue_new ();
+        view->max_var = next_var - 1;
+
+        if (verbose) {
+            printf ("INFO: %u XOR constraints - %lu clauses with %lu auxiliary variables, Gauss-Jordan elimination: %u units, %u equivalences\n",
+                    g_queue_get_length (cnf->xors), n_clauses, next_var - 1 - *n_vars, units->len, equivalences->len / 2);
+        }
+    }
+
+    g_array_free (units, true);
+    g_array_free (equivalences, true);
+
+    return view;
+}
+
+/* returns a temporary copy of cnf sharing its clauses, in which the lazy constraints are expanded into clauses
+ * for consumers that need all clauses (e.g. preprocessing, lookahead, model verification) */
+static struct base_cnf * base_cnf_lazy_view_new (struct base_cnf *cnf, bool verbose)
+{
+    struct base_cnf *view = g_slice_new (struct base_cnf);
+    *view = *cnf;
+
+    view->clauses  = g_queue_copy (cnf->clauses);
+    view->lazy     = g_queue_new ();
+    view->lazy_n_clauses = 0;
+    view->solution = NULL;
+    view->units    = NULL;
+
+    view->dimacs_cache      = g_string_new (NULL);
+    view->dimacs_cache_last = NULL;
+    view->dimacs_cache_n_clauses = 0;
+    view->dimacs_n_writes = 0;
+    g_mutex_init (&(view->dimacs_cache_mutex));
+
+    for (GList *li = cnf->lazy->head; li != NULL; li = li->next) {
+        base_cnf_lazy_expand (li->data, view->clauses);
+    }
+
+    if (verbose) {
+        printf ("INFO: %u lazy cardinality constraints expanded - %lu clauses\n",
+                g_queue_get_length (cnf->lazy), cnf->lazy_n_clauses);
+    }
+
+    return view;
+}
+
+/* returns true if lazy constraints of cnf have to be expanded before solving as the configured
+ * steps work on all clauses instead of only writing them */
+static bool base_cnf_lazy_needs_view (struct base_cnf *cnf)
+{
+    if (g_queue_is_empty (cnf->lazy)) return false;
+
+    return ((!cnf->xor_view && !g_queue_is_empty (cnf->xors)) || (cnf->preprocess_options != NULL) ||
+            cnf->split_components || cnf->renumber || cnf->symmetry_breaking);
+}
+
+/* frees a copy of cnf created by base_cnf_xor_view_new or base_cnf_lazy_view_new */
+static void base_cnf_view_free (struct base_cnf *cnf, struct base_cnf *view)
+{
+    while (g_queue_get_length (view->clauses) > g_queue_get_length (cnf->clauses)) {
+        long int *clause = g_queue_pop_tail (view->clauses);
+        int len = 0;
+        while (clause[len] != 0) len++;
+        g_slice_free1 (sizeof (long int) * (len + 1), clause);
+    }
+    g_queue_free (view->clauses);
+
+    if (view->xors != cnf->xors) g_queue_free (view->xors);
+    if (view->lazy != cnf->lazy) g_queue_free (view->lazy);
+
+    if (g_atomic_int_get (&(view->solver_timed_out))) g_atomic_int_set (&(cnf->solver_timed_out), 1);
+
+    g_string_free (view->dimacs_cache, true);
+    g_mutex_clear (&(view->dimacs_cache_mutex));
+
+    g_slice_free (struct base_cnf, view);
+}
+
+/* solves cnf with XOR constraints encoded by base_cnf_xor_view_new, arguments as for base_cnf_solve_assuming. */
+static bool base_cnf_solve_xors (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                 const long int *assumptions, const gint *stop, bool verbose, GSList **solution)
+{
+    *solution = NULL;
+
+    unsigned long int n_vars;
+    struct base_cnf *view = base_cnf_xor_view_new (cnf, assumptions, verbose, &n_vars);
+    if (view == NULL) return true;
+
+    bool result = base_cnf_solve_stoppable (view, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, stop, verbose, solution);
+
+    /* remove auxiliary variables of XOR constraints */
+    if (view->max_var > n_vars) base_cnf_solution_trim (solution, n_vars);
+
+    base_cnf_view_free (cnf, view);
+
+    return result;
+}
+
+/* solves cnf under assumptions like base_cnf_solve_assuming, solver runs are stopped as soon as *stop is set
+ * (NULL: no stop flag), which is treated as error. components are not split if a stop flag is given, as
+ * its concurrent runs use their own flag. */
+static bool base_cnf_solve_stoppable (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                      const long int *assumptions, const gint *stop, bool verbose, GSList **solution)
+{
+    if (cnf == NULL) return false;
+
+    if (base_cnf_trivially_unsat (cnf, verbose)) {
+        *solution = NULL;
+        return true;
+    }
+
+    if (base_cnf_lazy_needs_view (cnf)) {
+        struct base_cnf *view = base_cnf_lazy_view_new (cnf, verbose);
+        bool result = base_cnf_solve_stoppable (view, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, stop, verbose, solution);
+        base_cnf_view_free (cnf, view);
+        return result;
+    }
+
+    if (!cnf->xor_view && !g_queue_is_empty (cnf->xors)) {
+        return base_cnf_solve_xors (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, stop, verbose, solution);
+    }
+
+    if (cnf->preprocess_options != NULL) {
+        return base_cnf_solve_preprocessed (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, stop, verbose, solution);
+    }
+
+    if (cnf->split_components && (stop == NULL)) {
+        return base_cnf_solve_components (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, verbose, solution);
+    }
+
+    return base_cnf_solve_whole (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, stop, verbose, solution);
+}
+
+/* solves cnf under assumptions without modifying cnf, returns true on successful run, false if an error occurred.
+ * assumptions: 0-terminated array of literals (long int) temporarily added as unit clauses or NULL,
+ * verbose: if false, solver output and info messages are not printed,
+ * *solution is set to the solution as GSList of literals (long int) or NULL if not satisfiable,
+ * it has to be freed by the caller. The remaining arguments are the same as for base_cnf_solve.
+ * different runs on the same cnf may be executed concurrently if tmp_file_name differs. */
+bool base_cnf_solve_assuming (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                              const long int *assumptions, bool verbose, GSList **solution)
+{
+    return base_cnf_solve_stoppable (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, NULL, verbose, solution);
+}
+
+/* thread pool function for solving cnf under a cube (gpointer index + 1 into cubes of struct base_cnf_cube_run) */
+static void base_cnf_cube_solve_func (gpointer data, gpointer user_data)
+{
+    struct base_cnf_cube_run *run = user_data;
+    guint index = GPOINTER_TO_UINT (data) - 1;
+
+    if (g_atomic_int_get (&(run->error)) || g_atomic_int_get (&(run->satisfiable))) return;
+
+    const long int *cube = g_ptr_array_index (run->cubes, index);
+    unsigned long int n_cube = 0;
+    while (cube[n_cube] != 0) n_cube++;
+
+    long int *assumptions = g_new (long int, run->n_assumptions + n_cube + 1);
+    for (unsigned long int i = 0; i < run->n_assumptions; i++) assumptions[i] = run->assumptions[i];
+    for (unsigned long int i = 0; i < n_cube; i++) assumptions[run->n_assumptions + i] = cube[i];
+    assumptions[run->n_assumptions + n_cube] = 0;
+
+    char *tmp_file_name = g_strdup_printf ("%s_cube_%u", run->tmp_file_name, index);
+    GSList *solution = NULL;
+
+    bool success = base_cnf_solve_stoppable (run->cnf, tmp_file_name, run->solver_bin, run->solution_on_stdout, run->cleanup, run->cnf_gz,
+                                             assumptions, &(run->stop), false, &solution);
+    g_free (tmp_file_name);
+    g_free (assumptions);
+
+    g_mutex_lock (&(run->mutex));
+
+    /* runs stopped after another cube has been found satisfiable are no errors */
+    if (!success && g_atomic_int_get (&(run->satisfiable))) {
+        g_mutex_unlock (&(run->mutex));
+        return;
+    }
+
+    const char *state = (!success ? "failed" : (solution != NULL ? "satisfiable" : "refuted"));
+
+    if (!success) {
+        g_atomic_int_set (&(run->error), 1);
+        g_atomic_int_set (&(run->stop), 1);
+    } else if (solution != NULL) {
+        if (run->solution == NULL) {
+            run->solution = solution;
+            solution = NULL;
+        }
+        g_atomic_int_set (&(run->satisfiable), 1);
+        g_atomic_int_set (&(run->stop), 1);
+    }
+    run->n_done++;
+    printf ("INFO: cube %u %s - %u cubes done, %u remaining\n", index, state, run->n_done, run->cubes->len - run->n_done);
+
+    g_mutex_unlock (&(run->mutex));
+
+    g_slist_free (solution);
+}
+
+/* solves cnf by splitting it into cubes with lookahead, which are solved by concurrent solver runs
+ * until the first one is satisfiable. returns true on successful run, false if an error occurred.
+ * cube_depth: maximum number of decisions per cube (0: depending on n_threads),
+ * n_threads: number of concurrent solver runs (0: number of processors),
+ * other arguments are the same as for base_cnf_solve. */
+bool base_cnf_solve_cube_and_conquer (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                      const long int *assumptions, unsigned int cube_depth, unsigned int n_threads)
+{
+    if (cnf == NULL) return false;
+    if (tmp_file_name == NULL) return false;
+
+    base_cnf_clear_solution (cnf);
+
+    if (base_cnf_trivially_unsat (cnf, true)) return true;
+
+    /* lookahead needs all clauses */
+    if (!g_queue_is_empty (cnf->lazy)) {
+        struct base_cnf *view = base_cnf_lazy_view_new (cnf, true);
+        bool result = base_cnf_solve_cube_and_conquer (view, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                                       assumptions, cube_depth, n_threads);
+        cnf->solution  = view->solution;
+        view->solution = NULL;
+        base_cnf_view_free (cnf, view);
+        return result;
+    }
+
+    if (n_threads == 0) n_threads = g_get_num_processors ();
+    if (cube_depth == 0) {
+        /* about 8 cubes per thread */
+        cube_depth = 3;
+        while ((1u << cube_depth) < 8 * n_threads) cube_depth++;
+    }
+
+    unsigned long int n_assumptions = 0;
+    unsigned long int max_var = cnf->max_var;
+    while ((assumptions != NULL) && (assumptions[n_assumptions] != 0)) {
+        long int var = assumptions[n_assumptions];
+        if (var < 0) var = -var;
+        if ((unsigned long int) var > max_var) max_var = var;
+        n_assumptions++;
+    }
+
+    printf ("INFO: generating cubes (depth %u)...\n", cube_depth);
+    GPtrArray *cubes = sat_cube_generate (cnf->clauses, assumptions, max_var, cube_depth, 64);
+
+    if (cubes->len == 0) {
+        printf ("INFO: all cubes refuted by lookahead\n");
+        g_ptr_array_free (cubes, true);
+        return true;
+    }
+
+    printf ("INFO: solving %u cubes (%u threads)...\n", cubes->len, n_threads);
+
+    struct base_cnf_cube_run run;
+    run.cnf                = cnf;
+    run.tmp_file_name      = tmp_file_name;
+    run.solver_bin         = solver_bin;
+    run.solution_on_stdout = solution_on_stdout;
+    run.cleanup            = cleanup;
+    run.cnf_gz             = cnf_gz;
+    run.assumptions        = assumptions;
+    run.n_assumptions      = n_assumptions;
+    run.cubes              = cubes;
+    run.error              = 0;
+    run.satisfiable        = 0;
+    run.stop               = 0;
+    run.solution           = NULL;
+    run.n_done             = 0;
+    g_mutex_init (&(run.mutex));
+
+    /* idle workers take the next cube from the queue */
+    GThreadPool *pool = g_thread_pool_new (base_cnf_cube_solve_func, &run, n_threads, false, NULL);
+    for (guint i = 0; i < cubes->len; i++) {
+        g_thread_pool_push (pool, GUINT_TO_POINTER (i + 1), NULL);
+    }
+    g_thread_pool_free (pool, false, true);
+
+    g_mutex_clear (&(run.mutex));
+    g_ptr_array_free (cubes, true);
+
+    if (run.error) {
+        g_slist_free (run.solution);
+        return false;
+    }
+
+    if (run.solution != NULL) {
+        printf ("INFO: satisfiable cube found after %u cubes\n", run.n_done);
+    } else {
+        printf ("INFO: all cubes refuted\n");
+    }
+
+    cnf->solution = run.solution;
+
+    return true;
+}
+
+/* reduce assumptions of an unsatisfiable run of cnf to a subset that is still unsatisfiable.
+ * assumptions: 0-terminated array of literals (long int), modified in place,
+ * each assumption is removed if cnf is still unsatisfiable without it, so the result is minimal
+ * with respect to removing single assumptions. other arguments as for base_cnf_solve.
+ * returns false on errors. */
+bool base_cnf_reduce_failed_assumptions (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                         long int *assumptions)
+{
+    if (cnf == NULL) return false;
+    if (assumptions == NULL) return true;
+
+    unsigned long int n_assumptions = 0;
+    while (assumptions[n_assumptions] != 0) n_assumptions++;
+    if (n_assumptions == 0) return true;
+
+    printf ("INFO: reducing %lu failed assumptions...\n", n_assumptions);
+
+    long int *test_assumptions = g_new0 (long int, n_assumptions + 1);
+
+    /* unsatisfiable without any assumption? */
+    GSList *solution = NULL;
+    if (!base_cnf_solve_assuming (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, test_assumptions, false, &solution)) {
+        g_free (test_assumptions);
+        return false;
+    }
+    if (solution == NULL) {
+        assumptions[0] = 0;
+        g_free (test_assumptions);
+        return true;
+    }
+    g_slist_free (solution);
+
+    /* try removing one assumption after another */
+    unsigned long int i_check = 0;
+    while (i_check < n_assumptions) {
+        unsigned long int n_test = 0;
+        for (unsigned long int i = 0; i < n_assumptions; i++) {
+            if (i == i_check) continue;
+            test_assumptions[n_test++] = assumptions[i];
+        }
+        test_assumptions[n_test] = 0;
+
+        if (!base_cnf_solve_assuming (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, test_assumptions, false, &solution)) {
+            g_free (test_assumptions);
+            return false;
+        }
+
+        if (solution == NULL) {
+            /* not needed */
+            memcpy (assumptions, test_assumptions, sizeof (long int) * (n_test + 1));
+            n_assumptions = n_test;
+        } else {
+            g_slist_free (solution);
+            i_check++;
+        }
+    }
+
+    g_free (test_assumptions);
+
+    return true;
+}
+
+/* enumerate solutions of cnf projected onto variables without modifying cnf.
+ * vars: 0-terminated array of variables (long int) to project solutions on,
+ * limit: maximum number of solutions to enumerate, 0 for no limit,
+ * solution_func: called for each solution with a 0-terminated array of literals (long int) of vars,
+ *   enumeration is stopped if it returns false.
+ * assumptions: 0-terminated array of literals (long int) added as unit clauses or NULL,
+ * other arguments as for base_cnf_solve. Each solution is excluded by a clause containing only
+ * the inverted literals of vars, that is only appended to the written cnf file like the assumptions.
+ * returns the number of enumerated solutions or -1 on errors. */
+long int base_cnf_enumerate_solutions (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                       const long int *assumptions, const long int *vars, unsigned long int limit, BaseCNFSolutionFunc solution_func, gpointer user_data)
+{
+    if (cnf == NULL) return -1;
+    if (vars == NULL) return -1;
+
+    if (base_cnf_trivially_unsat (cnf, true)) return 0;
+
+    if (!cnf->xor_view && !g_queue_is_empty (cnf->xors)) {
+        unsigned long int n_vars;
+        struct base_cnf *view = base_cnf_xor_view_new (cnf, assumptions, true, &n_vars);
+        if (view == NULL) return 0;
+
+        long int result = base_cnf_enumerate_solutions (view, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                                        assumptions, vars, limit, solution_func, user_data);
+        base_cnf_view_free (cnf, view);
+        return result;
+    }
+
+    /* projection */
+    unsigned long int n_proj = 0;
+    unsigned long int extra_max_var = 0;
+    while (vars[n_proj] != 0) {
+        long int var = vars[n_proj];
+        if (var < 0) var = -var;
+        if (var > extra_max_var) extra_max_var = var;
+        n_proj++;
+    }
+
+    /* literal of each projection variable in current solution */
+    GHashTable *var_index = g_hash_table_new (g_direct_hash, g_direct_equal);
+    for (unsigned long int i = 0; i < n_proj; i++) {
+        long int var = vars[i];
+        if (var < 0) var = -var;
+        g_hash_table_insert (var_index, GSIZE_TO_POINTER (var), GSIZE_TO_POINTER (i + 1));
+    }
+    long int *projected = g_new0 (long int, n_proj + 1);
+
+    GString *blocking_clauses = g_string_new (NULL);
+    unsigned long int n_blocking_clauses = 0;
+    long int n_solutions = 0;
+
+    /* assumptions */
+    for (int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+        long int var = (assumptions[i] > 0 ? assumptions[i] : -assumptions[i]);
+        if (var > extra_max_var) extra_max_var = var;
+        g_string_append_printf (blocking_clauses, "%ld 0\n", assumptions[i]);
+        n_blocking_clauses++;
+    }
+
+    printf ("INFO: enumerating solutions...\n");
+
+    while ((limit == 0) || (n_solutions < limit)) {
+        GSList *solution = NULL;
+        if (!base_cnf_run (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                           true, blocking_clauses, n_blocking_clauses, extra_max_var, NULL, false, &solution)) {
+            n_solutions = -1;
+            break;
+        }
+        if (solution == NULL) break;
+
+        /* project */
+        for (unsigned long int i = 0; i < n_proj; i++) {
+            long int var = vars[i];
+            projected[i] = -(var < 0 ? -var : var);
+        }
+        for (GSList *li = solution; li != NULL; li = li->next) {
+            long int lit = GPOINTER_TO_SIZE (li->data);
+            gsize index  = GPOINTER_TO_SIZE (g_hash_table_lookup (var_index, GSIZE_TO_POINTER (lit < 0 ? -lit : lit)));
+            if (index == 0) continue;
+            projected[index - 1] = lit;
+        }
+        g_slist_free (solution);
+
+        n_solutions++;
+
+        /* exclude */
+        for (unsigned long int i = 0; i < n_proj; i++) {
+            g_string_append_printf (blocking_clauses, "%ld ", -projected[i]);
+        }
+        g_string_append (blocking_clauses, "0\n");
+        n_blocking_clauses++;
+
+        if (solution_func != NULL) {
+            if (!solution_func (projected, user_data)) break;
+        }
+
+        /* empty projection has exactly one solution */
+        if (n_proj == 0) break;
+    }
+
+    if (n_solutions >= 0) printf ("INFO: %ld solutions enumerated\n", n_solutions);
+
+    g_string_free (blocking_clauses, true);
+    g_hash_table_destroy (var_index);
+    g_free (projected);
+
+    return n_solutions;
+}
+
+/* return sum of the weights of the literals of objective that are true in value (indexed by variable,
+ * 1: true, -1: false, variables above n_vars are false) */
+static long int base_cnf_objective_cost (const struct base_cnf_objective *objective, const signed char *value, unsigned long int n_vars)
+{
+    long int cost = 0;
+
+    for (unsigned int i = 0; i < objective->n; i++) {
+        long int lit = objective->lits[i];
+        unsigned long int var = (lit > 0 ? lit : -lit);
+        signed char var_value = (var <= n_vars ? value[var] : -1);
+
+        if ((var_value > 0) == (lit > 0)) cost += objective->weights[i];
+    }
+
+    return cost;
+}
+
+/* set costs of all objectives in solution and print them with the time since start */
+static void base_cnf_optimize_costs (GSList *solution, const struct base_cnf_objective *objectives, unsigned int n_objectives,
+                                     unsigned long int n_vars, gint64 start, long int *costs)
+{
+    signed char *value = g_new (signed char, n_vars + 1);
+    memset (value, -1, n_vars + 1);
+
+    for (GSList *li = solution; li != NULL; li = li->next) {
+        long int lit = GPOINTER_TO_SIZE (li->data);
+        unsigned long int var = (lit > 0 ? lit : -lit);
+        if (var <= n_vars) value[var] = (lit > 0 ? 1 : -1);
+    }
+
+    GString *str = g_string_new (NULL);
+    for (unsigned int i = 0; i < n_objectives; i++) {
+        costs[i] = base_cnf_objective_cost (&(objectives[i]), value, n_vars);
+        g_string_append_printf (str, " %ld", costs[i]);
+    }
+
+    printf ("INFO: model with costs%s after %.3f s\n", str->str, (double) (g_get_monotonic_time () - start) / G_USEC_PER_SEC);
+
+    g_string_free (str, true);
+    g_free (value);
+}
+
+/* append unit clauses fixing the outputs (long int) of a totalizer with sums above bound to false to str
+ * and return their number */
+static unsigned long int base_cnf_optimize_bound (GString *str, GArray *sums, GArray *outputs, long int bound)
+{
+    unsigned long int n_units = 0;
+
+    for (guint i = 0; i < sums->len; i++) {
+        if (g_array_index (sums, long int, i) <= bound) continue;
+
+        g_string_append_printf (str, "%ld 0\n", -g_array_index (outputs, long int, i));
+        n_units++;
+    }
+
+    return n_units;
+}
+
+/* append clauses (GQueue of 0-terminated arrays of literals (long int) allocated by g_slice) to str in DIMACS format
+ * and free them */
+static void base_cnf_optimize_append_clauses (GString *str, GQueue *clauses)
+{
+    while (!g_queue_is_empty (clauses)) {
+        long int *clause = g_queue_pop_head (clauses);
+        base_cnf_append_dimacs_clause (str, clause);
+
+        unsigned int len = 0;
+        while (clause[len] != 0) len++;
+        g_slice_free1 (sizeof (long int) * (len + 1), clause);
+    }
+}
+
+/* append clauses of a pseudo-Boolean encoding of cost of objective <= bound with auxiliary variables
+ * following *max_var to str, *max_var is set to the greatest one. returns the number of clauses. */
+static unsigned long int base_cnf_optimize_pb_bound (GString *str, const struct base_cnf_objective *objective, long int bound,
+                                                     unsigned long int *max_var, GQueue *clauses)
+{
+    unsigned long int next_var = *max_var + 1;
+    unsigned long int n_clauses = sat_pb_append (SAT_PB_AUTO, objective->lits, objective->weights, objective->n, bound,
+                                                 NULL, &next_var, clauses);
+    *max_var = next_var - 1;
+
+    base_cnf_optimize_append_clauses (str, clauses);
+
+    return n_clauses;
+}
+
+/* runs the solver on cnf with extra_clauses for base_cnf_optimize, the solver is stopped at deadline
+ * (monotonic time, 0: none) including the time for writing the cnf file and *stopped is set.
+ * returns false on errors. */
+static bool base_cnf_optimize_run (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                   GString *extra_clauses, unsigned long int n_extra_clauses, unsigned long int extra_max_var,
+                                   gint64 deadline, GSList **solution, bool *stopped)
+{
+    *solution = NULL;
+
+    if ((deadline > 0) && (g_get_monotonic_time () >= deadline)) {
+        *stopped = true;
+        return true;
+    }
+    cnf->solver_deadline = deadline;
+    g_atomic_int_set (&(cnf->solver_timed_out), 0);
+
+    if (base_cnf_run (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                      true, extra_clauses, n_extra_clauses, extra_max_var, NULL, false, solution)) return true;
+
+    if (base_cnf_solver_timed_out (cnf)) {
+        *stopped = true;
+        return true;
+    }
+
+    return false;
+}
+
+/* minimize objectives of cnf in lexicographic order by linear SAT-UNSAT search over generalized totalizers
+ * whose bounds are tightened by unit clauses appended to the written cnf file only. objectives whose totalizer
+ * would exceed BASE_CNF_OPTIMIZE_MAX_TOTALIZER_CLAUSES (e.g. by many distinct weights) get a separate
+ * pseudo-Boolean encoding of each bound instead.
+ * timeout: time budget of all solver runs including writing their cnf files in seconds (0: no limit).
+ * returns false on errors. */
+bool base_cnf_optimize (struct base_cnf *cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                        const long int *assumptions, const struct base_cnf_objective *objectives, unsigned int n_objectives,
+                        double timeout, long int *costs, bool *optimal)
+{
+    if (cnf == NULL) return false;
+    if ((objectives == NULL) && (n_objectives > 0)) return false;
+
+    base_cnf_clear_solution (cnf);
+    *optimal = false;
+
+    if (base_cnf_trivially_unsat (cnf, true)) {
+        *optimal = true;
+        return true;
+    }
+
+    if (!cnf->xor_view && !g_queue_is_empty (cnf->xors)) {
+        unsigned long int n_vars;
+        struct base_cnf *view = base_cnf_xor_view_new (cnf, assumptions, true, &n_vars);
+        if (view == NULL) {
+            *optimal = true;
+            return true;
+        }
+
+        bool result = base_cnf_optimize (view, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                         assumptions, objectives, n_objectives, timeout, costs, optimal);
+
+        cnf->solution  = view->solution;
+        view->solution = NULL;
+        if (view->max_var > n_vars) base_cnf_solution_trim (&(cnf->solution), n_vars);
+
+        base_cnf_view_free (cnf, view);
+        return result;
+    }
+
+    /* variables of the problem, totalizers use the following ones */
+    unsigned long int n_vars = cnf->max_var;
+    for (int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+        unsigned long int var = (assumptions[i] > 0 ? assumptions[i] : -assumptions[i]);
+        if (var > n_vars) n_vars = var;
+    }
+    for (unsigned int i = 0; i < n_objectives; i++) {
+        for (unsigned int j = 0; j < objectives[i].n; j++) {
+            unsigned long int var = (objectives[i].lits[j] > 0 ? objectives[i].lits[j] : -objectives[i].lits[j]);
+            if (var > n_vars) n_vars = var;
+        }
+    }
+    unsigned long int extra_max_var = n_vars;
+
+    /* assumptions, totalizers and bounds of finished objectives */
+    GString *fixed = g_string_new (NULL);
+    unsigned long int n_fixed = 0;
+    for (int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+        g_string_append_printf (fixed, "%ld 0\n", assumptions[i]);
+        n_fixed++;
+    }
+
+    GArray  *sums    = g_array_new (false, false, sizeof (long int));
+    GArray  *outputs = g_array_new (false, false, sizeof (long int));
+    GQueue  *clauses = g_queue_new ();
+
+    gint64 start    = g_get_monotonic_time ();
+    gint64 deadline = (timeout > 0 ? start + (gint64) (timeout * G_USEC_PER_SEC) : 0);
+    bool stopped    = false;
+
+    printf ("INFO: minimizing %u objectives...\n", n_objectives);
+
+    GSList *best = NULL;
+    bool success = base_cnf_optimize_run (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                          fixed, n_fixed, extra_max_var, deadline, &best, &stopped);
+    if (best != NULL) base_cnf_optimize_costs (best, objectives, n_objectives, n_vars, start, costs);
+
+    for (unsigned int level = 0; success && !stopped && (best != NULL) && (level < n_objectives); level++) {
+        const struct base_cnf_objective *objective = &(objectives[level]);
+
+        g_array_set_size (sums, 0);
+        g_array_set_size (outputs, 0);
+        bool totalizer = false;
+
+        if (costs[level] > 0) {
+            unsigned long int next_var = extra_max_var + 1;
+            /* sums above the cost are merged, the cost itself is kept for fixing it if it is optimal */
+            n_fixed += sat_pb_totalizer_append (objective->lits, objective->weights, objective->n, costs[level],
+                                                BASE_CNF_OPTIMIZE_MAX_TOTALIZER_CLAUSES, sums, outputs, &next_var, clauses);
+            extra_max_var = next_var - 1;
+            totalizer     = (sums->len > 0);
+
+            if (totalizer) {
+                base_cnf_optimize_append_clauses (fixed, clauses);
+            } else {
+                printf ("INFO: totalizer of objective %u exceeds %lu clauses - encoding each bound separately\n",
+                        level + 1, (unsigned long int) BASE_CNF_OPTIMIZE_MAX_TOTALIZER_CLAUSES);
+            }
+        }
+
+        /* tighten bound below cost of best model until there is none, the bound is removed from fixed afterwards */
+        while (costs[level] > 0) {
+            gsize fixed_len = fixed->len;
+            unsigned long int n_extra = n_fixed;
+            unsigned long int bound_max_var = extra_max_var;
+
+            if (totalizer) {
+                n_extra += base_cnf_optimize_bound (fixed, sums, outputs, costs[level] - 1);
+            } else {
+                n_extra += base_cnf_optimize_pb_bound (fixed, objective, costs[level] - 1, &bound_max_var, clauses);
+            }
+
+            GSList *solution = NULL;
+            success = base_cnf_optimize_run (cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                             fixed, n_extra, bound_max_var, deadline, &solution, &stopped);
+            g_string_truncate (fixed, fixed_len);
+            if (!success || stopped || (solution == NULL)) break;
+
+            g_slist_free (best);
+            best = solution;
+            base_cnf_optimize_costs (best, objectives, n_objectives, n_vars, start, costs);
+        }
+        if (!success || stopped) break;
+
+        /* keep optimal cost for the next objectives */
+        if (totalizer) {
+            n_fixed += base_cnf_optimize_bound (fixed, sums, outputs, costs[level]);
+        } else if (costs[level] > 0) {
+            n_fixed += base_cnf_optimize_pb_bound (fixed, objective, costs[level], &extra_max_var, clauses);
+        } else {
+            for (unsigned int i = 0; i < objective->n; i++) {
+                g_string_append_printf (fixed, "%ld 0\n", -objective->lits[i]);
+                n_fixed++;
+            }
+        }
+    }
+
+    if (success) {
+        double seconds = (double) (g_get_monotonic_time () - start) / G_USEC_PER_SEC;
+
+        if (!stopped) {
+            *optimal = true;
+            if (best == NULL) {
+                printf ("INFO: problem is not satisfiable\n");
+            } else {
+                printf ("INFO: optimum found after %.3f s\n", seconds);
+            }
+        } else {
+            printf ("INFO: time budget of %g s exhausted after %.3f s%s\n", timeout, seconds,
+                    (best == NULL ? " without model" : " - keeping best model"));
+        }
+
+        if (best != NULL) base_cnf_solution_trim (&best, n_vars);
+        cnf->solution = best;
+    } else {
+        g_slist_free (best);
+    }
+
+    cnf->solver_deadline = 0;
+
+    g_queue_free (clauses);
+    g_array_free (sums, true);
+    g_array_free (outputs, true);
+    g_string_free (fixed, true);
+
+    return success;
+}
+
+/* print clause given as 0-terminated array of literals (long int) with weight to file in WCNF format */
+static void base_cnf_fprint_wcnf_clause (FILE *file, const char *weight, const long int *clause)
+{
+    fprintf (file, "%s", weight);
+    for (int i = 0; clause[i] != 0; i++) {
+        fprintf (file, " %ld", clause[i]);
+    }
+    fprintf (file, " 0\n");
+}
+
+/* write cnf with assumptions as hard clauses and weighted soft literals in WCNF format, see header */
+bool base_cnf_write_wcnf (struct base_cnf *cnf, const char *file_name, const long int *assumptions,
+                          const long int *soft_lits, const long int *soft_weights, unsigned int n_soft)
+{
+    if (cnf == NULL) return false;
+    if (file_name == NULL) return false;
+
+    /* unit simplification or Gauss-Jordan elimination may derive an empty clause */
+    bool unsat = base_cnf_trivially_unsat (cnf, false);
+
+    struct base_cnf *view = NULL;
+    if (!unsat && !cnf->xor_view && !g_queue_is_empty (cnf->xors)) {
+        /* XOR constraints as clauses */
+        bool xor_native = cnf->xor_native;
+        unsigned long int n_vars;
+
+        cnf->xor_native = false;
+        view = base_cnf_xor_view_new (cnf, assumptions, false, &n_vars);
+        cnf->xor_native = xor_native;
+
+        if (view == NULL) unsat = true;
+    }
+
+    FILE *file = fopen (file_name, "w");
+    if (file == NULL) {
+        printf ("ERROR: could not open file %s\n", file_name);
+        if (view != NULL) base_cnf_view_free (cnf, view);
+        return false;
+    }
+
+    if (unsat) {
+        static const long int empty_clause[] = {0};
+        base_cnf_fprint_wcnf_clause (file, "h", empty_clause);
+    } else {
+        struct base_cnf *hard = (view != NULL ? view : cnf);
+
+        for (GList *cl = hard->clauses->head; cl != NULL; cl = cl->next) {
+            base_cnf_fprint_wcnf_clause (file, "h", cl->data);
+        }
+        for (GList *li = hard->lazy->head; li != NULL; li = li->next) {
+            GQueue *clauses = g_queue_new ();
+            base_cnf_lazy_expand (li->data, clauses);
+
+            while (!g_queue_is_empty (clauses)) {
+                long int *clause = g_queue_pop_head (clauses);
+                base_cnf_fprint_wcnf_clause (file, "h", clause);
+
+                unsigned int len = 0;
+                while (clause[len] != 0) len++;
+                g_slice_free1 (sizeof (long int) * (len + 1), clause);
+            }
+            g_queue_free (clauses);
+        }
+        for (int i = 0; (assumptions != NULL) && (assumptions[i] != 0); i++) {
+            long int unit[] = {assumptions[i], 0};
+            base_cnf_fprint_wcnf_clause (file, "h", unit);
+        }
+    }
+
+    for (unsigned int i = 0; i < n_soft; i++) {
+        fprintf (file, "%ld %ld 0\n", soft_weights[i], soft_lits[i]);
+    }
+
+    fclose (file);
+
+    if (view != NULL) base_cnf_view_free (cnf, view);
+
+    return true;
+}
+
+/* enable preprocessing before solving with given options or disable it if options is NULL */
+void base_cnf_set_preprocess (struct base_cnf *cnf, const struct sat_preprocess_options *options)
+{
+    if (cnf == NULL) return;
+
+    if (options == NULL) {
+        if (cnf->preprocess_options != NULL) {
+            g_slice_free (struct sat_preprocess_options, cnf->preprocess_options);
+        }
+        cnf->preprocess_options = NULL;
+        return;
+    }
+
+    if (cnf->preprocess_options == NULL) {
+        cnf->preprocess_options = g_slice_new (struct sat_preprocess_options);
+    }
+    *(cnf->preprocess_options) = *options;
+}
+
+/* enable or disable solving variable-disjoint components of cnf by separate solver runs.
+ * n_threads: number of concurrent solver runs (0: number of processors),
+ * min_vars: components with less variables are solved together by one run. */
+void base_cnf_set_split_components (struct base_cnf *cnf, bool enable, unsigned int n_threads, unsigned long int min_vars)
+{
+    if (cnf == NULL) return;
+
+    cnf->split_components = enable;
+    cnf->split_threads    = n_threads;
+    cnf->split_min_vars   = min_vars;
+}
+
+/* enable or disable adding lex-leader symmetry-breaking clauses for symmetries found before solving.
+ * max_vertices: symmetry search is skipped if number of literals + clauses is greater,
+ * max_generators: maximum number of symmetry generators to break. */
+void base_cnf_set_symmetry_breaking (struct base_cnf *cnf, bool enable, unsigned long int max_vertices, unsigned int max_generators)
+{
+    if (cnf == NULL) return;
+
+    cnf->symmetry_breaking       = enable;
+    cnf->symmetry_max_vertices   = max_vertices;
+    cnf->symmetry_max_generators = max_generators;
+}
+
+/* enable or disable renumbering variables and reordering clauses for locality before solving */
+void base_cnf_set_renumber (struct base_cnf *cnf, bool enable)
+{
+    if (cnf == NULL) return;
+
+    cnf->renumber = enable;
+}
+
+/* configure handling of XOR constraints on solving.
+ * native: write them as "x" lines for XOR-aware solvers instead of clauses,
+ * cut: maximum number of literals per XOR of the clause encoding (at least 3),
+ * gauss_max_bits: maximum size of the Gauss-Jordan matrix in bits, 0 disables elimination. */
+void base_cnf_set_xor (struct base_cnf *cnf, bool native, unsigned int cut, unsigned long int gauss_max_bits)
+{
+    if (cnf == NULL) return;
+
+    cnf->xor_native         = native;
+    cnf->xor_cut            = (cut < 3 ? 3 : cut);
+    cnf->xor_gauss_max_bits = gauss_max_bits;
+}
+
+/* stop solver runs after seconds (0: no limit), a stopped run is treated as error */
+void base_cnf_set_solver_timeout (struct base_cnf *cnf, double seconds)
+{
+    if (cnf == NULL) return;
+
+    cnf->solver_timeout = (seconds > 0 ? seconds : 0);
+    g_atomic_int_set (&(cnf->solver_timed_out), 0);
+}
+
+/* return true if a solver run of cnf has been stopped by the timeout since base_cnf_set_solver_timeout */
+bool base_cnf_solver_timed_out (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return false;
+
+    return (g_atomic_int_get (&(cnf->solver_timed_out)) != 0);
+}
+
+/* return true if literal is true in bit-packed model of verification run */
+static inline bool base_cnf_verify_lit (struct base_cnf_verify_run *run, long int lit)
+{
+    unsigned long int var = (lit > 0 ? lit : -lit);
+    if (var > run->max_var) return false;
+
+    guint64 mask = ((guint64) 1) << (var & 63);
+    if ((run->assigned[var >> 6] & mask) == 0) return false;
+
+    return (((run->value[var >> 6] & mask) != 0) == (lit > 0));
+}
+
+/* thread pool function for verifying a job (guint job index + 1) of constraints */
+static void base_cnf_verify_func (gpointer data, gpointer user_data)
+{
+    struct base_cnf_verify_run *run = user_data;
+
+    guint start = (GPOINTER_TO_UINT (data) - 1) * run->job_size;
+    guint end   = start + run->job_size;
+    if (end > run->constraints->len) end = run->constraints->len;
+
+    for (guint i = start; i < end; i++) {
+        /* a violation of an earlier constraint has been found */
+        if ((guint) g_atomic_int_get (&run->first_violated) <= i) return;
+
+        const long int *constraint = g_ptr_array_index (run->constraints, i);
+        bool satisfied = false;
+
+        if (i < (guint) run->n_clauses) {
+            for (unsigned int j = 0; constraint[j] != 0; j++) {
+                if (base_cnf_verify_lit (run, constraint[j])) {
+                    satisfied = true;
+                    break;
+                }
+            }
+        } else {
+            satisfied = true;
+            bool parity = false;
+            for (unsigned int j = 0; constraint[j] != 0; j++) {
+                /* unassigned variables violate XOR constraints */
+                if (!base_cnf_verify_lit (run, constraint[j]) && !base_cnf_verify_lit (run, -constraint[j])) satisfied = false;
+                if (base_cnf_verify_lit (run, constraint[j])) parity = !parity;
+            }
+            if (!parity) satisfied = false;
+        }
+
+        if (satisfied) continue;
+
+        gint old_violated = g_atomic_int_get (&run->first_violated);
+        while (((guint) old_violated > i) && !g_atomic_int_compare_and_exchange (&run->first_violated, old_violated, i)) {
+            old_violated = g_atomic_int_get (&run->first_violated);
+        }
+        return;
+    }
+}
+
+/* verify model given as GSList of literals as (long int) against all clauses and XOR constraints of cnf
+ * and return NULL if all of them are satisfied. Otherwise a copy of the first violated constraint is returned
+ * as 0-terminated array of literals as (long int) freed with g_free, *is_xor is set if it is an XOR constraint.
+ * The model is bit-packed and large problems are checked by n_threads concurrent jobs (0: number of processors). */
+long int * base_cnf_verify_model (struct base_cnf *cnf, GSList *model, unsigned int n_threads, bool *is_xor)
+{
+    if (cnf == NULL) return NULL;
+
+    if (!g_queue_is_empty (cnf->lazy)) {
+        struct base_cnf *view = base_cnf_lazy_view_new (cnf, false);
+        long int *result = base_cnf_verify_model (view, model, n_threads, is_xor);
+        base_cnf_view_free (cnf, view);
+        return result;
+    }
+
+    struct base_cnf_verify_run run;
+
+    unsigned long int n_words = (cnf->max_var >> 6) + 1;
+
+    run.max_var  = cnf->max_var;
+    run.assigned = g_new0 (guint64, n_words);
+    run.value    = g_new0 (guint64, n_words);
+
+    for (GSList *li = model; li != NULL; li = li->next) {
+        long int lit = GPOINTER_TO_SIZE (li->data);
+        unsigned long int var = (lit > 0 ? lit : -lit);
+        if ((var == 0) || (var > run.max_var)) continue;
+
+        guint64 mask = ((guint64) 1) << (var & 63);
+        run.assigned[var >> 6] |= mask;
+        if (lit > 0) {
+            run.value[var >> 6] |= mask;
+        } else {
+            run.value[var >> 6] &= ~mask;
+        }
+    }
+
+    run.constraints = g_ptr_array_sized_new (g_queue_get_length (cnf->clauses) + g_queue_get_length (cnf->xors));
+    for (GList *cl = cnf->clauses->head; cl != NULL; cl = cl->next) {
+        g_ptr_array_add (run.constraints, cl->data);
+    }
+    run.n_clauses = run.constraints->len;
+    for (GList *cl = cnf->xors->head; cl != NULL; cl = cl->next) {
+        g_ptr_array_add (run.constraints, cl->data);
+    }
+    run.first_violated = run.constraints->len;
+
+    if (n_threads == 0) n_threads = g_get_num_processors ();
+
+    run.job_size = (run.constraints->len + n_threads - 1) / n_threads;
+    if (run.job_size < BASE_CNF_VERIFY_MIN_JOB_SIZE) run.job_size = BASE_CNF_VERIFY_MIN_JOB_SIZE;
+
+    guint n_jobs = (run.constraints->len + run.job_size - 1) / run.job_size;
+
+    if (n_jobs <= 1) {
+        if (n_jobs == 1) base_cnf_verify_func (GUINT_TO_POINTER (1), &run);
+    } else {
+        GThreadPool *pool = g_thread_pool_new (base_cnf_verify_func, &run, n_jobs, false, NULL);
+        for (guint i = 0; i < n_jobs; i++) {
+            g_thread_pool_push (pool, GUINT_TO_POINTER (i + 1), NULL);
+        }
+        g_thread_pool_free (pool, false, true);
+    }
+
+    long int *result = NULL;
+
+    if ((guint) run.first_violated < run.constraints->len) {
+        const long int *constraint = g_ptr_array_index (run.constraints, run.first_violated);
+
+        unsigned int len = 0;
+        while (constraint[len] != 0) len++;
+
+        result = g_new (long int, len + 1);
+        memcpy (result, constraint, sizeof (long int) * (len + 1));
+        if (is_xor != NULL) *is_xor = (run.first_violated >= run.n_clauses);
+    }
+
+    g_ptr_array_free (run.constraints, true);
+    g_free (run.assigned);
+    g_free (run.value);
+
+    return result;
+}
+
+/* make current solution of cnf invalid to optain another one on next solving */
+void base_cnf_cancel_solution (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return;
+
+    GSList *cancel_clause = NULL;
+
+    for (GSList *li = cnf->solution; li != NULL; li = li->next) {
+        long int lit = -GPOINTER_TO_SIZE (li->data);
+
+        cancel_clause = g_slist_prepend (cancel_clause, GSIZE_TO_POINTER (lit));
+    }
+
+    base_cnf_add_clause_gslist (cnf, cancel_clause);
+
+    g_slist_free (cancel_clause);
+}
+
+/* return internal clauses of cnf as GQueue of 0-terminated arrays of literals as (long int).
+ * returned GQueue should not be modified. */
+GQueue* base_cnf_clauses (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return NULL;
+    return cnf->clauses;
+}
+
+/* append the clauses of all lazy constraints of cnf to clauses (GQueue of 0-terminated arrays of literals
+ * (long int) allocated by g_slice) and return their number */
+unsigned long int base_cnf_append_lazy_clauses (struct base_cnf *cnf, GQueue *clauses)
+{
+    if (cnf == NULL) return 0;
+
+    unsigned long int result = 0;
+    for (GList *li = cnf->lazy->head; li != NULL; li = li->next) {
+        result += base_cnf_lazy_expand (li->data, clauses);
+    }
+
+    return result;
+}
+
+/* return solution (if satisfiable) or NULL if not or not yet solved as GSList of literals as (long int).
+ * returned GSList should not be modified. */
+GSList * base_cnf_solution (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return NULL;
+    return cnf->solution;
+}
+
+/* return number of clauses in cnf */
+unsigned long int base_cnf_num_clauses (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return 0;
+    return g_queue_get_length (cnf->clauses);
+}
+
+/* return greatest variable number used in clauses of cnf */
+unsigned long int base_cnf_max_var (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return 0;
+    return cnf->max_var;
+}
+
+/* return XOR constraints of cnf as GQueue of 0-terminated arrays of literals as (long int) whose exclusive or is true.
+ * returned GQueue should not be modified */
+GQueue * base_cnf_xors (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return NULL;
+    return cnf->xors;
+}
+
+/* return number of XOR constraints in cnf */
+unsigned long int base_cnf_num_xors (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return 0;
+    return g_queue_get_length (cnf->xors);
+}
+
+/* return number of lazy constraints in cnf */
+unsigned long int base_cnf_num_lazy (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return 0;
+    return g_queue_get_length (cnf->lazy);
+}
+
+/* return number of clauses of the lazy constraints in cnf */
+unsigned long int base_cnf_num_lazy_clauses (struct base_cnf *cnf)
+{
+    if (cnf == NULL) return 0;
+    return cnf->lazy_n_clauses;
 }
@@ -22,8 +22,22 @@
 #include <stdbool.h>
 #include <glib.h>
 
+#include "sat_preprocess.h"
+#include "sat_cardinality.h"
+
 typedef struct base_cnf *BaseCNF;
 
+/* function called for each enumerated solution given as 0-terminated array of literals as (long int),
+ * enumeration is stopped if it returns false */
+typedef bool (*BaseCNFSolutionFunc) (const long int *solution, gpointer user_data);
+
+/* objective minimized by base_cnf_optimize: sum of the positive weights of the true literals among the n lits */
+struct base_cnf_objective {
+    const long int *lits;
+    const long int *weights;
+    unsigned int   n;
+};
+
 /* returns a newly allocated BaseCNF */
 BaseCNF base_cnf_new ();
 
@@ -32,25 +46,152 @@ void base_cnf_free (BaseCNF *cnf);
 
 /* adds a clause to cnf given as 0-terminated array of literals as (long int) */
 void base_cnf_add_clause_array  (BaseCNF cnf, const long int *clause);
+/* adds an empty clause to cnf, making it unsatisfiable */
+void base_cnf_add_empty_clause (BaseCNF cnf);
 /* adds a clause to cnf given as GSList of literals as (long int) */
 void base_cnf_add_clause_gslist  (BaseCNF cnf, GSList *clause);
 /* adds a clause to cnf given as GQueue of literals as (long int) */
 void base_cnf_add_clause_gqueue (BaseCNF cnf, GQueue *clause);
+/* adds an XOR constraint to cnf given as 0-terminated array of literals as (long int) whose exclusive or is true.
+ * XOR constraints are stored natively and encoded on solving, constraints with less than 3 variables
+ * after normalization are added as clauses. */
+void base_cnf_add_xor_array (BaseCNF cnf, const long int *xor);
+/* adds at least min and at most max of the n literals lits to cnf as descriptor of the given cardinality encoding,
+ * which is only expanded into clauses when they are needed: on writing the cnf file clauses are streamed into it,
+ * other consumers (e.g. preprocessing, model verification) work on an expanded copy. guard is added to each
+ * clause if not 0. auxiliary variables are numbered from *next_var on, which is incremented accordingly.
+ * returns the number of clauses. */
+unsigned long int base_cnf_add_lazy_cardinality (BaseCNF cnf, SatCardinalityEncoding encoding, const long int *lits, unsigned int n,
+                                                 unsigned int min, unsigned int max, long int guard, unsigned long int *next_var);
+
+/* removes clauses, XOR constraints and lazy constraints added last until n_clauses, n_xors and n_lazy remain and
+ * lowers greatest variable number to max_var. the current solution is removed. */
+void base_cnf_truncate (BaseCNF cnf, unsigned long int n_clauses, unsigned long int n_xors, unsigned long int n_lazy, unsigned long int max_var);
 
 /* solves cnf, returns true on successful run, false if an error occurred.
  * temporary files ar prefixed with tmp_file_name, solver binary solver_bin is used,
  * solution_on_stdout: if true it is assumed that solver prints solution on stdout,
  * cleanup: if true remove temporary files when finished,
- * cnf_gz: if true use gzipped dimacs for cnf file */
-bool base_cnf_solve (BaseCNF cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz);
+ * cnf_gz: if true use gzipped dimacs for cnf file,
+ * assumptions: 0-terminated array of literals (long int) only valid for this run or NULL */
+bool base_cnf_solve (BaseCNF cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                     const long int *assumptions);
+/* solves cnf under assumptions without modifying cnf, returns true on successful run, false if an error occurred.
+ * assumptions: 0-terminated array of literals (long int) temporarily added as unit clauses or NULL,
+ * verbose: if false, solver output and info messages are not printed,
+ * *solution is set to the solution as GSList of literals (long int) or NULL if not satisfiable,
+ * it has to be freed by the caller. The remaining arguments are the same as for base_cnf_solve.
+ * different runs on the same cnf may be executed concurrently if tmp_file_name differs. */
+bool base_cnf_solve_assuming (BaseCNF cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                              const long int *assumptions, bool verbose, GSList **solution);
+/* solves cnf by splitting it into cubes (sets of assumptions) by lookahead, which are solved by
+ * concurrent solver runs until the first one is satisfiable. returns true on successful run, false if an error occurred.
+ * cube_depth: maximum number of decisions per cube (0: depending on n_threads),
+ * n_threads: number of concurrent solver runs (0: number of processors),
+ * other arguments are the same as for base_cnf_solve. */
+bool base_cnf_solve_cube_and_conquer (BaseCNF cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                      const long int *assumptions, unsigned int cube_depth, unsigned int n_threads);
+/* reduce assumptions of an unsatisfiable run of cnf to a subset that is still unsatisfiable.
+ * assumptions: 0-terminated array of literals (long int), modified in place,
+ * each assumption is removed if cnf is still unsatisfiable without it, so the result is minimal
+ * with respect to removing single assumptions. other arguments as for base_cnf_solve.
+ * returns false on errors. */
+bool base_cnf_reduce_failed_assumptions (BaseCNF cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                         long int *assumptions);
+/* enumerate solutions of cnf projected onto variables without modifying cnf.
+ * vars: 0-terminated array of variables (long int) to project solutions on,
+ * limit: maximum number of solutions to enumerate, 0 for no limit,
+ * solution_func: called for each solution with a 0-terminated array of literals (long int) of vars,
+ *   enumeration is stopped if it returns false.
+ * assumptions: 0-terminated array of literals (long int) added as unit clauses or NULL,
+ * other arguments as for base_cnf_solve. Each solution is excluded by a clause containing only
+ * the inverted literals of vars, that is only appended to the written cnf file like the assumptions.
+ * returns the number of enumerated solutions or -1 on errors. */
+long int base_cnf_enumerate_solutions (BaseCNF cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                       const long int *assumptions, const long int *vars, unsigned long int limit, BaseCNFSolutionFunc solution_func, gpointer user_data);
+/* minimize the n_objectives objectives of cnf in lexicographic order without modifying cnf by linear SAT-UNSAT search:
+ * a generalized totalizer over the literals of an objective is built once with the cost of the first model as
+ * limit, then each improved model only adds unit clauses fixing the totalizer outputs above its cost minus one
+ * to false until no model is found. The optimal cost is kept by unit clauses while minimizing the next objectives.
+ * All these clauses are only appended to the written cnf file.
+ * assumptions: 0-terminated array of literals (long int) added as unit clauses or NULL,
+ * timeout: time budget in seconds for all solver runs (0: no limit), the best model found so far is kept,
+ * costs: set to the costs of the best model per objective.
+ * The best model becomes the solution of cnf, NULL if not satisfiable or no model has been found in time.
+ * *optimal is set to true if the search has been completed. other arguments as for base_cnf_solve.
+ * returns false on errors. */
+bool base_cnf_optimize (BaseCNF cnf, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                        const long int *assumptions, const struct base_cnf_objective *objectives, unsigned int n_objectives,
+                        double timeout, long int *costs, bool *optimal);
+/* write cnf with assumptions (0-terminated array of literals (long int) or NULL) as hard clauses and the n_soft
+ * literals soft_lits as soft unit clauses with weights soft_weights to file_name in WCNF format of the MaxSAT
+ * evaluations ("h" lines for hard clauses). XOR constraints and lazy constraints are written as clauses.
+ * returns true on success. */
+bool base_cnf_write_wcnf (BaseCNF cnf, const char *file_name, const long int *assumptions,
+                          const long int *soft_lits, const long int *soft_weights, unsigned int n_soft);
+/* enable preprocessing before solving with given options or disable it if options is NULL.
+ * solving works on a preprocessed copy, the clauses of cnf are not modified and
+ * solutions are extended to all variables. enumeration of solutions is not preprocessed. */
+void base_cnf_set_preprocess (BaseCNF cnf, const struct sat_preprocess_options *options);
+/* enable or disable simplification of clauses on insertion by assignments implied by
+ * unit clauses and propagated through binary clauses. satisfied clauses are dropped and
+ * false literals are removed, solving is skipped if an empty clause is derived. */
+void base_cnf_set_unit_simplification (BaseCNF cnf, bool enable);
+/* enable or disable solving variable-disjoint components of cnf by concurrent solver runs
+ * whose solutions are merged. n_threads: number of concurrent runs (0: number of processors),
+ * min_vars: components with less variables are solved together by one run.
+ * splitting is not applied when preprocessing is enabled or solutions are enumerated. */
+void base_cnf_set_split_components (BaseCNF cnf, bool enable, unsigned int n_threads, unsigned long int min_vars);
+/* enable or disable adding lex-leader symmetry-breaking clauses for symmetries of cnf (including assumptions)
+ * found before solving. Solutions stay valid, but symmetric solutions are excluded.
+ * max_vertices: symmetry search is skipped if number of literals + clauses is greater,
+ * max_generators: maximum number of symmetry generators to break.
+ * symmetries are not broken when preprocessing is enabled or components are split. */
+void base_cnf_set_symmetry_breaking (BaseCNF cnf, bool enable, unsigned long int max_vertices, unsigned int max_generators);
+/* enable or disable renumbering before solving: variables without clauses are left out, the others
+ * are numbered by breadth-first search over clauses (Cuthill-McKee) and clauses are sorted by their
+ * variables. Solutions are mapped back with unused variables assigned false.
+ * not applied when preprocessing is enabled or components are split. */
+void base_cnf_set_renumber (BaseCNF cnf, bool enable);
+/* configure handling of XOR constraints on solving: they are written as native "x" lines for XOR-aware
+ * solvers if native is true, otherwise as clauses by splitting them into chains of XORs with at most
+ * cut literals (at least 3) connected by auxiliary variables. Before solving, Gauss-Jordan elimination
+ * over the XOR constraints and unit clauses adds implied units and equivalences as clauses, it is skipped
+ * if the matrix would need more than gauss_max_bits bits (0: disabled). */
+void base_cnf_set_xor (BaseCNF cnf, bool native, unsigned int cut, unsigned long int gauss_max_bits);
+/* stop each solver run of cnf after given number of seconds (0: no limit), the run is treated as error */
+void base_cnf_set_solver_timeout (BaseCNF cnf, double seconds);
+/* return true if a solver run of cnf has been stopped by the timeout since it was last set */
+bool base_cnf_solver_timed_out (BaseCNF cnf);
+/* verify model given as GSList of literals as (long int) against all clauses and XOR constraints of cnf
+ * and return NULL if all of them are satisfied. Otherwise a copy of the first violated constraint is returned
+ * as 0-terminated array of literals as (long int) freed with g_free, *is_xor is set if it is an XOR constraint.
+ * The model is bit-packed and large problems are checked by n_threads concurrent jobs (0: number of processors). */
+long int * base_cnf_verify_model (BaseCNF cnf, GSList *model, unsigned int n_threads, bool *is_xor);
 /* make current solution of cnf invalid to optain another one on next solving */
 void base_cnf_cancel_solution (BaseCNF cnf);
 
 /* return internal clauses of cnf as GQueue of 0-terminated arrays of literals as (long int).
  * returned GQueue should not be modified */
 GQueue * base_cnf_clauses (BaseCNF cnf);
+/* return XOR constraints of cnf as GQueue of 0-terminated arrays of literals as (long int) whose exclusive
+ * or is true. returned GQueue should not be modified */
+GQueue * base_cnf_xors (BaseCNF cnf);
+/* append the clauses of all lazy constraints of cnf to clauses (GQueue of 0-terminated arrays of literals
+ * (long int) allocated by g_slice) and return their number */
+unsigned long int base_cnf_append_lazy_clauses (BaseCNF cnf, GQueue *clauses);
 /* return solution (if satisfiable) or NULL if not or not yet solved as GSList of literals as (long int).
  * returned GSList should not be modified. */
 GSList * base_cnf_solution (BaseCNF cnf);
+/* return number of clauses in cnf */
+unsigned long int base_cnf_num_clauses (BaseCNF cnf);
+/* return number of XOR constraints in cnf */
+unsigned long int base_cnf_num_xors (BaseCNF cnf);
+/* return number of lazy constraints in cnf */
+unsigned long int base_cnf_num_lazy (BaseCNF cnf);
+/* return number of clauses of the lazy constraints in cnf */
+unsigned long int base_cnf_num_lazy_clauses (BaseCNF cnf);
+/* return greatest variable number used in clauses of cnf */
+unsigned long int base_cnf_max_var (BaseCNF cnf);
 
 #endif
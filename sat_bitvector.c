@@ -0,0 +1,708 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sat_bitvector.h"
+
+#include <string.h>
+
+/* smaller operands of Karatsuba multipliers are multiplied by Wallace trees */
+#define SAT_BITVECTOR_KARATSUBA_MIN_BITS 16
+
+/* names of operations indexed by SatBitvectorOp */
+static const char * const sat_bitvector_op_names[] = {
+    "add",
+    "sub",
+    "mul",
+    "and",
+    "or",
+    "xor",
+    "not",
+    "shl",
+    "lshr",
+    "ashr",
+    "eq",
+    "ne",
+    "ult",
+    "ule",
+    "ugt",
+    "uge",
+    "slt",
+    "sle",
+    "sgt",
+    "sge",
+    NULL
+};
+
+/* names of multipliers indexed by SatBitvectorMultiplier */
+static const char * const sat_bitvector_multiplier_names[] = {
+    "array",
+    "wallace",
+    "karatsuba",
+    NULL
+};
+
+/* destination of generated clauses */
+struct sat_bitvector_out {
+    /* GQueue of clauses or NULL for counting only */
+    GQueue            *clauses;
+    unsigned long int n_clauses;
+    unsigned long int *next_var;
+};
+
+/* set *op to the operation with given name (e.g. "add") and return true, false for unknown names */
+bool sat_bitvector_op_from_string (const char *name, SatBitvectorOp *op)
+{
+    if (name == NULL) return false;
+
+    for (int i = 0; sat_bitvector_op_names[i] != NULL; i++) {
+        if (strcmp (name, sat_bitvector_op_names[i]) == 0) {
+            if (op != NULL) *op = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* return name of operation */
+const char * sat_bitvector_op_name (SatBitvectorOp op)
+{
+    if (op > SAT_BITVECTOR_SGE) return NULL;
+    return sat_bitvector_op_names[op];
+}
+
+/* return number of operands of operation */
+unsigned int sat_bitvector_op_arity (SatBitvectorOp op)
+{
+    return (op == SAT_BITVECTOR_NOT ? 1 : 2);
+}
+
+/* return true for predicates (comparisons), whose result is a single bit */
+bool sat_bitvector_op_is_predicate (SatBitvectorOp op)
+{
+    return (op >= SAT_BITVECTOR_EQ);
+}
+
+/* return true for operations interpreting their operands as signed */
+bool sat_bitvector_op_is_signed (SatBitvectorOp op)
+{
+    return ((op == SAT_BITVECTOR_ASHR) || (op >= SAT_BITVECTOR_SLT));
+}
+
+/* set *multiplier to the multiplier with given name (e.g. "wallace") and return true, false for unknown names */
+bool sat_bitvector_multiplier_from_string (const char *name, SatBitvectorMultiplier *multiplier)
+{
+    if (name == NULL) return false;
+
+    for (int i = 0; sat_bitvector_multiplier_names[i] != NULL; i++) {
+        if (strcmp (name, sat_bitvector_multiplier_names[i]) == 0) {
+            if (multiplier != NULL) *multiplier = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* return true if bit is constant */
+static inline bool sat_bitvector_is_const (long int bit)
+{
+    return ((bit == SAT_BITVECTOR_TRUE) || (bit == SAT_BITVECTOR_FALSE));
+}
+
+/* append clause of len literals to out: clauses with a true constant are left out, false constants are removed */
+static void sat_bitvector_clause (struct sat_bitvector_out *out, const long int *lits, unsigned int len)
+{
+    unsigned int n_lits = 0;
+    for (unsigned int i = 0; i < len; i++) {
+        if (lits[i] == SAT_BITVECTOR_TRUE) return;
+        if (lits[i] != SAT_BITVECTOR_FALSE) n_lits++;
+    }
+
+    out->n_clauses++;
+    if (out->clauses == NULL) return;
+
+    long int *clause = g_slice_alloc (sizeof (long int) * (n_lits + 1));
+    n_lits = 0;
+    for (unsigned int i = 0; i < len; i++) {
+        if (lits[i] != SAT_BITVECTOR_FALSE) clause[n_lits++] = lits[i];
+    }
+    clause[n_lits] = 0;
+
+    g_queue_push_tail (out->clauses, clause);
+}
+
+/* append clause of literals a, b, c and d to out, 0 literals are left out */
+static void sat_bitvector_clause4 (struct sat_bitvector_out *out, long int a, long int b, long int c, long int d)
+{
+    long int clause[4] = {0, 0, 0, 0};
+    unsigned int len = 0;
+
+    if (a != 0) clause[len++] = a;
+    if (b != 0) clause[len++] = b;
+    if (c != 0) clause[len++] = c;
+    if (d != 0) clause[len++] = d;
+
+    sat_bitvector_clause (out, clause, len);
+}
+
+/* return a new auxiliary variable */
+static inline long int sat_bitvector_new_var (struct sat_bitvector_out *out)
+{
+    long int var = *(out->next_var);
+    (*(out->next_var))++;
+    return var;
+}
+
+/* return literal equivalent to a and b */
+static long int sat_bitvector_and (struct sat_bitvector_out *out, long int a, long int b)
+{
+    if ((a == SAT_BITVECTOR_FALSE) || (b == SAT_BITVECTOR_FALSE) || (a == -b)) return SAT_BITVECTOR_FALSE;
+    if (a == SAT_BITVECTOR_TRUE) return b;
+    if ((b == SAT_BITVECTOR_TRUE) || (a == b)) return a;
+
+    long int g = sat_bitvector_new_var (out);
+    sat_bitvector_clause4 (out, -g, a, 0, 0);
+    sat_bitvector_clause4 (out, -g, b, 0, 0);
+    sat_bitvector_clause4 (out, g, -a, -b, 0);
+
+    return g;
+}
+
+/* return literal equivalent to a or b */
+static long int sat_bitvector_or (struct sat_bitvector_out *out, long int a, long int b)
+{
+    return -sat_bitvector_and (out, -a, -b);
+}
+
+/* return literal equivalent to a xor b */
+static long int sat_bitvector_xor (struct sat_bitvector_out *out, long int a, long int b)
+{
+    if (a == SAT_BITVECTOR_FALSE) return b;
+    if (a == SAT_BITVECTOR_TRUE)  return -b;
+    if (b == SAT_BITVECTOR_FALSE) return a;
+    if (b == SAT_BITVECTOR_TRUE)  return -a;
+    if (a == b)  return SAT_BITVECTOR_FALSE;
+    if (a == -b) return SAT_BITVECTOR_TRUE;
+
+    long int g = sat_bitvector_new_var (out);
+    sat_bitvector_clause4 (out, -g, -a, -b, 0);
+    sat_bitvector_clause4 (out, -g, a, b, 0);
+    sat_bitvector_clause4 (out, g, -a, b, 0);
+    sat_bitvector_clause4 (out, g, a, -b, 0);
+
+    return g;
+}
+
+/* return literal equivalent to a xor b xor c (sum of a full adder) */
+static long int sat_bitvector_xor3 (struct sat_bitvector_out *out, long int a, long int b, long int c)
+{
+    long int va = (a > 0 ? a : -a);
+    long int vb = (b > 0 ? b : -b);
+    long int vc = (c > 0 ? c : -c);
+
+    if (sat_bitvector_is_const (a) || sat_bitvector_is_const (b) || sat_bitvector_is_const (c) ||
+        (va == vb) || (va == vc) || (vb == vc)) {
+        return sat_bitvector_xor (out, sat_bitvector_xor (out, a, b), c);
+    }
+
+    /* one clause per assignment of a, b and c forcing g to its parity */
+    long int g = sat_bitvector_new_var (out);
+    for (int pattern = 0; pattern < 8; pattern++) {
+        bool pa = ((pattern & 1) != 0);
+        bool pb = ((pattern & 2) != 0);
+        bool pc = ((pattern & 4) != 0);
+        bool parity = (pa != pb) != pc;
+
+        sat_bitvector_clause4 (out, (pa ? -a : a), (pb ? -b : b), (pc ? -c : c), (parity ? g : -g));
+    }
+
+    return g;
+}
+
+/* return literal equivalent to the majority of a, b and c (carry of a full adder) */
+static long int sat_bitvector_maj (struct sat_bitvector_out *out, long int a, long int b, long int c)
+{
+    if (a == SAT_BITVECTOR_TRUE)  return sat_bitvector_or  (out, b, c);
+    if (a == SAT_BITVECTOR_FALSE) return sat_bitvector_and (out, b, c);
+    if (b == SAT_BITVECTOR_TRUE)  return sat_bitvector_or  (out, a, c);
+    if (b == SAT_BITVECTOR_FALSE) return sat_bitvector_and (out, a, c);
+    if (c == SAT_BITVECTOR_TRUE)  return sat_bitvector_or  (out, a, b);
+    if (c == SAT_BITVECTOR_FALSE) return sat_bitvector_and (out, a, b);
+
+    if ((a == b) || (a == c)) return a;
+    if (b == c)  return b;
+    if (a == -b) return c;
+    if (a == -c) return b;
+    if (b == -c) return a;
+
+    long int g = sat_bitvector_new_var (out);
+    sat_bitvector_clause4 (out, -a, -b, g, 0);
+    sat_bitvector_clause4 (out, -a, -c, g, 0);
+    sat_bitvector_clause4 (out, -b, -c, g, 0);
+    sat_bitvector_clause4 (out, a, b, -g, 0);
+    sat_bitvector_clause4 (out, a, c, -g, 0);
+    sat_bitvector_clause4 (out, b, c, -g, 0);
+
+    return g;
+}
+
+/* return literal equivalent to (s ? t : e) */
+static long int sat_bitvector_mux (struct sat_bitvector_out *out, long int s, long int t, long int e)
+{
+    if (s == SAT_BITVECTOR_TRUE)  return t;
+    if (s == SAT_BITVECTOR_FALSE) return e;
+    if (t == e)  return t;
+    if (t == -e) return -sat_bitvector_xor (out, s, t);
+
+    if (t == SAT_BITVECTOR_TRUE)  return sat_bitvector_or  (out, s, e);
+    if (t == SAT_BITVECTOR_FALSE) return sat_bitvector_and (out, -s, e);
+    if (e == SAT_BITVECTOR_TRUE)  return sat_bitvector_or  (out, -s, t);
+    if (e == SAT_BITVECTOR_FALSE) return sat_bitvector_and (out, s, t);
+
+    if (s == t)  return sat_bitvector_or  (out, s, e);
+    if (s == -t) return sat_bitvector_and (out, -s, e);
+    if (s == e)  return sat_bitvector_and (out, s, t);
+    if (s == -e) return sat_bitvector_or  (out, -s, t);
+
+    long int g = sat_bitvector_new_var (out);
+    sat_bitvector_clause4 (out, -s, -t, g, 0);
+    sat_bitvector_clause4 (out, -s, t, -g, 0);
+    sat_bitvector_clause4 (out, s, -e, g, 0);
+    sat_bitvector_clause4 (out, s, e, -g, 0);
+    /* redundant, but propagate equal inputs */
+    sat_bitvector_clause4 (out, -t, -e, g, 0);
+    sat_bitvector_clause4 (out, t, e, -g, 0);
+
+    return g;
+}
+
+/* return literal equivalent to the conjunction of the n literals lits */
+static long int sat_bitvector_and_n (struct sat_bitvector_out *out, const long int *lits, unsigned int n)
+{
+    long int *inputs = g_new (long int, n + 1);
+    unsigned int n_inputs = 0;
+
+    for (unsigned int i = 0; i < n; i++) {
+        if (lits[i] == SAT_BITVECTOR_FALSE) {
+            g_free (inputs);
+            return SAT_BITVECTOR_FALSE;
+        }
+        if (lits[i] != SAT_BITVECTOR_TRUE) inputs[n_inputs++] = lits[i];
+    }
+
+    long int result;
+    if (n_inputs == 0) {
+        result = SAT_BITVECTOR_TRUE;
+    } else if (n_inputs == 1) {
+        result = inputs[0];
+    } else {
+        result = sat_bitvector_new_var (out);
+        for (unsigned int i = 0; i < n_inputs; i++) {
+            sat_bitvector_clause4 (out, -result, inputs[i], 0, 0);
+            inputs[i] = -inputs[i];
+        }
+        inputs[n_inputs] = result;
+        sat_bitvector_clause (out, inputs, n_inputs + 1);
+    }
+
+    g_free (inputs);
+    return result;
+}
+
+/* ripple-carry adder: sum = a + b + carry over width bits, *carry_out is set to the carry of the most
+ * significant bit if not NULL */
+static void sat_bitvector_adder (struct sat_bitvector_out *out, const long int *a, const long int *b, long int carry,
+                                 unsigned int width, long int *sum, long int *carry_out)
+{
+    for (unsigned int i = 0; i < width; i++) {
+        long int bit_sum = sat_bitvector_xor3 (out, a[i], b[i], carry);
+        if ((i + 1 < width) || (carry_out != NULL)) carry = sat_bitvector_maj (out, a[i], b[i], carry);
+        sum[i] = bit_sum;
+    }
+
+    if (carry_out != NULL) *carry_out = carry;
+}
+
+/* subtractor: diff = a - b = a + ~b + 1 over width bits */
+static void sat_bitvector_subtractor (struct sat_bitvector_out *out, const long int *a, const long int *b,
+                                      unsigned int width, long int *diff)
+{
+    long int *b_inv = g_new (long int, width + 1);
+    for (unsigned int i = 0; i < width; i++) b_inv[i] = -b[i];
+
+    sat_bitvector_adder (out, a, b_inv, SAT_BITVECTOR_TRUE, width, diff, NULL);
+
+    g_free (b_inv);
+}
+
+/* array multiplier: lower width bits of product of a (na bits) and b (nb bits),
+ * each row of partial products is added to the accumulated sum */
+static void sat_bitvector_mul_array (struct sat_bitvector_out *out, const long int *a, unsigned int na, const long int *b, unsigned int nb,
+                                     long int *product, unsigned int width)
+{
+    long int *row = g_new (long int, width + 1);
+
+    for (unsigned int i = 0; i < width; i++) product[i] = SAT_BITVECTOR_FALSE;
+
+    for (unsigned int i = 0; (i < nb) && (i < width); i++) {
+        for (unsigned int col = i; col < width; col++) {
+            unsigned int j = col - i;
+            row[col - i] = (j < na ? sat_bitvector_and (out, a[j], b[i]) : SAT_BITVECTOR_FALSE);
+        }
+        sat_bitvector_adder (out, &(product[i]), row, SAT_BITVECTOR_FALSE, width - i, &(product[i]), NULL);
+    }
+
+    g_free (row);
+}
+
+/* Wallace tree multiplier: lower width bits of product of a (na bits) and b (nb bits),
+ * columns of partial products are reduced by full adders to two rows added by a ripple-carry adder */
+static void sat_bitvector_mul_wallace (struct sat_bitvector_out *out, const long int *a, unsigned int na, const long int *b, unsigned int nb,
+                                       long int *product, unsigned int width)
+{
+    GArray **columns = g_new (GArray *, width + 1);
+    for (unsigned int col = 0; col < width; col++) columns[col] = g_array_new (false, false, sizeof (long int));
+
+    for (unsigned int i = 0; i < nb; i++) {
+        for (unsigned int j = 0; (j < na) && (i + j < width); j++) {
+            long int bit = sat_bitvector_and (out, a[j], b[i]);
+            if (bit != SAT_BITVECTOR_FALSE) g_array_append_val (columns[i + j], bit);
+        }
+    }
+
+    /* reduce columns to at most 2 bits */
+    bool reduce = true;
+    while (reduce) {
+        reduce = false;
+
+        GArray **next_columns = g_new (GArray *, width + 1);
+        for (unsigned int col = 0; col < width; col++) next_columns[col] = g_array_new (false, false, sizeof (long int));
+
+        for (unsigned int col = 0; col < width; col++) {
+            GArray *bits = columns[col];
+            guint i = 0;
+
+            for (; i + 3 <= bits->len; i += 3) {
+                long int x = g_array_index (bits, long int, i);
+                long int y = g_array_index (bits, long int, i + 1);
+                long int z = g_array_index (bits, long int, i + 2);
+
+                long int bit_sum = sat_bitvector_xor3 (out, x, y, z);
+                g_array_append_val (next_columns[col], bit_sum);
+                if (col + 1 < width) {
+                    long int carry = sat_bitvector_maj (out, x, y, z);
+                    g_array_append_val (next_columns[col + 1], carry);
+                }
+            }
+            for (; i < bits->len; i++) {
+                g_array_append_val (next_columns[col], g_array_index (bits, long int, i));
+            }
+        }
+
+        for (unsigned int col = 0; col < width; col++) {
+            g_array_free (columns[col], true);
+            if (next_columns[col]->len > 2) reduce = true;
+        }
+        g_free (columns);
+        columns = next_columns;
+    }
+
+    long int *x = g_new (long int, width + 1);
+    long int *y = g_new (long int, width + 1);
+    for (unsigned int col = 0; col < width; col++) {
+        x[col] = (columns[col]->len > 0 ? g_array_index (columns[col], long int, 0) : SAT_BITVECTOR_FALSE);
+        y[col] = (columns[col]->len > 1 ? g_array_index (columns[col], long int, 1) : SAT_BITVECTOR_FALSE);
+        g_array_free (columns[col], true);
+    }
+    g_free (columns);
+
+    sat_bitvector_adder (out, x, y, SAT_BITVECTOR_FALSE, width, product, NULL);
+
+    g_free (x);
+    g_free (y);
+}
+
+/* full product of a (na bits) and b (nb bits) with na + nb bits. Karatsuba multipliers split both operands
+ * at h bits: a * b = z2 * 2^(2h) + (z1 - z2 - z0) * 2^h + z0 with z0 = a0 * b0, z2 = a1 * b1 and
+ * z1 = (a0 + a1) * (b0 + b1), all other products use Wallace trees. */
+static void sat_bitvector_mul_full (struct sat_bitvector_out *out, SatBitvectorMultiplier multiplier,
+                                    const long int *a, unsigned int na, const long int *b, unsigned int nb, long int *product)
+{
+    unsigned int n = na + nb;
+    unsigned int h = (na > nb ? na : nb) / 2;
+
+    if ((multiplier != SAT_BITVECTOR_MUL_KARATSUBA) ||
+        (na < SAT_BITVECTOR_KARATSUBA_MIN_BITS) || (nb < SAT_BITVECTOR_KARATSUBA_MIN_BITS) || (h >= na) || (h >= nb)) {
+        if (multiplier == SAT_BITVECTOR_MUL_ARRAY) {
+            sat_bitvector_mul_array (out, a, na, b, nb, product, n);
+        } else {
+            sat_bitvector_mul_wallace (out, a, na, b, nb, product, n);
+        }
+        return;
+    }
+
+    unsigned int na1 = na - h;
+    unsigned int nb1 = nb - h;
+
+    /* z0 = a0 * b0, z2 = a1 * b1 */
+    long int *z0 = g_new (long int, 2 * h + 1);
+    long int *z2 = g_new (long int, na1 + nb1 + 1);
+    sat_bitvector_mul_full (out, multiplier, a, h, b, h, z0);
+    sat_bitvector_mul_full (out, multiplier, &(a[h]), na1, &(b[h]), nb1, z2);
+
+    /* sums of halves with one more bit */
+    unsigned int ns_a = (na1 > h ? na1 : h) + 1;
+    unsigned int ns_b = (nb1 > h ? nb1 : h) + 1;
+    unsigned int ns   = (ns_a > ns_b ? ns_a : ns_b);
+
+    long int *x     = g_new (long int, ns + 1);
+    long int *y     = g_new (long int, ns + 1);
+    long int *sum_a = g_new (long int, ns + 1);
+    long int *sum_b = g_new (long int, ns + 1);
+
+    for (unsigned int i = 0; i < ns_a; i++) {
+        x[i] = (i < h   ? a[i]     : SAT_BITVECTOR_FALSE);
+        y[i] = (i < na1 ? a[h + i] : SAT_BITVECTOR_FALSE);
+    }
+    sat_bitvector_adder (out, x, y, SAT_BITVECTOR_FALSE, ns_a, sum_a, NULL);
+
+    for (unsigned int i = 0; i < ns_b; i++) {
+        x[i] = (i < h   ? b[i]     : SAT_BITVECTOR_FALSE);
+        y[i] = (i < nb1 ? b[h + i] : SAT_BITVECTOR_FALSE);
+    }
+    sat_bitvector_adder (out, x, y, SAT_BITVECTOR_FALSE, ns_b, sum_b, NULL);
+
+    long int *z1 = g_new (long int, ns_a + ns_b + 1);
+    sat_bitvector_mul_full (out, multiplier, sum_a, ns_a, sum_b, ns_b, z1);
+
+    /* upper n - h bits: (z0 >> h) + (z1 - z0 - z2) + (z2 << h), modulo 2^(n - h) as the product fits */
+    unsigned int nu = n - h;
+    long int *m     = g_new (long int, nu + 1);
+    long int *t     = g_new (long int, nu + 1);
+
+    for (unsigned int i = 0; i < nu; i++) {
+        m[i] = (i < ns_a + ns_b ? z1[i] : SAT_BITVECTOR_FALSE);
+        t[i] = (i < 2 * h ? z0[i] : SAT_BITVECTOR_FALSE);
+    }
+    sat_bitvector_subtractor (out, m, t, nu, m);
+
+    for (unsigned int i = 0; i < nu; i++) t[i] = (i < na1 + nb1 ? z2[i] : SAT_BITVECTOR_FALSE);
+    sat_bitvector_subtractor (out, m, t, nu, m);
+
+    for (unsigned int i = 0; i < nu; i++) t[i] = (i + h < 2 * h ? z0[i + h] : SAT_BITVECTOR_FALSE);
+    sat_bitvector_adder (out, m, t, SAT_BITVECTOR_FALSE, nu, m, NULL);
+
+    for (unsigned int i = 0; i < nu; i++) t[i] = ((i >= h) && (i - h < na1 + nb1) ? z2[i - h] : SAT_BITVECTOR_FALSE);
+    sat_bitvector_adder (out, m, t, SAT_BITVECTOR_FALSE, nu, m, NULL);
+
+    for (unsigned int i = 0; i < h; i++)  product[i]     = z0[i];
+    for (unsigned int i = 0; i < nu; i++) product[h + i] = m[i];
+
+    g_free (z0);
+    g_free (z1);
+    g_free (z2);
+    g_free (x);
+    g_free (y);
+    g_free (sum_a);
+    g_free (sum_b);
+    g_free (m);
+    g_free (t);
+}
+
+/* return literal for a < b (strict) or a <= b (unsigned) over width bits:
+ * from the least significant bit on, a differing bit decides, otherwise the lower bits */
+static long int sat_bitvector_less (struct sat_bitvector_out *out, const long int *a, const long int *b, unsigned int width, bool strict)
+{
+    long int less = (strict ? SAT_BITVECTOR_FALSE : SAT_BITVECTOR_TRUE);
+
+    for (unsigned int i = 0; i < width; i++) {
+        less = sat_bitvector_maj (out, -a[i], b[i], less);
+    }
+
+    return less;
+}
+
+/* return literal for a == b over width bits */
+static long int sat_bitvector_equal (struct sat_bitvector_out *out, const long int *a, const long int *b, unsigned int width)
+{
+    long int *same = g_new (long int, width + 1);
+    for (unsigned int i = 0; i < width; i++) same[i] = -sat_bitvector_xor (out, a[i], b[i]);
+
+    long int result = sat_bitvector_and_n (out, same, width);
+
+    g_free (same);
+    return result;
+}
+
+/* barrel shifter: result = a shifted by the b_width bits of b over width bits, left if left is true,
+ * right otherwise with fill bits of fill (constant false or sign bit) */
+static void sat_bitvector_shifter (struct sat_bitvector_out *out, const long int *a, const long int *b, unsigned int width,
+                                   unsigned int b_width, bool left, bool arithmetic, long int *result)
+{
+    long int *current = g_new (long int, width + 1);
+    long int *next    = g_new (long int, width + 1);
+    memcpy (current, a, sizeof (long int) * width);
+
+    for (unsigned int k = 0; k < b_width; k++) {
+        /* sign bit is kept by arithmetic shifts */
+        long int fill = (arithmetic ? current[width - 1] : SAT_BITVECTOR_FALSE);
+        bool shift_all = ((k >= 32) || ((1UL << k) >= width));
+        unsigned int distance = (shift_all ? width : (1U << k));
+
+        for (unsigned int i = 0; i < width; i++) {
+            long int shifted;
+            if (left) {
+                shifted = (i >= distance ? current[i - distance] : SAT_BITVECTOR_FALSE);
+            } else {
+                shifted = (i + distance < width ? current[i + distance] : fill);
+            }
+            next[i] = sat_bitvector_mux (out, b[k], shifted, current[i]);
+        }
+
+        long int *temp = current;
+        current = next;
+        next    = temp;
+    }
+
+    memcpy (result, current, sizeof (long int) * width);
+
+    g_free (current);
+    g_free (next);
+}
+
+/* append clauses computing op applied to a and b, see header for details */
+unsigned long int sat_bitvector_append (SatBitvectorOp op, SatBitvectorMultiplier multiplier, const long int *a, const long int *b,
+                                        unsigned int width, unsigned int b_width, long int *result,
+                                        unsigned long int *next_var, GQueue *clauses)
+{
+    struct sat_bitvector_out out;
+    out.clauses   = clauses;
+    out.n_clauses = 0;
+    out.next_var  = next_var;
+
+    if (width == 0) {
+        if (sat_bitvector_op_is_predicate (op)) {
+            bool is_true = ((op == SAT_BITVECTOR_EQ) || (op == SAT_BITVECTOR_ULE) || (op == SAT_BITVECTOR_UGE) ||
+                            (op == SAT_BITVECTOR_SLE) || (op == SAT_BITVECTOR_SGE));
+            result[0] = (is_true ? SAT_BITVECTOR_TRUE : SAT_BITVECTOR_FALSE);
+        }
+        return 0;
+    }
+
+    /* signed comparison: unsigned comparison with inverted sign bits */
+    long int *a_cmp = NULL;
+    long int *b_cmp = NULL;
+    if (sat_bitvector_op_is_predicate (op)) {
+        a_cmp = g_new (long int, width + 1);
+        b_cmp = g_new (long int, width + 1);
+        memcpy (a_cmp, a, sizeof (long int) * width);
+        memcpy (b_cmp, b, sizeof (long int) * width);
+        if (sat_bitvector_op_is_signed (op)) {
+            a_cmp[width - 1] = -a_cmp[width - 1];
+            b_cmp[width - 1] = -b_cmp[width - 1];
+        }
+    }
+
+    switch (op) {
+        case SAT_BITVECTOR_ADD:
+            sat_bitvector_adder (&out, a, b, SAT_BITVECTOR_FALSE, width, result, NULL);
+            break;
+        case SAT_BITVECTOR_SUB:
+            sat_bitvector_subtractor (&out, a, b, width, result);
+            break;
+        case SAT_BITVECTOR_MUL:
+            if (multiplier == SAT_BITVECTOR_MUL_KARATSUBA) {
+                long int *full = g_new (long int, 2 * width + 1);
+                sat_bitvector_mul_full (&out, multiplier, a, width, b, width, full);
+                memcpy (result, full, sizeof (long int) * width);
+                g_free (full);
+            } else if (multiplier == SAT_BITVECTOR_MUL_ARRAY) {
+                sat_bitvector_mul_array (&out, a, width, b, width, result, width);
+            } else {
+                sat_bitvector_mul_wallace (&out, a, width, b, width, result, width);
+            }
+            break;
+        case SAT_BITVECTOR_AND:
+            for (unsigned int i = 0; i < width; i++) result[i] = sat_bitvector_and (&out, a[i], b[i]);
+            break;
+        case SAT_BITVECTOR_OR:
+            for (unsigned int i = 0; i < width; i++) result[i] = sat_bitvector_or (&out, a[i], b[i]);
+            break;
+        case SAT_BITVECTOR_XOR:
+            for (unsigned int i = 0; i < width; i++) result[i] = sat_bitvector_xor (&out, a[i], b[i]);
+            break;
+        case SAT_BITVECTOR_NOT:
+            for (unsigned int i = 0; i < width; i++) result[i] = -a[i];
+            break;
+        case SAT_BITVECTOR_SHL:
+            sat_bitvector_shifter (&out, a, b, width, b_width, true, false, result);
+            break;
+        case SAT_BITVECTOR_LSHR:
+            sat_bitvector_shifter (&out, a, b, width, b_width, false, false, result);
+            break;
+        case SAT_BITVECTOR_ASHR:
+            sat_bitvector_shifter (&out, a, b, width, b_width, false, true, result);
+            break;
+        case SAT_BITVECTOR_EQ:
+            result[0] = sat_bitvector_equal (&out, a_cmp, b_cmp, width);
+            break;
+        case SAT_BITVECTOR_NE:
+            result[0] = -sat_bitvector_equal (&out, a_cmp, b_cmp, width);
+            break;
+        case SAT_BITVECTOR_ULT:
+        case SAT_BITVECTOR_SLT:
+            result[0] = sat_bitvector_less (&out, a_cmp, b_cmp, width, true);
+            break;
+        case SAT_BITVECTOR_ULE:
+        case SAT_BITVECTOR_SLE:
+            result[0] = sat_bitvector_less (&out, a_cmp, b_cmp, width, false);
+            break;
+        case SAT_BITVECTOR_UGT:
+        case SAT_BITVECTOR_SGT:
+            result[0] = sat_bitvector_less (&out, b_cmp, a_cmp, width, true);
+            break;
+        case SAT_BITVECTOR_UGE:
+        case SAT_BITVECTOR_SGE:
+            result[0] = sat_bitvector_less (&out, b_cmp, a_cmp, width, false);
+            break;
+    }
+
+    g_free (a_cmp);
+    g_free (b_cmp);
+
+    return out.n_clauses;
+}
+
+/* append clauses for a[i] == b[i] for the n bits of a and b to clauses and return their number. */
+unsigned long int sat_bitvector_append_equal (const long int *a, const long int *b, unsigned int n, GQueue *clauses)
+{
+    struct sat_bitvector_out out;
+    out.clauses   = clauses;
+    out.n_clauses = 0;
+    out.next_var  = NULL;
+
+    for (unsigned int i = 0; i < n; i++) {
+        if (a[i] == b[i]) continue;
+
+        sat_bitvector_clause4 (&out, -a[i], b[i], 0, 0);
+        sat_bitvector_clause4 (&out, a[i], -b[i], 0, 0);
+    }
+
+    return out.n_clauses;
+}
@@ -0,0 +1,100 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __sat_bitvector_h__
+#define __sat_bitvector_h__
+
+#include <stdbool.h>
+#include <glib.h>
+
+/* constant bits of operands and results, they never appear in generated clauses */
+#define SAT_BITVECTOR_TRUE  (G_MAXLONG)
+#define SAT_BITVECTOR_FALSE (-G_MAXLONG)
+
+/* operations on bit-vectors (two's complement, least significant bit first) */
+enum sat_bitvector_op_t {
+    /* arithmetic modulo 2^width */
+    SAT_BITVECTOR_ADD,
+    SAT_BITVECTOR_SUB,
+    SAT_BITVECTOR_MUL,
+    /* bitwise */
+    SAT_BITVECTOR_AND,
+    SAT_BITVECTOR_OR,
+    SAT_BITVECTOR_XOR,
+    SAT_BITVECTOR_NOT,
+    /* shift of first operand by second operand bits */
+    SAT_BITVECTOR_SHL,
+    SAT_BITVECTOR_LSHR,
+    SAT_BITVECTOR_ASHR,
+    /* predicates with a single result bit */
+    SAT_BITVECTOR_EQ,
+    SAT_BITVECTOR_NE,
+    SAT_BITVECTOR_ULT,
+    SAT_BITVECTOR_ULE,
+    SAT_BITVECTOR_UGT,
+    SAT_BITVECTOR_UGE,
+    SAT_BITVECTOR_SLT,
+    SAT_BITVECTOR_SLE,
+    SAT_BITVECTOR_SGT,
+    SAT_BITVECTOR_SGE
+};
+
+typedef enum sat_bitvector_op_t SatBitvectorOp;
+
+/* circuits for multiplication */
+enum sat_bitvector_multiplier_t {
+    /* rows of partial products added by ripple-carry adders */
+    SAT_BITVECTOR_MUL_ARRAY,
+    /* columns of partial products reduced by full adders, final ripple-carry adder */
+    SAT_BITVECTOR_MUL_WALLACE,
+    /* operands split in halves recursively with three products of the halves (Karatsuba),
+     * small products by Wallace tree */
+    SAT_BITVECTOR_MUL_KARATSUBA
+};
+
+typedef enum sat_bitvector_multiplier_t SatBitvectorMultiplier;
+
+/* set *op to the operation with given name (e.g. "add") and return true, false for unknown names */
+bool sat_bitvector_op_from_string (const char *name, SatBitvectorOp *op);
+/* return name of operation */
+const char * sat_bitvector_op_name (SatBitvectorOp op);
+/* return number of operands of operation */
+unsigned int sat_bitvector_op_arity (SatBitvectorOp op);
+/* return true for predicates (comparisons), whose result is a single bit */
+bool sat_bitvector_op_is_predicate (SatBitvectorOp op);
+/* return true for operations interpreting their operands as signed */
+bool sat_bitvector_op_is_signed (SatBitvectorOp op);
+
+/* set *multiplier to the multiplier with given name (e.g. "wallace") and return true, false for unknown names */
+bool sat_bitvector_multiplier_from_string (const char *name, SatBitvectorMultiplier *multiplier);
+
+/* append clauses computing op applied to a and b to clauses (GQueue of 0-terminated arrays of literals (long int)
+ * allocated by g_slice) and return their number. If clauses is NULL, clauses are only counted.
+ * a: width bits, b: width bits or b_width bits of the shift amount for shifts (unused for not),
+ * result: set to width output literals or a single one for predicates.
+ * bits are literals or SAT_BITVECTOR_TRUE/FALSE, gates with constant inputs are simplified, so results may be
+ * constants or input literals. Auxiliary variables are numbered from *next_var on, which is incremented accordingly. */
+unsigned long int sat_bitvector_append (SatBitvectorOp op, SatBitvectorMultiplier multiplier, const long int *a, const long int *b,
+                                        unsigned int width, unsigned int b_width, long int *result,
+                                        unsigned long int *next_var, GQueue *clauses);
+
+/* append clauses for a[i] == b[i] for the n bits of a and b to clauses (see sat_bitvector_append)
+ * and return their number. */
+unsigned long int sat_bitvector_append_equal (const long int *a, const long int *b, unsigned int n, GQueue *clauses);
+
+#endif
@@ -0,0 +1,718 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sat_cardinality.h"
+
+#include <string.h>
+
+/* names of encodings indexed by SatCardinalityEncoding */
+static const char * const sat_cardinality_names[] = {
+    "auto",
+    "direct",
+    "seqcounter",
+    "totalizer",
+    "modtotalizer",
+    "cardnetwork",
+    "sortnetwork",
+    "commander",
+    "product",
+    "binary",
+    "ladder",
+    NULL
+};
+
+/* destination of generated clauses */
+struct sat_cardinality_out {
+    /* GQueue of clauses or NULL for counting only */
+    GQueue            *clauses;
+    unsigned long int n_clauses;
+    unsigned long int *next_var;
+    /* comparators define outputs in both directions */
+    bool              exact;
+};
+
+/* set *encoding to the encoding with given name (e.g. "totalizer") and return true, false for unknown names */
+bool sat_cardinality_encoding_from_string (const char *name, SatCardinalityEncoding *encoding)
+{
+    if (name == NULL) return false;
+
+    for (int i = 0; sat_cardinality_names[i] != NULL; i++) {
+        if (strcmp (name, sat_cardinality_names[i]) == 0) {
+            if (encoding != NULL) *encoding = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* return name of encoding */
+const char * sat_cardinality_encoding_name (SatCardinalityEncoding encoding)
+{
+    if (encoding > SAT_CARDINALITY_LADDER) return NULL;
+    return sat_cardinality_names[encoding];
+}
+
+/* append clause of len literals to out */
+static void sat_cardinality_clause (struct sat_cardinality_out *out, const long int *lits, unsigned int len)
+{
+    out->n_clauses++;
+    if (out->clauses == NULL) return;
+
+    long int *clause = g_slice_alloc (sizeof (long int) * (len + 1));
+    if (len > 0) memcpy (clause, lits, sizeof (long int) * len);
+    clause[len] = 0;
+
+    g_queue_push_tail (out->clauses, clause);
+}
+
+/* append clause of literals a, b and c to out, 0 literals are left out */
+static void sat_cardinality_clause3 (struct sat_cardinality_out *out, long int a, long int b, long int c)
+{
+    long int clause[3];
+    unsigned int len = 0;
+
+    if (a != 0) clause[len++] = a;
+    if (b != 0) clause[len++] = b;
+    if (c != 0) clause[len++] = c;
+
+    sat_cardinality_clause (out, clause, len);
+}
+
+/* return a new auxiliary variable */
+static inline long int sat_cardinality_new_var (struct sat_cardinality_out *out)
+{
+    long int var = *(out->next_var);
+    (*(out->next_var))++;
+    return var;
+}
+
+/* direct encoding: one clause of negated literals per subset of k + 1 literals in lexicographic order */
+static void sat_cardinality_direct (struct sat_cardinality_out *out, const long int *lits, unsigned int n, unsigned int k)
+{
+    unsigned int size = k + 1;
+
+    unsigned int *index = g_new (unsigned int, size);
+    long int *clause    = g_new (long int, size);
+
+    for (unsigned int i = 0; i < size; i++) index[i] = i;
+
+    while (true) {
+        for (unsigned int i = 0; i < size; i++) clause[i] = -lits[index[i]];
+        sat_cardinality_clause (out, clause, size);
+
+        /* next subset */
+        int i = size - 1;
+        while ((i >= 0) && (index[i] == n - size + i)) i--;
+        if (i < 0) break;
+
+        index[i]++;
+        for (unsigned int j = i + 1; j < size; j++) index[j] = index[j - 1] + 1;
+    }
+
+    g_free (index);
+    g_free (clause);
+}
+
+/* sequential counter: register variable s(i, j) is true if at least j + 1 of the first i + 1 literals are true */
+static void sat_cardinality_sequential_counter (struct sat_cardinality_out *out, const long int *lits, unsigned int n, unsigned int k)
+{
+    long int *s = g_new (long int, (gsize) (n - 1) * k);
+#define SAT_CARDINALITY_S(i, j) (s[(gsize) (i) * k + (j)])
+
+    for (unsigned int i = 0; i < n - 1; i++) {
+        for (unsigned int j = 0; j < k; j++) {
+            SAT_CARDINALITY_S (i, j) = sat_cardinality_new_var (out);
+        }
+    }
+
+    sat_cardinality_clause3 (out, -lits[0], SAT_CARDINALITY_S (0, 0), 0);
+    for (unsigned int j = 1; j < k; j++) {
+        sat_cardinality_clause3 (out, -SAT_CARDINALITY_S (0, j), 0, 0);
+    }
+
+    for (unsigned int i = 1; i < n - 1; i++) {
+        sat_cardinality_clause3 (out, -lits[i], SAT_CARDINALITY_S (i, 0), 0);
+        sat_cardinality_clause3 (out, -SAT_CARDINALITY_S (i - 1, 0), SAT_CARDINALITY_S (i, 0), 0);
+        for (unsigned int j = 1; j < k; j++) {
+            sat_cardinality_clause3 (out, -lits[i], -SAT_CARDINALITY_S (i - 1, j - 1), SAT_CARDINALITY_S (i, j));
+            sat_cardinality_clause3 (out, -SAT_CARDINALITY_S (i - 1, j), SAT_CARDINALITY_S (i, j), 0);
+        }
+        sat_cardinality_clause3 (out, -lits[i], -SAT_CARDINALITY_S (i - 1, k - 1), 0);
+    }
+
+    sat_cardinality_clause3 (out, -lits[n - 1], -SAT_CARDINALITY_S (n - 2, k - 1), 0);
+
+#undef SAT_CARDINALITY_S
+    g_free (s);
+}
+
+/* totalizer over n literals: append unary count outputs (long int) limited to cap to outputs,
+ * output i is true if at least i + 1 literals are true */
+static void sat_cardinality_totalizer_node (struct sat_cardinality_out *out, const long int *lits, unsigned int n, unsigned int cap, GArray *outputs)
+{
+    if (n == 1) {
+        g_array_append_val (outputs, lits[0]);
+        return;
+    }
+
+    GArray *left  = g_array_new (false, false, sizeof (long int));
+    GArray *right = g_array_new (false, false, sizeof (long int));
+
+    sat_cardinality_totalizer_node (out, lits, n / 2, cap, left);
+    sat_cardinality_totalizer_node (out, lits + n / 2, n - n / 2, cap, right);
+
+    unsigned int width = MIN (left->len + right->len, cap);
+    guint first = outputs->len;
+    for (unsigned int i = 0; i < width; i++) {
+        long int var = sat_cardinality_new_var (out);
+        g_array_append_val (outputs, var);
+    }
+
+    for (unsigned int i = 0; i <= left->len; i++) {
+        for (unsigned int j = 0; j <= right->len; j++) {
+            if ((i + j == 0) || (i + j > width)) continue;
+
+            long int a = (i > 0 ? -g_array_index (left, long int, i - 1) : 0);
+            long int b = (j > 0 ? -g_array_index (right, long int, j - 1) : 0);
+            sat_cardinality_clause3 (out, a, b, g_array_index (outputs, long int, first + i + j - 1));
+        }
+    }
+
+    g_array_free (left, true);
+    g_array_free (right, true);
+}
+
+/* totalizer: at most k true, the output for k + 1 is forbidden */
+static void sat_cardinality_totalizer (struct sat_cardinality_out *out, const long int *lits, unsigned int n, unsigned int k)
+{
+    GArray *outputs = g_array_new (false, false, sizeof (long int));
+
+    sat_cardinality_totalizer_node (out, lits, n, k + 1, outputs);
+    sat_cardinality_clause3 (out, -g_array_index (outputs, long int, k), 0, 0);
+
+    g_array_free (outputs, true);
+}
+
+/* modulo totalizer over n literals with count represented by lower digit (count mod p) and upper digit
+ * (count / p) both in unary, upper digit limited to max_upper. Lower output i is true if the lower digit
+ * is at least i + 1, upper output respectively. */
+static void sat_cardinality_modulo_node (struct sat_cardinality_out *out, const long int *lits, unsigned int n,
+                                         unsigned int p, unsigned int max_upper, GArray *lower, GArray *upper)
+{
+    if (n == 1) {
+        g_array_append_val (lower, lits[0]);
+        return;
+    }
+
+    GArray *lower_a = g_array_new (false, false, sizeof (long int));
+    GArray *upper_a = g_array_new (false, false, sizeof (long int));
+    GArray *lower_b = g_array_new (false, false, sizeof (long int));
+    GArray *upper_b = g_array_new (false, false, sizeof (long int));
+
+    sat_cardinality_modulo_node (out, lits, n / 2, p, max_upper, lower_a, upper_a);
+    sat_cardinality_modulo_node (out, lits + n / 2, n - n / 2, p, max_upper, lower_b, upper_b);
+
+    unsigned int lower_width = MIN (n, p - 1);
+    unsigned int upper_width = MIN (n / p, max_upper);
+
+    for (unsigned int i = 0; i < lower_width; i++) {
+        long int var = sat_cardinality_new_var (out);
+        g_array_append_val (lower, var);
+    }
+    for (unsigned int i = 0; i < upper_width; i++) {
+        long int var = sat_cardinality_new_var (out);
+        g_array_append_val (upper, var);
+    }
+
+    /* carry: lower digits sum up to p or more */
+    long int carry = 0;
+    if (lower_a->len + lower_b->len >= p) carry = sat_cardinality_new_var (out);
+
+    for (unsigned int i = 0; i <= lower_a->len; i++) {
+        for (unsigned int j = 0; j <= lower_b->len; j++) {
+            if (i + j == 0) continue;
+
+            long int a = (i > 0 ? -g_array_index (lower_a, long int, i - 1) : 0);
+            long int b = (j > 0 ? -g_array_index (lower_b, long int, j - 1) : 0);
+
+            if (i + j < p) {
+                long int clause[4];
+                unsigned int len = 0;
+                if (a != 0) clause[len++] = a;
+                if (b != 0) clause[len++] = b;
+                if (carry != 0) clause[len++] = carry;
+                clause[len++] = g_array_index (lower, long int, i + j - 1);
+                sat_cardinality_clause (out, clause, len);
+            } else {
+                sat_cardinality_clause3 (out, a, b, carry);
+                if (i + j > p) {
+                    sat_cardinality_clause3 (out, a, b, g_array_index (lower, long int, i + j - p - 1));
+                }
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i <= upper_a->len; i++) {
+        for (unsigned int j = 0; j <= upper_b->len; j++) {
+            long int a = (i > 0 ? -g_array_index (upper_a, long int, i - 1) : 0);
+            long int b = (j > 0 ? -g_array_index (upper_b, long int, j - 1) : 0);
+
+            unsigned int target = MIN (i + j, max_upper);
+            if ((target > 0) && (target <= upper_width)) {
+                sat_cardinality_clause3 (out, a, b, g_array_index (upper, long int, target - 1));
+            }
+
+            if (carry == 0) continue;
+
+            /* a carry exceeding the upper digits of this node is impossible */
+            target = MIN (i + j + 1, max_upper);
+            long int clause[4];
+            unsigned int len = 0;
+            if (a != 0) clause[len++] = a;
+            if (b != 0) clause[len++] = b;
+            clause[len++] = -carry;
+            if (target <= upper_width) clause[len++] = g_array_index (upper, long int, target - 1);
+            sat_cardinality_clause (out, clause, len);
+        }
+    }
+
+    g_array_free (lower_a, true);
+    g_array_free (upper_a, true);
+    g_array_free (lower_b, true);
+    g_array_free (upper_b, true);
+}
+
+/* modulo totalizer: at most k true with modulo p about square root of k + 1 = q * p + r */
+static void sat_cardinality_modulo_totalizer (struct sat_cardinality_out *out, const long int *lits, unsigned int n, unsigned int k)
+{
+    unsigned int p = 2;
+    while (p * p < k + 1) p++;
+
+    unsigned int q = (k + 1) / p;
+    unsigned int r = (k + 1) % p;
+
+    GArray *lower = g_array_new (false, false, sizeof (long int));
+    GArray *upper = g_array_new (false, false, sizeof (long int));
+
+    sat_cardinality_modulo_node (out, lits, n, p, q + 1, lower, upper);
+
+    if (r == 0) {
+        /* upper digit at least q */
+        if (q <= upper->len) sat_cardinality_clause3 (out, -g_array_index (upper, long int, q - 1), 0, 0);
+    } else {
+        /* upper digit at least q + 1 or upper digit at least q and lower digit at least r */
+        if (q + 1 <= upper->len) sat_cardinality_clause3 (out, -g_array_index (upper, long int, q), 0, 0);
+        if (r <= lower->len) {
+            if (q == 0) {
+                sat_cardinality_clause3 (out, -g_array_index (lower, long int, r - 1), 0, 0);
+            } else if (q <= upper->len) {
+                sat_cardinality_clause3 (out, -g_array_index (upper, long int, q - 1), -g_array_index (lower, long int, r - 1), 0);
+            }
+        }
+    }
+
+    g_array_free (lower, true);
+    g_array_free (upper, true);
+}
+
+/* comparator of a and b: *max = a or b, *min = a and b, outputs are only generated if requested */
+static void sat_cardinality_comparator (struct sat_cardinality_out *out, long int a, long int b, long int *max, long int *min)
+{
+    if (max != NULL) {
+        *max = sat_cardinality_new_var (out);
+        sat_cardinality_clause3 (out, -a, *max, 0);
+        sat_cardinality_clause3 (out, -b, *max, 0);
+        if (out->exact) sat_cardinality_clause3 (out, a, b, -*max);
+    }
+    if (min != NULL) {
+        *min = sat_cardinality_new_var (out);
+        sat_cardinality_clause3 (out, -a, -b, *min);
+        if (out->exact) {
+            sat_cardinality_clause3 (out, a, -*min, 0);
+            sat_cardinality_clause3 (out, b, -*min, 0);
+        }
+    }
+}
+
+/* odd-even merge of sorted sequences a (na literals) and b (nb literals) with true literals first,
+ * the first cap outputs are appended to result */
+static void sat_cardinality_merge (struct sat_cardinality_out *out, const long int *a, unsigned int na,
+                                   const long int *b, unsigned int nb, unsigned int cap, GArray *result)
+{
+    if (cap == 0) return;
+
+    if ((na == 0) || (nb == 0)) {
+        const long int *c = (na == 0 ? b : a);
+        unsigned int nc   = MIN (na + nb, cap);
+        g_array_append_vals (result, c, nc);
+        return;
+    }
+
+    if ((na == 1) && (nb == 1)) {
+        long int max;
+        long int min;
+        sat_cardinality_comparator (out, a[0], b[0], &max, (cap >= 2 ? &min : NULL));
+        g_array_append_val (result, max);
+        if (cap >= 2) g_array_append_val (result, min);
+        return;
+    }
+
+    /* even and odd positions of both sequences */
+    long int *a_even = g_new (long int, na);
+    long int *a_odd  = a_even + (na + 1) / 2;
+    long int *b_even = g_new (long int, nb);
+    long int *b_odd  = b_even + (nb + 1) / 2;
+
+    for (unsigned int i = 0; i < na; i++) {
+        if ((i % 2) == 0) a_even[i / 2] = a[i]; else a_odd[i / 2] = a[i];
+    }
+    for (unsigned int i = 0; i < nb; i++) {
+        if ((i % 2) == 0) b_even[i / 2] = b[i]; else b_odd[i / 2] = b[i];
+    }
+
+    GArray *v = g_array_new (false, false, sizeof (long int));
+    GArray *w = g_array_new (false, false, sizeof (long int));
+
+    sat_cardinality_merge (out, a_even, (na + 1) / 2, b_even, (nb + 1) / 2, cap / 2 + 1, v);
+    sat_cardinality_merge (out, a_odd, na / 2, b_odd, nb / 2, cap / 2, w);
+
+    unsigned int nv = (na + 1) / 2 + (nb + 1) / 2;
+    unsigned int nw = na / 2 + nb / 2;
+
+    guint first = result->len;
+    g_array_append_val (result, g_array_index (v, long int, 0));
+
+    for (unsigned int i = 0; result->len - first < cap; i++) {
+        bool have_w = (i < nw);
+        bool have_v = (i + 1 < nv);
+
+        if (have_w && have_v) {
+            long int max;
+            long int min;
+            bool need_min = (result->len - first + 1 < cap);
+            sat_cardinality_comparator (out, g_array_index (w, long int, i), g_array_index (v, long int, i + 1),
+                                        &max, (need_min ? &min : NULL));
+            g_array_append_val (result, max);
+            if (need_min) g_array_append_val (result, min);
+        } else if (have_w) {
+            g_array_append_val (result, g_array_index (w, long int, i));
+        } else if (have_v) {
+            g_array_append_val (result, g_array_index (v, long int, i + 1));
+        } else {
+            break;
+        }
+    }
+
+    g_array_free (v, true);
+    g_array_free (w, true);
+    g_free (a_even);
+    g_free (b_even);
+}
+
+/* odd-even merge sort of n literals, the first cap outputs are appended to result */
+static void sat_cardinality_sort (struct sat_cardinality_out *out, const long int *lits, unsigned int n, unsigned int cap, GArray *result)
+{
+    if (n <= 1) {
+        if ((n == 1) && (cap > 0)) g_array_append_val (result, lits[0]);
+        return;
+    }
+
+    GArray *left  = g_array_new (false, false, sizeof (long int));
+    GArray *right = g_array_new (false, false, sizeof (long int));
+
+    sat_cardinality_sort (out, lits, n / 2, cap, left);
+    sat_cardinality_sort (out, lits + n / 2, n - n / 2, cap, right);
+
+    sat_cardinality_merge (out, (long int *) left->data, left->len, (long int *) right->data, right->len, cap, result);
+
+    g_array_free (left, true);
+    g_array_free (right, true);
+}
+
+/* sorting network limited to cap outputs: at most k true, output k + 1 is forbidden */
+static void sat_cardinality_network (struct sat_cardinality_out *out, const long int *lits, unsigned int n, unsigned int k, unsigned int cap)
+{
+    GArray *outputs = g_array_new (false, false, sizeof (long int));
+
+    sat_cardinality_sort (out, lits, n, cap, outputs);
+    sat_cardinality_clause3 (out, -g_array_index (outputs, long int, k), 0, 0);
+
+    g_array_free (outputs, true);
+}
+
+/* at most one of the n literals lits in pairs */
+static void sat_cardinality_pairwise (struct sat_cardinality_out *out, const long int *lits, unsigned int n)
+{
+    for (unsigned int i = 0; i < n; i++) {
+        for (unsigned int j = i + 1; j < n; j++) {
+            sat_cardinality_clause3 (out, -lits[i], -lits[j], 0);
+        }
+    }
+}
+
+/* commander encoding (Klieber, Kwon): groups of SAT_CARDINALITY_COMMANDER_GROUP literals are encoded
+ * pairwise, each literal implies the commander variable of its group, at most one commander recursively */
+#define SAT_CARDINALITY_COMMANDER_GROUP 3
+static void sat_cardinality_commander (struct sat_cardinality_out *out, const long int *lits, unsigned int n)
+{
+    if (n <= SAT_CARDINALITY_COMMANDER_GROUP + 1) {
+        sat_cardinality_pairwise (out, lits, n);
+        return;
+    }
+
+    unsigned int n_groups = (n + SAT_CARDINALITY_COMMANDER_GROUP - 1) / SAT_CARDINALITY_COMMANDER_GROUP;
+    long int *commanders  = g_new (long int, n_groups);
+
+    for (unsigned int g = 0; g < n_groups; g++) {
+        unsigned int first = g * SAT_CARDINALITY_COMMANDER_GROUP;
+        unsigned int size  = MIN (SAT_CARDINALITY_COMMANDER_GROUP, n - first);
+
+        commanders[g] = sat_cardinality_new_var (out);
+
+        sat_cardinality_pairwise (out, &(lits[first]), size);
+        for (unsigned int i = first; i < first + size; i++) {
+            sat_cardinality_clause3 (out, -lits[i], commanders[g], 0);
+        }
+    }
+
+    sat_cardinality_commander (out, commanders, n_groups);
+
+    g_free (commanders);
+}
+
+/* product encoding (Chen): literals are arranged in a p x q grid, each literal implies its row and
+ * column variable, at most one row and column recursively */
+static void sat_cardinality_product (struct sat_cardinality_out *out, const long int *lits, unsigned int n)
+{
+    if (n <= 4) {
+        sat_cardinality_pairwise (out, lits, n);
+        return;
+    }
+
+    unsigned int p = 1;
+    while (p * p < n) p++;
+    unsigned int q = (n + p - 1) / p;
+
+    long int *rows = g_new (long int, p + q);
+    long int *cols = &(rows[p]);
+
+    for (unsigned int i = 0; i < p; i++) rows[i] = sat_cardinality_new_var (out);
+    for (unsigned int j = 0; j < q; j++) cols[j] = sat_cardinality_new_var (out);
+
+    for (unsigned int i = 0; i < n; i++) {
+        sat_cardinality_clause3 (out, -lits[i], rows[i / q], 0);
+        sat_cardinality_clause3 (out, -lits[i], cols[i % q], 0);
+    }
+
+    sat_cardinality_product (out, rows, p);
+    sat_cardinality_product (out, cols, q);
+
+    g_free (rows);
+}
+
+/* binary encoding (Frisch et al.): literal i implies the bits of the binary representation of i */
+static void sat_cardinality_binary (struct sat_cardinality_out *out, const long int *lits, unsigned int n)
+{
+    unsigned int n_bits = 0;
+    while ((1UL << n_bits) < n) n_bits++;
+
+    long int *bits = g_new (long int, n_bits);
+    for (unsigned int b = 0; b < n_bits; b++) bits[b] = sat_cardinality_new_var (out);
+
+    for (unsigned int i = 0; i < n; i++) {
+        for (unsigned int b = 0; b < n_bits; b++) {
+            sat_cardinality_clause3 (out, -lits[i], (((i >> b) & 1) ? bits[b] : -bits[b]), 0);
+        }
+    }
+
+    g_free (bits);
+}
+
+/* ladder encoding (Gent, Nightingale): ladder variables y(i) with y(i + 1) -> y(i),
+ * literal i implies y(i - 1) and -y(i), so all literals after a true one are false */
+static void sat_cardinality_ladder (struct sat_cardinality_out *out, const long int *lits, unsigned int n)
+{
+    long int *y = g_new (long int, n - 1);
+    for (unsigned int i = 0; i < n - 1; i++) y[i] = sat_cardinality_new_var (out);
+
+    for (unsigned int i = 0; i + 2 < n; i++) {
+        sat_cardinality_clause3 (out, -y[i + 1], y[i], 0);
+    }
+    for (unsigned int i = 0; i < n; i++) {
+        if (i > 0)     sat_cardinality_clause3 (out, -lits[i], y[i - 1], 0);
+        if (i < n - 1) sat_cardinality_clause3 (out, -lits[i], -y[i], 0);
+    }
+
+    g_free (y);
+}
+
+/* encode at most k of n literals lits with 0 < k < n and given encoding (not auto),
+ * at most one encodings (commander ... ladder) require k = 1 */
+static void sat_cardinality_atmost (struct sat_cardinality_out *out, SatCardinalityEncoding encoding, const long int *lits, unsigned int n, unsigned int k)
+{
+    switch (encoding) {
+        case SAT_CARDINALITY_DIRECT:
+            sat_cardinality_direct (out, lits, n, k);
+            break;
+        case SAT_CARDINALITY_SEQUENTIAL_COUNTER:
+            sat_cardinality_sequential_counter (out, lits, n, k);
+            break;
+        case SAT_CARDINALITY_TOTALIZER:
+            sat_cardinality_totalizer (out, lits, n, k);
+            break;
+        case SAT_CARDINALITY_MODULO_TOTALIZER:
+            sat_cardinality_modulo_totalizer (out, lits, n, k);
+            break;
+        case SAT_CARDINALITY_CARDINALITY_NETWORK:
+            sat_cardinality_network (out, lits, n, k, k + 1);
+            break;
+        case SAT_CARDINALITY_COMMANDER:
+            sat_cardinality_commander (out, lits, n);
+            break;
+        case SAT_CARDINALITY_PRODUCT:
+            sat_cardinality_product (out, lits, n);
+            break;
+        case SAT_CARDINALITY_BINARY:
+            sat_cardinality_binary (out, lits, n);
+            break;
+        case SAT_CARDINALITY_LADDER:
+            sat_cardinality_ladder (out, lits, n);
+            break;
+        case SAT_CARDINALITY_SORTING_NETWORK:
+        default:
+            sat_cardinality_network (out, lits, n, k, n);
+            break;
+    }
+}
+
+/* return number of subsets of size k of n elements, saturated at limit */
+static unsigned long int sat_cardinality_binomial (unsigned int n, unsigned int k, unsigned long int limit)
+{
+    if (k > n - k) k = n - k;
+
+    unsigned long int result = 1;
+    for (unsigned int i = 1; i <= k; i++) {
+        /* intermediate results are increasing binomial coefficients */
+        if (result > G_MAXULONG / (n - k + i)) return limit;
+        result = result * (n - k + i) / i;
+        if (result >= limit) return limit;
+    }
+
+    return result;
+}
+
+/* return the encoding of at most k of n literals with least clauses + 2 * auxiliary variables */
+SatCardinalityEncoding sat_cardinality_choose (unsigned int n, unsigned int k)
+{
+    if ((k == 0) || (k >= n)) return SAT_CARDINALITY_DIRECT;
+
+    long int *lits = g_new (long int, n);
+    for (unsigned int i = 0; i < n; i++) lits[i] = i + 1;
+
+    SatCardinalityEncoding best = SAT_CARDINALITY_SEQUENTIAL_COUNTER;
+    unsigned long int best_cost = G_MAXULONG;
+
+    SatCardinalityEncoding last = (k == 1 ? SAT_CARDINALITY_LADDER : SAT_CARDINALITY_CARDINALITY_NETWORK);
+
+    for (SatCardinalityEncoding encoding = SAT_CARDINALITY_SEQUENTIAL_COUNTER; encoding <= last; encoding++) {
+        /* sorting network is never smaller than cardinality network */
+        if (encoding == SAT_CARDINALITY_SORTING_NETWORK) continue;
+
+        unsigned long int next_var = n + 1;
+        struct sat_cardinality_out out = {NULL, 0, &next_var, false};
+
+        sat_cardinality_atmost (&out, encoding, lits, n, k);
+
+        unsigned long int cost = out.n_clauses + 2 * (next_var - n - 1);
+        if (cost < best_cost) {
+            best      = encoding;
+            best_cost = cost;
+        }
+    }
+
+    g_free (lits);
+
+    /* direct encoding if not larger */
+    if (sat_cardinality_binomial (n, k + 1, best_cost + 1) <= best_cost) return SAT_CARDINALITY_DIRECT;
+
+    return best;
+}
+
+/* encode at most k of n literals lits with k < n, encoding auto or an at most one encoding for k > 1
+ * is replaced by the chosen encoding */
+static void sat_cardinality_bound (struct sat_cardinality_out *out, SatCardinalityEncoding encoding, const long int *lits, unsigned int n, unsigned int k)
+{
+    if (k == 0) {
+        for (unsigned int i = 0; i < n; i++) sat_cardinality_clause3 (out, -lits[i], 0, 0);
+    } else if (k == n - 1) {
+        /* single clause */
+        sat_cardinality_direct (out, lits, n, k);
+    } else {
+        if ((encoding == SAT_CARDINALITY_AUTO) || ((encoding >= SAT_CARDINALITY_COMMANDER) && (k > 1))) {
+            encoding = sat_cardinality_choose (n, k);
+        }
+        sat_cardinality_atmost (out, encoding, lits, n, k);
+    }
+}
+
+/* append clauses for at least min and at most max of the n literals lits being true to clauses (GQueue of
+ * 0-terminated arrays of literals (long int) allocated by g_slice) and return their number. If clauses is NULL,
+ * clauses are only counted. At least min is encoded as at most n - min of the negated literals.
+ * Auxiliary variables are numbered from *next_var on, which is incremented accordingly.
+ * Counters and networks only propagate from literals to outputs, which suffices for the bounds. */
+unsigned long int sat_cardinality_append (SatCardinalityEncoding encoding, const long int *lits, unsigned int n,
+                                          unsigned int min, unsigned int max, unsigned long int *next_var, GQueue *clauses)
+{
+    struct sat_cardinality_out out = {clauses, 0, next_var, false};
+
+    if ((min > n) || (min > max)) {
+        sat_cardinality_clause (&out, NULL, 0);
+        return out.n_clauses;
+    }
+
+    /* at least min: at most n - min false */
+    if (min > 0) {
+        long int *neg_lits = g_new (long int, n);
+        for (unsigned int i = 0; i < n; i++) neg_lits[i] = -lits[i];
+
+        sat_cardinality_bound (&out, encoding, neg_lits, n, n - min);
+
+        g_free (neg_lits);
+    }
+
+    /* at most max */
+    if (max < n) {
+        sat_cardinality_bound (&out, encoding, lits, n, max);
+    }
+
+    return out.n_clauses;
+}
+
+/* append clauses of an odd-even merge sorting network of the n literals lits to clauses (see
+ * sat_cardinality_append) and its n outputs (long int) to outputs and return the number of clauses.
+ * Output i is equivalent to at least i + 1 of the literals being true. */
+unsigned long int sat_cardinality_append_sorter (const long int *lits, unsigned int n, GArray *outputs,
+                                                 unsigned long int *next_var, GQueue *clauses)
+{
+    struct sat_cardinality_out out = {clauses, 0, next_var, true};
+
+    sat_cardinality_sort (&out, lits, n, n, outputs);
+
+    return out.n_clauses;
+}
@@ -0,0 +1,77 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __sat_cardinality_h__
+#define __sat_cardinality_h__
+
+#include <stdbool.h>
+#include <glib.h>
+
+/* clause encodings of cardinality constraints */
+enum sat_cardinality_encoding_t {
+    /* choose encoding with least clauses and auxiliary variables */
+    SAT_CARDINALITY_AUTO,
+    /* one clause per subset of literals exceeding the bound, no auxiliary variables */
+    SAT_CARDINALITY_DIRECT,
+    /* sequential counter (Sinz) */
+    SAT_CARDINALITY_SEQUENTIAL_COUNTER,
+    /* totalizer (Bailleux, Boufkhad) */
+    SAT_CARDINALITY_TOTALIZER,
+    /* modulo totalizer (Ogawa et al.) */
+    SAT_CARDINALITY_MODULO_TOTALIZER,
+    /* cardinality network: odd-even merge sort pruned to bound + 1 outputs (Asin et al.) */
+    SAT_CARDINALITY_CARDINALITY_NETWORK,
+    /* full odd-even merge sorting network (Een, Soerensson) */
+    SAT_CARDINALITY_SORTING_NETWORK,
+    /* at most one encodings, bounds > 1 use the automatic choice */
+    /* commander variables of groups of 3 literals, recursively (Klieber, Kwon) */
+    SAT_CARDINALITY_COMMANDER,
+    /* row and column variables of a sqrt(n) x sqrt(n) grid, recursively (Chen) */
+    SAT_CARDINALITY_PRODUCT,
+    /* log2(n) bit variables selecting the true literal (Frisch et al.) */
+    SAT_CARDINALITY_BINARY,
+    /* n - 1 ladder variables (Gent, Nightingale) */
+    SAT_CARDINALITY_LADDER
+};
+
+typedef enum sat_cardinality_encoding_t SatCardinalityEncoding;
+
+/* set *encoding to the encoding with given name (e.g. "totalizer") and return true, false for unknown names */
+bool sat_cardinality_encoding_from_string (const char *name, SatCardinalityEncoding *encoding);
+/* return name of encoding */
+const char * sat_cardinality_encoding_name (SatCardinalityEncoding encoding);
+
+/* return the encoding of at most k of n literals with least clauses + 2 * auxiliary variables */
+SatCardinalityEncoding sat_cardinality_choose (unsigned int n, unsigned int k);
+
+/* append clauses for at least min and at most max of the n literals lits being true to clauses (GQueue of
+ * 0-terminated arrays of literals (long int) allocated by g_slice) and return their number. If clauses is NULL,
+ * clauses are only counted. At least min is encoded as at most n - min of the negated literals, bounds n - 1
+ * as single clause.
+ * Auxiliary variables are numbered from *next_var on, which is incremented accordingly.
+ * Counters and networks only propagate from literals to outputs, which suffices for the bounds. */
+unsigned long int sat_cardinality_append (SatCardinalityEncoding encoding, const long int *lits, unsigned int n,
+                                          unsigned int min, unsigned int max, unsigned long int *next_var, GQueue *clauses);
+
+/* append clauses of an odd-even merge sorting network of the n literals lits to clauses (see
+ * sat_cardinality_append) and its n outputs (long int) to outputs and return the number of clauses.
+ * Output i is equivalent to at least i + 1 of the literals being true. */
+unsigned long int sat_cardinality_append_sorter (const long int *lits, unsigned int n, GArray *outputs,
+                                                 unsigned long int *next_var, GQueue *clauses);
+
+#endif
@@ -0,0 +1,312 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sat_cube.h"
+
+/* lookahead data struct */
+struct sat_cube {
+    /* greatest variable */
+    unsigned long int max_var;
+
+    /* GPtrArray of clauses as 0-terminated arrays of literals (const long int *) */
+    GPtrArray *clauses;
+    /* occurrence lists indexed by literal index as GArray of clause indices (guint) */
+    GArray **occurrences;
+
+    /* value per variable: 0 unassigned, 1 true, -1 false */
+    signed char *value;
+    /* assigned literals (long int) in order of assignment */
+    GArray *trail;
+    /* index of next literal in trail to propagate */
+    guint  trail_head;
+
+    /* variables (long int) ordered by decreasing number of occurrences */
+    GArray *candidates;
+    unsigned int max_candidates;
+    unsigned int depth;
+
+    /* decisions and failed literals (long int) of current cube */
+    GArray *cube;
+    /* resulting cubes (long int *) */
+    GPtrArray *result;
+};
+
+/* return index of literal for occurrence lists */
+static inline guint sat_cube_lit_index (long int lit)
+{
+    return (lit > 0 ? 2 * lit : 2 * (-lit) + 1);
+}
+
+/* return value of literal: 0 unassigned, 1 true, -1 false */
+static inline int sat_cube_lit_value (struct sat_cube *sc, long int lit)
+{
+    int val = sc->value[lit > 0 ? lit : -lit];
+    return (lit > 0 ? val : -val);
+}
+
+/* assign literal without propagation */
+static void sat_cube_assign (struct sat_cube *sc, long int lit)
+{
+    sc->value[lit > 0 ? lit : -lit] = (lit > 0 ? 1 : -1);
+    g_array_append_val (sc->trail, lit);
+}
+
+/* unassign literals of trail back to length trail_len */
+static void sat_cube_undo (struct sat_cube *sc, guint trail_len)
+{
+    for (guint i = trail_len; i < sc->trail->len; i++) {
+        long int lit = g_array_index (sc->trail, long int, i);
+        sc->value[lit > 0 ? lit : -lit] = 0;
+    }
+    g_array_set_size (sc->trail, trail_len);
+    sc->trail_head = trail_len;
+}
+
+/* propagate assigned literals through clauses, returns false on conflict */
+static bool sat_cube_propagate (struct sat_cube *sc)
+{
+    while (sc->trail_head < sc->trail->len) {
+        long int lit = g_array_index (sc->trail, long int, sc->trail_head);
+        sc->trail_head++;
+
+        GArray *occ = sc->occurrences[sat_cube_lit_index (-lit)];
+
+        for (guint i = 0; i < occ->len; i++) {
+            const long int *clause = g_ptr_array_index (sc->clauses, g_array_index (occ, guint, i));
+
+            long int open_lit   = 0;
+            unsigned int n_open = 0;
+            bool satisfied      = false;
+
+            for (unsigned int j = 0; clause[j] != 0; j++) {
+                int val = sat_cube_lit_value (sc, clause[j]);
+                if (val > 0) {
+                    satisfied = true;
+                    break;
+                }
+                if (val == 0) {
+                    open_lit = clause[j];
+                    n_open++;
+                    if (n_open > 1) break;
+                }
+            }
+
+            if (satisfied || (n_open > 1)) continue;
+            if (n_open == 0) return false;
+
+            sat_cube_assign (sc, open_lit);
+        }
+    }
+
+    return true;
+}
+
+/* assign lit, propagate it and return number of implied assignments including lit or -1 on conflict.
+ * assignments are undone afterwards. */
+static long int sat_cube_probe (struct sat_cube *sc, long int lit)
+{
+    guint trail_len = sc->trail->len;
+
+    sat_cube_assign (sc, lit);
+    bool ok = sat_cube_propagate (sc);
+    long int result = sc->trail->len - trail_len;
+
+    sat_cube_undo (sc, trail_len);
+
+    return (ok ? result : -1);
+}
+
+/* add current cube to result */
+static void sat_cube_emit (struct sat_cube *sc)
+{
+    long int *cube = g_new (long int, sc->cube->len + 1);
+    for (guint i = 0; i < sc->cube->len; i++) {
+        cube[i] = g_array_index (sc->cube, long int, i);
+    }
+    cube[sc->cube->len] = 0;
+
+    g_ptr_array_add (sc->result, cube);
+}
+
+/* lookahead on candidates and branch on best variable up to depth, cubes are added to result.
+ * failed literals are assigned and added to the cube, the caller has to undo them. */
+static void sat_cube_branch (struct sat_cube *sc, unsigned int level)
+{
+    if (level >= sc->depth) {
+        sat_cube_emit (sc);
+        return;
+    }
+
+    long int best_var = 0;
+    bool failed       = true;
+
+    /* rescan if failed literals assigned the best variable */
+    while (failed) {
+        failed   = false;
+        best_var = 0;
+
+        unsigned long int best_score = 0;
+        unsigned int n_checked = 0;
+
+        for (guint i = 0; (i < sc->candidates->len) && (n_checked < sc->max_candidates); i++) {
+            long int var = g_array_index (sc->candidates, long int, i);
+            if (sc->value[var] != 0) continue;
+            n_checked++;
+
+            long int n_pos = sat_cube_probe (sc, var);
+            long int n_neg = sat_cube_probe (sc, -var);
+
+            if ((n_pos < 0) && (n_neg < 0)) return;
+
+            if ((n_pos < 0) || (n_neg < 0)) {
+                /* failed literal: the other value is implied */
+                long int lit = (n_pos < 0 ? -var : var);
+                sat_cube_assign (sc, lit);
+                g_array_append_val (sc->cube, lit);
+                if (!sat_cube_propagate (sc)) return;
+
+                failed = true;
+                continue;
+            }
+
+            unsigned long int score = n_pos * n_neg + n_pos + n_neg;
+            if (score > best_score) {
+                best_score = score;
+                best_var   = var;
+            }
+        }
+
+        if ((best_var != 0) && (sc->value[best_var] == 0)) failed = false;
+    }
+
+    if (best_var == 0) {
+        sat_cube_emit (sc);
+        return;
+    }
+
+    for (int sign = 1; sign >= -1; sign -= 2) {
+        long int lit = sign * best_var;
+
+        guint trail_len = sc->trail->len;
+        guint cube_len  = sc->cube->len;
+
+        sat_cube_assign (sc, lit);
+        g_array_append_val (sc->cube, lit);
+
+        if (sat_cube_propagate (sc)) sat_cube_branch (sc, level + 1);
+
+        sat_cube_undo (sc, trail_len);
+        g_array_set_size (sc->cube, cube_len);
+    }
+}
+
+/* compare variables (long int) by decreasing number of occurrences given in user_data (guint *) */
+static gint sat_cube_candidate_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const guint *n_occ = user_data;
+    long int var_a = *((const long int *) a);
+    long int var_b = *((const long int *) b);
+
+    if (n_occ[var_a] > n_occ[var_b]) return -1;
+    if (n_occ[var_a] < n_occ[var_b]) return 1;
+    return (var_a < var_b ? -1 : (var_a > var_b ? 1 : 0));
+}
+
+/* split clauses into cubes by lookahead and return them as GPtrArray of 0-terminated
+ * arrays of literals (long int), freed with the GPtrArray. */
+GPtrArray * sat_cube_generate (GQueue *clauses, const long int *assumptions, unsigned long int max_var,
+                               unsigned int depth, unsigned int max_candidates)
+{
+    if (clauses == NULL) return NULL;
+
+    struct sat_cube sc;
+
+    sc.max_var        = max_var;
+    sc.clauses        = g_ptr_array_new ();
+    sc.occurrences    = g_new (GArray *, 2 * (max_var + 1));
+    sc.value          = g_new0 (signed char, max_var + 1);
+    sc.trail          = g_array_new (false, false, sizeof (long int));
+    sc.trail_head     = 0;
+    sc.candidates     = g_array_new (false, false, sizeof (long int));
+    sc.max_candidates = (max_candidates > 0 ? max_candidates : 1);
+    sc.depth          = depth;
+    sc.cube           = g_array_new (false, false, sizeof (long int));
+    sc.result         = g_ptr_array_new_with_free_func (g_free);
+
+    for (unsigned long int i = 0; i < 2 * (max_var + 1); i++) {
+        sc.occurrences[i] = g_array_new (false, false, sizeof (guint));
+    }
+
+    guint *n_occ = g_new0 (guint, max_var + 1);
+    bool conflict = false;
+
+    for (GList *cl = clauses->head; cl != NULL; cl = cl->next) {
+        const long int *clause = cl->data;
+        guint index = sc.clauses->len;
+
+        g_ptr_array_add (sc.clauses, (gpointer) clause);
+
+        if (clause[0] == 0) conflict = true;
+
+        for (unsigned int j = 0; clause[j] != 0; j++) {
+            g_array_append_val (sc.occurrences[sat_cube_lit_index (clause[j])], index);
+            n_occ[clause[j] > 0 ? clause[j] : -clause[j]]++;
+        }
+    }
+
+    /* unit clauses and assumptions */
+    for (guint i = 0; (i < sc.clauses->len) && !conflict; i++) {
+        const long int *clause = g_ptr_array_index (sc.clauses, i);
+        if ((clause[0] == 0) || (clause[1] != 0)) continue;
+
+        int val = sat_cube_lit_value (&sc, clause[0]);
+        if (val < 0) conflict = true;
+        if (val == 0) sat_cube_assign (&sc, clause[0]);
+    }
+    for (unsigned int i = 0; (assumptions != NULL) && (assumptions[i] != 0) && !conflict; i++) {
+        int val = sat_cube_lit_value (&sc, assumptions[i]);
+        if (val < 0) conflict = true;
+        if (val == 0) sat_cube_assign (&sc, assumptions[i]);
+    }
+
+    if (!conflict) conflict = !sat_cube_propagate (&sc);
+
+    if (!conflict) {
+        for (unsigned long int var = 1; var <= max_var; var++) {
+            if (n_occ[var] == 0) continue;
+            long int l_var = var;
+            g_array_append_val (sc.candidates, l_var);
+        }
+        g_array_sort_with_data (sc.candidates, sat_cube_candidate_compare, n_occ);
+
+        sat_cube_branch (&sc, 0);
+    }
+
+    for (unsigned long int i = 0; i < 2 * (max_var + 1); i++) {
+        g_array_free (sc.occurrences[i], true);
+    }
+    g_free (sc.occurrences);
+    g_free (sc.value);
+    g_free (n_occ);
+    g_array_free (sc.trail, true);
+    g_array_free (sc.candidates, true);
+    g_array_free (sc.cube, true);
+    g_ptr_array_free (sc.clauses, true);
+
+    return sc.result;
+}
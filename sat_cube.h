@@ -0,0 +1,39 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __sat_cube_h__
+#define __sat_cube_h__
+
+#include <stdbool.h>
+#include <glib.h>
+
+/* split clauses into cubes by lookahead and return them as GPtrArray of 0-terminated
+ * arrays of literals (long int), freed with the GPtrArray. Every solution of the clauses
+ * satisfies one of the cubes. Branching variables are chosen among the max_candidates
+ * unassigned variables with most occurrences by the product of the number of assignments
+ * implied by both values. Failed literals are added to the cube, refuted cubes are dropped,
+ * so an empty result means unsatisfiable.
+ * clauses: GQueue of 0-terminated arrays of literals (long int), not modified,
+ * assumptions: 0-terminated array of literals (long int) assumed for all cubes or NULL,
+ *   they are not contained in the resulting cubes,
+ * max_var: greatest variable in clauses and assumptions,
+ * depth: maximum number of branching decisions per cube. */
+GPtrArray * sat_cube_generate (GQueue *clauses, const long int *assumptions, unsigned long int max_var,
+                               unsigned int depth, unsigned int max_candidates);
+
+#endif
@@ -698,3 +698,105 @@ static bool sat_formula_cnf_sorted_clause_is_subsummed (GQueue *sorted_clause_su
 
     return true;
 }
+
+/* return greatest variable of the given sat_formula tree */
+static long int sat_formula_max_var (struct sat_formula *formula)
+{
+    if (formula == NULL) return 0;
+
+    if (formula->tag == SAT_FORMULA_TAG_LITERAL) {
+        return (formula->literal > 0 ? formula->literal : -formula->literal);
+    }
+
+    long int left  = sat_formula_max_var (formula->left_operand);
+    long int right = sat_formula_max_var (formula->right_operand);
+
+    return (left > right ? left : right);
+}
+
+/* append operands of the xor/equal chain formula to the literals of xor, operands that are no literals
+ * are replaced by auxiliary variables numbered from *next_var on with defining clauses appended to
+ * the definitions of xor. returns the constant the exclusive or of the operands is inverted by. */
+static bool sat_formula_xor_collect (struct sat_formula *formula, struct sat_formula_xor *xor, long int *next_var)
+{
+    switch (formula->tag) {
+        case SAT_FORMULA_TAG_LITERAL:
+            g_queue_push_tail (xor->literals, GSIZE_TO_POINTER (formula->literal));
+            return false;
+
+        case SAT_FORMULA_TAG_INVERSION:
+            return !sat_formula_xor_collect (formula->left_operand, xor, next_var);
+
+        case SAT_FORMULA_TAG_OP_XOR:
+            return (sat_formula_xor_collect (formula->left_operand, xor, next_var) !=
+                    sat_formula_xor_collect (formula->right_operand, xor, next_var));
+
+        case SAT_FORMULA_TAG_OP_EQUAL:
+            /* f1 == f2 is f1 xor f2 xor true */
+            return (sat_formula_xor_collect (formula->left_operand, xor, next_var) ==
+                    sat_formula_xor_collect (formula->right_operand, xor, next_var));
+
+        default:
+            break;
+    }
+
+    long int aux = *next_var;
+    (*next_var)++;
+
+    struct sat_formula *definition = sat_formula_new_operation (SAT_FORMULA_TAG_OP_EQUAL,
+                                                                sat_formula_new_literal (aux),
+                                                                sat_formula_duplicate (formula));
+    xor->definitions = g_list_concat (xor->definitions, sat_formula_to_cnf (definition));
+    sat_formula_free (&definition);
+
+    g_queue_push_tail (xor->literals, GSIZE_TO_POINTER (aux));
+
+    return false;
+}
+
+/* returns the given sat_formula tree as parity constraint if it is a chain of xor/equal operations
+ * over at least 3 operands or NULL otherwise */
+struct sat_formula_xor * sat_formula_to_xor (struct sat_formula *formula)
+{
+    if (formula == NULL) return NULL;
+
+    struct sat_formula *top = formula;
+    while (top->tag == SAT_FORMULA_TAG_INVERSION) top = top->left_operand;
+
+    if ((top->tag != SAT_FORMULA_TAG_OP_XOR) && (top->tag != SAT_FORMULA_TAG_OP_EQUAL)) return NULL;
+
+    struct sat_formula_xor *result = g_slice_new (struct sat_formula_xor);
+    result->literals    = g_queue_new ();
+    result->max_var     = sat_formula_max_var (formula);
+    result->definitions = NULL;
+
+    long int next_var = result->max_var + 1;
+    bool inverted = sat_formula_xor_collect (formula, result, &next_var);
+
+    /* short chains are cheaper as plain clauses */
+    if (g_queue_get_length (result->literals) < 3) {
+        sat_formula_xor_free (&result);
+        return NULL;
+    }
+
+    /* xor of literals must be false: invert one of them */
+    if (inverted) {
+        long int lit = GPOINTER_TO_SIZE (result->literals->head->data);
+        result->literals->head->data = GSIZE_TO_POINTER (-lit);
+    }
+
+    return result;
+}
+
+/* frees the given parity constraint and sets the referenced pointer to NULL */
+void sat_formula_xor_free (struct sat_formula_xor **xor)
+{
+    if (xor == NULL) return;
+    if (*xor == NULL) return;
+
+    g_queue_free ((*xor)->literals);
+    g_list_free_full ((*xor)->definitions, (GDestroyNotify) g_queue_free);
+    g_slice_free (struct sat_formula_xor, *xor);
+
+    *xor = NULL;
+}
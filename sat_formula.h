@@ -39,6 +39,16 @@ enum sat_formula_tag_t {
 typedef enum sat_formula_tag_t SatFormulaTag;
 typedef struct sat_formula *SatFormula;
 
+/* parity constraint extracted from a formula by sat_formula_to_xor */
+struct sat_formula_xor {
+    /* GQueue of literals as long int whose exclusive or is true */
+    GQueue   *literals;
+    /* greatest variable of the formula, greater variables are auxiliary variables */
+    long int max_var;
+    /* clauses defining auxiliary variables as GList of clauses, where each clause is a GQueue of literals as long int */
+    GList    *definitions;
+};
+
 /* allocate and return a new sat_formula element representing the given literal */
 struct sat_formula * sat_formula_new_literal (long int literal);
 /* allocate and return a new sat_formula element representing the inversion of given argument */
@@ -58,5 +68,11 @@ SatFormula sat_formula_duplicate (SatFormula formula);
 /* transforms and returns a given sat_formula tree into a CNF formula represented
  * as a GList of clauses, where each clause is a GQueue of literals as long int */
 GList * sat_formula_to_cnf (SatFormula formula);
+/* returns the given sat_formula tree as parity constraint if it is a chain of xor/equal operations
+ * over at least 3 operands, operands that are no literals are replaced by auxiliary variables defined
+ * by clauses. returns NULL for other formulas. */
+struct sat_formula_xor * sat_formula_to_xor (SatFormula formula);
+/* frees the given parity constraint and sets the referenced pointer to NULL */
+void sat_formula_xor_free (struct sat_formula_xor **xor);
 
 #endif
@@ -25,10 +25,121 @@
 
 char inbuf [1024];
 
+/* xor/equal chains checked by sat_formula_test_xor */
+struct sat_formula_test_xor_case {
+    const char *expr;
+    /* expected number of parity literals, 0 if the formula is no chain */
+    unsigned int n_literals;
+    /* expected number of auxiliary variables for operands that are no literals */
+    unsigned int n_aux;
+};
+
+static const struct sat_formula_test_xor_case sat_formula_test_xor_cases [] = {
+    {"1 ^ 2 ^ 3",                   3, 0},
+    {"1 == 2 == 3",                 3, 0},
+    {"1 ^ 2 == 3 ^ 4",              4, 0},
+    {"-1 ^ 2 ^ 3",                  3, 0},
+    {"1 ^ -2 == -3",                3, 0},
+    {"-(1 ^ 2) ^ 3",                3, 0},
+    {"!(1 == 2) == !3 == 4",        4, 0},
+    {"-(-1 == -2 == -3)",           3, 0},
+    {"-(1 ^ 2 ^ 3 ^ 4 ^ 5)",        5, 0},
+    {"1 ^ (2 & 3) ^ 4",             3, 1},
+    {"-(2 | 3) == 1 == -(4 -> 5)",  3, 2},
+    {"1 ^ 2",                       0, 0},
+    {"-(1 == 2)",                   0, 0},
+    {"1 & 2 & 3",                   0, 0},
+    {"(1 ^ 2) | 3",                 0, 0},
+    {NULL,                          0, 0}
+};
+
+/* return true if all clauses (GList of GQueues of literals as long int) are satisfied by value (indexed by variable) */
+static bool sat_formula_test_clauses_satisfied (GList *clause_list, const bool *value)
+{
+    for (GList *li1 = clause_list; li1 != NULL; li1 = li1->next) {
+        GQueue *clause = li1->data;
+        bool satisfied = false;
+        for (GList *li2 = clause->head; li2 != NULL; li2 = li2->next) {
+            long int lit = GPOINTER_TO_SIZE (li2->data);
+            if (value[lit > 0 ? lit : -lit] == (lit > 0)) satisfied = true;
+        }
+        if (!satisfied) return false;
+    }
+
+    return true;
+}
+
+/* check sat_formula_to_xor for all test cases: for each assignment of the formula variables, the CNF
+ * of the formula has to be satisfied iff the exclusive or of the parity literals is true, where the
+ * auxiliary variables are uniquely determined by their definitions. returns the number of failed cases. */
+static int sat_formula_test_xor (void)
+{
+    int n_failed = 0;
+
+    for (const struct sat_formula_test_xor_case *test = sat_formula_test_xor_cases; test->expr != NULL; test++) {
+        SatFormula formula = sat_formula_parse (test->expr);
+        struct sat_formula_xor *xor = sat_formula_to_xor (formula);
+        bool ok = true;
+
+        if (xor == NULL) {
+            ok = (test->n_literals == 0);
+        } else if ((test->n_literals == 0) || (g_queue_get_length (xor->literals) != test->n_literals)) {
+            ok = false;
+        } else {
+            GList *clause_list = sat_formula_to_cnf (formula);
+
+            long int n_vars = xor->max_var + test->n_aux;
+            bool *value = g_new0 (bool, n_vars + 1);
+
+            for (unsigned long int a = 0; ok && (a < (1UL << xor->max_var)); a++) {
+                for (long int var = 1; var <= xor->max_var; var++) value[var] = ((a >> (var - 1)) & 1);
+                bool formula_value = sat_formula_test_clauses_satisfied (clause_list, value);
+
+                /* assignments of auxiliary variables satisfying their definitions */
+                unsigned int n_defined = 0;
+                for (unsigned long int b = 0; b < (1UL << test->n_aux); b++) {
+                    for (unsigned int i = 0; i < test->n_aux; i++) value[xor->max_var + 1 + i] = ((b >> i) & 1);
+                    if (!sat_formula_test_clauses_satisfied (xor->definitions, value)) continue;
+                    n_defined++;
+
+                    bool parity = false;
+                    for (GList *li = xor->literals->head; li != NULL; li = li->next) {
+                        long int lit = GPOINTER_TO_SIZE (li->data);
+                        long int var = (lit > 0 ? lit : -lit);
+                        if ((var < 1) || (var > n_vars)) {
+                            ok = false;
+                            break;
+                        }
+                        if (value[var] == (lit > 0)) parity = !parity;
+                    }
+                    if (parity != formula_value) ok = false;
+                }
+                if (n_defined != 1) ok = false;
+            }
+
+            g_free (value);
+            g_list_free_full (clause_list, (GDestroyNotify) g_queue_free);
+        }
+
+        printf ("%s: xor %s\n", (ok ? "OK    " : "FAILED"), test->expr);
+        if (!ok) n_failed++;
+
+        sat_formula_xor_free (&xor);
+        sat_formula_free (&formula);
+    }
+
+    return n_failed;
+}
+
 int main (int argc, char *argv[])
 {
     SatFormula formula = NULL;
 
+    /* self check of xor/equal chain extraction */
+    if ((argc > 1) && (strcmp (argv[1], "--xor") == 0)) {
+        return (sat_formula_test_xor () == 0 ? 0 : 1);
+    }
+
     GString *expr = g_string_new (NULL);
     bool iterate  = true;
 
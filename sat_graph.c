@@ -0,0 +1,673 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sat_graph.h"
+#include "sat_bitvector.h"
+#include "sat_cardinality.h"
+#include "sat_pb.h"
+
+#include <string.h>
+
+/* constant literals, they never appear in generated clauses */
+#define SAT_GRAPH_TRUE  SAT_BITVECTOR_TRUE
+#define SAT_GRAPH_FALSE SAT_BITVECTOR_FALSE
+
+/* names of constraints indexed by SatGraphConstraint */
+static const char * const sat_graph_names[] = {
+    "path",
+    "hamiltonian_path",
+    "hamiltonian_cycle",
+    "reachable",
+    "acyclic",
+    NULL
+};
+
+/* destination of generated clauses */
+struct sat_graph_out {
+    /* GQueue of clauses or NULL for counting only */
+    GQueue            *clauses;
+    unsigned long int n_clauses;
+    unsigned long int *next_var;
+};
+
+/* arcs of a graph: undirected edges are represented by the arcs 2 * i and 2 * i + 1 in both directions,
+ * self loops are left out */
+struct sat_graph {
+    bool         directed;
+    unsigned int n_nodes;
+    unsigned int n_arcs;
+    unsigned int *tail;
+    unsigned int *head;
+    long int     *lit;
+    /* arcs into node v: in_arcs[in_start[v]] ... in_arcs[in_start[v + 1] - 1], arcs out of v likewise */
+    unsigned int *in_start;
+    unsigned int *in_arcs;
+    unsigned int *out_start;
+    unsigned int *out_arcs;
+    /* node preceding all others without a label, n_nodes if there is none */
+    unsigned int root;
+    /* only node supported by the root (breaks the symmetric direction of undirected cycles), n_nodes for all */
+    unsigned int first;
+    /* label bits of the nodes (width per node, least significant first), allocated on first use */
+    unsigned int width;
+    long int     *labels;
+    /* bits of label + 1 with carry (width + 1 per node, 0 if not yet computed), allocated on first use */
+    long int     *succ;
+};
+
+/* set *constraint to the constraint with given name (e.g. "path") and return true, false for unknown names */
+bool sat_graph_constraint_from_string (const char *name, SatGraphConstraint *constraint)
+{
+    if (name == NULL) return false;
+
+    for (int i = 0; sat_graph_names[i] != NULL; i++) {
+        if (strcmp (name, sat_graph_names[i]) == 0) {
+            if (constraint != NULL) *constraint = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* return name of constraint */
+const char * sat_graph_constraint_name (SatGraphConstraint constraint)
+{
+    if (constraint > SAT_GRAPH_ACYCLIC) return NULL;
+    return sat_graph_names[constraint];
+}
+
+/* append clause of len literals to out: clauses with a true constant are left out, false constants are removed */
+static void sat_graph_clause (struct sat_graph_out *out, const long int *lits, unsigned int len)
+{
+    unsigned int n_lits = 0;
+    for (unsigned int i = 0; i < len; i++) {
+        if (lits[i] == SAT_GRAPH_TRUE) return;
+        if (lits[i] != SAT_GRAPH_FALSE) n_lits++;
+    }
+
+    out->n_clauses++;
+    if (out->clauses == NULL) return;
+
+    long int *clause = g_slice_alloc (sizeof (long int) * (n_lits + 1));
+    n_lits = 0;
+    for (unsigned int i = 0; i < len; i++) {
+        if (lits[i] != SAT_GRAPH_FALSE) clause[n_lits++] = lits[i];
+    }
+    clause[n_lits] = 0;
+
+    g_queue_push_tail (out->clauses, clause);
+}
+
+/* append clause of literals a, b and c to out, 0 literals are left out */
+static void sat_graph_clause3 (struct sat_graph_out *out, long int a, long int b, long int c)
+{
+    long int clause[3] = {0, 0, 0};
+    unsigned int len = 0;
+
+    if (a != 0) clause[len++] = a;
+    if (b != 0) clause[len++] = b;
+    if (c != 0) clause[len++] = c;
+
+    sat_graph_clause (out, clause, len);
+}
+
+/* return a new auxiliary variable of out */
+static inline long int sat_graph_new_var (struct sat_graph_out *out)
+{
+    return (long int) ((*(out->next_var))++);
+}
+
+/* return number of bits of value */
+static unsigned int sat_graph_bit_length (unsigned long int value)
+{
+    unsigned int n_bits = 0;
+    while (value != 0) {
+        n_bits++;
+        value >>= 1;
+    }
+    return n_bits;
+}
+
+/* set *start and *arcs to the arcs of each node given by node[k] for arc k (compressed rows) */
+static void sat_graph_index (unsigned int n_nodes, unsigned int n_arcs, const unsigned int *node,
+                             unsigned int **start, unsigned int **arcs)
+{
+    *start = g_new0 (unsigned int, n_nodes + 1);
+    *arcs  = g_new (unsigned int, n_arcs + 1);
+
+    for (unsigned int k = 0; k < n_arcs; k++) (*start)[node[k] + 1]++;
+    for (unsigned int v = 0; v < n_nodes; v++) (*start)[v + 1] += (*start)[v];
+
+    unsigned int *pos = g_new (unsigned int, n_nodes + 1);
+    memcpy (pos, *start, sizeof (unsigned int) * (n_nodes + 1));
+    for (unsigned int k = 0; k < n_arcs; k++) (*arcs)[pos[node[k]]++] = k;
+    g_free (pos);
+}
+
+/* initialize g with the arcs of the n_edges edges from[i] - to[i] selected by edge_lits[i] */
+static void sat_graph_init (struct sat_graph *g, bool directed, unsigned int n_nodes,
+                            const unsigned int *from, const unsigned int *to, const long int *edge_lits, unsigned int n_edges)
+{
+    unsigned int max_arcs = (directed ? n_edges : 2 * n_edges);
+
+    g->directed = directed;
+    g->n_nodes  = n_nodes;
+    g->n_arcs   = 0;
+    g->tail     = g_new (unsigned int, max_arcs + 1);
+    g->head     = g_new (unsigned int, max_arcs + 1);
+    g->lit      = g_new (long int, max_arcs + 1);
+    g->root     = n_nodes;
+    g->first    = n_nodes;
+    g->width    = 0;
+    g->labels   = NULL;
+    g->succ     = NULL;
+
+    for (unsigned int i = 0; i < n_edges; i++) {
+        if (from[i] == to[i]) continue;
+
+        g->tail[g->n_arcs] = from[i];
+        g->head[g->n_arcs] = to[i];
+        g->lit[g->n_arcs]  = edge_lits[i];
+        g->n_arcs++;
+
+        if (!directed) {
+            g->tail[g->n_arcs] = to[i];
+            g->head[g->n_arcs] = from[i];
+            g->lit[g->n_arcs]  = edge_lits[i];
+            g->n_arcs++;
+        }
+    }
+
+    sat_graph_index (n_nodes, g->n_arcs, g->head, &(g->in_start), &(g->in_arcs));
+    sat_graph_index (n_nodes, g->n_arcs, g->tail, &(g->out_start), &(g->out_arcs));
+}
+
+/* free arrays of g */
+static void sat_graph_clear (struct sat_graph *g)
+{
+    g_free (g->tail);
+    g_free (g->head);
+    g_free (g->lit);
+    g_free (g->in_start);
+    g_free (g->in_arcs);
+    g_free (g->out_start);
+    g_free (g->out_arcs);
+    g_free (g->labels);
+    g_free (g->succ);
+}
+
+/* copy literals of the arcs start[v] ... start[v + 1] - 1 of arcs to lits and return their number */
+static unsigned int sat_graph_arc_lits (const struct sat_graph *g, const unsigned int *start, const unsigned int *arcs,
+                                        unsigned int v, long int *lits)
+{
+    unsigned int n = 0;
+    for (unsigned int i = start[v]; i < start[v + 1]; i++) lits[n++] = g->lit[arcs[i]];
+    return n;
+}
+
+/* allocate label bits of all nodes except root on first use */
+static void sat_graph_labels (struct sat_graph *g, struct sat_graph_out *out)
+{
+    if (g->labels != NULL) return;
+
+    unsigned int n_labeled = (g->root < g->n_nodes ? g->n_nodes - 1 : g->n_nodes);
+
+    g->width  = MAX (sat_graph_bit_length (n_labeled - 1), 1);
+    g->labels = g_new (long int, (unsigned long int) g->n_nodes * g->width + 1);
+
+    for (unsigned int v = 0; v < g->n_nodes; v++) {
+        if (v == g->root) continue;
+        for (unsigned int i = 0; i < g->width; i++) g->labels[v * g->width + i] = sat_graph_new_var (out);
+    }
+}
+
+/* return literal for label (u) < label (v): the root precedes all nodes */
+static long int sat_graph_less (struct sat_graph *g, struct sat_graph_out *out, unsigned int u, unsigned int v)
+{
+    if (u == g->root) return SAT_GRAPH_TRUE;
+    if ((v == g->root) || (u == v)) return SAT_GRAPH_FALSE;
+
+    sat_graph_labels (g, out);
+
+    long int result = 0;
+    out->n_clauses += sat_bitvector_append (SAT_BITVECTOR_ULT, SAT_BITVECTOR_MUL_WALLACE,
+                                            &(g->labels[u * g->width]), &(g->labels[v * g->width]), g->width, g->width,
+                                            &result, out->next_var, out->clauses);
+    return result;
+}
+
+/* append clauses for cond -> label (v) = label (u) + 1 without overflow, label (v) = 0 if u is the root.
+ * Unlike label (u) < label (v) this fixes the labels to distances along the selected arcs, so they propagate
+ * like positions of steps. */
+static void sat_graph_successor (struct sat_graph *g, struct sat_graph_out *out, long int cond, unsigned int u, unsigned int v)
+{
+    if ((v == g->root) || (u == v)) {
+        sat_graph_clause3 (out, -cond, 0, 0);
+        return;
+    }
+
+    sat_graph_labels (g, out);
+    unsigned int width = g->width;
+    const long int *label_v = &(g->labels[v * width]);
+
+    if (u == g->root) {
+        for (unsigned int i = 0; i < width; i++) sat_graph_clause3 (out, -cond, -label_v[i], 0);
+        return;
+    }
+
+    /* label (u) + 1 with carry as bit width, computed once per node */
+    if (g->succ == NULL) g->succ = g_new0 (long int, (unsigned long int) g->n_nodes * (width + 1) + 1);
+    long int *succ_u = &(g->succ[u * (width + 1)]);
+
+    if (succ_u[0] == 0) {
+        long int *a = g_new (long int, width + 2);
+        long int *b = g_new (long int, width + 2);
+        for (unsigned int i = 0; i < width; i++) a[i] = g->labels[u * width + i];
+        for (unsigned int i = 0; i <= width; i++) b[i] = (i == 0 ? SAT_GRAPH_TRUE : SAT_GRAPH_FALSE);
+        a[width] = SAT_GRAPH_FALSE;
+
+        out->n_clauses += sat_bitvector_append (SAT_BITVECTOR_ADD, SAT_BITVECTOR_MUL_WALLACE, a, b, width + 1, width + 1,
+                                                succ_u, out->next_var, out->clauses);
+        g_free (a);
+        g_free (b);
+    }
+
+    for (unsigned int i = 0; i < width; i++) {
+        sat_graph_clause3 (out, -cond, -succ_u[i], label_v[i]);
+        sat_graph_clause3 (out, -cond, succ_u[i], -label_v[i]);
+    }
+    sat_graph_clause3 (out, -cond, -succ_u[width], 0);
+}
+
+/* append clauses for sum (lits) = k * node over the n literals lits (room for n + 1),
+ * node may be a literal or a constant */
+static void sat_graph_degree (struct sat_graph_out *out, long int *lits, unsigned int n, long int node, long int k)
+{
+    long int *weights = g_new (long int, n + 1);
+    unsigned int n_terms = n;
+    long int bound = 0;
+
+    for (unsigned int i = 0; i < n; i++) weights[i] = 1;
+
+    if (node == SAT_GRAPH_TRUE) {
+        bound = k;
+    } else if (node != SAT_GRAPH_FALSE) {
+        lits[n_terms]    = node;
+        weights[n_terms] = -k;
+        n_terms++;
+    }
+
+    out->n_clauses += sat_pb_append (SAT_PB_AUTO, lits, weights, n_terms, bound, NULL, out->next_var, out->clauses);
+
+    for (unsigned int i = 0; i < n_terms; i++) weights[i] = -weights[i];
+    out->n_clauses += sat_pb_append (SAT_PB_AUTO, lits, weights, n_terms, -bound, NULL, out->next_var, out->clauses);
+
+    g_free (weights);
+}
+
+/* append clauses requiring a supporting arc into each node v except the root with nodes[v] true:
+ * it is selected and comes from a node with label (v) - 1 (paths and cycles: exactly one such arc)
+ * or, if reach is true, from a node with nodes[u] true and a smaller label.
+ * The node of a cycle without root with the smallest label has no support. */
+static void sat_graph_support (struct sat_graph *g, struct sat_graph_out *out, const long int *nodes, bool reach)
+{
+    long int *clause = g_new (long int, g->n_arcs + 2);
+
+    for (unsigned int v = 0; v < g->n_nodes; v++) {
+        if ((v == g->root) || (nodes[v] == SAT_GRAPH_FALSE)) continue;
+
+        unsigned int len = 0;
+        clause[len++] = -nodes[v];
+
+        for (unsigned int i = g->in_start[v]; i < g->in_start[v + 1]; i++) {
+            unsigned int k = g->in_arcs[i];
+            unsigned int u = g->tail[k];
+
+            if ((u == g->root) && (g->first < g->n_nodes) && (v != g->first)) continue;
+
+            if (reach) {
+                /* any shorter path suffices, exact distances would be a harder search */
+                long int less = sat_graph_less (g, out, u, v);
+                if ((less == SAT_GRAPH_FALSE) || (nodes[u] == SAT_GRAPH_FALSE)) continue;
+
+                if ((less == SAT_GRAPH_TRUE) && (nodes[u] == SAT_GRAPH_TRUE)) {
+                    clause[len++] = g->lit[k];
+                    continue;
+                }
+
+                long int support = sat_graph_new_var (out);
+                sat_graph_clause3 (out, -support, g->lit[k], 0);
+                sat_graph_clause3 (out, -support, less, 0);
+                sat_graph_clause3 (out, -support, nodes[u], 0);
+                clause[len++] = support;
+            } else {
+                long int support = sat_graph_new_var (out);
+                sat_graph_clause3 (out, -support, g->lit[k], 0);
+                sat_graph_successor (g, out, support, u, v);
+                clause[len++] = support;
+            }
+        }
+
+        sat_graph_clause (out, clause, len);
+
+        /* a single predecessor on paths and cycles */
+        if (!reach && (len > 2)) {
+            out->n_clauses += sat_cardinality_append (SAT_CARDINALITY_AUTO, &(clause[1]), len - 1, 0, 1, out->next_var, out->clauses);
+        }
+    }
+
+    g_free (clause);
+}
+
+/* append clauses requiring label (head) = label (tail) + 1 along all selected arcs except those into the root */
+static void sat_graph_increasing (struct sat_graph *g, struct sat_graph_out *out)
+{
+    for (unsigned int k = 0; k < g->n_arcs; k++) {
+        if (g->head[k] == g->root) continue;
+        sat_graph_successor (g, out, g->lit[k], g->tail[k], g->head[k]);
+    }
+}
+
+/* simple path from source to target over the nodes with nodes[v] true (true for source and target) */
+static void sat_graph_path (struct sat_graph *g, struct sat_graph_out *out, const long int *nodes,
+                            unsigned int source, unsigned int target)
+{
+    long int *lits = g_new (long int, g->n_arcs + 2);
+
+    for (unsigned int v = 0; v < g->n_nodes; v++) {
+        bool is_source = (v == source);
+        bool is_target = (v == target);
+
+        if (g->directed) {
+            /* in = out = nodes[v] except for the ends */
+            unsigned int n = sat_graph_arc_lits (g, g->in_start, g->in_arcs, v, lits);
+            if (is_source)      sat_graph_degree (out, lits, n, SAT_GRAPH_TRUE, 0);
+            else if (is_target) sat_graph_degree (out, lits, n, SAT_GRAPH_TRUE, 1);
+            else                sat_graph_degree (out, lits, n, nodes[v], 1);
+
+            n = sat_graph_arc_lits (g, g->out_start, g->out_arcs, v, lits);
+            if (is_source)      sat_graph_degree (out, lits, n, SAT_GRAPH_TRUE, 1);
+            else if (is_target) sat_graph_degree (out, lits, n, SAT_GRAPH_TRUE, 0);
+            else                sat_graph_degree (out, lits, n, nodes[v], 1);
+        } else {
+            /* ends have one incident edge, other nodes on the path two */
+            unsigned int n = sat_graph_arc_lits (g, g->in_start, g->in_arcs, v, lits);
+            if (is_source || is_target) sat_graph_degree (out, lits, n, SAT_GRAPH_TRUE, 1);
+            else                        sat_graph_degree (out, lits, n, nodes[v], 2);
+        }
+    }
+
+    g_free (lits);
+
+    /* no cycles apart from the path */
+    g->root = source;
+    if (g->directed) {
+        sat_graph_increasing (g, out);
+    } else {
+        sat_graph_support (g, out, nodes, false);
+    }
+}
+
+/* cycle through all nodes, labels start at root */
+static void sat_graph_cycle (struct sat_graph *g, struct sat_graph_out *out, unsigned int root)
+{
+    long int *lits  = g_new (long int, g->n_arcs + 2);
+    long int *nodes = g_new (long int, g->n_nodes + 1);
+
+    for (unsigned int v = 0; v < g->n_nodes; v++) {
+        nodes[v] = SAT_GRAPH_TRUE;
+
+        if (g->directed) {
+            unsigned int n = sat_graph_arc_lits (g, g->in_start, g->in_arcs, v, lits);
+            sat_graph_degree (out, lits, n, SAT_GRAPH_TRUE, 1);
+            n = sat_graph_arc_lits (g, g->out_start, g->out_arcs, v, lits);
+            sat_graph_degree (out, lits, n, SAT_GRAPH_TRUE, 1);
+        } else {
+            unsigned int n = sat_graph_arc_lits (g, g->in_start, g->in_arcs, v, lits);
+            sat_graph_degree (out, lits, n, SAT_GRAPH_TRUE, 2);
+        }
+    }
+
+    /* no subcycles without root */
+    g->root = root;
+    if (g->directed) {
+        sat_graph_increasing (g, out);
+    } else {
+        sat_graph_support (g, out, nodes, false);
+    }
+
+    g_free (lits);
+    g_free (nodes);
+}
+
+/* nodes[v] true exactly for the nodes reachable from source (nodes[source] is true) */
+static void sat_graph_reachable (struct sat_graph *g, struct sat_graph_out *out, const long int *nodes, unsigned int source)
+{
+    /* successors of reachable nodes are reachable */
+    for (unsigned int k = 0; k < g->n_arcs; k++) {
+        long int clause[3] = {-(g->lit[k]), -nodes[g->tail[k]], nodes[g->head[k]]};
+        sat_graph_clause (out, clause, 3);
+    }
+
+    /* reachable nodes have a reachable predecessor closer to source */
+    g->root = source;
+    sat_graph_support (g, out, nodes, true);
+}
+
+/* target reachable from source without node literals: the selected arcs contain a path from source to target
+ * marked by auxiliary variables with in = out <= 1 except for the ends, so no labels are needed */
+static void sat_graph_reachable_path (struct sat_graph *g, struct sat_graph_out *out, unsigned int source, unsigned int target)
+{
+    long int *used = g_new (long int, g->n_arcs + 1);
+    for (unsigned int k = 0; k < g->n_arcs; k++) {
+        used[k] = sat_graph_new_var (out);
+        sat_graph_clause3 (out, -used[k], g->lit[k], 0);
+    }
+
+    long int *lits = g_new (long int, g->n_arcs + 2);
+    for (unsigned int v = 0; v < g->n_nodes; v++) {
+        long int node = SAT_GRAPH_TRUE;
+        if ((v != source) && (v != target)) node = sat_graph_new_var (out);
+
+        unsigned int n = 0;
+        for (unsigned int i = g->in_start[v]; i < g->in_start[v + 1]; i++) lits[n++] = used[g->in_arcs[i]];
+        sat_graph_degree (out, lits, n, node, (v == source ? 0 : 1));
+
+        n = 0;
+        for (unsigned int i = g->out_start[v]; i < g->out_start[v + 1]; i++) lits[n++] = used[g->out_arcs[i]];
+        sat_graph_degree (out, lits, n, node, (v == target ? 0 : 1));
+    }
+
+    g_free (lits);
+    g_free (used);
+}
+
+/* no cycles of selected arcs: labels increase along arcs, undirected edges are oriented with at most one
+ * incoming edge per node, so labels are depths in a forest */
+static void sat_graph_acyclic (struct sat_graph *g, struct sat_graph_out *out)
+{
+    g->root = g->n_nodes;
+
+    if (g->directed) {
+        for (unsigned int k = 0; k < g->n_arcs; k++) {
+            sat_graph_clause3 (out, -(g->lit[k]), sat_graph_less (g, out, g->tail[k], g->head[k]), 0);
+        }
+        return;
+    }
+
+    long int *orient = g_new (long int, g->n_arcs + 1);
+    for (unsigned int k = 0; k < g->n_arcs; k++) orient[k] = sat_graph_new_var (out);
+
+    for (unsigned int k = 0; k < g->n_arcs; k += 2) {
+        sat_graph_clause3 (out, -(g->lit[k]), orient[k], orient[k + 1]);
+    }
+    for (unsigned int k = 0; k < g->n_arcs; k++) {
+        sat_graph_clause3 (out, -orient[k], g->lit[k], 0);
+        sat_graph_successor (g, out, orient[k], g->tail[k], g->head[k]);
+    }
+
+    long int *lits = g_new (long int, g->n_arcs + 1);
+    for (unsigned int v = 0; v < g->n_nodes; v++) {
+        unsigned int n = 0;
+        for (unsigned int i = g->in_start[v]; i < g->in_start[v + 1]; i++) lits[n++] = orient[g->in_arcs[i]];
+        if (n > 1) {
+            out->n_clauses += sat_cardinality_append (SAT_CARDINALITY_AUTO, lits, n, 0, 1, out->next_var, out->clauses);
+        }
+    }
+
+    g_free (lits);
+    g_free (orient);
+}
+
+/* hamiltonian path as cycle through an additional node n_nodes adjacent to the possible ends */
+static void sat_graph_hamiltonian_path (struct sat_graph_out *out, bool directed, unsigned int n_nodes,
+                                        const unsigned int *from, const unsigned int *to, const long int *edge_lits, unsigned int n_edges,
+                                        long int source, long int target)
+{
+    /* a single node needs no edges */
+    if (n_nodes < 2) return;
+
+    unsigned int max_edges = n_edges + 2 * n_nodes;
+    unsigned int *ext_from = g_new (unsigned int, max_edges);
+    unsigned int *ext_to   = g_new (unsigned int, max_edges);
+    long int     *ext_lits = g_new (long int, max_edges);
+
+    memcpy (ext_from, from, sizeof (unsigned int) * n_edges);
+    memcpy (ext_to, to, sizeof (unsigned int) * n_edges);
+    memcpy (ext_lits, edge_lits, sizeof (long int) * n_edges);
+
+    unsigned int n = n_edges;
+    for (unsigned int v = 0; v < n_nodes; v++) {
+        bool is_source = (source == (long int) v);
+        bool is_target = (target == (long int) v);
+
+        if (directed) {
+            /* start: n_nodes -> v, end: v -> n_nodes */
+            if ((source < 0) || is_source) {
+                ext_from[n] = n_nodes;
+                ext_to[n]   = v;
+                ext_lits[n] = sat_graph_new_var (out);
+                if (is_source) sat_graph_clause3 (out, ext_lits[n], 0, 0);
+                n++;
+            }
+            if ((target < 0) || is_target) {
+                ext_from[n] = v;
+                ext_to[n]   = n_nodes;
+                ext_lits[n] = sat_graph_new_var (out);
+                if (is_target) sat_graph_clause3 (out, ext_lits[n], 0, 0);
+                n++;
+            }
+        } else if ((source < 0) || (target < 0) || is_source || is_target) {
+            ext_from[n] = n_nodes;
+            ext_to[n]   = v;
+            ext_lits[n] = sat_graph_new_var (out);
+            if (is_source || is_target) sat_graph_clause3 (out, ext_lits[n], 0, 0);
+            n++;
+        }
+    }
+
+    struct sat_graph g;
+    sat_graph_init (&g, directed, n_nodes + 1, ext_from, ext_to, ext_lits, n);
+    if (!directed && (source >= 0)) g.first = source;
+    sat_graph_cycle (&g, out, n_nodes);
+    sat_graph_clear (&g);
+
+    g_free (ext_from);
+    g_free (ext_to);
+    g_free (ext_lits);
+}
+
+/* append clauses for constraint on the graph with nodes 0 ... n_nodes - 1 and the n_edges edges from[i] - to[i]
+ * selected by edge_lits[i], see header for details. */
+unsigned long int sat_graph_append (SatGraphConstraint constraint, bool directed, unsigned int n_nodes,
+                                    const unsigned int *from, const unsigned int *to, const long int *edge_lits, unsigned int n_edges,
+                                    const long int *node_lits, long int source, long int target,
+                                    unsigned long int *next_var, GQueue *clauses)
+{
+    struct sat_graph_out out = {clauses, 0, next_var};
+
+    /* self loops are neither on paths nor acyclic */
+    if (constraint != SAT_GRAPH_REACHABLE) {
+        for (unsigned int i = 0; i < n_edges; i++) {
+            if (from[i] == to[i]) sat_graph_clause3 (&out, -edge_lits[i], 0, 0);
+        }
+    }
+
+    if (constraint == SAT_GRAPH_HAMILTONIAN_PATH) {
+        sat_graph_hamiltonian_path (&out, directed, n_nodes, from, to, edge_lits, n_edges, source, target);
+        return out.n_clauses;
+    }
+
+    /* reachability of target alone needs no node literals */
+    bool named = false;
+    for (unsigned int v = 0; (node_lits != NULL) && (v < n_nodes); v++) {
+        if (node_lits[v] != 0) named = true;
+    }
+    if ((constraint == SAT_GRAPH_REACHABLE) && !named) {
+        if ((target >= 0) && (target != source)) {
+            struct sat_graph g;
+            sat_graph_init (&g, directed, n_nodes, from, to, edge_lits, n_edges);
+            sat_graph_reachable_path (&g, &out, source, target);
+            sat_graph_clear (&g);
+        }
+        return out.n_clauses;
+    }
+
+    /* node literals: source (and target of path) are true */
+    long int *nodes = g_new (long int, n_nodes + 1);
+    for (unsigned int v = 0; v < n_nodes; v++) {
+        bool fixed = ((long int) v == source) || ((constraint == SAT_GRAPH_PATH) && ((long int) v == target));
+        long int lit = (node_lits != NULL ? node_lits[v] : 0);
+
+        if ((constraint != SAT_GRAPH_PATH) && (constraint != SAT_GRAPH_REACHABLE)) {
+            nodes[v] = SAT_GRAPH_TRUE;
+        } else if (fixed) {
+            if (lit != 0) sat_graph_clause3 (&out, lit, 0, 0);
+            nodes[v] = SAT_GRAPH_TRUE;
+        } else {
+            nodes[v] = (lit != 0 ? lit : sat_graph_new_var (&out));
+        }
+    }
+
+    struct sat_graph g;
+    sat_graph_init (&g, directed, n_nodes, from, to, edge_lits, n_edges);
+
+    switch (constraint) {
+        case SAT_GRAPH_PATH:
+            sat_graph_path (&g, &out, nodes, source, target);
+            break;
+        case SAT_GRAPH_HAMILTONIAN_CYCLE:
+            if (n_nodes > 0) sat_graph_cycle (&g, &out, (source >= 0 ? source : 0));
+            break;
+        case SAT_GRAPH_REACHABLE:
+            sat_graph_reachable (&g, &out, nodes, source);
+            if (target >= 0) sat_graph_clause3 (&out, nodes[target], 0, 0);
+            break;
+        case SAT_GRAPH_ACYCLIC:
+            sat_graph_acyclic (&g, &out);
+            break;
+        default:
+            break;
+    }
+
+    sat_graph_clear (&g);
+    g_free (nodes);
+
+    return out.n_clauses;
+}
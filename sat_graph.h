@@ -0,0 +1,62 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __sat_graph_h__
+#define __sat_graph_h__
+
+#include <stdbool.h>
+#include <glib.h>
+
+/* constraints on the subgraph of selected edges (edge literal true) */
+enum sat_graph_constraint_t {
+    /* selected edges form a simple path from source to target */
+    SAT_GRAPH_PATH,
+    /* selected edges form a simple path visiting every node, source and target are optional */
+    SAT_GRAPH_HAMILTONIAN_PATH,
+    /* selected edges form a cycle visiting every node */
+    SAT_GRAPH_HAMILTONIAN_CYCLE,
+    /* node literals are true exactly for the nodes reachable from source, target (optional) is reachable */
+    SAT_GRAPH_REACHABLE,
+    /* selected edges contain no cycle */
+    SAT_GRAPH_ACYCLIC
+};
+
+typedef enum sat_graph_constraint_t SatGraphConstraint;
+
+/* set *constraint to the constraint with given name (e.g. "path") and return true, false for unknown names */
+bool sat_graph_constraint_from_string (const char *name, SatGraphConstraint *constraint);
+/* return name of constraint */
+const char * sat_graph_constraint_name (SatGraphConstraint constraint);
+
+/* append clauses for constraint on the graph with nodes 0 ... n_nodes - 1 and the n_edges edges from[i] - to[i]
+ * (arcs if directed is true) selected by edge_lits[i] to clauses (GQueue of 0-terminated arrays of literals (long int)
+ * allocated by g_slice) and return their number. If clauses is NULL, clauses are only counted.
+ * node_lits: NULL or literals of the nodes (0: auxiliary variable), true exactly for the nodes on the path (path)
+ * or reachable from source (reachable), unused by the other constraints.
+ * source, target: nodes or -1 if not given.
+ * Instead of a transitive closure, cycles are excluded by binary labels of log2(n_nodes) bits per node: distances
+ * (label + 1 along selected arcs, undirected edges are oriented by a predecessor of each node) for paths, cycles and
+ * undirected acyclic, comparisons for directed acyclic and node literals of reachable. Reachability of target alone
+ * is witnessed by a path of auxiliary arc variables without labels.
+ * Auxiliary variables are numbered from *next_var on, which is incremented accordingly. */
+unsigned long int sat_graph_append (SatGraphConstraint constraint, bool directed, unsigned int n_nodes,
+                                    const unsigned int *from, const unsigned int *to, const long int *edge_lits, unsigned int n_edges,
+                                    const long int *node_lits, long int source, long int target,
+                                    unsigned long int *next_var, GQueue *clauses);
+
+#endif
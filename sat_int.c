@@ -0,0 +1,453 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sat_int.h"
+#include "sat_cardinality.h"
+
+#include <string.h>
+
+/* largest domains encoded directly / by order encoding with encoding auto */
+#define SAT_INT_AUTO_MAX_DIRECT 32
+#define SAT_INT_AUTO_MAX_ORDER  256
+
+/* names of encodings indexed by SatIntEncoding */
+static const char * const sat_int_names[] = {
+    "auto",
+    "direct",
+    "order",
+    "log",
+    NULL
+};
+
+/* destination of generated clauses */
+struct sat_int_out {
+    /* GQueue of clauses or NULL for counting only */
+    GQueue            *clauses;
+    unsigned long int n_clauses;
+    unsigned long int *next_var;
+};
+
+/* set *encoding to the encoding with given name (e.g. "order") and return true, false for unknown names */
+bool sat_int_encoding_from_string (const char *name, SatIntEncoding *encoding)
+{
+    if (name == NULL) return false;
+
+    for (int i = 0; sat_int_names[i] != NULL; i++) {
+        if (strcmp (name, sat_int_names[i]) == 0) {
+            if (encoding != NULL) *encoding = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* return name of encoding */
+const char * sat_int_encoding_name (SatIntEncoding encoding)
+{
+    if (encoding > SAT_INT_LOG) return NULL;
+    return sat_int_names[encoding];
+}
+
+/* return number of values - 1 of domain min ... max */
+static inline unsigned long int sat_int_range (long int min, long int max)
+{
+    return (unsigned long int) max - (unsigned long int) min;
+}
+
+/* return number of bits of value */
+static unsigned int sat_int_bit_length (unsigned long int value)
+{
+    unsigned int n_bits = 0;
+    while (value != 0) {
+        n_bits++;
+        value >>= 1;
+    }
+    return n_bits;
+}
+
+/* return encoding for a variable with domain min ... max, encoding auto is resolved by domain size
+ * and single values are always encoded directly */
+SatIntEncoding sat_int_encoding_choose (SatIntEncoding encoding, long int min, long int max)
+{
+    unsigned long int range = sat_int_range (min, max);
+
+    if (range == 0) return SAT_INT_DIRECT;
+    if (encoding != SAT_INT_AUTO) return encoding;
+
+    if (range < SAT_INT_AUTO_MAX_DIRECT) return SAT_INT_DIRECT;
+    if (range < SAT_INT_AUTO_MAX_ORDER)  return SAT_INT_ORDER;
+    return SAT_INT_LOG;
+}
+
+/* return number of literals of a variable with domain min ... max in encoding (not auto) */
+unsigned int sat_int_num_lits (SatIntEncoding encoding, long int min, long int max)
+{
+    unsigned long int range = sat_int_range (min, max);
+
+    switch (encoding) {
+        case SAT_INT_DIRECT: return range + 1;
+        case SAT_INT_ORDER:  return range;
+        case SAT_INT_LOG:    return sat_int_bit_length (range);
+        default:             return 0;
+    }
+}
+
+/* append clause of len literals to out: clauses with a true constant are left out, false constants are removed */
+static void sat_int_clause (struct sat_int_out *out, const long int *lits, unsigned int len)
+{
+    unsigned int n_lits = 0;
+    for (unsigned int i = 0; i < len; i++) {
+        if (lits[i] == SAT_INT_TRUE) return;
+        if (lits[i] != SAT_INT_FALSE) n_lits++;
+    }
+
+    out->n_clauses++;
+    if (out->clauses == NULL) return;
+
+    long int *clause = g_slice_alloc (sizeof (long int) * (n_lits + 1));
+    n_lits = 0;
+    for (unsigned int i = 0; i < len; i++) {
+        if (lits[i] != SAT_INT_FALSE) clause[n_lits++] = lits[i];
+    }
+    clause[n_lits] = 0;
+
+    g_queue_push_tail (out->clauses, clause);
+}
+
+/* append clause of literals a, b and c to out, 0 literals are left out */
+static void sat_int_clause3 (struct sat_int_out *out, long int a, long int b, long int c)
+{
+    long int clause[3] = {0, 0, 0};
+    unsigned int len = 0;
+
+    if (a != 0) clause[len++] = a;
+    if (b != 0) clause[len++] = b;
+    if (c != 0) clause[len++] = c;
+
+    sat_int_clause (out, clause, len);
+}
+
+/* return a new auxiliary variable */
+static inline long int sat_int_new_var (struct sat_int_out *out)
+{
+    long int var = *(out->next_var);
+    (*(out->next_var))++;
+    return var;
+}
+
+/* append clauses restricting the literals of a variable to valid values, see header for details. */
+unsigned long int sat_int_append_domain (SatIntEncoding encoding, long int min, long int max, const long int *lits,
+                                         unsigned long int *next_var, GQueue *clauses)
+{
+    struct sat_int_out out = {clauses, 0, next_var};
+    unsigned int n_lits = sat_int_num_lits (encoding, min, max);
+
+    if (encoding == SAT_INT_DIRECT) {
+        return sat_cardinality_append (SAT_CARDINALITY_AUTO, lits, n_lits, 1, 1, next_var, clauses);
+    }
+
+    if (encoding == SAT_INT_ORDER) {
+        /* x >= v + 1 implies x >= v */
+        for (unsigned int i = 0; i + 1 < n_lits; i++) sat_int_clause3 (&out, -lits[i + 1], lits[i], 0);
+    }
+
+    if (encoding == SAT_INT_LOG) {
+        /* x - min <= range: for each 0 bit of range, the bit of x may only be set if a higher 1 bit of range is not */
+        unsigned long int range = sat_int_range (min, max);
+        long int *clause = g_new (long int, n_lits + 1);
+
+        for (unsigned int k = 0; k < n_lits; k++) {
+            if (((range >> k) & 1) != 0) continue;
+
+            unsigned int len = 0;
+            clause[len++] = -lits[k];
+            for (unsigned int j = k + 1; j < n_lits; j++) {
+                if (((range >> j) & 1) != 0) clause[len++] = -lits[j];
+            }
+            sat_int_clause (&out, clause, len);
+        }
+
+        g_free (clause);
+    }
+
+    return out.n_clauses;
+}
+
+/* return literal for x = v, see header for details. */
+long int sat_int_eq_literal (SatIntEncoding encoding, long int min, long int max, const long int *lits, long int v)
+{
+    if ((v < min) || (v > max)) return SAT_INT_FALSE;
+
+    unsigned long int i     = sat_int_range (min, v);
+    unsigned long int range = sat_int_range (min, max);
+
+    switch (encoding) {
+        case SAT_INT_DIRECT:
+            return lits[i];
+        case SAT_INT_ORDER:
+            if (i == 0)     return -lits[0];
+            if (i == range) return lits[range - 1];
+            return 0;
+        case SAT_INT_LOG:
+            if (range == 1) return (i == 0 ? -lits[0] : lits[0]);
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+/* append clauses defining var equivalent to x = v, see header for details. */
+unsigned long int sat_int_append_eq_definition (SatIntEncoding encoding, long int min, long int max, const long int *lits,
+                                                long int v, long int var, GQueue *clauses)
+{
+    struct sat_int_out out = {clauses, 0, NULL};
+    unsigned long int i = sat_int_range (min, v);
+
+    if (encoding == SAT_INT_ORDER) {
+        /* x >= v and not x >= v + 1 */
+        sat_int_clause3 (&out, -var, lits[i - 1], 0);
+        sat_int_clause3 (&out, -var, -lits[i], 0);
+        sat_int_clause3 (&out, var, -lits[i - 1], lits[i]);
+    }
+
+    if (encoding == SAT_INT_LOG) {
+        /* conjunction of the bits of v - min */
+        unsigned int n_lits = sat_int_num_lits (encoding, min, max);
+        long int *clause = g_new (long int, n_lits + 1);
+
+        for (unsigned int k = 0; k < n_lits; k++) {
+            long int bit = (((i >> k) & 1) != 0 ? lits[k] : -lits[k]);
+            sat_int_clause3 (&out, -var, bit, 0);
+            clause[k] = -bit;
+        }
+        clause[n_lits] = var;
+        sat_int_clause (&out, clause, n_lits + 1);
+
+        g_free (clause);
+    }
+
+    return out.n_clauses;
+}
+
+/* return value of a variable with domain min ... max in encoding, value[i] is the assignment of lits[i] */
+long int sat_int_decode (SatIntEncoding encoding, long int min, long int max, const bool *value)
+{
+    unsigned int n_lits = sat_int_num_lits (encoding, min, max);
+    unsigned long int offset = 0;
+
+    for (unsigned int i = 0; i < n_lits; i++) {
+        if (!value[i]) continue;
+
+        if (encoding == SAT_INT_DIRECT) {
+            offset = i;
+            break;
+        } else if (encoding == SAT_INT_ORDER) {
+            offset++;
+        } else {
+            offset |= (1UL << i);
+        }
+    }
+
+    return (long int) ((unsigned long int) min + offset);
+}
+
+/* set terms of coef * x, see header for details. */
+bool sat_int_linear_terms (SatIntEncoding encoding, long int min, long int max, const long int *lits, long int coef,
+                           long int *term_lits, long int *weights, unsigned int *n_terms, long int *offset)
+{
+    unsigned int n_lits = sat_int_num_lits (encoding, min, max);
+    *n_terms = 0;
+
+    /* x = min + sum (weight_i * lit_i) */
+    if (__builtin_mul_overflow (coef, min, offset)) return false;
+
+    for (unsigned int i = 0; i < n_lits; i++) {
+        long int weight = 1;
+
+        if (encoding == SAT_INT_DIRECT) {
+            /* x = min + sum ((v - min) * (x = v)) as exactly one value is true */
+            if (i == 0) continue;
+            weight = i;
+        } else if (encoding == SAT_INT_LOG) {
+            if (i >= 62) return false;
+            weight = (1L << i);
+        }
+
+        if (__builtin_mul_overflow (coef, weight, &(weights[*n_terms]))) return false;
+        term_lits[*n_terms] = lits[i];
+        (*n_terms)++;
+    }
+
+    return true;
+}
+
+/* append clauses for pairwise different values of the n views x, see header for details. */
+unsigned long int sat_int_append_alldifferent (const struct sat_int_view *x, unsigned int n,
+                                               unsigned long int *next_var, GQueue *clauses)
+{
+    struct sat_int_out out = {clauses, 0, next_var};
+    if (n == 0) return 0;
+
+    long int min = x[0].min;
+    long int max = x[0].max;
+    for (unsigned int i = 1; i < n; i++) {
+        min = MIN (min, x[i].min);
+        max = MAX (max, x[i].max);
+    }
+
+    /* values can only be covered exactly if there are as many of them as variables */
+    bool permutation = (sat_int_range (min, max) + 1 == n);
+    long int *lits = g_new (long int, n + 1);
+
+    for (long int v = min; ; v++) {
+        unsigned int n_lits  = 0;
+        unsigned int n_true  = 0;
+
+        for (unsigned int i = 0; i < n; i++) {
+            if ((v < x[i].min) || (v > x[i].max)) continue;
+
+            long int lit = x[i].eq[sat_int_range (x[i].min, v)];
+            if (lit == SAT_INT_FALSE) continue;
+            if (lit == SAT_INT_TRUE) n_true++;
+            lits[n_lits++] = lit;
+        }
+
+        if (n_true > 1) {
+            /* constants with equal values */
+            sat_int_clause (&out, NULL, 0);
+        } else if (n_true == 1) {
+            for (unsigned int i = 0; i < n_lits; i++) {
+                if (lits[i] != SAT_INT_TRUE) sat_int_clause3 (&out, -lits[i], 0, 0);
+            }
+        } else if (n_lits > 1) {
+            out.n_clauses += sat_cardinality_append (SAT_CARDINALITY_AUTO, lits, n_lits, 0, 1, next_var, clauses);
+        }
+
+        if (permutation && (n_true == 0)) sat_int_clause (&out, lits, n_lits);
+
+        if (v == max) break;
+    }
+
+    g_free (lits);
+
+    return out.n_clauses;
+}
+
+/* append clauses for result = entries[index], see header for details. */
+unsigned long int sat_int_append_element (const struct sat_int_view *index, const struct sat_int_view *entries, unsigned int n,
+                                          const struct sat_int_view *result, unsigned long int *next_var, GQueue *clauses)
+{
+    struct sat_int_out out = {clauses, 0, next_var};
+
+    for (long int i = index->min; ; i++) {
+        long int selected = index->eq[sat_int_range (index->min, i)];
+
+        if (selected == SAT_INT_FALSE) {
+            /* impossible index */
+        } else if ((i < 0) || ((unsigned long int) i >= n)) {
+            sat_int_clause3 (&out, -selected, 0, 0);
+        } else {
+            const struct sat_int_view *entry = &(entries[i]);
+
+            /* selected entry value implies result value and vice versa */
+            for (long int v = entry->min; ; v++) {
+                long int lit_entry  = entry->eq[sat_int_range (entry->min, v)];
+                long int lit_result = ((v < result->min) || (v > result->max) ? SAT_INT_FALSE : result->eq[sat_int_range (result->min, v)]);
+
+                if (lit_entry != SAT_INT_FALSE) sat_int_clause3 (&out, -selected, -lit_entry, lit_result);
+                if (v == entry->max) break;
+            }
+            for (long int v = result->min; ; v++) {
+                long int lit_result = result->eq[sat_int_range (result->min, v)];
+                long int lit_entry  = ((v < entry->min) || (v > entry->max) ? SAT_INT_FALSE : entry->eq[sat_int_range (entry->min, v)]);
+
+                if (lit_result != SAT_INT_FALSE) sat_int_clause3 (&out, -selected, -lit_result, lit_entry);
+                if (v == result->max) break;
+            }
+        }
+
+        if (i == index->max) break;
+    }
+
+    return out.n_clauses;
+}
+
+/* append clauses for (x[0], ..., x[n - 1]) being one of the rows of tuples, see header for details. */
+unsigned long int sat_int_append_table (const struct sat_int_view *x, unsigned int n, const long int *tuples, unsigned int n_tuples,
+                                        unsigned long int *next_var, GQueue *clauses)
+{
+    struct sat_int_out out = {clauses, 0, next_var};
+
+    /* rows possible within the domains */
+    long int *selectors = g_new (long int, n_tuples + 1);
+    unsigned int n_rows = 0;
+
+    for (unsigned int r = 0; r < n_tuples; r++) {
+        const long int *row = &(tuples[(gsize) r * n]);
+        bool possible = true;
+
+        for (unsigned int k = 0; (k < n) && possible; k++) {
+            possible = (row[k] >= x[k].min) && (row[k] <= x[k].max) && (x[k].eq[sat_int_range (x[k].min, row[k])] != SAT_INT_FALSE);
+        }
+
+        selectors[r] = 0;
+        if (possible) {
+            selectors[r] = sat_int_new_var (&out);
+            n_rows++;
+        }
+    }
+
+    /* one of the rows, each row implies its values */
+    long int *clause = g_new (long int, MAX (n_tuples, n) + 2);
+    unsigned int len = 0;
+
+    for (unsigned int r = 0; r < n_tuples; r++) {
+        if (selectors[r] == 0) continue;
+        clause[len++] = selectors[r];
+
+        const long int *row = &(tuples[(gsize) r * n]);
+        for (unsigned int k = 0; k < n; k++) {
+            sat_int_clause3 (&out, -selectors[r], x[k].eq[sat_int_range (x[k].min, row[k])], 0);
+        }
+    }
+    sat_int_clause (&out, clause, len);
+
+    /* each value implies one of its supporting rows */
+    for (unsigned int k = 0; (k < n) && (n_rows > 0); k++) {
+        for (long int v = x[k].min; ; v++) {
+            long int lit = x[k].eq[sat_int_range (x[k].min, v)];
+
+            if (lit != SAT_INT_FALSE) {
+                len = 0;
+                clause[len++] = -lit;
+                for (unsigned int r = 0; r < n_tuples; r++) {
+                    if ((selectors[r] != 0) && (tuples[(gsize) r * n + k] == v)) clause[len++] = selectors[r];
+                }
+                sat_int_clause (&out, clause, len);
+            }
+
+            if (v == x[k].max) break;
+        }
+    }
+
+    g_free (clause);
+    g_free (selectors);
+
+    return out.n_clauses;
+}
@@ -0,0 +1,100 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __sat_int_h__
+#define __sat_int_h__
+
+#include <stdbool.h>
+#include <glib.h>
+
+/* constant literals of value views, they never appear in generated clauses */
+#define SAT_INT_TRUE  (G_MAXLONG)
+#define SAT_INT_FALSE (-G_MAXLONG)
+
+/* encodings of integer variables with domain min ... max (n = max - min + 1 values) */
+enum sat_int_encoding_t {
+    /* choose by domain size: direct up to 32 values, order up to 256 values, log above */
+    SAT_INT_AUTO,
+    /* one literal per value (x = v), exactly one of them true */
+    SAT_INT_DIRECT,
+    /* n - 1 literals (x >= v) for v = min + 1 ... max, each implying the previous one */
+    SAT_INT_ORDER,
+    /* binary digits of x - min, least significant first */
+    SAT_INT_LOG
+};
+
+typedef enum sat_int_encoding_t SatIntEncoding;
+
+/* literals of the values of an integer variable or constant:
+ * eq[v - min] is the literal for x = v, SAT_INT_FALSE for impossible values or SAT_INT_TRUE */
+struct sat_int_view {
+    long int       min;
+    long int       max;
+    const long int *eq;
+};
+
+/* set *encoding to the encoding with given name (e.g. "order") and return true, false for unknown names */
+bool sat_int_encoding_from_string (const char *name, SatIntEncoding *encoding);
+/* return name of encoding */
+const char * sat_int_encoding_name (SatIntEncoding encoding);
+
+/* return encoding for a variable with domain min ... max, encoding auto is resolved by domain size
+ * and single values are always encoded directly */
+SatIntEncoding sat_int_encoding_choose (SatIntEncoding encoding, long int min, long int max);
+/* return number of literals of a variable with domain min ... max in encoding (not auto) */
+unsigned int sat_int_num_lits (SatIntEncoding encoding, long int min, long int max);
+
+/* append clauses restricting the literals lits of a variable with domain min ... max in encoding to valid
+ * values to clauses (GQueue of 0-terminated arrays of literals (long int) allocated by g_slice) and return their
+ * number. If clauses is NULL, clauses are only counted. Auxiliary variables are numbered from *next_var on,
+ * which is incremented accordingly. */
+unsigned long int sat_int_append_domain (SatIntEncoding encoding, long int min, long int max, const long int *lits,
+                                         unsigned long int *next_var, GQueue *clauses);
+
+/* return literal for x = v of a variable with domain min ... max in encoding with literals lits,
+ * SAT_INT_FALSE for values outside of the domain and 0 if a defined variable is needed
+ * (see sat_int_append_eq_definition). */
+long int sat_int_eq_literal (SatIntEncoding encoding, long int min, long int max, const long int *lits, long int v);
+/* append clauses defining var equivalent to x = v (see sat_int_eq_literal) to clauses and return their number. */
+unsigned long int sat_int_append_eq_definition (SatIntEncoding encoding, long int min, long int max, const long int *lits,
+                                                long int v, long int var, GQueue *clauses);
+
+/* return value of a variable with domain min ... max in encoding, value[i] is the assignment of lits[i] */
+long int sat_int_decode (SatIntEncoding encoding, long int min, long int max, const bool *value);
+
+/* set terms of coef * x for a variable with domain min ... max in encoding with literals lits:
+ * coef * x = *offset + sum (weights[i] * term_lits[i]) for the *n_terms (at most sat_int_num_lits) terms.
+ * returns false if weights or offset would overflow. */
+bool sat_int_linear_terms (SatIntEncoding encoding, long int min, long int max, const long int *lits, long int coef,
+                           long int *term_lits, long int *weights, unsigned int *n_terms, long int *offset);
+
+/* append clauses for pairwise different values of the n views x (at most one per value, at least one
+ * per value if there are exactly as many values as variables) to clauses (see sat_int_append_domain) */
+unsigned long int sat_int_append_alldifferent (const struct sat_int_view *x, unsigned int n,
+                                               unsigned long int *next_var, GQueue *clauses);
+/* append clauses for result = entries[index] (index counted from 0, indices outside of 0 ... n - 1
+ * are excluded) to clauses (see sat_int_append_domain) */
+unsigned long int sat_int_append_element (const struct sat_int_view *index, const struct sat_int_view *entries, unsigned int n,
+                                          const struct sat_int_view *result, unsigned long int *next_var, GQueue *clauses);
+/* append clauses for (x[0], ..., x[n - 1]) being one of the n_tuples rows of tuples (n values each, row by row)
+ * to clauses (see sat_int_append_domain). Each row gets a selector variable, each value of a variable
+ * implies one of the selectors of its supporting rows. */
+unsigned long int sat_int_append_table (const struct sat_int_view *x, unsigned int n, const long int *tuples, unsigned int n_tuples,
+                                        unsigned long int *next_var, GQueue *clauses);
+
+#endif
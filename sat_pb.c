@@ -0,0 +1,868 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sat_pb.h"
+#include "sat_cardinality.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* names of encodings indexed by SatPbEncoding */
+static const char * const sat_pb_names[] = {
+    "auto",
+    "bdd",
+    "gte",
+    "adder",
+    "sortnetwork",
+    NULL
+};
+
+/* terminal nodes of BDDs */
+#define SAT_PB_TRUE  G_MAXLONG
+#define SAT_PB_FALSE (-G_MAXLONG)
+
+/* destination of generated clauses */
+struct sat_pb_out {
+    /* GQueue of clauses or NULL for counting only */
+    GQueue            *clauses;
+    unsigned long int n_clauses;
+    unsigned long int *next_var;
+    /* encoding is aborted after limit clauses if limit > 0 */
+    unsigned long int limit;
+    bool              aborted;
+};
+
+/* weighted literal of a constraint */
+struct sat_pb_term {
+    long int lit;
+    long int weight;
+};
+
+/* suffix of literals and weights of a normalized constraint, key of cached BDD nodes */
+struct sat_pb_suffix {
+    const long int *lits;
+    const long int *weights;
+    unsigned int   len;
+    guint          hash;
+};
+
+/* BDD node of a suffix for all bounds in [beta, gamma] */
+struct sat_pb_bdd_node {
+    long int beta;
+    long int gamma;
+    /* node variable, SAT_PB_TRUE or SAT_PB_FALSE */
+    long int lit;
+};
+
+struct sat_pb_cache {
+    /* hash table mapping suffixes (struct sat_pb_suffix *) to their nodes
+     * (GArray of struct sat_pb_bdd_node sorted by beta) */
+    GHashTable *tbl_suffix_to_nodes;
+    /* arrays of literals and weights (long int *) referenced by suffixes */
+    GSList     *arrays;
+};
+
+/* state of a BDD construction */
+struct sat_pb_bdd {
+    struct sat_pb_out *out;
+    const long int    *lits;
+    const long int    *weights;
+    /* sum of weights i ... n - 1 for level i */
+    long int          *suffix_sum;
+    /* nodes (GArray of struct sat_pb_bdd_node) of each level */
+    GArray            **nodes;
+};
+
+/* partial sum of a generalized totalizer node: literal is true if the sum is at least value */
+struct sat_pb_sum {
+    long int value;
+    long int lit;
+};
+
+/* set *encoding to the encoding with given name (e.g. "bdd") and return true, false for unknown names */
+bool sat_pb_encoding_from_string (const char *name, SatPbEncoding *encoding)
+{
+    if (name == NULL) return false;
+
+    for (int i = 0; sat_pb_names[i] != NULL; i++) {
+        if (strcmp (name, sat_pb_names[i]) == 0) {
+            if (encoding != NULL) *encoding = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* return name of encoding */
+const char * sat_pb_encoding_name (SatPbEncoding encoding)
+{
+    if (encoding > SAT_PB_SORTING_NETWORK) return NULL;
+    return sat_pb_names[encoding];
+}
+
+/* return a + b saturated at G_MINLONG and G_MAXLONG */
+static long int sat_pb_add (long int a, long int b)
+{
+    if ((b > 0) && (a > G_MAXLONG - b)) return G_MAXLONG;
+    if ((b < 0) && (a < G_MINLONG - b)) return G_MINLONG;
+    return a + b;
+}
+
+/* append clause of len literals to out */
+static void sat_pb_clause (struct sat_pb_out *out, const long int *lits, unsigned int len)
+{
+    out->n_clauses++;
+    if ((out->limit > 0) && (out->n_clauses > out->limit)) out->aborted = true;
+    if (out->clauses == NULL) return;
+
+    long int *clause = g_slice_alloc (sizeof (long int) * (len + 1));
+    if (len > 0) memcpy (clause, lits, sizeof (long int) * len);
+    clause[len] = 0;
+
+    g_queue_push_tail (out->clauses, clause);
+}
+
+/* append clause of literals a, b and c to out, 0 literals are left out */
+static void sat_pb_clause3 (struct sat_pb_out *out, long int a, long int b, long int c)
+{
+    long int clause[3];
+    unsigned int len = 0;
+
+    if (a != 0) clause[len++] = a;
+    if (b != 0) clause[len++] = b;
+    if (c != 0) clause[len++] = c;
+
+    sat_pb_clause (out, clause, len);
+}
+
+/* return a new auxiliary variable */
+static inline long int sat_pb_new_var (struct sat_pb_out *out)
+{
+    long int var = *(out->next_var);
+    (*(out->next_var))++;
+    return var;
+}
+
+/* GHashFunc of struct sat_pb_suffix */
+static guint sat_pb_suffix_hash (gconstpointer key)
+{
+    return ((const struct sat_pb_suffix *) key)->hash;
+}
+
+/* GEqualFunc of struct sat_pb_suffix */
+static gboolean sat_pb_suffix_equal (gconstpointer a, gconstpointer b)
+{
+    const struct sat_pb_suffix *sa = a;
+    const struct sat_pb_suffix *sb = b;
+
+    if ((sa->hash != sb->hash) || (sa->len != sb->len)) return false;
+    if (memcmp (sa->lits, sb->lits, sizeof (long int) * sa->len) != 0) return false;
+    return (memcmp (sa->weights, sb->weights, sizeof (long int) * sa->len) == 0);
+}
+
+/* GDestroyNotify of struct sat_pb_suffix */
+static void sat_pb_suffix_free (gpointer data)
+{
+    g_slice_free (struct sat_pb_suffix, data);
+}
+
+/* GDestroyNotify of node arrays */
+static void sat_pb_nodes_free (gpointer data)
+{
+    g_array_free ((GArray *) data, true);
+}
+
+/* create a new, empty cache */
+SatPbCache sat_pb_cache_new (void)
+{
+    struct sat_pb_cache *result = g_slice_new (struct sat_pb_cache);
+
+    result->tbl_suffix_to_nodes = g_hash_table_new_full (sat_pb_suffix_hash, sat_pb_suffix_equal,
+                                                         sat_pb_suffix_free, sat_pb_nodes_free);
+    result->arrays = NULL;
+
+    return result;
+}
+
+/* remove all nodes from cache, e.g. if their variables are no longer valid */
+void sat_pb_cache_clear (SatPbCache cache)
+{
+    if (cache == NULL) return;
+
+    g_hash_table_remove_all (cache->tbl_suffix_to_nodes);
+    g_slist_free_full (cache->arrays, g_free);
+    cache->arrays = NULL;
+}
+
+/* free cache and set *cache to NULL */
+void sat_pb_cache_free (SatPbCache *cache)
+{
+    if (cache == NULL) return;
+    if (*cache == NULL) return;
+
+    sat_pb_cache_clear (*cache);
+    g_hash_table_destroy ((*cache)->tbl_suffix_to_nodes);
+    g_slice_free (struct sat_pb_cache, *cache);
+
+    *cache = NULL;
+}
+
+/* return node of bdd for level i and bound k, new nodes are created with their clauses */
+static struct sat_pb_bdd_node sat_pb_bdd_build (struct sat_pb_bdd *bdd, unsigned int i, long int k)
+{
+    struct sat_pb_bdd_node result;
+
+    if (k < 0) {
+        result.beta  = G_MINLONG;
+        result.gamma = -1;
+        result.lit   = SAT_PB_FALSE;
+        return result;
+    }
+    if (k >= bdd->suffix_sum[i]) {
+        result.beta  = bdd->suffix_sum[i];
+        result.gamma = G_MAXLONG;
+        result.lit   = SAT_PB_TRUE;
+        return result;
+    }
+
+    /* existing node: last one with beta <= k */
+    GArray *nodes = bdd->nodes[i];
+    guint lower = 0;
+    guint upper = nodes->len;
+    while (lower < upper) {
+        guint middle = (lower + upper) / 2;
+        if (g_array_index (nodes, struct sat_pb_bdd_node, middle).beta <= k) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+    if ((lower > 0) && (g_array_index (nodes, struct sat_pb_bdd_node, lower - 1).gamma >= k)) {
+        return g_array_index (nodes, struct sat_pb_bdd_node, lower - 1);
+    }
+
+    if (bdd->out->aborted) {
+        result.beta  = k;
+        result.gamma = k;
+        result.lit   = SAT_PB_FALSE;
+        return result;
+    }
+
+    long int weight = bdd->weights[i];
+    struct sat_pb_bdd_node high = sat_pb_bdd_build (bdd, i + 1, k - weight);
+    struct sat_pb_bdd_node low  = sat_pb_bdd_build (bdd, i + 1, k);
+
+    result.beta  = MAX (low.beta, sat_pb_add (high.beta, weight));
+    result.gamma = MIN (low.gamma, sat_pb_add (high.gamma, weight));
+
+    if (high.lit == low.lit) {
+        result.lit = low.lit;
+    } else {
+        /* node -> low, node and literal -> high */
+        result.lit = sat_pb_new_var (bdd->out);
+        if (low.lit != SAT_PB_TRUE) {
+            sat_pb_clause3 (bdd->out, -result.lit, low.lit, 0);
+        }
+        if (high.lit == SAT_PB_FALSE) {
+            sat_pb_clause3 (bdd->out, -result.lit, -bdd->lits[i], 0);
+        } else if (high.lit != SAT_PB_TRUE) {
+            sat_pb_clause3 (bdd->out, -result.lit, -bdd->lits[i], high.lit);
+        }
+    }
+
+    if (!bdd->out->aborted) g_array_insert_val (nodes, lower, result);
+
+    return result;
+}
+
+/* BDD encoding of normalized constraint, nodes are shared with cache if not NULL */
+static void sat_pb_bdd (struct sat_pb_out *out, const long int *lits, const long int *weights, unsigned int n,
+                        long int k, SatPbCache cache)
+{
+    SatPbCache local_cache = NULL;
+    if (cache == NULL) {
+        local_cache = sat_pb_cache_new ();
+        cache       = local_cache;
+    }
+
+    struct sat_pb_bdd bdd;
+    bdd.out        = out;
+    bdd.lits       = lits;
+    bdd.weights    = weights;
+    bdd.suffix_sum = g_new (long int, n + 1);
+    bdd.nodes      = g_new (GArray *, n);
+
+    bdd.suffix_sum[n] = 0;
+    for (unsigned int i = n; i > 0; i--) {
+        bdd.suffix_sum[i - 1] = sat_pb_add (bdd.suffix_sum[i], weights[i - 1]);
+    }
+
+    /* node arrays of suffixes from cache, literals and weights are copied for new suffixes */
+    long int *copy = NULL;
+    guint hash     = 0;
+
+    for (unsigned int i = n; i > 0; i--) {
+        hash = hash * 1000003 + (guint) (lits[i - 1] * 31 + weights[i - 1]);
+
+        struct sat_pb_suffix suffix = {&(lits[i - 1]), &(weights[i - 1]), n - i + 1, hash};
+
+        GArray *nodes = g_hash_table_lookup (cache->tbl_suffix_to_nodes, &suffix);
+        if (nodes == NULL) {
+            if (copy == NULL) {
+                copy = g_new (long int, 2 * n);
+                memcpy (copy, lits, sizeof (long int) * n);
+                memcpy (&(copy[n]), weights, sizeof (long int) * n);
+                cache->arrays = g_slist_prepend (cache->arrays, copy);
+            }
+
+            struct sat_pb_suffix *key = g_slice_new (struct sat_pb_suffix);
+            key->lits    = &(copy[i - 1]);
+            key->weights = &(copy[n + i - 1]);
+            key->len     = suffix.len;
+            key->hash    = hash;
+
+            nodes = g_array_new (false, false, sizeof (struct sat_pb_bdd_node));
+            g_hash_table_insert (cache->tbl_suffix_to_nodes, key, nodes);
+        }
+
+        bdd.nodes[i - 1] = nodes;
+    }
+
+    struct sat_pb_bdd_node root = sat_pb_bdd_build (&bdd, 0, k);
+
+    if (root.lit == SAT_PB_FALSE) {
+        sat_pb_clause (out, NULL, 0);
+    } else if (root.lit != SAT_PB_TRUE) {
+        sat_pb_clause3 (out, root.lit, 0, 0);
+    }
+
+    g_free (bdd.suffix_sum);
+    g_free (bdd.nodes);
+    sat_pb_cache_free (&local_cache);
+}
+
+/* GCompareFunc of struct sat_pb_sum by value */
+static gint sat_pb_sum_compare (gconstpointer a, gconstpointer b)
+{
+    long int va = ((const struct sat_pb_sum *) a)->value;
+    long int vb = ((const struct sat_pb_sum *) b)->value;
+
+    return (va > vb) - (va < vb);
+}
+
+/* generalized totalizer node of n literals: return its partial sums (GArray of struct sat_pb_sum) limited
+ * to k + 1. For the root no outputs are created, only sums above k are forbidden. */
+static GArray * sat_pb_gte_node (struct sat_pb_out *out, const long int *lits, const long int *weights, unsigned int n,
+                                 long int k, bool root)
+{
+    GArray *result = g_array_new (false, false, sizeof (struct sat_pb_sum));
+
+    if (n == 1) {
+        struct sat_pb_sum sum = {weights[0], lits[0]};
+        g_array_append_val (result, sum);
+        return result;
+    }
+
+    GArray *left  = sat_pb_gte_node (out, lits, weights, n / 2, k, false);
+    GArray *right = sat_pb_gte_node (out, &(lits[n / 2]), &(weights[n / 2]), n - n / 2, k, false);
+
+    /* output variables of reachable sums */
+    GHashTable *tbl_value_to_lit = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    /* pairs of partial sums including the empty sum 0 */
+    for (guint a = 0; (a <= left->len) && !out->aborted; a++) {
+        struct sat_pb_sum sa = {0, 0};
+        if (a < left->len) sa = g_array_index (left, struct sat_pb_sum, a);
+
+        for (guint b = 0; b <= right->len; b++) {
+            struct sat_pb_sum sb = {0, 0};
+            if (b < right->len) sb = g_array_index (right, struct sat_pb_sum, b);
+
+            if ((sa.lit == 0) && (sb.lit == 0)) continue;
+
+            long int value = MIN (sa.value + sb.value, k + 1);
+
+            if (root) {
+                if (value > k) sat_pb_clause3 (out, -sa.lit, -sb.lit, 0);
+                continue;
+            }
+
+            long int lit = GPOINTER_TO_SIZE (g_hash_table_lookup (tbl_value_to_lit, GSIZE_TO_POINTER (value)));
+            if (lit == 0) {
+                lit = sat_pb_new_var (out);
+                g_hash_table_insert (tbl_value_to_lit, GSIZE_TO_POINTER (value), GSIZE_TO_POINTER (lit));
+
+                struct sat_pb_sum sum = {value, lit};
+                g_array_append_val (result, sum);
+            }
+
+            sat_pb_clause3 (out, -sa.lit, -sb.lit, lit);
+        }
+    }
+
+    g_array_sort (result, sat_pb_sum_compare);
+
+    g_hash_table_destroy (tbl_value_to_lit);
+    g_array_free (left, true);
+    g_array_free (right, true);
+
+    return result;
+}
+
+/* generalized totalizer encoding of normalized constraint */
+static void sat_pb_gte (struct sat_pb_out *out, const long int *lits, const long int *weights, unsigned int n, long int k)
+{
+    GArray *sums = sat_pb_gte_node (out, lits, weights, n, k, true);
+    g_array_free (sums, true);
+}
+
+/* append clauses of a generalized totalizer with outputs for bounds sum <= bound, bound <= cap, see header */
+unsigned long int sat_pb_totalizer_append (const long int *lits, const long int *weights, unsigned int n, long int cap,
+                                           unsigned long int max_clauses, GArray *sums, GArray *outputs,
+                                           unsigned long int *next_var, GQueue *clauses)
+{
+    struct sat_pb_out out = {clauses, 0, next_var, max_clauses, false};
+
+    if (n == 0) return 0;
+
+    guint n_queued = (clauses != NULL ? g_queue_get_length (clauses) : 0);
+    unsigned long int first_var = *next_var;
+
+    GArray *root = sat_pb_gte_node (&out, lits, weights, n, cap, false);
+
+    if (out.aborted) {
+        while ((clauses != NULL) && (g_queue_get_length (clauses) > n_queued)) {
+            long int *clause = g_queue_pop_tail (clauses);
+            unsigned int len = 0;
+            while (clause[len] != 0) len++;
+            g_slice_free1 (sizeof (long int) * (len + 1), clause);
+        }
+        *next_var = first_var;
+        g_array_free (root, true);
+        return 0;
+    }
+
+    for (guint i = 0; i < root->len; i++) {
+        struct sat_pb_sum *sum = &g_array_index (root, struct sat_pb_sum, i);
+        g_array_append_val (sums, sum->value);
+        g_array_append_val (outputs, sum->lit);
+    }
+    g_array_free (root, true);
+
+    return out.n_clauses;
+}
+
+/* full adder (c == 0) or half adder of x, y and c: return sum bit, carry bit is set to *carry */
+static long int sat_pb_full_adder (struct sat_pb_out *out, long int x, long int y, long int c, long int *carry)
+{
+    long int inputs[3] = {x, y, c};
+    unsigned int n_inputs = (c == 0 ? 2 : 3);
+
+    long int sum = sat_pb_new_var (out);
+    *carry = sat_pb_new_var (out);
+
+    /* sum is the parity of the inputs: one clause per assignment of the inputs */
+    for (unsigned int mask = 0; mask < (1U << n_inputs); mask++) {
+        long int clause[4];
+        bool parity = false;
+
+        for (unsigned int i = 0; i < n_inputs; i++) {
+            bool value = ((mask >> i) & 1);
+            clause[i] = (value ? -inputs[i] : inputs[i]);
+            parity ^= value;
+        }
+        clause[n_inputs] = (parity ? sum : -sum);
+
+        sat_pb_clause (out, clause, n_inputs + 1);
+    }
+
+    /* carry is the majority of the inputs */
+    if (n_inputs == 2) {
+        sat_pb_clause3 (out, -x, -y, *carry);
+        sat_pb_clause3 (out, x, -*carry, 0);
+        sat_pb_clause3 (out, y, -*carry, 0);
+    } else {
+        for (unsigned int i = 0; i < 3; i++) {
+            long int a = inputs[i];
+            long int b = inputs[(i + 1) % 3];
+            sat_pb_clause3 (out, -a, -b, *carry);
+            sat_pb_clause3 (out, a, b, -*carry);
+        }
+    }
+
+    return sum;
+}
+
+/* forbid that the binary number of bits (long int, least significant first, 0 for constant false) exceeds k:
+ * for each bit i with k_i = 0, bit i and all higher bits j with k_j = 1 must not be true together */
+static void sat_pb_binary_compare (struct sat_pb_out *out, GArray *bits, long int k)
+{
+    GArray *clause = g_array_new (false, false, sizeof (long int));
+
+    for (guint i = 0; i < bits->len; i++) {
+        long int bit = g_array_index (bits, long int, i);
+        if ((bit == 0) || (((k >> i) & 1) != 0)) continue;
+
+        g_array_set_size (clause, 0);
+        g_array_append_val (clause, bit);
+
+        bool constant_false = false;
+        for (guint j = i + 1; j < sizeof (long int) * 8 - 1; j++) {
+            if (((k >> j) & 1) == 0) continue;
+
+            long int bit_j = (j < bits->len ? g_array_index (bits, long int, j) : 0);
+            if (bit_j == 0) {
+                constant_false = true;
+                break;
+            }
+            g_array_append_val (clause, bit_j);
+        }
+        if (constant_false) continue;
+
+        for (guint j = 0; j < clause->len; j++) g_array_index (clause, long int, j) *= -1;
+        sat_pb_clause (out, (long int *) clause->data, clause->len);
+    }
+
+    g_array_free (clause, true);
+}
+
+/* adder network encoding of normalized constraint */
+static void sat_pb_adder (struct sat_pb_out *out, const long int *lits, const long int *weights, unsigned int n, long int k)
+{
+    /* literals of each binary digit */
+    GPtrArray *buckets = g_ptr_array_new_with_free_func ((GDestroyNotify) g_queue_free);
+
+    for (unsigned int i = 0; i < n; i++) {
+        for (guint b = 0; (weights[i] >> b) != 0; b++) {
+            while (buckets->len <= b) g_ptr_array_add (buckets, g_queue_new ());
+            if (((weights[i] >> b) & 1) != 0) {
+                g_queue_push_tail (g_ptr_array_index (buckets, b), GSIZE_TO_POINTER (lits[i]));
+            }
+        }
+    }
+
+    /* reduce each digit to a single bit by adders, carries to the next digit */
+    GArray *bits = g_array_new (false, false, sizeof (long int));
+
+    for (guint b = 0; b < buckets->len; b++) {
+        GQueue *bucket = g_ptr_array_index (buckets, b);
+
+        while (g_queue_get_length (bucket) >= 2) {
+            long int x = GPOINTER_TO_SIZE (g_queue_pop_head (bucket));
+            long int y = GPOINTER_TO_SIZE (g_queue_pop_head (bucket));
+            long int z = (g_queue_is_empty (bucket) ? 0 : (long int) GPOINTER_TO_SIZE (g_queue_pop_head (bucket)));
+            long int carry;
+
+            long int sum = sat_pb_full_adder (out, x, y, z, &carry);
+
+            g_queue_push_tail (bucket, GSIZE_TO_POINTER (sum));
+            if (buckets->len <= b + 1) g_ptr_array_add (buckets, g_queue_new ());
+            g_queue_push_tail (g_ptr_array_index (buckets, b + 1), GSIZE_TO_POINTER (carry));
+        }
+
+        long int bit = (g_queue_is_empty (bucket) ? 0 : (long int) GPOINTER_TO_SIZE (g_queue_pop_head (bucket)));
+        g_array_append_val (bits, bit);
+    }
+
+    sat_pb_binary_compare (out, bits, k);
+
+    g_array_free (bits, true);
+    g_ptr_array_free (buckets, true);
+}
+
+/* sorting network encoding of normalized constraint: digit b sorts the literals with bit b set in their
+ * weight and the carries (every second output) of digit b - 1. The most significant digit keeps its count,
+ * lower digits are represented by the parity of their count. */
+static void sat_pb_sorting_network (struct sat_pb_out *out, const long int *lits, const long int *weights, unsigned int n, long int k)
+{
+    unsigned int top = 0;
+    while ((weights[0] >> (top + 1)) != 0) top++;
+
+    /* sorted outputs and parity variable (0 if count is constant 0) of each digit */
+    GArray  **digits = g_new (GArray *, top + 1);
+    long int *parity = g_new0 (long int, top + 1);
+
+    GArray *inputs = g_array_new (false, false, sizeof (long int));
+
+    for (unsigned int b = 0; b <= top; b++) {
+        if (b > 0) {
+            GArray *previous = digits[b - 1];
+            g_array_set_size (inputs, 0);
+            for (guint j = 1; j < previous->len; j += 2) g_array_append_val (inputs, g_array_index (previous, long int, j));
+        }
+        for (unsigned int i = 0; i < n; i++) {
+            if (((weights[i] >> b) & 1) != 0) g_array_append_val (inputs, lits[i]);
+        }
+
+        digits[b] = g_array_new (false, false, sizeof (long int));
+        out->n_clauses += sat_cardinality_append_sorter ((long int *) inputs->data, inputs->len, digits[b],
+                                                         out->next_var, out->clauses);
+
+        /* odd count -> parity */
+        GArray *sorted = digits[b];
+        if ((b < top) && (sorted->len > 0)) {
+            parity[b] = sat_pb_new_var (out);
+            for (guint j = 0; j < sorted->len; j += 2) {
+                long int next = (j + 1 < sorted->len ? g_array_index (sorted, long int, j + 1) : 0);
+                sat_pb_clause3 (out, -g_array_index (sorted, long int, j), next, parity[b]);
+            }
+        }
+    }
+
+    /* the number exceeds k if a digit exceeds the digit of k and all higher digits are at least those of k */
+    GArray  *top_digit = digits[top];
+    long int k_top     = k >> top;
+
+    if ((guint) k_top < top_digit->len) {
+        sat_pb_clause3 (out, -g_array_index (top_digit, long int, k_top), 0, 0);
+    }
+
+    GArray *clause = g_array_new (false, false, sizeof (long int));
+
+    for (unsigned int b = 0; b < top; b++) {
+        if ((((k >> b) & 1) != 0) || (parity[b] == 0)) continue;
+
+        g_array_set_size (clause, 0);
+        long int lit = -parity[b];
+        g_array_append_val (clause, lit);
+
+        bool constant_false = false;
+        for (unsigned int j = b + 1; j < top; j++) {
+            if (((k >> j) & 1) == 0) continue;
+            if (parity[j] == 0) {
+                constant_false = true;
+                break;
+            }
+            lit = -parity[j];
+            g_array_append_val (clause, lit);
+        }
+        if ((guint) (k_top - 1) >= top_digit->len) constant_false = true;
+        if (constant_false) continue;
+
+        lit = -g_array_index (top_digit, long int, k_top - 1);
+        g_array_append_val (clause, lit);
+
+        sat_pb_clause (out, (long int *) clause->data, clause->len);
+    }
+
+    g_array_free (clause, true);
+    g_array_free (inputs, true);
+    for (unsigned int b = 0; b <= top; b++) g_array_free (digits[b], true);
+    g_free (digits);
+    g_free (parity);
+}
+
+/* encode normalized constraint with given encoding (not auto) */
+static void sat_pb_encode (struct sat_pb_out *out, SatPbEncoding encoding, const long int *lits, const long int *weights,
+                           unsigned int n, long int k, SatPbCache cache)
+{
+    switch (encoding) {
+        case SAT_PB_BDD:
+            sat_pb_bdd (out, lits, weights, n, k, cache);
+            break;
+        case SAT_PB_GENERALIZED_TOTALIZER:
+            sat_pb_gte (out, lits, weights, n, k);
+            break;
+        case SAT_PB_ADDER:
+            sat_pb_adder (out, lits, weights, n, k);
+            break;
+        case SAT_PB_SORTING_NETWORK:
+        default:
+            sat_pb_sorting_network (out, lits, weights, n, k);
+            break;
+    }
+}
+
+/* return the encoding of normalized constraint with least clauses + 2 * auxiliary variables */
+static SatPbEncoding sat_pb_choose (const long int *lits, const long int *weights, unsigned int n, long int k)
+{
+    static const SatPbEncoding candidates[] = {SAT_PB_ADDER, SAT_PB_SORTING_NETWORK, SAT_PB_GENERALIZED_TOTALIZER, SAT_PB_BDD};
+
+    SatPbEncoding best = SAT_PB_ADDER;
+    unsigned long int best_cost = 0;
+
+    for (unsigned int i = 0; i < G_N_ELEMENTS (candidates); i++) {
+        unsigned long int next_var = 1;
+        struct sat_pb_out out = {NULL, 0, &next_var, best_cost, false};
+
+        sat_pb_encode (&out, candidates[i], lits, weights, n, k, NULL);
+        if (out.aborted) continue;
+
+        unsigned long int cost = out.n_clauses + 2 * (next_var - 1);
+        if ((best_cost == 0) || (cost < best_cost)) {
+            best      = candidates[i];
+            best_cost = cost;
+        }
+    }
+
+    return best;
+}
+
+/* qsort compare function of struct sat_pb_term by variable, then literal */
+static int sat_pb_term_compare_var (const void *a, const void *b)
+{
+    const struct sat_pb_term *ta = a;
+    const struct sat_pb_term *tb = b;
+
+    long int va = labs (ta->lit);
+    long int vb = labs (tb->lit);
+    if (va != vb) return (va > vb) - (va < vb);
+
+    return (ta->lit > tb->lit) - (ta->lit < tb->lit);
+}
+
+/* qsort compare function of struct sat_pb_term by descending weight, then literal */
+static int sat_pb_term_compare_weight (const void *a, const void *b)
+{
+    const struct sat_pb_term *ta = a;
+    const struct sat_pb_term *tb = b;
+
+    if (ta->weight != tb->weight) return (ta->weight < tb->weight) - (ta->weight > tb->weight);
+
+    return (ta->lit > tb->lit) - (ta->lit < tb->lit);
+}
+
+/* append clauses for sum (weights[i] * lits[i]) <= bound over the n literals lits to clauses (GQueue of
+ * 0-terminated arrays of literals (long int) allocated by g_slice) and return their number. If clauses is NULL,
+ * clauses are only counted. Weights may be negative or zero, literals may repeat. The constraint is normalized
+ * first: negative weights are moved to the negated literal, literals of the same variable are merged, literals
+ * whose weight exceeds the bound are fixed to false by unit clauses and weights are divided by their greatest
+ * common divisor. With encoding auto, constraints with equal weights are passed to sat_cardinality_append.
+ * Auxiliary variables are numbered from *next_var on, which is incremented accordingly. BDD nodes are looked
+ * up in and added to cache if not NULL, so the variables of all cached constraints have to remain valid. */
+unsigned long int sat_pb_append (SatPbEncoding encoding, const long int *lits, const long int *weights, unsigned int n,
+                                 long int bound, SatPbCache cache, unsigned long int *next_var, GQueue *clauses)
+{
+    struct sat_pb_out out = {clauses, 0, next_var, 0, false};
+
+    /* positive weights: w * -x = w - w * x */
+    struct sat_pb_term *terms = g_new (struct sat_pb_term, n + 1);
+    unsigned int n_terms = 0;
+
+    for (unsigned int i = 0; i < n; i++) {
+        if ((weights[i] == 0) || (lits[i] == 0)) continue;
+
+        if (weights[i] < 0) {
+            terms[n_terms].lit    = -lits[i];
+            terms[n_terms].weight = (weights[i] == G_MINLONG ? G_MAXLONG : -weights[i]);
+            bound = sat_pb_add (bound, terms[n_terms].weight);
+        } else {
+            terms[n_terms].lit    = lits[i];
+            terms[n_terms].weight = weights[i];
+        }
+        n_terms++;
+    }
+
+    /* merge literals of the same variable: w1 * x + w2 * -x = w2 + (w1 - w2) * x */
+    qsort (terms, n_terms, sizeof (struct sat_pb_term), sat_pb_term_compare_var);
+
+    unsigned int n_merged = 0;
+    for (unsigned int i = 0; i < n_terms; i++) {
+        if ((n_merged > 0) && (labs (terms[n_merged - 1].lit) == labs (terms[i].lit))) {
+            struct sat_pb_term *last = &(terms[n_merged - 1]);
+
+            if (last->lit == terms[i].lit) {
+                last->weight = sat_pb_add (last->weight, terms[i].weight);
+            } else {
+                long int common = MIN (last->weight, terms[i].weight);
+                bound = sat_pb_add (bound, -common);
+
+                if (last->weight == common) {
+                    last->lit    = terms[i].lit;
+                    last->weight = terms[i].weight - common;
+                } else {
+                    last->weight -= common;
+                }
+                if (last->weight == 0) n_merged--;
+            }
+        } else {
+            terms[n_merged++] = terms[i];
+        }
+    }
+    n_terms = n_merged;
+
+    if (bound < 0) {
+        sat_pb_clause (&out, NULL, 0);
+        g_free (terms);
+        return out.n_clauses;
+    }
+
+    /* fix literals exceeding the bound on their own */
+    long int sum = 0;
+    n_merged = 0;
+    for (unsigned int i = 0; i < n_terms; i++) {
+        if (terms[i].weight > bound) {
+            sat_pb_clause3 (&out, -terms[i].lit, 0, 0);
+        } else {
+            sum = sat_pb_add (sum, terms[i].weight);
+            terms[n_merged++] = terms[i];
+        }
+    }
+    n_terms = n_merged;
+
+    if (sum <= bound) {
+        g_free (terms);
+        return out.n_clauses;
+    }
+
+    /* divide by greatest common divisor */
+    long int gcd = 0;
+    for (unsigned int i = 0; i < n_terms; i++) {
+        long int a = terms[i].weight;
+        long int b = gcd;
+        while (b != 0) {
+            long int t = a % b;
+            a = b;
+            b = t;
+        }
+        gcd = a;
+    }
+    for (unsigned int i = 0; i < n_terms; i++) terms[i].weight /= gcd;
+    bound /= gcd;
+
+    qsort (terms, n_terms, sizeof (struct sat_pb_term), sat_pb_term_compare_weight);
+
+    long int *norm_lits    = g_new (long int, n_terms);
+    long int *norm_weights = g_new (long int, n_terms);
+    for (unsigned int i = 0; i < n_terms; i++) {
+        norm_lits[i]    = terms[i].lit;
+        norm_weights[i] = terms[i].weight;
+    }
+    g_free (terms);
+
+    if (encoding == SAT_PB_AUTO) {
+        if (norm_weights[0] == norm_weights[n_terms - 1]) {
+            /* cardinality constraint */
+            out.n_clauses += sat_cardinality_append (SAT_CARDINALITY_AUTO, norm_lits, n_terms, 0, bound / norm_weights[0],
+                                                     next_var, clauses);
+            g_free (norm_lits);
+            g_free (norm_weights);
+            return out.n_clauses;
+        }
+
+        encoding = sat_pb_choose (norm_lits, norm_weights, n_terms, bound);
+    }
+
+    sat_pb_encode (&out, encoding, norm_lits, norm_weights, n_terms, bound, cache);
+
+    g_free (norm_lits);
+    g_free (norm_weights);
+
+    return out.n_clauses;
+}
@@ -0,0 +1,78 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __sat_pb_h__
+#define __sat_pb_h__
+
+#include <stdbool.h>
+#include <glib.h>
+
+/* clause encodings of pseudo-Boolean constraints sum (w_i * x_i) <= k */
+enum sat_pb_encoding_t {
+    /* choose encoding with least clauses and auxiliary variables */
+    SAT_PB_AUTO,
+    /* reduced ordered BDD with interval merging of equivalent nodes (Abio et al.) */
+    SAT_PB_BDD,
+    /* generalized totalizer: tree of all reachable partial sums (Joshi et al.) */
+    SAT_PB_GENERALIZED_TOTALIZER,
+    /* network of binary full and half adders and comparator (Een, Soerensson) */
+    SAT_PB_ADDER,
+    /* sorting networks per binary digit with carries and comparator (Een, Soerensson) */
+    SAT_PB_SORTING_NETWORK
+};
+
+typedef enum sat_pb_encoding_t SatPbEncoding;
+
+/* cache of BDD nodes shared between constraints with equal suffixes of literals and weights */
+typedef struct sat_pb_cache *SatPbCache;
+
+/* set *encoding to the encoding with given name (e.g. "bdd") and return true, false for unknown names */
+bool sat_pb_encoding_from_string (const char *name, SatPbEncoding *encoding);
+/* return name of encoding */
+const char * sat_pb_encoding_name (SatPbEncoding encoding);
+
+/* create a new, empty cache */
+SatPbCache sat_pb_cache_new (void);
+/* remove all nodes from cache, e.g. if their variables are no longer valid */
+void sat_pb_cache_clear (SatPbCache cache);
+/* free cache and set *cache to NULL */
+void sat_pb_cache_free (SatPbCache *cache);
+
+/* append clauses for sum (weights[i] * lits[i]) <= bound over the n literals lits to clauses (GQueue of
+ * 0-terminated arrays of literals (long int) allocated by g_slice) and return their number. If clauses is NULL,
+ * clauses are only counted. Weights may be negative or zero, literals may repeat. The constraint is normalized
+ * first: negative weights are moved to the negated literal, literals of the same variable are merged, literals
+ * whose weight exceeds the bound are fixed to false by unit clauses and weights are divided by their greatest
+ * common divisor. With encoding auto, constraints with equal weights are passed to sat_cardinality_append.
+ * Auxiliary variables are numbered from *next_var on, which is incremented accordingly. BDD nodes are looked
+ * up in and added to cache if not NULL, so the variables of all cached constraints have to remain valid. */
+unsigned long int sat_pb_append (SatPbEncoding encoding, const long int *lits, const long int *weights, unsigned int n,
+                                 long int bound, SatPbCache cache, unsigned long int *next_var, GQueue *clauses);
+
+/* append clauses of a generalized totalizer over the n literals lits with positive weights to clauses (as for
+ * sat_pb_append) and return their number. The reachable sums of weights (limited to cap + 1) are appended to sums
+ * in ascending order and their output literals (long int) to outputs. The output of the sum of the true literals
+ * is implied, so sum (weights[i] * lits[i]) <= bound (bound <= cap) is enforced by unit clauses fixing all outputs
+ * of greater sums to false: bounds can be tightened without new auxiliary variables. If more than max_clauses
+ * clauses (0: no limit) would be needed, nothing is appended, sums and outputs are not changed and 0 is returned.
+ * Auxiliary variables are numbered from *next_var on, which is incremented accordingly. */
+unsigned long int sat_pb_totalizer_append (const long int *lits, const long int *weights, unsigned int n, long int cap,
+                                           unsigned long int max_clauses, GArray *sums, GArray *outputs,
+                                           unsigned long int *next_var, GQueue *clauses);
+
+#endif
@@ -0,0 +1,1511 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sat_preprocess.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* clause of preprocessing working copy */
+struct sat_preprocess_clause {
+    /* true if clause has been removed from formula */
+    bool removed;
+    /* number of literals */
+    unsigned int size;
+    /* number of allocated literals */
+    unsigned int capacity;
+    /* literals (long int) */
+    long int *lits;
+};
+
+/* preprocessing data struct */
+struct sat_preprocess {
+    /* greatest variable including auxiliary variables of re-encoded constraints */
+    unsigned long int max_var;
+    /* greatest variable of the input, solutions are extended to these variables */
+    unsigned long int input_max_var;
+
+    /* GPtrArray of all clauses (struct sat_preprocess_clause *) including removed ones */
+    GPtrArray *clauses;
+    /* occurrence lists indexed by literal index as GArray of clause indices (guint),
+     * they may contain removed clauses */
+    GArray **occurrences;
+
+    /* value per variable: 0 unassigned, 1 true, -1 false */
+    signed char *value;
+    /* true for variables without remaining occurrences after elimination */
+    bool *eliminated;
+    /* temporary marks per literal index */
+    unsigned char *mark;
+
+    /* assigned literals (long int) in order of assignment */
+    GArray *unit_queue;
+    /* index of next literal in unit_queue to propagate */
+    guint  unit_queue_head;
+
+    /* removed clauses for model reconstruction: literals with witness literal first followed by the clause size */
+    GArray *reconstruction;
+
+    /* true if formula is unsatisfiable */
+    bool unsat;
+
+    /* statistics */
+    unsigned long int n_input_clauses;
+    unsigned long int n_fixed;
+    unsigned long int n_pure;
+    unsigned long int n_eliminated;
+    unsigned long int n_subsumed;
+    unsigned long int n_strengthened;
+    unsigned long int n_blocked;
+    unsigned long int n_substituted;
+    unsigned long int n_duplicates;
+    unsigned long int n_cardinality;
+    unsigned long int n_cardinality_removed;
+    unsigned long int n_cardinality_added;
+    unsigned long int n_auxiliary;
+};
+
+/* return index of literal for occurrence lists and marks */
+static inline guint sat_preprocess_lit_index (long int lit)
+{
+    return (lit > 0 ? 2 * lit : 2 * (-lit) + 1);
+}
+
+/* return value of literal: 0 unassigned, 1 true, -1 false */
+static inline int sat_preprocess_lit_value (struct sat_preprocess *pre, long int lit)
+{
+    int val = pre->value[lit > 0 ? lit : -lit];
+    return (lit > 0 ? val : -val);
+}
+
+/* return clause with index ci */
+static inline struct sat_preprocess_clause * sat_preprocess_clause (struct sat_preprocess *pre, guint ci)
+{
+    return (struct sat_preprocess_clause *) g_ptr_array_index (pre->clauses, ci);
+}
+
+/* set options to default values: all passes enabled with moderate budgets */
+void sat_preprocess_options_default (struct sat_preprocess_options *options)
+{
+    if (options == NULL) return;
+
+    options->equivalent_literals    = true;
+    options->pure_literals          = true;
+    options->subsumption            = true;
+    options->variable_elimination   = true;
+    options->blocked_clauses        = true;
+    options->cardinality            = true;
+
+    options->elim_max_occurrences   = 16;
+    options->elim_max_growth        = 0;
+    options->elim_max_clause_length = 16;
+    options->max_steps              = 100000000;
+}
+
+/* assign literal to true and queue it for propagation */
+static void sat_preprocess_assign (struct sat_preprocess *pre, long int lit)
+{
+    int val = sat_preprocess_lit_value (pre, lit);
+
+    if (val > 0) return;
+    if (val < 0) {
+        pre->unsat = true;
+        return;
+    }
+
+    pre->value[lit > 0 ? lit : -lit] = (lit > 0 ? 1 : -1);
+    g_array_append_val (pre->unit_queue, lit);
+    pre->n_fixed++;
+}
+
+/* add clause given as array of n literals (long int) simplified by current assignment */
+static void sat_preprocess_add_clause (struct sat_preprocess *pre, const long int *lits, unsigned int n)
+{
+    if (pre->unsat) return;
+
+    long int *temp_clause = g_slice_alloc (sizeof (long int) * (n + 1));
+    unsigned int size = 0;
+    bool satisfied    = false;
+
+    for (unsigned int i = 0; i < n; i++) {
+        long int lit = lits[i];
+        int val = sat_preprocess_lit_value (pre, lit);
+
+        if (val > 0) {
+            satisfied = true;
+            break;
+        }
+        if (val < 0) continue;
+        if (pre->mark[sat_preprocess_lit_index (lit)]) continue;
+        if (pre->mark[sat_preprocess_lit_index (-lit)]) {
+            /* tautology */
+            satisfied = true;
+            break;
+        }
+
+        pre->mark[sat_preprocess_lit_index (lit)] = 1;
+        temp_clause[size] = lit;
+        size++;
+    }
+
+    for (unsigned int i = 0; i < size; i++) {
+        pre->mark[sat_preprocess_lit_index (temp_clause[i])] = 0;
+    }
+
+    if (!satisfied) {
+        if (size == 0) {
+            pre->unsat = true;
+        } else if (size == 1) {
+            sat_preprocess_assign (pre, temp_clause[0]);
+        } else {
+            struct sat_preprocess_clause *clause = g_slice_new (struct sat_preprocess_clause);
+            clause->removed  = false;
+            clause->size     = size;
+            clause->capacity = size;
+            clause->lits     = g_slice_alloc (sizeof (long int) * size);
+            memcpy (clause->lits, temp_clause, sizeof (long int) * size);
+
+            guint ci = pre->clauses->len;
+            g_ptr_array_add (pre->clauses, clause);
+
+            for (unsigned int i = 0; i < size; i++) {
+                g_array_append_val (pre->occurrences[sat_preprocess_lit_index (clause->lits[i])], ci);
+            }
+        }
+    }
+
+    g_slice_free1 (sizeof (long int) * (n + 1), temp_clause);
+}
+
+/* returns a newly allocated working copy of clauses for preprocessing.
+ * clauses: GQueue of 0-terminated arrays of literals (long int), not modified,
+ * units: 0-terminated array of literals (long int) added as unit clauses or NULL,
+ * max_var: greatest variable in clauses. */
+struct sat_preprocess * sat_preprocess_new (GQueue *clauses, const long int *units, unsigned long int max_var)
+{
+    if (clauses == NULL) return NULL;
+
+    for (int i = 0; (units != NULL) && (units[i] != 0); i++) {
+        unsigned long int var = (units[i] > 0 ? units[i] : -units[i]);
+        if (var > max_var) max_var = var;
+    }
+
+    struct sat_preprocess *result = g_slice_new (struct sat_preprocess);
+
+    result->max_var       = max_var;
+    result->input_max_var = max_var;
+    result->clauses = g_ptr_array_sized_new (g_queue_get_length (clauses));
+
+    result->occurrences = g_new (GArray *, 2 * max_var + 2);
+    for (unsigned long int i = 0; i < 2 * max_var + 2; i++) {
+        result->occurrences[i] = g_array_new (false, false, sizeof (guint));
+    }
+
+    result->value      = g_new0 (signed char, max_var + 1);
+    result->eliminated = g_new0 (bool, max_var + 1);
+    result->mark       = g_new0 (unsigned char, 2 * max_var + 2);
+
+    result->unit_queue      = g_array_new (false, false, sizeof (long int));
+    result->unit_queue_head = 0;
+    result->reconstruction  = g_array_new (false, false, sizeof (long int));
+
+    result->unsat = false;
+
+    result->n_input_clauses = g_queue_get_length (clauses);
+    result->n_fixed         = 0;
+    result->n_pure          = 0;
+    result->n_eliminated    = 0;
+    result->n_subsumed      = 0;
+    result->n_strengthened  = 0;
+    result->n_blocked       = 0;
+    result->n_substituted   = 0;
+    result->n_duplicates    = 0;
+
+    result->n_cardinality         = 0;
+    result->n_cardinality_removed = 0;
+    result->n_cardinality_added   = 0;
+    result->n_auxiliary           = 0;
+
+    for (GList *cl = clauses->head; cl != NULL; cl = cl->next) {
+        const long int *clause = (const long int *) cl->data;
+        unsigned int len = 0;
+        while (clause[len] != 0) len++;
+
+        sat_preprocess_add_clause (result, clause, len);
+    }
+
+    for (int i = 0; (units != NULL) && (units[i] != 0); i++) {
+        sat_preprocess_assign (result, units[i]);
+        result->n_input_clauses++;
+    }
+
+    return result;
+}
+
+/* frees data of SatPreprocess and sets the referenced pointer to NULL */
+void sat_preprocess_free (struct sat_preprocess **pre)
+{
+    if (pre == NULL) return;
+
+    struct sat_preprocess *rpre = *pre;
+    if (rpre == NULL) return;
+
+    for (guint ci = 0; ci < rpre->clauses->len; ci++) {
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (rpre, ci);
+        g_slice_free1 (sizeof (long int) * clause->capacity, clause->lits);
+        g_slice_free (struct sat_preprocess_clause, clause);
+    }
+    g_ptr_array_free (rpre->clauses, true);
+
+    for (unsigned long int i = 0; i < 2 * rpre->max_var + 2; i++) {
+        g_array_free (rpre->occurrences[i], true);
+    }
+    g_free (rpre->occurrences);
+
+    g_free (rpre->value);
+    g_free (rpre->eliminated);
+    g_free (rpre->mark);
+
+    g_array_free (rpre->unit_queue, true);
+    g_array_free (rpre->reconstruction, true);
+
+    g_slice_free (struct sat_preprocess, rpre);
+
+    *pre = NULL;
+}
+
+/* return occurrence list of literal without removed clauses */
+static GArray * sat_preprocess_occurrences (struct sat_preprocess *pre, long int lit)
+{
+    GArray *occ = pre->occurrences[sat_preprocess_lit_index (lit)];
+
+    guint j = 0;
+    for (guint i = 0; i < occ->len; i++) {
+        guint ci = g_array_index (occ, guint, i);
+        if (sat_preprocess_clause (pre, ci)->removed) continue;
+        g_array_index (occ, guint, j) = ci;
+        j++;
+    }
+    g_array_set_size (occ, j);
+
+    return occ;
+}
+
+/* remove clause with index ci and record it for model reconstruction with witness literal */
+static void sat_preprocess_remove_clause_witness (struct sat_preprocess *pre, guint ci, long int witness)
+{
+    struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, ci);
+
+    g_array_append_val (pre->reconstruction, witness);
+    for (unsigned int i = 0; i < clause->size; i++) {
+        if (clause->lits[i] == witness) continue;
+        g_array_append_val (pre->reconstruction, clause->lits[i]);
+    }
+    long int size = clause->size;
+    g_array_append_val (pre->reconstruction, size);
+
+    clause->removed = true;
+}
+
+/* remove literal from clause with index ci, the clause is replaced by an assignment if it becomes a unit */
+static void sat_preprocess_strengthen (struct sat_preprocess *pre, guint ci, long int lit)
+{
+    struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, ci);
+
+    for (unsigned int i = 0; i < clause->size; i++) {
+        if (clause->lits[i] != lit) continue;
+        clause->lits[i] = clause->lits[clause->size - 1];
+        clause->size--;
+        break;
+    }
+
+    GArray *occ = pre->occurrences[sat_preprocess_lit_index (lit)];
+    for (guint i = 0; i < occ->len; i++) {
+        if (g_array_index (occ, guint, i) != ci) continue;
+        g_array_remove_index_fast (occ, i);
+        break;
+    }
+
+    if (clause->size == 1) {
+        clause->removed = true;
+        sat_preprocess_assign (pre, clause->lits[0]);
+    }
+}
+
+/* propagate all queued assignments */
+static void sat_preprocess_propagate (struct sat_preprocess *pre)
+{
+    while ((!pre->unsat) && (pre->unit_queue_head < pre->unit_queue->len)) {
+        long int lit = g_array_index (pre->unit_queue, long int, pre->unit_queue_head);
+        pre->unit_queue_head++;
+
+        /* satisfied clauses are implied */
+        GArray *occ = sat_preprocess_occurrences (pre, lit);
+        for (guint i = 0; i < occ->len; i++) {
+            sat_preprocess_clause (pre, g_array_index (occ, guint, i))->removed = true;
+        }
+        g_array_set_size (occ, 0);
+
+        /* remove falsified literal */
+        occ = sat_preprocess_occurrences (pre, -lit);
+        for (guint i = 0; i < occ->len; i++) {
+            struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, g_array_index (occ, guint, i));
+
+            for (unsigned int j = 0; j < clause->size; j++) {
+                if (clause->lits[j] != -lit) continue;
+                clause->lits[j] = clause->lits[clause->size - 1];
+                clause->size--;
+                break;
+            }
+
+            if (clause->size == 1) {
+                clause->removed = true;
+                sat_preprocess_assign (pre, clause->lits[0]);
+            }
+        }
+        g_array_set_size (occ, 0);
+    }
+}
+
+/* hash function for clauses with sorted literals */
+static guint sat_preprocess_clause_hash (gconstpointer key)
+{
+    const struct sat_preprocess_clause *clause = key;
+
+    guint result = clause->size;
+    for (unsigned int i = 0; i < clause->size; i++) {
+        result = result * 31 + (guint) clause->lits[i];
+    }
+
+    return result;
+}
+
+/* equal function for clauses with sorted literals */
+static gboolean sat_preprocess_clause_equal (gconstpointer a, gconstpointer b)
+{
+    const struct sat_preprocess_clause *clause_a = a;
+    const struct sat_preprocess_clause *clause_b = b;
+
+    if (clause_a->size != clause_b->size) return false;
+
+    return (memcmp (clause_a->lits, clause_b->lits, sizeof (long int) * clause_a->size) == 0);
+}
+
+/* compare function for sorting literals */
+static int sat_preprocess_lit_compare (const void *a, const void *b)
+{
+    long int lit_a = *((const long int *) a);
+    long int lit_b = *((const long int *) b);
+
+    if (lit_a < lit_b) return -1;
+    if (lit_a > lit_b) return 1;
+    return 0;
+}
+
+/* remove duplicate clauses */
+static void sat_preprocess_remove_duplicates (struct sat_preprocess *pre)
+{
+    GHashTable *clause_set = g_hash_table_new (sat_preprocess_clause_hash, sat_preprocess_clause_equal);
+
+    for (guint ci = 0; ci < pre->clauses->len; ci++) {
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, ci);
+        if (clause->removed) continue;
+
+        qsort (clause->lits, clause->size, sizeof (long int), sat_preprocess_lit_compare);
+
+        if (g_hash_table_contains (clause_set, clause)) {
+            clause->removed = true;
+            pre->n_duplicates++;
+        } else {
+            g_hash_table_add (clause_set, clause);
+        }
+    }
+
+    g_hash_table_destroy (clause_set);
+}
+
+/* substitute literals that are equivalent according to the binary implication graph
+ * by a representative of their strongly connected component */
+static void sat_preprocess_equivalent_literals (struct sat_preprocess *pre)
+{
+    guint n_nodes = 2 * pre->max_var + 2;
+
+    /* binary implication graph in compressed form: edges of node are in
+     * edges[edge_start[node] ... edge_start[node + 1] - 1] */
+    guint *edge_start = g_new0 (guint, n_nodes + 1);
+
+    for (guint ci = 0; ci < pre->clauses->len; ci++) {
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, ci);
+        if (clause->removed) continue;
+        if (clause->size != 2) continue;
+
+        edge_start[sat_preprocess_lit_index (-clause->lits[0]) + 1]++;
+        edge_start[sat_preprocess_lit_index (-clause->lits[1]) + 1]++;
+    }
+    for (guint node = 0; node < n_nodes; node++) {
+        edge_start[node + 1] += edge_start[node];
+    }
+
+    if (edge_start[n_nodes] == 0) {
+        g_free (edge_start);
+        return;
+    }
+
+    long int *edges   = g_new (long int, edge_start[n_nodes]);
+    guint *edge_fill  = g_new (guint, n_nodes);
+    memcpy (edge_fill, edge_start, sizeof (guint) * n_nodes);
+
+    for (guint ci = 0; ci < pre->clauses->len; ci++) {
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, ci);
+        if (clause->removed) continue;
+        if (clause->size != 2) continue;
+
+        edges[edge_fill[sat_preprocess_lit_index (-clause->lits[0])]++] = clause->lits[1];
+        edges[edge_fill[sat_preprocess_lit_index (-clause->lits[1])]++] = clause->lits[0];
+    }
+    g_free (edge_fill);
+
+    /* tarjan's algorithm without recursion: nodes are literals,
+     * visit_index is 0 for unvisited nodes, component is set when a node's component is complete */
+    guint *visit_index = g_new0 (guint, n_nodes);
+    guint *low_index   = g_new0 (guint, n_nodes);
+    guint *next_edge   = g_new0 (guint, n_nodes);
+    bool  *on_stack    = g_new0 (bool, n_nodes);
+    long int *representative = g_new0 (long int, n_nodes);
+
+    GArray *node_stack = g_array_new (false, false, sizeof (long int));
+    GArray *call_stack = g_array_new (false, false, sizeof (long int));
+    guint visit_counter = 0;
+
+    for (long int root_var = 1; root_var <= pre->max_var; root_var++) {
+        for (int sign = 0; sign < 2; sign++) {
+            long int root = (sign == 0 ? root_var : -root_var);
+            guint root_node = sat_preprocess_lit_index (root);
+            if (visit_index[root_node] != 0) continue;
+            if (edge_start[root_node] == edge_start[root_node + 1]) continue;
+
+            visit_counter++;
+            visit_index[root_node] = low_index[root_node] = visit_counter;
+            next_edge[root_node] = edge_start[root_node];
+            on_stack[root_node]  = true;
+            g_array_append_val (node_stack, root);
+            g_array_append_val (call_stack, root);
+
+            while (call_stack->len > 0) {
+                long int lit = g_array_index (call_stack, long int, call_stack->len - 1);
+                guint node   = sat_preprocess_lit_index (lit);
+
+                if (next_edge[node] < edge_start[node + 1]) {
+                    long int succ   = edges[next_edge[node]];
+                    guint succ_node = sat_preprocess_lit_index (succ);
+                    next_edge[node]++;
+
+                    if (visit_index[succ_node] == 0) {
+                        visit_counter++;
+                        visit_index[succ_node] = low_index[succ_node] = visit_counter;
+                        next_edge[succ_node] = edge_start[succ_node];
+                        on_stack[succ_node]  = true;
+                        g_array_append_val (node_stack, succ);
+                        g_array_append_val (call_stack, succ);
+                    } else if (on_stack[succ_node] && (visit_index[succ_node] < low_index[node])) {
+                        low_index[node] = visit_index[succ_node];
+                    }
+                    continue;
+                }
+
+                g_array_set_size (call_stack, call_stack->len - 1);
+                if (call_stack->len > 0) {
+                    guint parent_node = sat_preprocess_lit_index (g_array_index (call_stack, long int, call_stack->len - 1));
+                    if (low_index[node] < low_index[parent_node]) low_index[parent_node] = low_index[node];
+                }
+
+                if (low_index[node] != visit_index[node]) continue;
+
+                /* component complete: literal with smallest variable is representative */
+                guint start = node_stack->len;
+                long int rep_lit = 0;
+                do {
+                    start--;
+                    long int member = g_array_index (node_stack, long int, start);
+                    if ((rep_lit == 0) || (labs (member) < labs (rep_lit))) rep_lit = member;
+                } while (g_array_index (node_stack, long int, start) != lit);
+
+                for (guint i = start; i < node_stack->len; i++) {
+                    long int member = g_array_index (node_stack, long int, i);
+                    guint member_node = sat_preprocess_lit_index (member);
+                    on_stack[member_node] = false;
+                    representative[member_node] = rep_lit;
+
+                    /* complementary literals in one component */
+                    if (representative[sat_preprocess_lit_index (-member)] == rep_lit) pre->unsat = true;
+                }
+                g_array_set_size (node_stack, start);
+            }
+        }
+    }
+
+    g_array_free (node_stack, true);
+    g_array_free (call_stack, true);
+    g_free (visit_index);
+    g_free (low_index);
+    g_free (next_edge);
+    g_free (on_stack);
+    g_free (edges);
+    g_free (edge_start);
+
+    if (pre->unsat) {
+        g_free (representative);
+        return;
+    }
+
+    /* substitute variables by representatives */
+    bool *rewrite = g_new0 (bool, pre->clauses->len);
+    GArray *rewrite_list = g_array_new (false, false, sizeof (guint));
+
+    for (long int var = 1; var <= pre->max_var; var++) {
+        long int rep_lit = representative[sat_preprocess_lit_index (var)];
+        if ((rep_lit == 0) || (rep_lit == var)) continue;
+        if (pre->value[var] != 0) continue;
+        if (pre->eliminated[var]) continue;
+
+        for (int sign = 0; sign < 2; sign++) {
+            GArray *occ = sat_preprocess_occurrences (pre, (sign == 0 ? var : -var));
+            for (guint i = 0; i < occ->len; i++) {
+                guint ci = g_array_index (occ, guint, i);
+                if (rewrite[ci]) continue;
+                rewrite[ci] = true;
+                g_array_append_val (rewrite_list, ci);
+            }
+        }
+
+        /* var == rep_lit for reconstruction */
+        long int equivalence[2] = {var, -rep_lit};
+        for (int sign = 0; sign < 2; sign++) {
+            g_array_append_vals (pre->reconstruction, equivalence, 2);
+            long int size = 2;
+            g_array_append_val (pre->reconstruction, size);
+            equivalence[0] = -equivalence[0];
+            equivalence[1] = -equivalence[1];
+        }
+
+        pre->eliminated[var] = true;
+        pre->n_substituted++;
+    }
+
+    for (guint i = 0; i < rewrite_list->len; i++) {
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, g_array_index (rewrite_list, guint, i));
+        if (clause->removed) continue;
+
+        for (unsigned int j = 0; j < clause->size; j++) {
+            long int lit = clause->lits[j];
+            long int rep_lit = representative[sat_preprocess_lit_index (lit)];
+            if (rep_lit != 0) clause->lits[j] = rep_lit;
+        }
+
+        clause->removed = true;
+        sat_preprocess_add_clause (pre, clause->lits, clause->size);
+    }
+
+    g_array_free (rewrite_list, true);
+    g_free (rewrite);
+    g_free (representative);
+
+    if (pre->n_substituted > 0) sat_preprocess_remove_duplicates (pre);
+    sat_preprocess_propagate (pre);
+}
+
+/* remove clauses of pure literals */
+static void sat_preprocess_pure_literals (struct sat_preprocess *pre)
+{
+    bool changed = true;
+
+    while (changed && (!pre->unsat)) {
+        changed = false;
+
+        for (long int var = 1; var <= pre->max_var; var++) {
+            if (pre->value[var] != 0) continue;
+            if (pre->eliminated[var]) continue;
+
+            guint n_pos = sat_preprocess_occurrences (pre, var)->len;
+            guint n_neg = sat_preprocess_occurrences (pre, -var)->len;
+
+            if (n_pos + n_neg == 0) continue;
+            if ((n_pos > 0) && (n_neg > 0)) continue;
+
+            long int lit = (n_neg == 0 ? var : -var);
+            GArray *occ  = sat_preprocess_occurrences (pre, lit);
+
+            for (guint i = 0; i < occ->len; i++) {
+                sat_preprocess_remove_clause_witness (pre, g_array_index (occ, guint, i), lit);
+            }
+            g_array_set_size (occ, 0);
+
+            pre->eliminated[var] = true;
+            pre->n_pure++;
+            changed = true;
+        }
+    }
+}
+
+/* compare function for sorting clause indices by clause size */
+static gint sat_preprocess_clause_size_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    struct sat_preprocess *pre = user_data;
+
+    unsigned int size_a = sat_preprocess_clause (pre, *((const guint *) a))->size;
+    unsigned int size_b = sat_preprocess_clause (pre, *((const guint *) b))->size;
+
+    if (size_a < size_b) return -1;
+    if (size_a > size_b) return 1;
+    return 0;
+}
+
+/* remove subsumed clauses and strengthen clauses by self-subsuming resolution */
+static void sat_preprocess_subsumption (struct sat_preprocess *pre, unsigned long int max_steps)
+{
+    GArray *order = g_array_sized_new (false, false, sizeof (guint), pre->clauses->len);
+    for (guint ci = 0; ci < pre->clauses->len; ci++) {
+        if (sat_preprocess_clause (pre, ci)->removed) continue;
+        g_array_append_val (order, ci);
+    }
+    g_array_sort_with_data (order, sat_preprocess_clause_size_compare, pre);
+
+    /* clauses to remove (literal 0) or to strengthen by removing literal */
+    GArray *target_clauses = g_array_new (false, false, sizeof (guint));
+    GArray *target_lits    = g_array_new (false, false, sizeof (long int));
+
+    unsigned long int steps = 0;
+
+    for (guint k = 0; (k < order->len) && (!pre->unsat) && (steps < max_steps); k++) {
+        guint ci = g_array_index (order, guint, k);
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, ci);
+        if (clause->removed) continue;
+
+        /* literal of clause with fewest occurrences */
+        long int min_lit = 0;
+        guint min_occ = 0;
+        for (unsigned int i = 0; i < clause->size; i++) {
+            long int lit = clause->lits[i];
+            guint n_occ = sat_preprocess_occurrences (pre, lit)->len + sat_preprocess_occurrences (pre, -lit)->len;
+            if ((min_lit == 0) || (n_occ < min_occ)) {
+                min_lit = lit;
+                min_occ = n_occ;
+            }
+            pre->mark[sat_preprocess_lit_index (lit)] = 1;
+        }
+
+        g_array_set_size (target_clauses, 0);
+        g_array_set_size (target_lits, 0);
+
+        for (int sign = 0; sign < 2; sign++) {
+            GArray *occ = pre->occurrences[sat_preprocess_lit_index (sign == 0 ? min_lit : -min_lit)];
+
+            for (guint i = 0; i < occ->len; i++) {
+                guint di = g_array_index (occ, guint, i);
+                if (di == ci) continue;
+
+                struct sat_preprocess_clause *other = sat_preprocess_clause (pre, di);
+                if (other->removed) continue;
+                if (other->size < clause->size) continue;
+
+                steps += other->size;
+
+                unsigned int n_match = 0;
+                long int flip_lit    = 0;
+                for (unsigned int j = 0; j < other->size; j++) {
+                    long int lit = other->lits[j];
+                    if (pre->mark[sat_preprocess_lit_index (lit)]) {
+                        n_match++;
+                    } else if (pre->mark[sat_preprocess_lit_index (-lit)]) {
+                        flip_lit = lit;
+                    }
+                }
+
+                if (n_match == clause->size) {
+                    long int no_lit = 0;
+                    g_array_append_val (target_clauses, di);
+                    g_array_append_val (target_lits, no_lit);
+                } else if ((n_match + 1 == clause->size) && (flip_lit != 0)) {
+                    g_array_append_val (target_clauses, di);
+                    g_array_append_val (target_lits, flip_lit);
+                }
+            }
+        }
+
+        for (unsigned int i = 0; i < clause->size; i++) {
+            pre->mark[sat_preprocess_lit_index (clause->lits[i])] = 0;
+        }
+
+        for (guint i = 0; i < target_clauses->len; i++) {
+            guint di     = g_array_index (target_clauses, guint, i);
+            long int lit = g_array_index (target_lits, long int, i);
+
+            if (sat_preprocess_clause (pre, di)->removed) continue;
+
+            if (lit == 0) {
+                sat_preprocess_clause (pre, di)->removed = true;
+                pre->n_subsumed++;
+            } else {
+                sat_preprocess_strengthen (pre, di, lit);
+                pre->n_strengthened++;
+            }
+        }
+
+        sat_preprocess_propagate (pre);
+    }
+
+    g_array_free (target_clauses, true);
+    g_array_free (target_lits, true);
+    g_array_free (order, true);
+}
+
+/* compare function for sorting variables by number of occurrences */
+static gint sat_preprocess_var_occurrences_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    struct sat_preprocess *pre = user_data;
+
+    long int var_a = *((const long int *) a);
+    long int var_b = *((const long int *) b);
+
+    guint n_a = pre->occurrences[sat_preprocess_lit_index (var_a)]->len + pre->occurrences[sat_preprocess_lit_index (-var_a)]->len;
+    guint n_b = pre->occurrences[sat_preprocess_lit_index (var_b)]->len + pre->occurrences[sat_preprocess_lit_index (-var_b)]->len;
+
+    if (n_a < n_b) return -1;
+    if (n_a > n_b) return 1;
+    return 0;
+}
+
+/* bounded variable elimination: replace clauses of a variable by their resolvents
+ * if this does not increase the number of clauses by more than the given bound */
+static void sat_preprocess_eliminate (struct sat_preprocess *pre, const struct sat_preprocess_options *options)
+{
+    GArray *order = g_array_sized_new (false, false, sizeof (long int), pre->max_var);
+    for (long int var = 1; var <= pre->max_var; var++) {
+        if (pre->value[var] != 0) continue;
+        if (pre->eliminated[var]) continue;
+        sat_preprocess_occurrences (pre, var);
+        sat_preprocess_occurrences (pre, -var);
+        g_array_append_val (order, var);
+    }
+    g_array_sort_with_data (order, sat_preprocess_var_occurrences_compare, pre);
+
+    /* resolvents as concatenated literals and their sizes */
+    GArray *resolvent_lits  = g_array_new (false, false, sizeof (long int));
+    GArray *resolvent_sizes = g_array_new (false, false, sizeof (guint));
+
+    unsigned long int steps = 0;
+
+    for (guint k = 0; (k < order->len) && (!pre->unsat) && (steps < options->max_steps); k++) {
+        long int var = g_array_index (order, long int, k);
+        if (pre->value[var] != 0) continue;
+        if (pre->eliminated[var]) continue;
+
+        GArray *pos = sat_preprocess_occurrences (pre, var);
+        GArray *neg = sat_preprocess_occurrences (pre, -var);
+
+        guint n_clauses = pos->len + neg->len;
+        if (n_clauses == 0) continue;
+        if (n_clauses > options->elim_max_occurrences) continue;
+
+        g_array_set_size (resolvent_lits, 0);
+        g_array_set_size (resolvent_sizes, 0);
+
+        bool eliminate = true;
+
+        for (guint i = 0; (i < pos->len) && eliminate; i++) {
+            struct sat_preprocess_clause *pclause = sat_preprocess_clause (pre, g_array_index (pos, guint, i));
+
+            for (unsigned int j = 0; j < pclause->size; j++) {
+                pre->mark[sat_preprocess_lit_index (pclause->lits[j])] = 1;
+            }
+
+            for (guint l = 0; l < neg->len; l++) {
+                struct sat_preprocess_clause *nclause = sat_preprocess_clause (pre, g_array_index (neg, guint, l));
+                steps += pclause->size + nclause->size;
+
+                guint start = resolvent_lits->len;
+                bool tautology = false;
+
+                for (unsigned int j = 0; j < pclause->size; j++) {
+                    if (pclause->lits[j] == var) continue;
+                    g_array_append_val (resolvent_lits, pclause->lits[j]);
+                }
+                for (unsigned int j = 0; j < nclause->size; j++) {
+                    long int lit = nclause->lits[j];
+                    if (lit == -var) continue;
+                    if (pre->mark[sat_preprocess_lit_index (-lit)]) {
+                        tautology = true;
+                        break;
+                    }
+                    if (pre->mark[sat_preprocess_lit_index (lit)]) continue;
+                    g_array_append_val (resolvent_lits, lit);
+                }
+
+                if (tautology) {
+                    g_array_set_size (resolvent_lits, start);
+                    continue;
+                }
+
+                guint size = resolvent_lits->len - start;
+                g_array_append_val (resolvent_sizes, size);
+
+                if ((size > options->elim_max_clause_length) ||
+                    (resolvent_sizes->len > n_clauses + options->elim_max_growth)) {
+                    eliminate = false;
+                    break;
+                }
+            }
+
+            for (unsigned int j = 0; j < pclause->size; j++) {
+                pre->mark[sat_preprocess_lit_index (pclause->lits[j])] = 0;
+            }
+        }
+
+        if (!eliminate) continue;
+
+        for (guint i = 0; i < pos->len; i++) {
+            sat_preprocess_remove_clause_witness (pre, g_array_index (pos, guint, i), var);
+        }
+        for (guint i = 0; i < neg->len; i++) {
+            sat_preprocess_remove_clause_witness (pre, g_array_index (neg, guint, i), -var);
+        }
+        g_array_set_size (pos, 0);
+        g_array_set_size (neg, 0);
+
+        pre->eliminated[var] = true;
+        pre->n_eliminated++;
+
+        guint start = 0;
+        for (guint i = 0; i < resolvent_sizes->len; i++) {
+            guint size = g_array_index (resolvent_sizes, guint, i);
+            sat_preprocess_add_clause (pre, &g_array_index (resolvent_lits, long int, start), size);
+            start += size;
+        }
+
+        sat_preprocess_propagate (pre);
+    }
+
+    g_array_free (resolvent_lits, true);
+    g_array_free (resolvent_sizes, true);
+    g_array_free (order, true);
+}
+
+/* remove blocked clauses: clauses with a literal for which all resolvents are tautologies */
+static void sat_preprocess_blocked_clauses (struct sat_preprocess *pre, unsigned long int max_steps)
+{
+    unsigned long int steps = 0;
+
+    for (guint ci = 0; (ci < pre->clauses->len) && (steps < max_steps); ci++) {
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, ci);
+        if (clause->removed) continue;
+
+        for (unsigned int i = 0; i < clause->size; i++) {
+            pre->mark[sat_preprocess_lit_index (clause->lits[i])] = 1;
+        }
+
+        long int witness = 0;
+
+        for (unsigned int i = 0; (i < clause->size) && (witness == 0); i++) {
+            long int lit = clause->lits[i];
+            GArray *occ  = sat_preprocess_occurrences (pre, -lit);
+            bool blocked = true;
+
+            for (guint j = 0; (j < occ->len) && blocked; j++) {
+                struct sat_preprocess_clause *other = sat_preprocess_clause (pre, g_array_index (occ, guint, j));
+                steps += other->size;
+
+                bool tautology = false;
+                for (unsigned int l = 0; l < other->size; l++) {
+                    long int olit = other->lits[l];
+                    if (olit == -lit) continue;
+                    if (pre->mark[sat_preprocess_lit_index (-olit)]) {
+                        tautology = true;
+                        break;
+                    }
+                }
+
+                if (!tautology) blocked = false;
+            }
+
+            if (blocked) witness = lit;
+        }
+
+        for (unsigned int i = 0; i < clause->size; i++) {
+            pre->mark[sat_preprocess_lit_index (clause->lits[i])] = 0;
+        }
+
+        if (witness != 0) {
+            sat_preprocess_remove_clause_witness (pre, ci, witness);
+            pre->n_blocked++;
+        }
+    }
+}
+
+/* cliques of binary clauses (pairwise at-most-one) are only re-encoded from this size on,
+ * smaller ones would not save clauses */
+#define SAT_PREPROCESS_MIN_CLIQUE_SIZE 6
+
+/* grow variable range of pre to max_var for auxiliary variables */
+static void sat_preprocess_grow (struct sat_preprocess *pre, unsigned long int max_var)
+{
+    if (max_var <= pre->max_var) return;
+
+    unsigned long int old_max_var = pre->max_var;
+
+    pre->occurrences = g_renew (GArray *, pre->occurrences, 2 * max_var + 2);
+    for (unsigned long int i = 2 * old_max_var + 2; i < 2 * max_var + 2; i++) {
+        pre->occurrences[i] = g_array_new (false, false, sizeof (guint));
+    }
+
+    pre->value      = g_renew (signed char, pre->value, max_var + 1);
+    pre->eliminated = g_renew (bool, pre->eliminated, max_var + 1);
+    pre->mark       = g_renew (unsigned char, pre->mark, 2 * max_var + 2);
+
+    memset (pre->value + old_max_var + 1, 0, sizeof (signed char) * (max_var - old_max_var));
+    memset (pre->eliminated + old_max_var + 1, 0, sizeof (bool) * (max_var - old_max_var));
+    memset (pre->mark + 2 * old_max_var + 2, 0, sizeof (unsigned char) * 2 * (max_var - old_max_var));
+
+    pre->max_var = max_var;
+}
+
+/* return number of clauses and set number of auxiliary variables of the sequential counter
+ * encoding of at most k of n literals */
+static unsigned long int sat_preprocess_atmost_size (unsigned long int n, unsigned long int k, unsigned long int *n_vars)
+{
+    unsigned long int n_clauses = 0;
+    *n_vars = 0;
+
+    for (unsigned long int i = 1; i <= n; i++) {
+        unsigned long int width      = MIN (i, k);
+        unsigned long int prev_width = MIN (i - 1, k);
+
+        if (i < n) {
+            *n_vars   += width;
+            n_clauses += 1 + prev_width + (width - 1);
+        }
+        if (i > k) n_clauses++;
+    }
+
+    return n_clauses;
+}
+
+/* add sequential counter encoding of at most k of the n literals lits, auxiliary variables are numbered
+ * from *next_var on. Register variable r(i, j) is true if at least j of the first i literals are true,
+ * for k = 1 this is the ladder encoding. */
+static void sat_preprocess_add_atmost (struct sat_preprocess *pre, const long int *lits, unsigned long int n, unsigned long int k,
+                                       unsigned long int *next_var)
+{
+    long int clause[3];
+
+    /* r(i - 1, 1) */
+    long int prev = 0;
+    unsigned long int prev_width = 0;
+
+    for (unsigned long int i = 1; i <= n; i++) {
+        long int lit = lits[i - 1];
+        unsigned long int width = MIN (i, k);
+
+        /* r(i, 1) */
+        long int cur = 0;
+
+        if (i < n) {
+            cur = *next_var;
+            *next_var += width;
+
+            clause[0] = -lit;
+            clause[1] = cur;
+            sat_preprocess_add_clause (pre, clause, 2);
+
+            for (unsigned long int j = 1; j <= prev_width; j++) {
+                clause[0] = -(prev + j - 1);
+                clause[1] = cur + j - 1;
+                sat_preprocess_add_clause (pre, clause, 2);
+            }
+            for (unsigned long int j = 2; j <= width; j++) {
+                clause[0] = -lit;
+                clause[1] = -(prev + j - 2);
+                clause[2] = cur + j - 1;
+                sat_preprocess_add_clause (pre, clause, 3);
+            }
+        }
+
+        /* overflow */
+        if (i > k) {
+            clause[0] = -lit;
+            clause[1] = -(prev + k - 1);
+            sat_preprocess_add_clause (pre, clause, 2);
+        }
+
+        prev       = cur;
+        prev_width = width;
+    }
+}
+
+/* append at most k of the n literals lits to constraints if the encoding is smaller than the
+ * n_removed clauses of the direct encoding, returns true if appended */
+static bool sat_preprocess_record_atmost (struct sat_preprocess *pre, GArray *constraints, const long int *lits,
+                                          unsigned long int n, unsigned long int k, unsigned long int n_removed,
+                                          unsigned long int *n_aux)
+{
+    unsigned long int n_vars;
+    unsigned long int n_clauses = sat_preprocess_atmost_size (n, k, &n_vars);
+
+    if (n_clauses >= n_removed) return false;
+
+    long int value = k;
+    g_array_append_val (constraints, value);
+    value = n;
+    g_array_append_val (constraints, value);
+    g_array_append_vals (constraints, lits, n);
+
+    *n_aux += n_vars;
+
+    pre->n_cardinality++;
+    pre->n_cardinality_removed += n_removed;
+    pre->n_cardinality_added   += n_clauses;
+    pre->n_auxiliary           += n_vars;
+
+    return true;
+}
+
+/* return root of node in union-find forest parent */
+static guint sat_preprocess_find_root (guint *parent, guint node)
+{
+    while (parent[node] != node) {
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+/* compare function for sorting clause indices by root given in user_data (guint *) */
+static gint sat_preprocess_clause_root_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const guint *root = user_data;
+
+    guint root_a = root[*((const guint *) a)];
+    guint root_b = root[*((const guint *) b)];
+
+    if (root_a < root_b) return -1;
+    if (root_a > root_b) return 1;
+    return 0;
+}
+
+/* find clauses of length l >= 3 whose literals are connected only among each other and form all
+ * subsets of size l of their n literals: direct encoding of at most l - 1 of the negated literals */
+static void sat_preprocess_find_binomial (struct sat_preprocess *pre, GArray *constraints, unsigned long int *n_aux)
+{
+    guint n_nodes = 2 * pre->max_var + 2;
+
+    GArray *order = g_array_new (false, false, sizeof (guint));
+    for (guint ci = 0; ci < pre->clauses->len; ci++) {
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, ci);
+        if (clause->removed) continue;
+        if (clause->size < 3) continue;
+        g_array_append_val (order, ci);
+    }
+    g_array_sort_with_data (order, sat_preprocess_clause_size_compare, pre);
+
+    guint *parent = g_new (guint, n_nodes);
+    for (guint i = 0; i < n_nodes; i++) parent[i] = i;
+    guint *root = g_new0 (guint, pre->clauses->len);
+
+    GHashTable *clause_set = g_hash_table_new (sat_preprocess_clause_hash, sat_preprocess_clause_equal);
+    GArray *lits = g_array_new (false, false, sizeof (long int));
+
+    guint start = 0;
+    while (start < order->len) {
+        unsigned int size = sat_preprocess_clause (pre, g_array_index (order, guint, start))->size;
+        guint end = start;
+        while ((end < order->len) && (sat_preprocess_clause (pre, g_array_index (order, guint, end))->size == size)) end++;
+
+        /* components of literals connected by clauses of this size */
+        for (guint i = start; i < end; i++) {
+            struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, g_array_index (order, guint, i));
+            guint first = sat_preprocess_find_root (parent, sat_preprocess_lit_index (clause->lits[0]));
+
+            for (unsigned int j = 1; j < clause->size; j++) {
+                guint other = sat_preprocess_find_root (parent, sat_preprocess_lit_index (clause->lits[j]));
+                if (other != first) parent[other] = first;
+            }
+        }
+        for (guint i = start; i < end; i++) {
+            guint ci = g_array_index (order, guint, i);
+            root[ci] = sat_preprocess_find_root (parent, sat_preprocess_lit_index (sat_preprocess_clause (pre, ci)->lits[0]));
+        }
+
+        g_qsort_with_data (&g_array_index (order, guint, start), end - start, sizeof (guint), sat_preprocess_clause_root_compare, root);
+
+        guint comp_start = start;
+        while (comp_start < end) {
+            guint comp_root = root[g_array_index (order, guint, comp_start)];
+            guint comp_end  = comp_start;
+            while ((comp_end < end) && (root[g_array_index (order, guint, comp_end)] == comp_root)) comp_end++;
+
+            /* literals and distinct clauses of component */
+            g_array_set_size (lits, 0);
+            for (guint i = comp_start; i < comp_end; i++) {
+                struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, g_array_index (order, guint, i));
+
+                qsort (clause->lits, clause->size, sizeof (long int), sat_preprocess_lit_compare);
+                g_hash_table_add (clause_set, clause);
+
+                for (unsigned int j = 0; j < clause->size; j++) {
+                    long int lit = clause->lits[j];
+                    if (pre->mark[sat_preprocess_lit_index (lit)]) continue;
+                    pre->mark[sat_preprocess_lit_index (lit)] = 1;
+                    /* at most l - 1 of the negated literals */
+                    lit = -lit;
+                    g_array_append_val (lits, lit);
+                }
+            }
+            for (guint i = 0; i < lits->len; i++) {
+                pre->mark[sat_preprocess_lit_index (-g_array_index (lits, long int, i))] = 0;
+            }
+
+            /* binomial coefficient of n over size, stopped when it exceeds the number of clauses */
+            unsigned long int n_distinct = g_hash_table_size (clause_set);
+            unsigned long int n          = lits->len;
+            unsigned long int binomial   = 1;
+            for (unsigned long int i = 1; (i <= size) && (binomial <= n_distinct) && (n > size); i++) {
+                binomial = binomial * (n - size + i) / i;
+            }
+
+            if ((n > size) && (binomial == n_distinct) &&
+                sat_preprocess_record_atmost (pre, constraints, (const long int *) lits->data, n, size - 1, n_distinct, n_aux)) {
+                for (guint i = comp_start; i < comp_end; i++) {
+                    sat_preprocess_clause (pre, g_array_index (order, guint, i))->removed = true;
+                }
+            }
+
+            g_hash_table_remove_all (clause_set);
+            comp_start = comp_end;
+        }
+
+        /* reset forest for the next size */
+        for (guint i = start; i < end; i++) {
+            struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, g_array_index (order, guint, i));
+            for (unsigned int j = 0; j < clause->size; j++) {
+                guint node = sat_preprocess_lit_index (clause->lits[j]);
+                parent[node] = node;
+            }
+        }
+
+        start = end;
+    }
+
+    g_array_free (lits, true);
+    g_hash_table_destroy (clause_set);
+    g_free (root);
+    g_free (parent);
+    g_array_free (order, true);
+}
+
+/* compare function for sorting literals (long int) by decreasing degree given in user_data (guint *) */
+static gint sat_preprocess_lit_degree_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const guint *degree = user_data;
+
+    guint degree_a = degree[sat_preprocess_lit_index (*((const long int *) a))];
+    guint degree_b = degree[sat_preprocess_lit_index (*((const long int *) b))];
+
+    if (degree_a > degree_b) return -1;
+    if (degree_a < degree_b) return 1;
+    return 0;
+}
+
+/* append literals v with binary clause (-lit -v) to neighbors and return number of visited clauses */
+static guint sat_preprocess_clique_neighbors (struct sat_preprocess *pre, long int lit, GArray *neighbors)
+{
+    GArray *occ = sat_preprocess_occurrences (pre, -lit);
+
+    for (guint i = 0; i < occ->len; i++) {
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, g_array_index (occ, guint, i));
+        if (clause->size != 2) continue;
+
+        long int other = -(clause->lits[0] == -lit ? clause->lits[1] : clause->lits[0]);
+        g_array_append_val (neighbors, other);
+    }
+
+    return occ->len;
+}
+
+/* find cliques in the graph of literals connected by binary clauses (-u -v), i.e. pairwise encoded
+ * at most one constraints, greedily starting at literals of high degree */
+static void sat_preprocess_find_cliques (struct sat_preprocess *pre, GArray *constraints, unsigned long int *n_aux,
+                                         unsigned long int max_steps)
+{
+    guint n_nodes = 2 * pre->max_var + 2;
+    guint *degree = g_new0 (guint, n_nodes);
+
+    for (guint ci = 0; ci < pre->clauses->len; ci++) {
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, ci);
+        if (clause->removed) continue;
+        if (clause->size != 2) continue;
+
+        degree[sat_preprocess_lit_index (-clause->lits[0])]++;
+        degree[sat_preprocess_lit_index (-clause->lits[1])]++;
+    }
+
+    GArray *order = g_array_new (false, false, sizeof (long int));
+    for (long int var = 1; var <= (long int) pre->max_var; var++) {
+        for (int sign = 1; sign >= -1; sign -= 2) {
+            long int lit = sign * var;
+            if (degree[sat_preprocess_lit_index (lit)] + 1 < SAT_PREPROCESS_MIN_CLIQUE_SIZE) continue;
+            g_array_append_val (order, lit);
+        }
+    }
+    g_array_sort_with_data (order, sat_preprocess_lit_degree_compare, degree);
+
+    GArray *candidates = g_array_new (false, false, sizeof (long int));
+    GArray *neighbors  = g_array_new (false, false, sizeof (long int));
+    GArray *clique     = g_array_new (false, false, sizeof (long int));
+
+    unsigned long int steps = 0;
+
+    for (guint k = 0; (k < order->len) && (steps < max_steps); k++) {
+        long int lit = g_array_index (order, long int, k);
+
+        /* several cliques may contain lit */
+        while (steps < max_steps) {
+            g_array_set_size (candidates, 0);
+            steps += sat_preprocess_clique_neighbors (pre, lit, candidates);
+            if (candidates->len + 1 < SAT_PREPROCESS_MIN_CLIQUE_SIZE) break;
+
+            g_array_sort_with_data (candidates, sat_preprocess_lit_degree_compare, degree);
+
+            g_array_set_size (clique, 0);
+            g_array_append_val (clique, lit);
+
+            /* add candidate of highest degree and keep its neighbors as candidates */
+            while (candidates->len > 0) {
+                long int next = g_array_index (candidates, long int, 0);
+                g_array_append_val (clique, next);
+
+                g_array_set_size (neighbors, 0);
+                steps += sat_preprocess_clique_neighbors (pre, next, neighbors);
+                for (guint i = 0; i < neighbors->len; i++) {
+                    pre->mark[sat_preprocess_lit_index (g_array_index (neighbors, long int, i))] = 1;
+                }
+
+                guint j = 0;
+                for (guint i = 1; i < candidates->len; i++) {
+                    long int cand = g_array_index (candidates, long int, i);
+                    if (!pre->mark[sat_preprocess_lit_index (cand)]) continue;
+                    g_array_index (candidates, long int, j) = cand;
+                    j++;
+                }
+                g_array_set_size (candidates, j);
+
+                for (guint i = 0; i < neighbors->len; i++) {
+                    pre->mark[sat_preprocess_lit_index (g_array_index (neighbors, long int, i))] = 0;
+                }
+            }
+
+            unsigned long int n = clique->len;
+            if (n < SAT_PREPROCESS_MIN_CLIQUE_SIZE) break;
+            if (!sat_preprocess_record_atmost (pre, constraints, (const long int *) clique->data, n, 1, n * (n - 1) / 2, n_aux)) break;
+
+            /* remove binary clauses within clique */
+            for (guint i = 0; i < clique->len; i++) {
+                pre->mark[sat_preprocess_lit_index (g_array_index (clique, long int, i))] = 1;
+            }
+            for (guint i = 0; i < clique->len; i++) {
+                GArray *occ = sat_preprocess_occurrences (pre, -g_array_index (clique, long int, i));
+
+                for (guint l = 0; l < occ->len; l++) {
+                    struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, g_array_index (occ, guint, l));
+                    if (clause->size != 2) continue;
+                    if (!pre->mark[sat_preprocess_lit_index (-clause->lits[0])]) continue;
+                    if (!pre->mark[sat_preprocess_lit_index (-clause->lits[1])]) continue;
+                    clause->removed = true;
+                }
+            }
+            for (guint i = 0; i < clique->len; i++) {
+                pre->mark[sat_preprocess_lit_index (g_array_index (clique, long int, i))] = 0;
+            }
+        }
+    }
+
+    g_array_free (clique, true);
+    g_array_free (neighbors, true);
+    g_array_free (candidates, true);
+    g_array_free (order, true);
+    g_free (degree);
+}
+
+/* replace at most k constraints given in direct encoding by a sequential counter encoding with
+ * auxiliary variables: cliques of binary clauses and complete sets of clauses of length k + 1.
+ * The removed clauses are implied by the new clauses, so every solution satisfies them on the
+ * original variables and no model reconstruction is needed. */
+static void sat_preprocess_cardinality (struct sat_preprocess *pre, unsigned long int max_steps)
+{
+    sat_preprocess_propagate (pre);
+    if (pre->unsat) return;
+
+    /* constraints to encode: k, n and n literals each */
+    GArray *constraints = g_array_new (false, false, sizeof (long int));
+    unsigned long int n_aux = 0;
+
+    sat_preprocess_find_binomial (pre, constraints, &n_aux);
+    sat_preprocess_find_cliques (pre, constraints, &n_aux, max_steps);
+
+    unsigned long int next_var = pre->max_var + 1;
+    sat_preprocess_grow (pre, pre->max_var + n_aux);
+
+    guint i = 0;
+    while (i < constraints->len) {
+        unsigned long int k = g_array_index (constraints, long int, i);
+        unsigned long int n = g_array_index (constraints, long int, i + 1);
+
+        sat_preprocess_add_atmost (pre, &g_array_index (constraints, long int, i + 2), n, k, &next_var);
+        i += n + 2;
+    }
+
+    g_array_free (constraints, true);
+}
+
+/* run enabled passes of options on pre, removed clauses are recorded for model reconstruction.
+ * returns false if the formula has been found to be unsatisfiable. */
+bool sat_preprocess_run (struct sat_preprocess *pre, const struct sat_preprocess_options *options)
+{
+    if (pre == NULL) return false;
+
+    sat_preprocess_propagate (pre);
+    if (options == NULL) return !pre->unsat;
+
+    if ((!pre->unsat) && options->equivalent_literals)  sat_preprocess_equivalent_literals (pre);
+    if ((!pre->unsat) && options->subsumption)          sat_preprocess_subsumption (pre, options->max_steps);
+    if ((!pre->unsat) && options->pure_literals)        sat_preprocess_pure_literals (pre);
+    if ((!pre->unsat) && options->variable_elimination) sat_preprocess_eliminate (pre, options);
+    if ((!pre->unsat) && options->blocked_clauses)      sat_preprocess_blocked_clauses (pre, options->max_steps);
+    if ((!pre->unsat) && options->cardinality)          sat_preprocess_cardinality (pre, options->max_steps);
+
+    return !pre->unsat;
+}
+
+/* append remaining clauses of pre in DIMACS format to str and return their number */
+unsigned long int sat_preprocess_append_dimacs (struct sat_preprocess *pre, GString *str)
+{
+    if (pre == NULL) return 0;
+    if (str == NULL) return 0;
+
+    unsigned long int n_clauses = 0;
+
+    for (guint ci = 0; ci < pre->clauses->len; ci++) {
+        struct sat_preprocess_clause *clause = sat_preprocess_clause (pre, ci);
+        if (clause->removed) continue;
+
+        for (unsigned int i = 0; i < clause->size; i++) {
+            g_string_append_printf (str, "%ld ", clause->lits[i]);
+        }
+        g_string_append (str, "0\n");
+
+        n_clauses++;
+    }
+
+    return n_clauses;
+}
+
+/* return greatest variable of pre including auxiliary variables */
+unsigned long int sat_preprocess_max_var (struct sat_preprocess *pre)
+{
+    if (pre == NULL) return 0;
+    return pre->max_var;
+}
+
+/* extend solution (GSList of literals (long int)) of remaining clauses to a solution of the original clauses
+ * and return it as newly allocated GSList of literals (long int) for all variables. */
+GSList * sat_preprocess_extend_solution (struct sat_preprocess *pre, GSList *solution)
+{
+    if (pre == NULL) return NULL;
+
+    signed char *model = g_new0 (signed char, pre->max_var + 1);
+
+    for (GSList *li = solution; li != NULL; li = li->next) {
+        long int lit = GPOINTER_TO_SIZE (li->data);
+        unsigned long int var = (lit > 0 ? lit : -lit);
+        if (var > pre->max_var) continue;
+        model[var] = (lit > 0 ? 1 : -1);
+    }
+
+    /* fixed variables do not occur in remaining clauses */
+    for (unsigned long int var = 1; var <= pre->max_var; var++) {
+        if (pre->value[var] != 0) model[var] = pre->value[var];
+        if (model[var] == 0)      model[var] = -1;
+    }
+
+    /* removed clauses in reverse order: set witness if not satisfied */
+    guint end = pre->reconstruction->len;
+    while (end > 0) {
+        long int size = g_array_index (pre->reconstruction, long int, end - 1);
+        guint start   = end - 1 - size;
+
+        bool satisfied = false;
+        for (guint i = start; i < end - 1; i++) {
+            long int lit = g_array_index (pre->reconstruction, long int, i);
+            if (model[lit > 0 ? lit : -lit] == (lit > 0 ? 1 : -1)) {
+                satisfied = true;
+                break;
+            }
+        }
+
+        if (!satisfied) {
+            long int witness = g_array_index (pre->reconstruction, long int, start);
+            model[witness > 0 ? witness : -witness] = (witness > 0 ? 1 : -1);
+        }
+
+        end = start;
+    }
+
+    /* auxiliary variables of re-encoded constraints are dropped */
+    GSList *result = NULL;
+    for (long int var = pre->input_max_var; var > 0; var--) {
+        long int lit = (model[var] > 0 ? var : -var);
+        result = g_slist_prepend (result, GSIZE_TO_POINTER (lit));
+    }
+
+    g_free (model);
+
+    return result;
+}
+
+/* print statistics of preprocessing as info */
+void sat_preprocess_print_info (struct sat_preprocess *pre)
+{
+    if (pre == NULL) return;
+
+    unsigned long int n_clauses = 0;
+    for (guint ci = 0; ci < pre->clauses->len; ci++) {
+        if (!sat_preprocess_clause (pre, ci)->removed) n_clauses++;
+    }
+
+    printf ("INFO: preprocessing: %lu of %lu clauses remaining\n", n_clauses, pre->n_input_clauses);
+    printf ("INFO: preprocessing: %lu fixed, %lu pure, %lu eliminated variables\n",
+            pre->n_fixed, pre->n_pure, pre->n_eliminated);
+    printf ("INFO: preprocessing: %lu subsumed, %lu strengthened, %lu blocked clauses\n",
+            pre->n_subsumed, pre->n_strengthened, pre->n_blocked);
+    printf ("INFO: preprocessing: %lu equivalent variables substituted, %lu duplicate clauses\n",
+            pre->n_substituted, pre->n_duplicates);
+    if (pre->n_cardinality > 0) {
+        printf ("INFO: preprocessing: %lu cardinality constraints re-encoded, %lu clauses replaced by %lu clauses with %lu auxiliary variables\n",
+                pre->n_cardinality, pre->n_cardinality_removed, pre->n_cardinality_added, pre->n_auxiliary);
+    }
+    if (pre->unsat) printf ("INFO: preprocessing: formula is unsatisfiable\n");
+}
@@ -0,0 +1,79 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __sat_preprocess_h__
+#define __sat_preprocess_h__
+
+#include <stdbool.h>
+#include <glib.h>
+
+typedef struct sat_preprocess *SatPreprocess;
+
+/* settings of preprocessing passes and their budgets, unit clauses are always propagated */
+struct sat_preprocess_options {
+    /* substitute equivalent literals found in the binary implication graph by a representative */
+    bool equivalent_literals;
+    /* remove clauses of pure literals */
+    bool pure_literals;
+    /* remove subsumed clauses and strengthen clauses by self-subsuming resolution */
+    bool subsumption;
+    /* bounded variable elimination by clause distribution */
+    bool variable_elimination;
+    /* blocked clause elimination */
+    bool blocked_clauses;
+    /* replace pairwise at-most-one cliques and direct encoded at-most-k constraints
+     * by sequential counters with auxiliary variables */
+    bool cardinality;
+
+    /* variables with more occurrences (positive + negative) are not eliminated */
+    unsigned long int elim_max_occurrences;
+    /* variables are only eliminated if number of resolvents does not exceed
+     * number of removed clauses by more than this value */
+    unsigned long int elim_max_growth;
+    /* variables are not eliminated if a resolvent would be longer */
+    unsigned long int elim_max_clause_length;
+    /* maximum number of literal visits of subsumption, elimination and blocked clause pass each */
+    unsigned long int max_steps;
+};
+
+/* set options to default values: all passes enabled with moderate budgets */
+void sat_preprocess_options_default (struct sat_preprocess_options *options);
+
+/* returns a newly allocated working copy of clauses for preprocessing.
+ * clauses: GQueue of 0-terminated arrays of literals (long int), not modified,
+ * units: 0-terminated array of literals (long int) added as unit clauses or NULL,
+ * max_var: greatest variable in clauses. */
+SatPreprocess sat_preprocess_new (GQueue *clauses, const long int *units, unsigned long int max_var);
+/* frees data of SatPreprocess and sets the referenced pointer to NULL */
+void sat_preprocess_free (SatPreprocess *pre);
+
+/* run enabled passes of options on pre, removed clauses are recorded for model reconstruction.
+ * returns false if the formula has been found to be unsatisfiable. */
+bool sat_preprocess_run (SatPreprocess pre, const struct sat_preprocess_options *options);
+
+/* append remaining clauses of pre in DIMACS format to str and return their number */
+unsigned long int sat_preprocess_append_dimacs (SatPreprocess pre, GString *str);
+/* return greatest variable of pre including auxiliary variables */
+unsigned long int sat_preprocess_max_var (SatPreprocess pre);
+/* extend solution (GSList of literals (long int)) of remaining clauses to a solution of the original clauses
+ * and return it as newly allocated GSList of literals (long int) for all variables without auxiliary variables. */
+GSList * sat_preprocess_extend_solution (SatPreprocess pre, GSList *solution);
+/* print statistics of preprocessing as info */
+void sat_preprocess_print_info (SatPreprocess pre);
+
+#endif
@@ -19,15 +19,22 @@
 #include "sat_problem.h"
 #include "sat_formula.h"
 #include "sat_base_cnf.h"
+#include "sat_int.h"
 
 #include <stdio.h>
 #include <string.h>
 
+/* largest domain of integer variables in alldifferent, element and table constraints */
+#define SAT_PROBLEM_INT_MAX_VIEW (1L << 20)
+/* largest domain of integer variables in direct or order encoding */
+#define SAT_PROBLEM_INT_MAX_UNARY (1L << 24)
+
 /* highlevel sat_problem data struct */
 struct sat_problem {
     /* current formula mapped to enumerated variables represented as BaseCNF */
     BaseCNF cnf;
-    /* greatest mapped variable number in use */
+    /* greatest mapped variable number in use, auxiliary variables of encodings are
+     * not named (see sat_problem_new_aux_vars) */
     long int last_var;
 
     /* strings used for variable mapping in other data structures */
@@ -44,15 +51,90 @@ struct sat_problem {
     bool         satisfiable;
     /* hash table mapping variable names (char *) to their boolean assigned value (bool) */
     GHashTable   *tbl_var_result;
+    /* GSList of assumption literals (long int) responsible for unsatisfiability of last run */
+    GSList       *failed_assumptions;
 
     /* strings used for caching of parsed formulas */
     GStringChunk *str_formulas;
     /* hash table for cached parsed formulas mapping string representation (char *) to
      * a GList of clauses where a clause is a GQueue of literals (long int) */
     GHashTable   *formula_to_cnf_cache;
+    /* hash table for cached parsed formulas that are parity constraints mapping string representation (char *)
+     * to struct sat_formula_xor * or NULL for other formulas */
+    GHashTable   *formula_to_xor_cache;
+
+    /* BDD nodes shared by pseudo-Boolean encodings added outside of groups */
+    SatPbCache pb_cache;
+    /* store cardinality encodings with at least lazy_min_clauses clauses as descriptors expanded on solving */
+    bool              lazy_encodings;
+    unsigned long int lazy_min_clauses;
+
+    /* stack of checkpoints (struct sat_problem_scope *) created by push, innermost first */
+    GSList *scopes;
+
+    /* hash table mapping group names (char *) to their selector variables (long int) */
+    GHashTable *tbl_group_to_selector;
+    /* hash table mapping selector variables (long int) to their group names (char *) */
+    GHashTable *tbl_selector_to_group;
+    /* selector variable guarding newly added clauses or 0 if no group is active */
+    long int   group_selector;
+    /* GSList of group names (const char *) responsible for unsatisfiability of last run */
+    GSList     *failed_groups;
+
+    /* hash table mapping bit-vector names (char *) to their widths (unsigned int) */
+    GHashTable *tbl_bitvector_width;
+    /* names of bit-vectors (char *) in order of declaration, for removing them by pop */
+    GPtrArray  *bitvectors;
+
+    /* hash table mapping names of integer variables (char *) to their domains (struct sat_problem_int *) */
+    GHashTable *tbl_ints;
+    /* names of integer variables (char *) in order of declaration, for removing them by pop */
+    GPtrArray  *ints;
+
+    /* soft clauses (struct sat_problem_soft) in order of addition */
+    GArray     *softs;
+    /* names of objectives (char *) in order of their first soft clause */
+    GPtrArray  *objectives;
+};
+
+/* finite-domain integer variable */
+struct sat_problem_int {
+    SatIntEncoding encoding;
+    long int       min;
+    long int       max;
+    /* auxiliary variable equivalent to x = min + i for each value i defined by sat_problem_int_view
+     * (0: not yet defined), NULL until the first one is needed */
+    long int       *eq_vars;
+};
 
-    /* counter for temporary variables generated for 1ofn order encoding */
-    int special_coding_iterator_1ofn;
+/* soft clause relaxed by a literal that is true if the clause is violated */
+struct sat_problem_soft {
+    /* index into objectives */
+    guint    objective;
+    long int lit;
+    long int weight;
+};
+
+/* checkpoint of a sat_problem for restoring it by pop */
+struct sat_problem_scope {
+    /* number of clauses */
+    unsigned long int n_clauses;
+    /* number of XOR constraints */
+    unsigned long int n_xors;
+    /* number of lazy cardinality constraints */
+    unsigned long int n_lazy;
+    /* greatest variable number used in clauses */
+    unsigned long int max_var;
+    /* greatest mapped variable number */
+    long int last_var;
+    /* number of declared bit-vectors */
+    unsigned int n_bitvectors;
+    /* number of declared integer variables */
+    unsigned int n_ints;
+    /* number of soft clauses */
+    guint n_softs;
+    /* number of objectives */
+    guint n_objectives;
 };
 
 /* user data for generating result list from GHashTable with
@@ -62,13 +144,76 @@ struct sat_problem_var_result_list_gen_user_data {
     GSList *result;
 };
 
+/* state of a variable during backbone computation */
+enum sat_problem_backbone_state {
+    /* not a candidate: unnamed, internal or already refuted by a model */
+    SAT_PROBLEM_BACKBONE_NONE,
+    /* candidate not yet checked */
+    SAT_PROBLEM_BACKBONE_CANDIDATE,
+    /* candidate currently checked by a solver run */
+    SAT_PROBLEM_BACKBONE_PENDING,
+    /* candidate proven to be fixed in every solution */
+    SAT_PROBLEM_BACKBONE_FIXED
+};
+
+/* shared data of backbone worker threads */
+struct sat_problem_backbone_data {
+    struct sat_problem *sat;
+
+    /* solver settings */
+    const char *tmp_file_name;
+    const char *solver_bin;
+    bool       solution_on_stdout;
+    bool       cleanup;
+    bool       cnf_gz;
+    /* group selectors assumed by each run as 0-terminated array (long int) */
+    const long int *group_assumptions;
+    unsigned long int n_group_assumptions;
+
+    /* protects all following members */
+    GMutex mutex;
+
+    /* number of entries in arrays: max var + 1 */
+    unsigned long int n_vars;
+    /* candidate literal of each variable as found in first solution */
+    long int *literal;
+    /* state of each variable as enum sat_problem_backbone_state */
+    unsigned char *state;
+
+    /* number of solver runs */
+    unsigned long int n_solver_runs;
+    /* true if a solver run failed */
+    bool error;
+};
+
 /* remove solution from sat_problem e.g. when a new clause is added */
 static void sat_problem_clear_solution (struct sat_problem *sat);
+/* set assignments of named variables from solution given as GSList of literals (long int) */
+static void sat_problem_set_solution (struct sat_problem *sat, GSList *solution);
 /* encode literal from string to integer representation and return the result */
 static long int sat_problem_encode_literal (struct sat_problem *sat, const char *literal);
+/* return the unnamed auxiliary variable whose name would be name, 0 if there is none */
+static long int sat_problem_aux_var_from_name (struct sat_problem *sat, const char *name);
+/* create and return the name of unnamed auxiliary variable var */
+static const char * sat_problem_aux_var_name (struct sat_problem *sat, long int var);
+/* add clause given as 0-terminated array of literals (long int) to cnf, guarded by selector of active group */
+static void sat_problem_add_encoded_clause_array (struct sat_problem *sat, const long int *clause);
+/* add clause given as GSList of literals (long int) to cnf, guarded by selector of active group */
+static void sat_problem_add_encoded_clause_gslist (struct sat_problem *sat, GSList *clause);
+/* add XOR constraint given as 0-terminated array of literals (long int) to cnf, guarded by selector of active group */
+static void sat_problem_add_encoded_xor_array (struct sat_problem *sat, const long int *xor);
+/* check model given as GSList of literals (long int) against all constraints and assumptions, report first violation */
+static bool sat_problem_verify_solution (struct sat_problem *sat, GSList *solution, const long int *assumptions, unsigned int n_threads);
 /* iterator function for generating result list for sat_problem_var_result_list
  * from GHashTable */
 static void sat_problem_var_result_list_gen_func (gpointer key, gpointer value, gpointer user_data);
+/* return true if variable name belongs to a variable generated internally (e.g. by an encoding) */
+static bool sat_problem_varname_is_internal (const char *name);
+/* thread pool function for checking backbone candidate variable (long int) */
+static void sat_problem_backbone_check_func (gpointer data, gpointer user_data);
+
+/* free struct sat_problem_int */
+static void sat_problem_int_free (gpointer data);
 
 
 /* allocate and return a new sat_problem */
@@ -84,6 +229,10 @@ struct sat_problem * sat_problem_new ()
     result->solver_run  = false;
     result->satisfiable = false;
 
+    result->failed_assumptions = NULL;
+    result->failed_groups      = NULL;
+    result->group_selector     = 0;
+
     result->str_literals         = NULL;
     result->str_formulas         = NULL;
 
@@ -91,6 +240,15 @@ struct sat_problem * sat_problem_new ()
     result->tbl_lit_int_to_name  = NULL;
     result->tbl_var_result       = NULL;
     result->formula_to_cnf_cache = NULL;
+    result->formula_to_xor_cache = NULL;
+    result->tbl_group_to_selector = NULL;
+    result->tbl_selector_to_group = NULL;
+    result->tbl_bitvector_width   = NULL;
+    result->bitvectors            = NULL;
+    result->tbl_ints              = NULL;
+    result->ints                  = NULL;
+    result->softs                 = NULL;
+    result->objectives            = NULL;
 
     result->str_literals = g_string_chunk_new (4096);
     result->str_formulas = g_string_chunk_new (4096);
@@ -104,17 +262,39 @@ struct sat_problem * sat_problem_new ()
     result->tbl_lit_int_to_name  = g_hash_table_new (g_direct_hash, g_direct_equal);
     result->tbl_var_result       = g_hash_table_new (g_str_hash, g_str_equal);
     result->formula_to_cnf_cache = g_hash_table_new (g_str_hash, g_str_equal);
+    result->formula_to_xor_cache = g_hash_table_new (g_str_hash, g_str_equal);
+    result->tbl_group_to_selector = g_hash_table_new (g_str_hash, g_str_equal);
+    result->tbl_selector_to_group = g_hash_table_new (g_direct_hash, g_direct_equal);
+    result->tbl_bitvector_width   = g_hash_table_new (g_str_hash, g_str_equal);
+    result->bitvectors            = g_ptr_array_new ();
+    result->tbl_ints              = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, sat_problem_int_free);
+    result->ints                  = g_ptr_array_new ();
+    result->softs                 = g_array_new (false, false, sizeof (struct sat_problem_soft));
+    result->objectives            = g_ptr_array_new ();
 
     if ((result->tbl_lit_name_to_int == NULL) ||
         (result->tbl_lit_int_to_name == NULL) ||
         (result->tbl_var_result == NULL) ||
-        (result->formula_to_cnf_cache == NULL)) {
+        (result->formula_to_cnf_cache == NULL) ||
+        (result->formula_to_xor_cache == NULL) ||
+        (result->tbl_group_to_selector == NULL) ||
+        (result->tbl_selector_to_group == NULL) ||
+        (result->tbl_bitvector_width == NULL) ||
+        (result->bitvectors == NULL) ||
+        (result->tbl_ints == NULL) ||
+        (result->ints == NULL) ||
+        (result->softs == NULL) ||
+        (result->objectives == NULL)) {
 
         sat_problem_free (&result);
         return NULL;
     }
 
-    result->special_coding_iterator_1ofn = 0;
+    result->pb_cache = sat_pb_cache_new ();
+    result->lazy_encodings   = false;
+    result->lazy_min_clauses = 0;
+
+    result->scopes = NULL;
 
     return result;
 }
@@ -132,6 +312,16 @@ void sat_problem_free (struct sat_problem **sat)
     if (sp->tbl_lit_name_to_int != NULL)  g_hash_table_destroy (sp->tbl_lit_name_to_int);
     if (sp->tbl_lit_int_to_name != NULL)  g_hash_table_destroy (sp->tbl_lit_int_to_name);
     if (sp->tbl_var_result != NULL)       g_hash_table_destroy (sp->tbl_var_result);
+    if (sp->tbl_group_to_selector != NULL) g_hash_table_destroy (sp->tbl_group_to_selector);
+    if (sp->tbl_selector_to_group != NULL) g_hash_table_destroy (sp->tbl_selector_to_group);
+    if (sp->tbl_bitvector_width != NULL)   g_hash_table_destroy (sp->tbl_bitvector_width);
+    if (sp->bitvectors != NULL)            g_ptr_array_free (sp->bitvectors, true);
+    if (sp->tbl_ints != NULL)              g_hash_table_destroy (sp->tbl_ints);
+    if (sp->ints != NULL)                  g_ptr_array_free (sp->ints, true);
+    if (sp->softs != NULL)                 g_array_free (sp->softs, true);
+    if (sp->objectives != NULL)            g_ptr_array_free (sp->objectives, true);
+    g_slist_free (sp->failed_assumptions);
+    g_slist_free (sp->failed_groups);
     if (sp->formula_to_cnf_cache != NULL) {
         GHashTableIter iter;
         gpointer key;
@@ -145,14 +335,54 @@ void sat_problem_free (struct sat_problem **sat)
 
         g_hash_table_destroy (sp->formula_to_cnf_cache);
     }
+    if (sp->formula_to_xor_cache != NULL) {
+        GHashTableIter iter;
+        gpointer key;
+        gpointer value;
+        g_hash_table_iter_init (&iter, sp->formula_to_xor_cache);
+
+        while (g_hash_table_iter_next (&iter, &key, &value)) {
+            struct sat_formula_xor *xor = value;
+            sat_formula_xor_free (&xor);
+        }
+
+        g_hash_table_destroy (sp->formula_to_xor_cache);
+    }
 
     if (sp->str_literals != NULL) g_string_chunk_free (sp->str_literals);
     if (sp->str_formulas != NULL) g_string_chunk_free (sp->str_formulas);
 
+    for (GSList *li = sp->scopes; li != NULL; li = li->next) {
+        g_slice_free (struct sat_problem_scope, li->data);
+    }
+    g_slist_free (sp->scopes);
+
+    sat_pb_cache_free (&(sp->pb_cache));
+
     g_slice_free (struct sat_problem, sp);
     *sat = NULL;
 }
 
+/* set assignments of named variables from solution given as GSList of literals (long int) and mark sat
+ * as solved and satisfiable */
+static void sat_problem_set_solution (struct sat_problem *sat, GSList *solution)
+{
+    sat->solver_run  = true;
+    sat->satisfiable = true;
+
+    for (GSList *li = solution; li != NULL; li = li->next) {
+        long int i_result = GPOINTER_TO_SIZE (li->data);
+
+        bool var_result = (i_result > 0 ? true     : false);
+        long int var    = (i_result > 0 ? i_result : -i_result);
+        char *var_name  = g_hash_table_lookup (sat->tbl_lit_int_to_name, GSIZE_TO_POINTER (var));
+
+        if (var_name == NULL) continue;
+
+        g_hash_table_insert (sat->tbl_var_result, var_name, GSIZE_TO_POINTER (var_result));
+    }
+}
+
 /* remove solution from sat_problem e.g. when a new clause is added */
 static void sat_problem_clear_solution (struct sat_problem *sat)
 {
@@ -161,9 +391,20 @@ static void sat_problem_clear_solution (struct sat_problem *sat)
         sat->solver_run  = false;
         sat->satisfiable = false;
         g_hash_table_remove_all (sat->tbl_var_result);
+        g_slist_free (sat->failed_assumptions);
+        sat->failed_assumptions = NULL;
+        g_slist_free (sat->failed_groups);
+        sat->failed_groups = NULL;
     }
 }
 
+/* return true if variable name belongs to a variable generated internally (e.g. by an encoding) */
+static bool sat_problem_varname_is_internal (const char *name)
+{
+    if (name == NULL) return true;
+    return (strncmp (name, "_int_", 5) == 0);
+}
+
 /* encode literal from string to integer representation and return the result */
 static long int sat_problem_encode_literal (struct sat_problem *sat, const char *literal)
 {
@@ -184,6 +425,10 @@ static long int sat_problem_encode_literal (struct sat_problem *sat, const char
     gpointer lookup_val = NULL;
     if (g_hash_table_contains (sat->tbl_lit_name_to_int, literal)) {
         lookup_val = g_hash_table_lookup (sat->tbl_lit_name_to_int, literal);
+    } else if (sat_problem_aux_var_from_name (sat, literal) != 0) {
+        long int var = sat_problem_aux_var_from_name (sat, literal);
+        sat_problem_aux_var_name (sat, var);
+        lookup_val = GSIZE_TO_POINTER (var);
     } else {
         sat->last_var++;
         lookup_val = GSIZE_TO_POINTER (sat->last_var);
@@ -203,6 +448,148 @@ static long int sat_problem_encode_literal (struct sat_problem *sat, const char
     return result;
 }
 
+/* return the unnamed auxiliary variable whose name would be name, 0 if there is none */
+static long int sat_problem_aux_var_from_name (struct sat_problem *sat, const char *name)
+{
+    long int var = 0;
+    int len = 0;
+
+    if (sscanf (name, "_int_aux_%ld_%n", &var, &len) != 1) return 0;
+    if ((len == 0) || (name[len] != '\0')) return 0;
+    if ((var <= 0) || (var > sat->last_var)) return 0;
+    if (g_hash_table_contains (sat->tbl_lit_int_to_name, GSIZE_TO_POINTER (var))) return 0;
+
+    return var;
+}
+
+/* create and return the name of unnamed auxiliary variable var */
+static const char * sat_problem_aux_var_name (struct sat_problem *sat, long int var)
+{
+    GString *temp_str = g_string_new (NULL);
+    g_string_printf (temp_str, "_int_aux_%ld_", var);
+    /* name may have been taken by a literal before var was allocated */
+    while (g_hash_table_contains (sat->tbl_lit_name_to_int, temp_str->str)) g_string_append_c (temp_str, '_');
+    char *ins_literal = g_string_chunk_insert_const (sat->str_literals, temp_str->str);
+    g_string_free (temp_str, true);
+
+    g_hash_table_insert (sat->tbl_lit_name_to_int, ins_literal, GSIZE_TO_POINTER (var));
+    g_hash_table_insert (sat->tbl_lit_int_to_name, GSIZE_TO_POINTER (var), ins_literal);
+
+    return ins_literal;
+}
+
+/* allocate n new auxiliary variables and return the first of them, the others follow consecutively.
+ * auxiliary variables are not entered into the name tables, their names (_int_aux_<number>_)
+ * are only created on demand by sat_problem_get_varname_from_number. */
+long int sat_problem_new_aux_vars (struct sat_problem *sat, unsigned long int n)
+{
+    if (sat == NULL) return 0;
+
+    long int result = sat->last_var + 1;
+    sat->last_var += n;
+
+    return result;
+}
+
+/* add clause given as 0-terminated array of literals (long int) to cnf, guarded by selector of active group */
+static void sat_problem_add_encoded_clause_array (struct sat_problem *sat, const long int *clause)
+{
+    if (sat->group_selector == 0) {
+        if (clause[0] == 0) {
+            base_cnf_add_empty_clause (sat->cnf);
+        } else {
+            base_cnf_add_clause_array (sat->cnf, clause);
+        }
+        return;
+    }
+
+    unsigned int len = 0;
+    while (clause[len] != 0) len++;
+
+    long int *guarded_clause = g_slice_alloc (sizeof (long int) * (len + 2));
+    memcpy (guarded_clause, clause, sizeof (long int) * len);
+    guarded_clause[len]     = -sat->group_selector;
+    guarded_clause[len + 1] = 0;
+
+    base_cnf_add_clause_array (sat->cnf, guarded_clause);
+
+    g_slice_free1 (sizeof (long int) * (len + 2), guarded_clause);
+}
+
+/* add clause given as GSList of literals (long int) to cnf, guarded by selector of active group */
+static void sat_problem_add_encoded_clause_gslist (struct sat_problem *sat, GSList *clause)
+{
+    if (sat->group_selector == 0) {
+        base_cnf_add_clause_gslist (sat->cnf, clause);
+        return;
+    }
+
+    GSList *guarded_clause = g_slist_copy (clause);
+    guarded_clause = g_slist_append (guarded_clause, GSIZE_TO_POINTER (-sat->group_selector));
+
+    base_cnf_add_clause_gslist (sat->cnf, guarded_clause);
+
+    g_slist_free (guarded_clause);
+}
+
+/* add XOR constraint given as 0-terminated array of literals (long int) whose exclusive or is true to cnf,
+ * guarded by selector of active group. */
+static void sat_problem_add_encoded_xor_array (struct sat_problem *sat, const long int *xor)
+{
+    if (sat->group_selector == 0) {
+        base_cnf_add_xor_array (sat->cnf, xor);
+        return;
+    }
+
+    unsigned int len = 0;
+    while (xor[len] != 0) len++;
+
+    /* selector implies helper variable equal to the exclusive or of the literals */
+    long int helper = sat_problem_new_aux_vars (sat, 1);
+
+    long int *defined_xor = g_slice_alloc (sizeof (long int) * (len + 2));
+    memcpy (defined_xor, xor, sizeof (long int) * len);
+    defined_xor[len]     = -helper;
+    defined_xor[len + 1] = 0;
+
+    base_cnf_add_xor_array (sat->cnf, defined_xor);
+
+    g_slice_free1 (sizeof (long int) * (len + 2), defined_xor);
+
+    long int clause[2] = {helper, 0};
+    sat_problem_add_encoded_clause_array (sat, clause);
+}
+
+/* set group of clauses added afterwards, NULL for clauses not belonging to any group.
+ * clauses of a group are guarded by a hidden selector variable, so the group can
+ * be enabled or disabled for each solver run. */
+void sat_problem_set_group (struct sat_problem *sat, const char *group)
+{
+    if (sat == NULL) return;
+
+    if (group == NULL) {
+        sat->group_selector = 0;
+        return;
+    }
+
+    gpointer lookup_val = g_hash_table_lookup (sat->tbl_group_to_selector, group);
+
+    if (lookup_val == NULL) {
+        GString *temp_str = g_string_new (NULL);
+        g_string_printf (temp_str, "_int_group_%s_", group);
+        long int selector = sat_problem_encode_literal (sat, temp_str->str);
+        g_string_free (temp_str, true);
+
+        char *ins_group = g_string_chunk_insert_const (sat->str_literals, group);
+        lookup_val = GSIZE_TO_POINTER (selector);
+
+        g_hash_table_insert (sat->tbl_group_to_selector, ins_group, lookup_val);
+        g_hash_table_insert (sat->tbl_selector_to_group, lookup_val, ins_group);
+    }
+
+    sat->group_selector = GPOINTER_TO_SIZE (lookup_val);
+}
+
 /* add a clause to sat represented as a GSList of variables (const char *) */
 void sat_problem_add_clause_gslist (struct sat_problem *sat, GSList *clause)
 {
@@ -227,7 +614,7 @@ void sat_problem_add_clause_gslist (struct sat_problem *sat, GSList *clause)
 
     lit_list = g_slist_reverse (lit_list);
 
-    base_cnf_add_clause_gslist (sat->cnf, lit_list);
+    sat_problem_add_encoded_clause_gslist (sat, lit_list);
 
     g_slist_free (lit_list);
 
@@ -258,7 +645,7 @@ void sat_problem_add_clause_array (struct sat_problem *sat, const char *const *c
 
     lit_list = g_slist_reverse (lit_list);
 
-    base_cnf_add_clause_gslist (sat->cnf, lit_list);
+    sat_problem_add_encoded_clause_gslist (sat, lit_list);
 
     g_slist_free (lit_list);
 
@@ -280,8 +667,6 @@ void sat_problem_add_1ofn_order_encoding (struct sat_problem *sat, GSList *lit_l
     }
 
     /* helper variables and main variables */
-    const char *h_var_template     = "_int_1ofn_%d_%d_";
-
     long int *main_array = g_slice_alloc (sizeof (long int) * 2*n_lit);
     long int *help_array = &(main_array[n_lit]);
 
@@ -292,12 +677,10 @@ void sat_problem_add_1ofn_order_encoding (struct sat_problem *sat, GSList *lit_l
         i++;
     }
 
-    GString *temp_str = g_string_new (NULL);
+    long int first_help = sat_problem_new_aux_vars (sat, n_lit - 1);
 
     for (i = 0; i < n_lit - 1; i++) {
-        g_string_printf (temp_str, h_var_template, sat->special_coding_iterator_1ofn, i);
-        long int literal = sat_problem_encode_literal (sat, temp_str->str);
-        help_array[i] = literal;
+        help_array[i] = first_help + i;
     }
 
     /* clauses */
@@ -307,273 +690,1167 @@ void sat_problem_add_1ofn_order_encoding (struct sat_problem *sat, GSList *lit_l
     for (i = 0; i < n_lit - 2; i++) {
         temp_clause[0] = help_array[i];
         temp_clause[1] = -help_array[i+1];
-        base_cnf_add_clause_array (sat->cnf, temp_clause);
+        sat_problem_add_encoded_clause_array (sat, temp_clause);
     }
 
     i = 0;
     temp_clause[0] = main_array[i];
     temp_clause[1] = help_array[i];
     temp_clause[2] = 0;
-    base_cnf_add_clause_array (sat->cnf, temp_clause);
+    sat_problem_add_encoded_clause_array (sat, temp_clause);
     temp_clause[0] = -main_array[i];
     temp_clause[1] = -help_array[i];
-    base_cnf_add_clause_array (sat->cnf, temp_clause);
+    sat_problem_add_encoded_clause_array (sat, temp_clause);
 
     temp_clause[3] = 0;
     for (i = 1; i < n_lit-1; i++) {
         temp_clause[0] = -main_array[i];
         temp_clause[1] = help_array[i-1];
         temp_clause[2] = 0;
-        base_cnf_add_clause_array (sat->cnf, temp_clause);
+        sat_problem_add_encoded_clause_array (sat, temp_clause);
         temp_clause[0] = -main_array[i];
         temp_clause[1] = -help_array[i];
-        base_cnf_add_clause_array (sat->cnf, temp_clause);
+        sat_problem_add_encoded_clause_array (sat, temp_clause);
         temp_clause[0] = main_array[i];
         temp_clause[1] = -help_array[i-1];
         temp_clause[2] = help_array[i];
-        base_cnf_add_clause_array (sat->cnf, temp_clause);
+        sat_problem_add_encoded_clause_array (sat, temp_clause);
     }
 
     i = n_lit - 1;
     temp_clause[0] = -main_array[i];
     temp_clause[1] = help_array[i-1];
     temp_clause[2] = 0;
-    base_cnf_add_clause_array (sat->cnf, temp_clause);
+    sat_problem_add_encoded_clause_array (sat, temp_clause);
     temp_clause[0] = main_array[i];
     temp_clause[1] = -help_array[i-1];
-    base_cnf_add_clause_array (sat->cnf, temp_clause);
+    sat_problem_add_encoded_clause_array (sat, temp_clause);
 
     /* finalization */
-    sat->special_coding_iterator_1ofn++;
-    g_string_free (temp_str, true);
     g_slice_free1 ((sizeof (long int) * 2*n_lit), main_array);
     sat_problem_clear_solution (sat);
 }
 
-/* apply m of n direct encoding to literals (const char *) in lit_list. */
-void sat_problem_add_mofn_direct_encoding (SatProblem sat, GSList *lit_list, unsigned int m, bool atleast, bool atmost)
+/* add XOR constraint over literals (const char *) in lit_list: an odd number of them has to be true.
+ * the constraint is stored natively and encoded on solving. */
+void sat_problem_add_xor_encoding (struct sat_problem *sat, GSList *lit_list)
 {
-    /* checks */
     if (sat == NULL) return;
 
     size_t n_lit = g_slist_length (lit_list);
 
-    if (m > n_lit) return;
+    long int *xor = g_slice_alloc (sizeof (long int) * (n_lit + 1));
+
+    int i = 0;
+    for (GSList *li = lit_list; li != NULL; li = li->next) {
+        xor[i] = sat_problem_encode_literal (sat, li->data);
+        i++;
+    }
+    xor[n_lit] = 0;
 
-    if ((n_lit == m) && atleast) {
-        GSList *temp_clause = g_slist_prepend (NULL, NULL);
+    sat_problem_add_encoded_xor_array (sat, xor);
 
-        for (GSList *li = lit_list; li != NULL; li = li->next) {
-            temp_clause->data = li->data;
-            sat_problem_add_clause_gslist (sat, temp_clause);
-        }
+    g_slice_free1 (sizeof (long int) * (n_lit + 1), xor);
+    sat_problem_clear_solution (sat);
+}
 
-        g_slist_free (temp_clause);
+/* apply m of n direct encoding to literals (const char *) in lit_list. */
+void sat_problem_add_mofn_direct_encoding (SatProblem sat, GSList *lit_list, unsigned int m, bool atleast, bool atmost)
+{
+    sat_problem_add_mofn_encoding (sat, lit_list, m, atleast, atmost, SAT_CARDINALITY_DIRECT);
+}
 
-        return;
-    }
+/* apply m of n encoding to literals (const char *) in lit_list using given cardinality encoding. */
+void sat_problem_add_mofn_encoding (SatProblem sat, GSList *lit_list, unsigned int m, bool atleast, bool atmost, SatCardinalityEncoding encoding)
+{
+    /* checks */
+    if (sat == NULL) return;
+
+    size_t n_lit = g_slist_length (lit_list);
+
+    if (m > n_lit) return;
 
-    /* main variables */
-    long int *main_array   = g_slice_alloc (sizeof (long int) * (n_lit + 1));
-    long int *temp_clause  = g_slice_alloc (sizeof (long int) * (n_lit + 1));
-    long int *index_clause = g_slice_alloc (sizeof (long int) * (n_lit + 1));
+    /* main variables: encoding uses raw variables 1 ... n and auxiliary variables above */
+    long int *main_array = g_slice_alloc (sizeof (long int) * (n_lit + 1));
+    long int *raw_array  = g_slice_alloc (sizeof (long int) * (n_lit + 1));
 
     int i = 0;
     for (GSList *li = lit_list; li != NULL; li = li->next) {
-        long int literal = sat_problem_encode_literal (sat, li->data);
-        main_array[i]   = literal;
-        index_clause[i] = i;
-        temp_clause[i]  = literal;
+        main_array[i] = sat_problem_encode_literal (sat, li->data);
+        raw_array[i]  = i + 1;
         i++;
     }
     main_array[n_lit] = 0;
+    raw_array[n_lit]  = 0;
 
-    /* clauses */
-    /* min m */
-    if (atleast) {
-        i = n_lit - m;
-        temp_clause[n_lit-m+1] = 0;
-
-        while (true) {
-            if (i == n_lit - m) {
-                /* last element */
-                if (index_clause[i] < n_lit) {
-                    /* valid clause */
-                    base_cnf_add_clause_array (sat->cnf, temp_clause);
-                } else {
-                    /* invalid clause */
-                    i--;
-                }
-            } else {
-                /* intermediate element */
-                if (index_clause[i] < i + m) {
-                    /* valid value */
-                    index_clause[i+1] = index_clause[i];
-                    i++;
-                } else {
-                    /* invalid value */
-                    i--;
-                }
-            }
+    unsigned int min = (atleast ? m : 0);
+    unsigned int max = (atmost  ? m : n_lit);
+    unsigned long int next_var = n_lit + 1;
 
-            if (i < 0) break;
+    /* large encodings: descriptor over mapped literals with auxiliary variables after the last mapped variable */
+    if (sat->lazy_encodings && (sat_cardinality_append (encoding, raw_array, n_lit, min, max, &next_var, NULL) >= sat->lazy_min_clauses)) {
+        unsigned long int first_var = sat->last_var + 1;
+        next_var = first_var;
 
-            /* next index */
-            long int index = index_clause[i];
-            index++;
-            index_clause[i] = index;
-            temp_clause[i] = main_array[index];
-        }
+        base_cnf_add_lazy_cardinality (sat->cnf, encoding, main_array, n_lit, min, max, -sat->group_selector, &next_var);
+        sat_problem_new_aux_vars (sat, next_var - first_var);
+
+        g_slice_free1 ((sizeof (long int) * (n_lit + 1)), main_array);
+        g_slice_free1 ((sizeof (long int) * (n_lit + 1)), raw_array);
+        sat_problem_clear_solution (sat);
+        return;
     }
 
+    /* clauses */
+    GQueue *clauses = g_queue_new ();
+    next_var = n_lit + 1;
 
-    /* exclusion */
-    if (atmost) {
-        temp_clause[m+1] = 0;
-
-        i = 0;
-        index_clause[0] = 0;
-        temp_clause[0]  = -main_array[0];
-
-        while (true) {
-            if (i == m) {
-                /* last element */
-                if (index_clause[i] < n_lit) {
-                    /* valid clause */
-                    base_cnf_add_clause_array (sat->cnf, temp_clause);
-                } else {
-                    /* invalid clause */
-                    i--;
-                }
-            } else {
-                /* intermediate element */
-                if (index_clause[i] < i + n_lit - m) {
-                    /* valid value */
-                    index_clause[i+1] = index_clause[i];
-                    i++;
-                } else {
-                    /* invalid value */
-                    i--;
-                }
-            }
+    sat_cardinality_append (encoding, raw_array, n_lit, min, max, &next_var, clauses);
+
+    /* auxiliary variables: raw variables n + 1 ... map to first_aux ... */
+    long int first_aux = sat_problem_new_aux_vars (sat, next_var - n_lit - 1);
 
-            if (i < 0) break;
+    /* map and insert */
+    while (!g_queue_is_empty (clauses)) {
+        long int *clause = g_queue_pop_head (clauses);
 
-            /* next index */
-            long int index = index_clause[i];
-            index++;
-            index_clause[i] = index;
-            temp_clause[i] = -main_array[index];
+        unsigned int len = 0;
+        for (len = 0; clause[len] != 0; len++) {
+            long int var = (clause[len] > 0 ? clause[len] : -clause[len]);
+            long int lit = (var <= n_lit ? main_array[var - 1] : first_aux + var - n_lit - 1);
+            clause[len] = (clause[len] > 0 ? lit : -lit);
         }
+
+        sat_problem_add_encoded_clause_array (sat, clause);
+        g_slice_free1 (sizeof (long int) * (len + 1), clause);
     }
 
+    /* finalization */
+    g_queue_free (clauses);
     g_slice_free1 ((sizeof (long int) * (n_lit + 1)), main_array);
-    g_slice_free1 ((sizeof (long int) * (n_lit + 1)), temp_clause);
-    g_slice_free1 ((sizeof (long int) * (n_lit + 1)), index_clause);
+    g_slice_free1 ((sizeof (long int) * (n_lit + 1)), raw_array);
     sat_problem_clear_solution (sat);
 }
 
-/* add a formula as mapping and return true on success.
- * formula: the formula represented as string with variables 1 ... n.
- * lit_mapping: list of literals (const char *) to map to variables in given formula.
- * parsed formulas are cached for making multiple usage more efficient as only mapping
- * needs to be applied individually whereas parsing only needs to be done once. */
-bool sat_problem_add_formula_mapping (struct sat_problem *sat, const char* formula, GSList *lit_mapping)
+/* apply pseudo-Boolean encoding sum (weights[i] * literal i) >= bound (atleast) and/or <= bound (atmost)
+ * to literals (const char *) in lit_list using given encoding. */
+void sat_problem_add_pb_encoding (SatProblem sat, GSList *lit_list, const long int *weights, long int bound,
+                                  bool atleast, bool atmost, SatPbEncoding encoding)
 {
-    if (sat == NULL) return false;
-    if (formula == NULL) return false;
-    if (lit_mapping == NULL) return false;
+    /* checks */
+    if (sat == NULL) return;
 
-    GList *clause_list = NULL;
+    size_t n_lit = g_slist_length (lit_list);
 
-    /* lookup / generate + cache */
-    if (!g_hash_table_lookup_extended (sat->formula_to_cnf_cache, formula, NULL, (void **) &clause_list)) {
-        SatFormula parsed_formula = NULL;
+    long int *main_array = g_slice_alloc (sizeof (long int) * (n_lit + 1));
+    long int *neg_array  = g_slice_alloc (sizeof (long int) * (n_lit + 1));
 
-        parsed_formula = sat_formula_parse (formula);
-        if (parsed_formula == NULL) {
-            printf ("ERROR: could not parse formula \"%s\"\n", formula);
-            return false;
-        }
+    int i = 0;
+    for (GSList *li = lit_list; li != NULL; li = li->next) {
+        main_array[i] = sat_problem_encode_literal (sat, li->data);
+        neg_array[i]  = -weights[i];
+        i++;
+    }
 
-        clause_list = sat_formula_to_cnf (parsed_formula);
-        sat_formula_free (&parsed_formula);
+    /* clauses: auxiliary variables are numbered after the last mapped variable */
+    GQueue *clauses = g_queue_new ();
+    unsigned long int first_var = sat->last_var + 1;
+    unsigned long int next_var  = first_var;
 
-        if (clause_list == NULL) {
-            printf ("ERROR: invalid formula \"%s\"\n", formula);
-        }
+    /* shared BDD nodes are only valid outside of groups */
+    SatPbCache cache = (sat->group_selector == 0 ? sat->pb_cache : NULL);
 
-        /* cache */
-        char *key = g_string_chunk_insert_const (sat->str_formulas, formula);
-        g_hash_table_insert (sat->formula_to_cnf_cache, key, clause_list);
+    if (atmost) {
+        sat_pb_append (encoding, main_array, weights, n_lit, bound, cache, &next_var, clauses);
     }
-
-    /* debug print */
-    /*
-    for (GList *li = clause_list; li != NULL; li = li->next) {
-        printf ("DEBUG: [");
-        GQueue *clause = li->data;
-        for (GList *lj = clause->head; lj != NULL; lj = lj->next) {
-            long int lit = GPOINTER_TO_SIZE (lj->data);
-            if (lj->next == NULL) {
-                printf ("%ld", lit);
-            } else {
-                printf ("%ld, ", lit);
-            }
-        }
-        printf ("]\n");
+    if (atleast) {
+        sat_pb_append (encoding, main_array, neg_array, n_lit, -bound, cache, &next_var, clauses);
     }
-    */
-
-    /* map */
-    bool result = true;
-    size_t n_lits = g_slist_length (lit_mapping);
-    GArray *encoded_mapping = g_array_sized_new (true, true, sizeof (long int), n_lits + 1);
-    long int zero_mapped = 0;
-    g_array_append_val (encoded_mapping, zero_mapped);
 
-    for (GSList *li = lit_mapping; li != NULL; li = li->next) {
-        const char *lit_str = li->data;
-        long int lit_enc = sat_problem_encode_literal (sat, lit_str);
-        g_array_append_val (encoded_mapping, lit_enc);
-        /* printf ("DEBUG: new encoded lit: %s -> %ld\n", lit_str, lit_enc); */
-    }
+    /* auxiliary variables first_var ... next_var - 1 */
+    sat_problem_new_aux_vars (sat, next_var - first_var);
 
-    GSList *clause_list_mapped = NULL;
-    for (GList *li = clause_list; li != NULL; li = li->next) {
-        GQueue *clause_raw    = li->data;
-        GSList *clause_mapped = NULL;
+    /* insert */
+    while (!g_queue_is_empty (clauses)) {
+        long int *clause = g_queue_pop_head (clauses);
 
-        for (GList *lj = clause_raw->head; lj != NULL; lj = lj->next) {
-            long int lit_raw = GPOINTER_TO_SIZE (lj->data);
-            bool lit_invert = false;
-            if (lit_raw < 0) {
-                lit_raw    = -lit_raw;
-                lit_invert = true;
-            }
+        unsigned int len = 0;
+        while (clause[len] != 0) len++;
 
-            if (lit_raw > n_lits) {
-                printf ("ERROR: no mapping specified for raw variable %ld\n", lit_raw);
-                g_slist_free (clause_mapped);
-                result = false;
-                goto sat_problem_add_formula_mapping_finalize;
-            }
+        sat_problem_add_encoded_clause_array (sat, clause);
+        g_slice_free1 (sizeof (long int) * (len + 1), clause);
+    }
 
-            long int lit_mapped = g_array_index (encoded_mapping, long int, lit_raw);
-            if (lit_invert) lit_mapped = -lit_mapped;
+    /* finalization */
+    g_queue_free (clauses);
+    g_slice_free1 ((sizeof (long int) * (n_lit + 1)), main_array);
+    g_slice_free1 ((sizeof (long int) * (n_lit + 1)), neg_array);
+    sat_problem_clear_solution (sat);
+}
 
-            clause_mapped = g_slist_prepend (clause_mapped, GSIZE_TO_POINTER (lit_mapped));
-        }
+/* declare bit-vector name with width bits named <name>_0 (least significant) ... <name>_<width - 1>
+ * and return true on success. Declaring an existing bit-vector again with the same width has no effect. */
+bool sat_problem_declare_bitvector (struct sat_problem *sat, const char *name, unsigned int width)
+{
+    if (sat == NULL) return false;
+    if ((name == NULL) || (strlen (name) == 0) || (name[0] == '-')) {
+        printf ("ERROR: invalid bit-vector name\n");
+        return false;
+    }
+    if (width == 0) {
+        printf ("ERROR: bit-vector %s needs at least one bit\n", name);
+        return false;
+    }
 
-        clause_mapped = g_slist_reverse (clause_mapped);
-        clause_list_mapped = g_slist_prepend (clause_list_mapped, clause_mapped);
+    unsigned int declared_width = GPOINTER_TO_UINT (g_hash_table_lookup (sat->tbl_bitvector_width, name));
+    if (declared_width == width) return true;
+    if (declared_width != 0) {
+        printf ("ERROR: bit-vector %s already declared with %u bits\n", name, declared_width);
+        return false;
     }
 
-    clause_list_mapped = g_slist_reverse (clause_list_mapped);
+    char *ins_name = g_string_chunk_insert_const (sat->str_literals, name);
+    g_hash_table_insert (sat->tbl_bitvector_width, ins_name, GUINT_TO_POINTER (width));
+    g_ptr_array_add (sat->bitvectors, ins_name);
 
-    /* debug print */
-    /*
-    for (GSList *li = clause_list_mapped; li != NULL; li = li->next) {
+    /* map bits in order */
+    GString *temp_str = g_string_new (NULL);
+    for (unsigned int i = 0; i < width; i++) {
+        g_string_printf (temp_str, "%s_%u", name, i);
+        sat_problem_encode_literal (sat, temp_str->str);
+    }
+    g_string_free (temp_str, true);
+
+    return true;
+}
+
+/* return number of bits of bit-vector name, 0 if not declared */
+unsigned int sat_problem_bitvector_width (struct sat_problem *sat, const char *name)
+{
+    if ((sat == NULL) || (name == NULL)) return 0;
+    return GPOINTER_TO_UINT (g_hash_table_lookup (sat->tbl_bitvector_width, name));
+}
+
+/* parse integer constant (decimal, hex with 0x or octal with 0) into *value and return true on success.
+ * *negative is set for values below zero, *n_bits to the number of bits needed in two's complement
+ * (unsigned for non-negative values). */
+static bool sat_problem_parse_bitvector_constant (const char *str, guint64 *value, bool *negative, unsigned int *n_bits)
+{
+    char *end = NULL;
+
+    if (str[0] == '\0') return false;
+
+    *negative = (str[0] == '-');
+    if (*negative) {
+        *value = (guint64) g_ascii_strtoll (str, &end, 0);
+    } else {
+        *value = g_ascii_strtoull (str, &end, 0);
+    }
+    if ((end == NULL) || (*end != '\0')) return false;
+
+    /* magnitude bits plus sign bit for negative values */
+    guint64 magnitude = (*negative ? ~(*value) : *value);
+    *n_bits = 0;
+    while (magnitude != 0) {
+        (*n_bits)++;
+        magnitude >>= 1;
+    }
+    if (*negative) (*n_bits)++;
+    if (*n_bits == 0) *n_bits = 1;
+
+    return true;
+}
+
+/* bits of an operand of a bit-vector constraint */
+struct sat_problem_bitvector_operand {
+    /* encoded bits (or SAT_BITVECTOR_TRUE/FALSE) of declared bit-vector or NULL for constants */
+    long int     *bits;
+    unsigned int width;
+    /* constant */
+    guint64      value;
+    bool         negative;
+};
+
+/* set bits of operand extended or truncated to width bits in result,
+ * declared bit-vectors are extended by their sign bit if sign_extend is true */
+static void sat_problem_bitvector_operand_bits (struct sat_problem_bitvector_operand *operand, unsigned int width, bool sign_extend, long int *result)
+{
+    for (unsigned int i = 0; i < width; i++) {
+        if (operand->bits == NULL) {
+            bool bit = (i < 64 ? ((operand->value >> i) & 1) != 0 : operand->negative);
+            result[i] = (bit ? SAT_BITVECTOR_TRUE : SAT_BITVECTOR_FALSE);
+        } else if (i < operand->width) {
+            result[i] = operand->bits[i];
+        } else {
+            result[i] = (sign_extend ? operand->bits[operand->width - 1] : SAT_BITVECTOR_FALSE);
+        }
+    }
+}
+
+/* encode bits of bit-vector name with width bits into bits */
+static void sat_problem_encode_bitvector (struct sat_problem *sat, const char *name, unsigned int width, long int *bits)
+{
+    GString *temp_str = g_string_new (NULL);
+    for (unsigned int i = 0; i < width; i++) {
+        g_string_printf (temp_str, "%s_%u", name, i);
+        bits[i] = sat_problem_encode_literal (sat, temp_str->str);
+    }
+    g_string_free (temp_str, true);
+}
+
+/* add bit-vector constraint result = op (operands) and return true on success, see header for details. */
+bool sat_problem_add_bitvector_constraint (struct sat_problem *sat, SatBitvectorOp op, SatBitvectorMultiplier multiplier,
+                                           const char *result, GSList *operands, unsigned int width)
+{
+    if (sat == NULL) return false;
+
+    unsigned int n_operands = g_slist_length (operands);
+    if (n_operands != sat_bitvector_op_arity (op)) {
+        printf ("ERROR: bit-vector operation %s expects %u operands\n", sat_bitvector_op_name (op), sat_bitvector_op_arity (op));
+        return false;
+    }
+
+    bool predicate = sat_bitvector_op_is_predicate (op);
+    bool shift     = ((op == SAT_BITVECTOR_SHL) || (op == SAT_BITVECTOR_LSHR) || (op == SAT_BITVECTOR_ASHR));
+
+    /* operands: declared bit-vectors or integer constants */
+    struct sat_problem_bitvector_operand operand[2];
+    unsigned int max_named_width = 0;
+    unsigned int max_const_width = 0;
+    bool valid = true;
+
+    unsigned int i = 0;
+    for (GSList *li = operands; li != NULL; li = li->next, i++) {
+        const char *name = li->data;
+        unsigned int n_bits = 0;
+
+        operand[i].bits  = NULL;
+        operand[i].width = sat_problem_bitvector_width (sat, name);
+
+        if (operand[i].width != 0) {
+            if ((i == 0) || !shift) max_named_width = MAX (max_named_width, operand[i].width);
+        } else if (sat_problem_parse_bitvector_constant (name, &(operand[i].value), &(operand[i].negative), &n_bits)) {
+            operand[i].width = n_bits;
+            if ((i == 0) || !shift) max_const_width = MAX (max_const_width, n_bits);
+        } else {
+            printf ("ERROR: operand %s is neither a declared bit-vector nor an integer\n", name);
+            valid = false;
+        }
+    }
+    if (!valid) return false;
+
+    /* width of result */
+    unsigned int result_width = sat_problem_bitvector_width (sat, result);
+    if ((result != NULL) && predicate && (result_width > 1)) {
+        printf ("ERROR: result %s of predicate %s has to be a single bit\n", result, sat_bitvector_op_name (op));
+        return false;
+    }
+    if ((result != NULL) && !predicate && (result_width != 0) && (width != 0) && (width != result_width)) {
+        printf ("ERROR: result %s has %u bits\n", result, result_width);
+        return false;
+    }
+    if ((result == NULL) && !predicate) {
+        printf ("ERROR: bit-vector operation %s expects a result\n", sat_bitvector_op_name (op));
+        return false;
+    }
+
+    /* width of operation: bits of result or widest operand */
+    unsigned int op_width = width;
+    if (predicate || (op_width == 0)) {
+        op_width = (predicate ? 0 : result_width);
+        if (op_width == 0) op_width = (max_named_width > 0 ? max_named_width : max_const_width);
+        if (predicate) op_width = MAX (op_width, max_const_width);
+    }
+    if (op_width == 0) {
+        printf ("ERROR: width of bit-vector operation %s unknown\n", sat_bitvector_op_name (op));
+        return false;
+    }
+
+    if (result != NULL) {
+        if (!sat_problem_declare_bitvector (sat, result, (predicate ? 1 : op_width))) return false;
+    }
+
+    /* encode operand and result bits before numbering auxiliary variables */
+    for (i = 0; i < n_operands; i++) {
+        if (sat_problem_bitvector_width (sat, g_slist_nth_data (operands, i)) == 0) continue;
+
+        operand[i].bits = g_new (long int, operand[i].width + 1);
+        sat_problem_encode_bitvector (sat, g_slist_nth_data (operands, i), operand[i].width, operand[i].bits);
+    }
+
+    unsigned int b_width = (shift ? operand[1].width : op_width);
+    bool sign_extend     = sat_bitvector_op_is_signed (op);
+
+    long int *a_bits      = g_new (long int, op_width + 1);
+    long int *b_bits      = g_new (long int, MAX (op_width, b_width) + 1);
+    long int *out_bits    = g_new (long int, op_width + 1);
+    long int *result_bits = g_new (long int, op_width + 1);
+
+    sat_problem_bitvector_operand_bits (&(operand[0]), op_width, sign_extend, a_bits);
+    if (n_operands > 1) {
+        sat_problem_bitvector_operand_bits (&(operand[1]), b_width, sign_extend && !shift, b_bits);
+    }
+
+    unsigned int n_result_bits = (predicate ? 1 : op_width);
+    if (result != NULL) {
+        sat_problem_encode_bitvector (sat, result, n_result_bits, result_bits);
+    } else {
+        /* asserted predicate */
+        result_bits[0] = SAT_BITVECTOR_TRUE;
+    }
+
+    /* clauses: auxiliary variables are numbered after the last mapped variable */
+    GQueue *clauses = g_queue_new ();
+    unsigned long int first_var = sat->last_var + 1;
+    unsigned long int next_var  = first_var;
+
+    sat_bitvector_append (op, multiplier, a_bits, b_bits, op_width, b_width, out_bits, &next_var, clauses);
+    sat_bitvector_append_equal (result_bits, out_bits, n_result_bits, clauses);
+
+    /* auxiliary variables first_var ... next_var - 1 */
+    sat_problem_new_aux_vars (sat, next_var - first_var);
+
+    /* insert */
+    while (!g_queue_is_empty (clauses)) {
+        long int *clause = g_queue_pop_head (clauses);
+
+        unsigned int len = 0;
+        while (clause[len] != 0) len++;
+
+        sat_problem_add_encoded_clause_array (sat, clause);
+        g_slice_free1 (sizeof (long int) * (len + 1), clause);
+    }
+
+    /* finalization */
+    g_queue_free (clauses);
+    for (i = 0; i < n_operands; i++) g_free (operand[i].bits);
+    g_free (a_bits);
+    g_free (b_bits);
+    g_free (out_bits);
+    g_free (result_bits);
+    sat_problem_clear_solution (sat);
+
+    return true;
+}
+
+/* free struct sat_problem_int */
+static void sat_problem_int_free (gpointer data)
+{
+    struct sat_problem_int *x = data;
+
+    g_free (x->eq_vars);
+    g_slice_free (struct sat_problem_int, x);
+}
+
+/* insert clauses (GQueue of 0-terminated arrays of literals (long int) allocated by g_slice) into cnf and free them,
+ * guarded by selector of active group if guarded is true */
+static void sat_problem_add_encoded_clause_queue (struct sat_problem *sat, GQueue *clauses, bool guarded)
+{
+    long int group_selector = sat->group_selector;
+    if (!guarded) sat->group_selector = 0;
+
+    while (!g_queue_is_empty (clauses)) {
+        long int *clause = g_queue_pop_head (clauses);
+
+        unsigned int len = 0;
+        while (clause[len] != 0) len++;
+
+        sat_problem_add_encoded_clause_array (sat, clause);
+        g_slice_free1 (sizeof (long int) * (len + 1), clause);
+    }
+
+    sat->group_selector = group_selector;
+}
+
+/* set name of literal i of integer variable name to str */
+static void sat_problem_int_lit_name (GString *str, const char *name, const struct sat_problem_int *x, unsigned int i)
+{
+    switch (x->encoding) {
+        case SAT_INT_DIRECT:
+            g_string_printf (str, "%s_%ld", name, x->min + (long int) i);
+            break;
+        case SAT_INT_ORDER:
+            g_string_printf (str, "%s_ge_%ld", name, x->min + (long int) i + 1);
+            break;
+        default:
+            g_string_printf (str, "%s_bit_%u", name, i);
+            break;
+    }
+}
+
+/* return newly allocated array of the encoded literals of integer variable name */
+static long int * sat_problem_int_lits (struct sat_problem *sat, const char *name, const struct sat_problem_int *x)
+{
+    unsigned int n_lits = sat_int_num_lits (x->encoding, x->min, x->max);
+    long int *lits = g_new (long int, n_lits + 1);
+
+    GString *temp_str = g_string_new (NULL);
+    for (unsigned int i = 0; i < n_lits; i++) {
+        sat_problem_int_lit_name (temp_str, name, x, i);
+        lits[i] = sat_problem_encode_literal (sat, temp_str->str);
+    }
+    g_string_free (temp_str, true);
+
+    return lits;
+}
+
+/* declare integer variable name with values min ... max in encoding and return true on success, see header for details. */
+bool sat_problem_declare_int (struct sat_problem *sat, const char *name, long int min, long int max, SatIntEncoding encoding)
+{
+    if (sat == NULL) return false;
+    if ((name == NULL) || (strlen (name) == 0) || (name[0] == '-')) {
+        printf ("ERROR: invalid integer variable name\n");
+        return false;
+    }
+    if (min > max) {
+        printf ("ERROR: empty domain %ld ... %ld of integer variable %s\n", min, max, name);
+        return false;
+    }
+
+    SatIntEncoding requested = encoding;
+    encoding = sat_int_encoding_choose (encoding, min, max);
+    if ((encoding != SAT_INT_LOG) && ((unsigned long int) max - (unsigned long int) min >= SAT_PROBLEM_INT_MAX_UNARY)) {
+        printf ("ERROR: domain of integer variable %s too large for %s encoding\n", name, sat_int_encoding_name (encoding));
+        return false;
+    }
+
+    struct sat_problem_int *declared = g_hash_table_lookup (sat->tbl_ints, name);
+    if (declared != NULL) {
+        if ((declared->min != min) || (declared->max != max)) {
+            printf ("ERROR: integer variable %s already declared with domain %ld ... %ld\n", name, declared->min, declared->max);
+            return false;
+        }
+        if ((requested != SAT_INT_AUTO) && (declared->encoding != encoding)) {
+            printf ("ERROR: integer variable %s already declared with %s encoding\n", name, sat_int_encoding_name (declared->encoding));
+            return false;
+        }
+        return true;
+    }
+
+    struct sat_problem_int *x = g_slice_new (struct sat_problem_int);
+    x->encoding = encoding;
+    x->min      = min;
+    x->max      = max;
+    x->eq_vars  = NULL;
+
+    char *ins_name = g_string_chunk_insert_const (sat->str_literals, name);
+    g_hash_table_insert (sat->tbl_ints, ins_name, x);
+    g_ptr_array_add (sat->ints, ins_name);
+
+    /* literals in order and clauses of the domain, which do not belong to a group */
+    long int *lits = sat_problem_int_lits (sat, name, x);
+
+    GQueue *clauses = g_queue_new ();
+    unsigned long int first_var = sat->last_var + 1;
+    unsigned long int next_var  = first_var;
+
+    sat_int_append_domain (x->encoding, x->min, x->max, lits, &next_var, clauses);
+    sat_problem_new_aux_vars (sat, next_var - first_var);
+    sat_problem_add_encoded_clause_queue (sat, clauses, false);
+
+    g_queue_free (clauses);
+    g_free (lits);
+    sat_problem_clear_solution (sat);
+
+    return true;
+}
+
+/* set *min and *max to the domain of integer variable name and return true, false if not declared */
+bool sat_problem_int_domain (struct sat_problem *sat, const char *name, long int *min, long int *max)
+{
+    if ((sat == NULL) || (name == NULL)) return false;
+
+    struct sat_problem_int *x = g_hash_table_lookup (sat->tbl_ints, name);
+    if (x == NULL) return false;
+
+    if (min != NULL) *min = x->min;
+    if (max != NULL) *max = x->max;
+    return true;
+}
+
+/* parse integer constant str into *value and return true on success */
+static bool sat_problem_parse_int_constant (const char *str, long int *value)
+{
+    char *end = NULL;
+
+    if (str[0] == '\0') return false;
+    *value = g_ascii_strtoll (str, &end, 0);
+
+    return ((end != NULL) && (*end == '\0'));
+}
+
+/* set view of operand (declared integer variable or integer constant) with newly allocated literals
+ * and return true on success. Literals for values of order and log encoded variables are defined
+ * by auxiliary variables shared by all constraints (see eq_vars of struct sat_problem_int). */
+static bool sat_problem_int_view (struct sat_problem *sat, const char *operand, struct sat_int_view *view)
+{
+    view->eq = NULL;
+
+    struct sat_problem_int *x = g_hash_table_lookup (sat->tbl_ints, operand);
+    if (x == NULL) {
+        long int value = 0;
+        if (!sat_problem_parse_int_constant (operand, &value)) {
+            printf ("ERROR: operand %s is neither a declared integer variable nor an integer\n", operand);
+            return false;
+        }
+
+        long int *eq = g_new (long int, 1);
+        eq[0]     = SAT_INT_TRUE;
+        view->min = value;
+        view->max = value;
+        view->eq  = eq;
+        return true;
+    }
+
+    if ((unsigned long int) x->max - (unsigned long int) x->min >= SAT_PROBLEM_INT_MAX_VIEW) {
+        printf ("ERROR: domain of integer variable %s too large for constraint\n", operand);
+        return false;
+    }
+
+    unsigned long int n_values = (unsigned long int) x->max - (unsigned long int) x->min + 1;
+    long int *lits = sat_problem_int_lits (sat, operand, x);
+    long int *eq   = g_new (long int, n_values);
+
+    GQueue *clauses = g_queue_new ();
+
+    for (unsigned long int i = 0; i < n_values; i++) {
+        long int v = (long int) ((unsigned long int) x->min + i);
+        eq[i] = sat_int_eq_literal (x->encoding, x->min, x->max, lits, v);
+        if (eq[i] != 0) continue;
+
+        if (x->eq_vars == NULL) x->eq_vars = g_new0 (long int, n_values);
+        if (x->eq_vars[i] == 0) {
+            x->eq_vars[i] = sat_problem_new_aux_vars (sat, 1);
+            sat_int_append_eq_definition (x->encoding, x->min, x->max, lits, v, x->eq_vars[i], clauses);
+        }
+        eq[i] = x->eq_vars[i];
+    }
+
+    /* definitions do not belong to a group */
+    sat_problem_add_encoded_clause_queue (sat, clauses, false);
+
+    g_queue_free (clauses);
+    g_free (lits);
+
+    view->min = x->min;
+    view->max = x->max;
+    view->eq  = eq;
+
+    return true;
+}
+
+/* free literals of n views */
+static void sat_problem_int_views_free (struct sat_int_view *views, unsigned int n)
+{
+    for (unsigned int i = 0; i < n; i++) g_free ((long int *) views[i].eq);
+    g_free (views);
+}
+
+/* return newly allocated views of operands (const char *) in operand_list or NULL on errors */
+static struct sat_int_view * sat_problem_int_views (struct sat_problem *sat, GSList *operand_list)
+{
+    unsigned int n = g_slist_length (operand_list);
+    struct sat_int_view *views = g_new0 (struct sat_int_view, n + 1);
+
+    unsigned int i = 0;
+    for (GSList *li = operand_list; li != NULL; li = li->next, i++) {
+        if (!sat_problem_int_view (sat, li->data, &(views[i]))) {
+            sat_problem_int_views_free (views, n);
+            return NULL;
+        }
+    }
+
+    return views;
+}
+
+/* add all different constraint over integer variables or constants (const char *) in operand_list
+ * and return true on success. */
+bool sat_problem_add_int_alldifferent (struct sat_problem *sat, GSList *operand_list)
+{
+    if (sat == NULL) return false;
+
+    unsigned int n = g_slist_length (operand_list);
+    struct sat_int_view *views = sat_problem_int_views (sat, operand_list);
+    if (views == NULL) return false;
+
+    GQueue *clauses = g_queue_new ();
+    unsigned long int first_var = sat->last_var + 1;
+    unsigned long int next_var  = first_var;
+
+    sat_int_append_alldifferent (views, n, &next_var, clauses);
+    sat_problem_new_aux_vars (sat, next_var - first_var);
+    sat_problem_add_encoded_clause_queue (sat, clauses, true);
+
+    g_queue_free (clauses);
+    sat_problem_int_views_free (views, n);
+    sat_problem_clear_solution (sat);
+
+    return true;
+}
+
+/* add linear constraint sum (coefs[i] * operand i) >= bound (atleast) and/or <= bound (atmost), see header for details. */
+bool sat_problem_add_int_linear (struct sat_problem *sat, GSList *operand_list, const long int *coefs, long int bound,
+                                 bool atleast, bool atmost, SatPbEncoding encoding)
+{
+    if (sat == NULL) return false;
+
+    /* terms of all operands */
+    GArray *term_lits    = g_array_new (false, false, sizeof (long int));
+    GArray *term_weights = g_array_new (false, false, sizeof (long int));
+    long int offset = 0;
+    bool valid = true;
+
+    unsigned int i = 0;
+    for (GSList *li = operand_list; (li != NULL) && valid; li = li->next, i++) {
+        const char *operand = li->data;
+        struct sat_problem_int *x = g_hash_table_lookup (sat->tbl_ints, operand);
+        long int term_offset = 0;
+
+        if (x == NULL) {
+            long int value = 0;
+            if (!sat_problem_parse_int_constant (operand, &value)) {
+                printf ("ERROR: operand %s is neither a declared integer variable nor an integer\n", operand);
+                valid = false;
+                continue;
+            }
+            valid = !__builtin_mul_overflow (coefs[i], value, &term_offset);
+        } else {
+            unsigned int n_lits = sat_int_num_lits (x->encoding, x->min, x->max);
+            unsigned int n_terms = 0;
+            long int *lits = sat_problem_int_lits (sat, operand, x);
+
+            guint len = term_lits->len;
+            g_array_set_size (term_lits, len + n_lits);
+            g_array_set_size (term_weights, len + n_lits);
+
+            valid = sat_int_linear_terms (x->encoding, x->min, x->max, lits, coefs[i],
+                                          &g_array_index (term_lits, long int, len), &g_array_index (term_weights, long int, len),
+                                          &n_terms, &term_offset);
+
+            g_array_set_size (term_lits, len + n_terms);
+            g_array_set_size (term_weights, len + n_terms);
+            g_free (lits);
+        }
+
+        if (valid) valid = !__builtin_add_overflow (offset, term_offset, &offset);
+        if (!valid) printf ("ERROR: linear constraint exceeds integer range\n");
+    }
+
+    /* sum (weights * lits) <= bound - offset */
+    long int lit_bound = 0;
+    if (valid && __builtin_sub_overflow (bound, offset, &lit_bound)) {
+        printf ("ERROR: linear constraint exceeds integer range\n");
+        valid = false;
+    }
+
+    if (valid) {
+        unsigned int n_terms = term_lits->len;
+        long int *lits       = (long int *) term_lits->data;
+        long int *weights    = (long int *) term_weights->data;
+        long int *neg_weights = g_new (long int, n_terms + 1);
+        for (unsigned int j = 0; j < n_terms; j++) neg_weights[j] = -weights[j];
+
+        GQueue *clauses = g_queue_new ();
+        unsigned long int first_var = sat->last_var + 1;
+        unsigned long int next_var  = first_var;
+
+        /* shared BDD nodes are only valid outside of groups */
+        SatPbCache cache = (sat->group_selector == 0 ? sat->pb_cache : NULL);
+
+        if (atmost) {
+            sat_pb_append (encoding, lits, weights, n_terms, lit_bound, cache, &next_var, clauses);
+        }
+        if (atleast) {
+            sat_pb_append (encoding, lits, neg_weights, n_terms, (lit_bound == G_MINLONG ? G_MAXLONG : -lit_bound), cache, &next_var, clauses);
+        }
+
+        sat_problem_new_aux_vars (sat, next_var - first_var);
+        sat_problem_add_encoded_clause_queue (sat, clauses, true);
+
+        g_queue_free (clauses);
+        g_free (neg_weights);
+        sat_problem_clear_solution (sat);
+    }
+
+    g_array_free (term_lits, true);
+    g_array_free (term_weights, true);
+
+    return valid;
+}
+
+/* add element constraint result = entry (index) with entries (const char *) in entry_list counted from 0,
+ * see header for details. */
+bool sat_problem_add_int_element (struct sat_problem *sat, const char *index, GSList *entry_list, const char *result)
+{
+    if (sat == NULL) return false;
+    if ((index == NULL) || (result == NULL)) {
+        printf ("ERROR: element constraint needs an index and a result\n");
+        return false;
+    }
+
+    unsigned int n = g_slist_length (entry_list);
+    struct sat_int_view index_view;
+    struct sat_int_view result_view;
+
+    if (!sat_problem_int_view (sat, index, &index_view)) return false;
+    if (!sat_problem_int_view (sat, result, &result_view)) {
+        g_free ((long int *) index_view.eq);
+        return false;
+    }
+    struct sat_int_view *entries = sat_problem_int_views (sat, entry_list);
+    if (entries == NULL) {
+        g_free ((long int *) index_view.eq);
+        g_free ((long int *) result_view.eq);
+        return false;
+    }
+
+    GQueue *clauses = g_queue_new ();
+    unsigned long int first_var = sat->last_var + 1;
+    unsigned long int next_var  = first_var;
+
+    sat_int_append_element (&index_view, entries, n, &result_view, &next_var, clauses);
+    sat_problem_new_aux_vars (sat, next_var - first_var);
+    sat_problem_add_encoded_clause_queue (sat, clauses, true);
+
+    g_queue_free (clauses);
+    g_free ((long int *) index_view.eq);
+    g_free ((long int *) result_view.eq);
+    sat_problem_int_views_free (entries, n);
+    sat_problem_clear_solution (sat);
+
+    return true;
+}
+
+/* add table constraint: the operands (const char *) in operand_list are one of the n_tuples rows of tuples,
+ * see header for details. */
+bool sat_problem_add_int_table (struct sat_problem *sat, GSList *operand_list, const long int *tuples, unsigned int n_tuples)
+{
+    if (sat == NULL) return false;
+
+    unsigned int n = g_slist_length (operand_list);
+    struct sat_int_view *views = sat_problem_int_views (sat, operand_list);
+    if (views == NULL) return false;
+
+    GQueue *clauses = g_queue_new ();
+    unsigned long int first_var = sat->last_var + 1;
+    unsigned long int next_var  = first_var;
+
+    sat_int_append_table (views, n, tuples, n_tuples, &next_var, clauses);
+    sat_problem_new_aux_vars (sat, next_var - first_var);
+    sat_problem_add_encoded_clause_queue (sat, clauses, true);
+
+    g_queue_free (clauses);
+    sat_problem_int_views_free (views, n);
+    sat_problem_clear_solution (sat);
+
+    return true;
+}
+
+/* return index of node name in tbl_nodes (node name -> index + 1), new nodes are appended to nodes */
+static unsigned int sat_problem_graph_node (GHashTable *tbl_nodes, GPtrArray *nodes, const char *name)
+{
+    gpointer index = g_hash_table_lookup (tbl_nodes, name);
+    if (index != NULL) return GPOINTER_TO_UINT (index) - 1;
+
+    g_ptr_array_add (nodes, (gpointer) name);
+    g_hash_table_insert (tbl_nodes, (gpointer) name, GUINT_TO_POINTER (nodes->len));
+
+    return nodes->len - 1;
+}
+
+/* add constraint on the graph of the edges (node, node, literal) in edge_list, see header for details. */
+bool sat_problem_add_graph_constraint (struct sat_problem *sat, SatGraphConstraint constraint, bool directed, GSList *edge_list,
+                                       GSList *node_list, const char *source, const char *target)
+{
+    if (sat == NULL) return false;
+
+    if (((constraint == SAT_GRAPH_PATH) || (constraint == SAT_GRAPH_REACHABLE)) && (source == NULL)) {
+        printf ("ERROR: %s constraint needs a source\n", sat_graph_constraint_name (constraint));
+        return false;
+    }
+    if ((constraint == SAT_GRAPH_PATH) && (target == NULL)) {
+        printf ("ERROR: path constraint needs a target\n");
+        return false;
+    }
+    if (((constraint == SAT_GRAPH_PATH) || (constraint == SAT_GRAPH_HAMILTONIAN_PATH)) &&
+        (source != NULL) && (target != NULL) && (strcmp (source, target) == 0)) {
+        printf ("ERROR: source and target of %s constraint have to differ\n", sat_graph_constraint_name (constraint));
+        return false;
+    }
+    if ((node_list != NULL) && (constraint != SAT_GRAPH_PATH) && (constraint != SAT_GRAPH_REACHABLE)) {
+        printf ("ERROR: node literals are only defined for path and reachable constraints\n");
+        return false;
+    }
+
+    GHashTable *tbl_nodes = g_hash_table_new (g_str_hash, g_str_equal);
+    GPtrArray *nodes      = g_ptr_array_new ();
+    unsigned int n_edges  = g_slist_length (edge_list);
+    unsigned int *from    = g_new (unsigned int, n_edges + 1);
+    unsigned int *to      = g_new (unsigned int, n_edges + 1);
+    long int *edge_lits   = g_new (long int, n_edges + 1);
+    GArray *node_lits     = g_array_new (false, true, sizeof (long int));
+    bool valid = true;
+
+    unsigned int i = 0;
+    for (GSList *li = edge_list; li != NULL; li = li->next) {
+        GSList *edge = li->data;
+        if (g_slist_length (edge) != 3) {
+            printf ("ERROR: edges have to be given as node, node, literal\n");
+            valid = false;
+            break;
+        }
+
+        from[i]      = sat_problem_graph_node (tbl_nodes, nodes, edge->data);
+        to[i]        = sat_problem_graph_node (tbl_nodes, nodes, edge->next->data);
+        edge_lits[i] = sat_problem_encode_literal (sat, edge->next->next->data);
+        if (edge_lits[i] == 0) {
+            printf ("ERROR: invalid literal \"%s\" of edge\n", (const char *) edge->next->next->data);
+            valid = false;
+            break;
+        }
+        i++;
+    }
+
+    for (GSList *li = node_list; valid && (li != NULL); li = li->next) {
+        GSList *node = li->data;
+        if (g_slist_length (node) != 2) {
+            printf ("ERROR: node literals have to be given as node, literal\n");
+            valid = false;
+            break;
+        }
+
+        unsigned int v = sat_problem_graph_node (tbl_nodes, nodes, node->data);
+        long int lit   = sat_problem_encode_literal (sat, node->next->data);
+        if (lit == 0) {
+            printf ("ERROR: invalid literal \"%s\" of node\n", (const char *) node->next->data);
+            valid = false;
+            break;
+        }
+        if (v >= node_lits->len) g_array_set_size (node_lits, v + 1);
+        g_array_index (node_lits, long int, v) = lit;
+    }
+
+    if (valid) {
+        /* source and target may be isolated nodes */
+        long int source_node = (source != NULL ? (long int) sat_problem_graph_node (tbl_nodes, nodes, source) : -1);
+        long int target_node = (target != NULL ? (long int) sat_problem_graph_node (tbl_nodes, nodes, target) : -1);
+        g_array_set_size (node_lits, nodes->len);
+
+        GQueue *clauses = g_queue_new ();
+        unsigned long int first_var = sat->last_var + 1;
+        unsigned long int next_var  = first_var;
+
+        sat_graph_append (constraint, directed, nodes->len, from, to, edge_lits, n_edges,
+                          (long int *) node_lits->data, source_node, target_node, &next_var, clauses);
+        sat_problem_new_aux_vars (sat, next_var - first_var);
+        sat_problem_add_encoded_clause_queue (sat, clauses, true);
+
+        g_queue_free (clauses);
+        sat_problem_clear_solution (sat);
+    }
+
+    g_hash_table_destroy (tbl_nodes);
+    g_ptr_array_free (nodes, true);
+    g_free (from);
+    g_free (to);
+    g_free (edge_lits);
+    g_array_free (node_lits, true);
+
+    return valid;
+}
+
+/* map raw literal of parity constraint xor to encoded literal, raw variables up to the greatest
+ * variable of the formula are mapped by encoded_mapping, greater ones to the auxiliary variables
+ * starting at first_aux. returns 0 if no mapping is specified. */
+static long int sat_problem_map_formula_xor_literal (struct sat_formula_xor *xor, GArray *encoded_mapping,
+                                                     long int first_aux, long int lit_raw)
+{
+    long int var_raw = (lit_raw < 0 ? -lit_raw : lit_raw);
+    long int lit_mapped;
+
+    if (var_raw > xor->max_var) {
+        lit_mapped = first_aux + var_raw - xor->max_var - 1;
+    } else if (var_raw >= encoded_mapping->len) {
+        printf ("ERROR: no mapping specified for raw variable %ld\n", var_raw);
+        return 0;
+    } else {
+        lit_mapped = g_array_index (encoded_mapping, long int, var_raw);
+    }
+
+    return (lit_raw < 0 ? -lit_mapped : lit_mapped);
+}
+
+/* add parity constraint xor of a formula with variables mapped by encoded_mapping, return true on success. */
+static bool sat_problem_add_formula_xor (struct sat_problem *sat, struct sat_formula_xor *xor, GArray *encoded_mapping)
+{
+    bool result = true;
+
+    guint n_lit = g_queue_get_length (xor->literals);
+    long int *xor_mapped = g_slice_alloc (sizeof (long int) * (n_lit + 1));
+
+    /* auxiliary variables of the formula only occur in their definitions */
+    long int max_var_raw = xor->max_var;
+    for (GList *li = xor->definitions; li != NULL; li = li->next) {
+        GQueue *clause_raw = li->data;
+        for (GList *lj = clause_raw->head; lj != NULL; lj = lj->next) {
+            long int lit_raw = GPOINTER_TO_SIZE (lj->data);
+            long int var_raw = (lit_raw < 0 ? -lit_raw : lit_raw);
+            if (var_raw > max_var_raw) max_var_raw = var_raw;
+        }
+    }
+    long int first_aux = sat_problem_new_aux_vars (sat, max_var_raw - xor->max_var);
+
+    guint i = 0;
+    for (GList *li = xor->literals->head; li != NULL; li = li->next) {
+        xor_mapped[i] = sat_problem_map_formula_xor_literal (xor, encoded_mapping, first_aux, GPOINTER_TO_SIZE (li->data));
+        if (xor_mapped[i] == 0) {
+            result = false;
+            goto sat_problem_add_formula_xor_finalize;
+        }
+        i++;
+    }
+    xor_mapped[n_lit] = 0;
+
+    for (GList *li = xor->definitions; li != NULL; li = li->next) {
+        GQueue *clause_raw    = li->data;
+        GSList *clause_mapped = NULL;
+
+        for (GList *lj = clause_raw->head; lj != NULL; lj = lj->next) {
+            long int lit_mapped = sat_problem_map_formula_xor_literal (xor, encoded_mapping, first_aux, GPOINTER_TO_SIZE (lj->data));
+            if (lit_mapped == 0) {
+                g_slist_free (clause_mapped);
+                result = false;
+                goto sat_problem_add_formula_xor_finalize;
+            }
+            clause_mapped = g_slist_prepend (clause_mapped, GSIZE_TO_POINTER (lit_mapped));
+        }
+
+        clause_mapped = g_slist_reverse (clause_mapped);
+        sat_problem_add_encoded_clause_gslist (sat, clause_mapped);
+        g_slist_free (clause_mapped);
+    }
+
+    sat_problem_add_encoded_xor_array (sat, xor_mapped);
+
+sat_problem_add_formula_xor_finalize:
+    g_slice_free1 (sizeof (long int) * (n_lit + 1), xor_mapped);
+    return result;
+}
+
+/* add a formula as mapping and return true on success.
+ * formula: the formula represented as string with variables 1 ... n.
+ * lit_mapping: list of literals (const char *) to map to variables in given formula.
+ * parsed formulas are cached for making multiple usage more efficient as only mapping
+ * needs to be applied individually whereas parsing only needs to be done once. */
+bool sat_problem_add_formula_mapping (struct sat_problem *sat, const char* formula, GSList *lit_mapping)
+{
+    if (sat == NULL) return false;
+    if (formula == NULL) return false;
+    if (lit_mapping == NULL) return false;
+
+    GList *clause_list = NULL;
+    struct sat_formula_xor *xor = NULL;
+
+    /* lookup / generate + cache: parity constraints are kept as xor, others are converted to cnf */
+    if (!g_hash_table_lookup_extended (sat->formula_to_xor_cache, formula, NULL, (void **) &xor)) {
+        SatFormula parsed_formula = NULL;
+
+        parsed_formula = sat_formula_parse (formula);
+        if (parsed_formula == NULL) {
+            printf ("ERROR: could not parse formula \"%s\"\n", formula);
+            return false;
+        }
+
+        xor = sat_formula_to_xor (parsed_formula);
+        if (xor == NULL) {
+            clause_list = sat_formula_to_cnf (parsed_formula);
+
+            if (clause_list == NULL) {
+                printf ("ERROR: invalid formula \"%s\"\n", formula);
+            }
+        }
+        sat_formula_free (&parsed_formula);
+
+        /* cache */
+        char *key = g_string_chunk_insert_const (sat->str_formulas, formula);
+        g_hash_table_insert (sat->formula_to_xor_cache, key, xor);
+        if (xor == NULL) g_hash_table_insert (sat->formula_to_cnf_cache, key, clause_list);
+    } else if (xor == NULL) {
+        clause_list = g_hash_table_lookup (sat->formula_to_cnf_cache, formula);
+    }
+
+    /* debug print */
+    /*
+    for (GList *li = clause_list; li != NULL; li = li->next) {
+        printf ("DEBUG: [");
+        GQueue *clause = li->data;
+        for (GList *lj = clause->head; lj != NULL; lj = lj->next) {
+            long int lit = GPOINTER_TO_SIZE (lj->data);
+            if (lj->next == NULL) {
+                printf ("%ld", lit);
+            } else {
+                printf ("%ld, ", lit);
+            }
+        }
+        printf ("]\n");
+    }
+    */
+
+    /* map */
+    bool result = true;
+    size_t n_lits = g_slist_length (lit_mapping);
+    GArray *encoded_mapping = g_array_sized_new (true, true, sizeof (long int), n_lits + 1);
+    long int zero_mapped = 0;
+    g_array_append_val (encoded_mapping, zero_mapped);
+
+    for (GSList *li = lit_mapping; li != NULL; li = li->next) {
+        const char *lit_str = li->data;
+        long int lit_enc = sat_problem_encode_literal (sat, lit_str);
+        g_array_append_val (encoded_mapping, lit_enc);
+        /* printf ("DEBUG: new encoded lit: %s -> %ld\n", lit_str, lit_enc); */
+    }
+
+    GSList *clause_list_mapped = NULL;
+
+    if (xor != NULL) {
+        result = sat_problem_add_formula_xor (sat, xor, encoded_mapping);
+        goto sat_problem_add_formula_mapping_finalize;
+    }
+
+    for (GList *li = clause_list; li != NULL; li = li->next) {
+        GQueue *clause_raw    = li->data;
+        GSList *clause_mapped = NULL;
+
+        for (GList *lj = clause_raw->head; lj != NULL; lj = lj->next) {
+            long int lit_raw = GPOINTER_TO_SIZE (lj->data);
+            bool lit_invert = false;
+            if (lit_raw < 0) {
+                lit_raw    = -lit_raw;
+                lit_invert = true;
+            }
+
+            if (lit_raw > n_lits) {
+                printf ("ERROR: no mapping specified for raw variable %ld\n", lit_raw);
+                g_slist_free (clause_mapped);
+                result = false;
+                goto sat_problem_add_formula_mapping_finalize;
+            }
+
+            long int lit_mapped = g_array_index (encoded_mapping, long int, lit_raw);
+            if (lit_invert) lit_mapped = -lit_mapped;
+
+            clause_mapped = g_slist_prepend (clause_mapped, GSIZE_TO_POINTER (lit_mapped));
+        }
+
+        clause_mapped = g_slist_reverse (clause_mapped);
+        clause_list_mapped = g_slist_prepend (clause_list_mapped, clause_mapped);
+    }
+
+    clause_list_mapped = g_slist_reverse (clause_list_mapped);
+
+    /* debug print */
+    /*
+    for (GSList *li = clause_list_mapped; li != NULL; li = li->next) {
         printf ("DEBUG: [");
         GSList *clause = li->data;
         for (GSList *lj = clause; lj != NULL; lj = lj->next) {
@@ -591,7 +1868,7 @@ bool sat_problem_add_formula_mapping (struct sat_problem *sat, const char* formu
     /* insert */
     for (GSList *li = clause_list_mapped; li != NULL; li = li->next) {
         GSList *clause = li->data;
-        base_cnf_add_clause_gslist (sat->cnf, clause);
+        sat_problem_add_encoded_clause_gslist (sat, clause);
     }
 
     /* cleanup */
@@ -602,14 +1879,19 @@ sat_problem_add_formula_mapping_finalize:
     return result;
 }
 
-/* lookup variable integer mapping and return mapped string */
+/* lookup variable integer mapping and return mapped string, names of auxiliary variables are created here */
 const char * sat_problem_get_varname_from_number (struct sat_problem *sat, long int number)
 {
     if (sat == NULL) return NULL;
     if (number <= 0) return NULL;
 
+    if (number > sat->last_var) return NULL;
+
     gpointer lookup_val = g_hash_table_lookup (sat->tbl_lit_int_to_name, GSIZE_TO_POINTER (number));
 
+    /* auxiliary variables are named on first request */
+    if (lookup_val == NULL) return sat_problem_aux_var_name (sat, number);
+
     return (const char *) lookup_val;
 }
 
@@ -627,8 +1909,8 @@ long int sat_problem_get_varnumber_from_name (struct sat_problem *sat, const cha
     }
 
     gpointer lookup_val = g_hash_table_lookup (sat->tbl_lit_name_to_int, name);
-    if (lookup_val == NULL) return 0;
-    long int result = GPOINTER_TO_SIZE (lookup_val);
+    long int result = (lookup_val == NULL ? sat_problem_aux_var_from_name (sat, name) : GPOINTER_TO_SIZE (lookup_val));
+    if (result == 0) return 0;
     if (invert) return -result;
     return result;
 }
@@ -642,52 +1924,463 @@ GQueue *sat_problem_get_clauses_mapped (struct sat_problem *sat)
     return base_cnf_clauses (sat->cnf);
 }
 
+/* append the clauses of encodings stored as descriptors (see sat_problem_set_lazy_encodings) to clauses
+ * as 0-terminated literal (long int) arrays allocated by g_slice and return their number. */
+unsigned long int sat_problem_append_lazy_clauses_mapped (struct sat_problem *sat, GQueue *clauses)
+{
+    if (sat == NULL) return 0;
+    return base_cnf_append_lazy_clauses (sat->cnf, clauses);
+}
+
+/* create a checkpoint of clauses and variables of sat to be restored by sat_problem_pop
+ * and return the resulting number of checkpoints. */
+unsigned int sat_problem_push (struct sat_problem *sat)
+{
+    if (sat == NULL) return 0;
+
+    struct sat_problem_scope *scope = g_slice_new (struct sat_problem_scope);
+
+    scope->n_clauses = base_cnf_num_clauses (sat->cnf);
+    scope->n_xors    = base_cnf_num_xors (sat->cnf);
+    scope->n_lazy    = base_cnf_num_lazy (sat->cnf);
+    scope->max_var   = base_cnf_max_var (sat->cnf);
+    scope->last_var  = sat->last_var;
+    scope->n_bitvectors = sat->bitvectors->len;
+    scope->n_ints       = sat->ints->len;
+    scope->n_softs      = sat->softs->len;
+    scope->n_objectives = sat->objectives->len;
+
+    sat->scopes = g_slist_prepend (sat->scopes, scope);
+
+    return g_slist_length (sat->scopes);
+}
+
+/* restore sat to the checkpoint created by the n_levels-th last sat_problem_push.
+ * clauses and variables added afterwards are removed, cached parsed formulas are kept.
+ * returns false if there are less than n_levels checkpoints. */
+bool sat_problem_pop (struct sat_problem *sat, unsigned int n_levels)
+{
+    if (sat == NULL) return false;
+    if (n_levels == 0) return true;
+
+    if (g_slist_length (sat->scopes) < n_levels) {
+        printf ("ERROR: no checkpoint to restore (%d available)\n", g_slist_length (sat->scopes));
+        return false;
+    }
+
+    /* only the outermost restored checkpoint matters */
+    for (unsigned int i = 1; i < n_levels; i++) {
+        g_slice_free (struct sat_problem_scope, sat->scopes->data);
+        sat->scopes = g_slist_delete_link (sat->scopes, sat->scopes);
+    }
+
+    struct sat_problem_scope *scope = sat->scopes->data;
+    sat->scopes = g_slist_delete_link (sat->scopes, sat->scopes);
+
+    sat_problem_clear_solution (sat);
+
+    base_cnf_truncate (sat->cnf, scope->n_clauses, scope->n_xors, scope->n_lazy, scope->max_var);
+
+    /* unmap variables created after checkpoint */
+    for (long int var = sat->last_var; var > scope->last_var; var--) {
+        gpointer var_ptr = GSIZE_TO_POINTER (var);
+        const char *name = g_hash_table_lookup (sat->tbl_lit_int_to_name, var_ptr);
+
+        if (name != NULL) g_hash_table_remove (sat->tbl_lit_name_to_int, name);
+        g_hash_table_remove (sat->tbl_lit_int_to_name, var_ptr);
+
+        const char *group = g_hash_table_lookup (sat->tbl_selector_to_group, var_ptr);
+        if (group != NULL) {
+            g_hash_table_remove (sat->tbl_group_to_selector, group);
+            g_hash_table_remove (sat->tbl_selector_to_group, var_ptr);
+        }
+    }
+
+    if (sat->group_selector > scope->last_var) sat->group_selector = 0;
+
+    /* undeclare bit-vectors declared after checkpoint */
+    while (sat->bitvectors->len > scope->n_bitvectors) {
+        g_hash_table_remove (sat->tbl_bitvector_width, g_ptr_array_index (sat->bitvectors, sat->bitvectors->len - 1));
+        g_ptr_array_remove_index (sat->bitvectors, sat->bitvectors->len - 1);
+    }
+    while (sat->ints->len > scope->n_ints) {
+        g_hash_table_remove (sat->tbl_ints, g_ptr_array_index (sat->ints, sat->ints->len - 1));
+        g_ptr_array_remove_index (sat->ints, sat->ints->len - 1);
+    }
+    /* forget value variables of remaining integer variables defined after checkpoint */
+    for (guint i = 0; i < sat->ints->len; i++) {
+        struct sat_problem_int *x = g_hash_table_lookup (sat->tbl_ints, g_ptr_array_index (sat->ints, i));
+        if (x->eq_vars == NULL) continue;
+
+        unsigned long int n_values = (unsigned long int) x->max - (unsigned long int) x->min + 1;
+        for (unsigned long int j = 0; j < n_values; j++) {
+            if (x->eq_vars[j] > scope->last_var) x->eq_vars[j] = 0;
+        }
+    }
+
+    /* remove soft clauses added after checkpoint */
+    g_array_set_size (sat->softs, scope->n_softs);
+    g_ptr_array_set_size (sat->objectives, scope->n_objectives);
+
+    sat->last_var = scope->last_var;
+
+    /* cached BDD nodes may use removed variables */
+    sat_pb_cache_clear (sat->pb_cache);
+
+    g_slice_free (struct sat_problem_scope, scope);
+
+    return true;
+}
+
+/* return number of checkpoints created by sat_problem_push that are not yet restored */
+unsigned int sat_problem_scope_level (struct sat_problem *sat)
+{
+    if (sat == NULL) return 0;
+    return g_slist_length (sat->scopes);
+}
+
+/* enable preprocessing of clauses before each solver run with given options
+ * or disable it if options is NULL. */
+void sat_problem_set_preprocess (struct sat_problem *sat, const struct sat_preprocess_options *options)
+{
+    if (sat == NULL) return;
+    base_cnf_set_preprocess (sat->cnf, options);
+}
+
+/* enable or disable simplification of clauses added afterwards by values implied
+ * by unit clauses and binary clauses. */
+void sat_problem_set_unit_simplification (struct sat_problem *sat, bool enable)
+{
+    if (sat == NULL) return;
+    base_cnf_set_unit_simplification (sat->cnf, enable);
+}
+
+/* enable or disable solving variable-disjoint components by concurrent solver runs.
+ * n_threads: number of concurrent runs (0: number of processors),
+ * min_vars: components with less variables are solved together by one run. */
+void sat_problem_set_split_components (struct sat_problem *sat, bool enable, unsigned int n_threads, unsigned long int min_vars)
+{
+    if (sat == NULL) return;
+    base_cnf_set_split_components (sat->cnf, enable, n_threads, min_vars);
+}
+
+/* enable or disable adding symmetry-breaking clauses for symmetries found before each solver run.
+ * max_vertices: symmetry search is skipped if number of literals + clauses is greater,
+ * max_generators: maximum number of symmetry generators to break. */
+void sat_problem_set_symmetry_breaking (struct sat_problem *sat, bool enable, unsigned long int max_vertices, unsigned int max_generators)
+{
+    if (sat == NULL) return;
+    base_cnf_set_symmetry_breaking (sat->cnf, enable, max_vertices, max_generators);
+}
+
+/* enable or disable compacting and renumbering variables for locality before each solver run. */
+void sat_problem_set_renumber (struct sat_problem *sat, bool enable)
+{
+    if (sat == NULL) return;
+    base_cnf_set_renumber (sat->cnf, enable);
+}
+
+/* enable or disable storing cardinality encodings (m of n and 1 of n except order encoding) with at least
+ * min_clauses clauses as compact descriptors, which are expanded into clauses on solving. */
+void sat_problem_set_lazy_encodings (struct sat_problem *sat, bool enable, unsigned long int min_clauses)
+{
+    if (sat == NULL) return;
+    sat->lazy_encodings   = enable;
+    sat->lazy_min_clauses = min_clauses;
+}
+
+/* set encoding of XOR constraints: native XOR clauses for capable solvers or chains of XORs with at most cut
+ * literals encoded as clauses. gauss_max_bits: maximum matrix size of Gauss-Jordan elimination (0: disabled). */
+void sat_problem_set_xor (struct sat_problem *sat, bool native, unsigned int cut, unsigned long int gauss_max_bits)
+{
+    if (sat == NULL) return;
+    base_cnf_set_xor (sat->cnf, native, cut, gauss_max_bits);
+}
+
+/* return group selectors of sat as 0-terminated array (long int) to be freed with g_free, each of them
+ * inverted unless the group is enabled by enable_groups (GSList of group names (const char *), NULL for all
+ * groups) and not disabled by disable_groups. returns NULL if a group is not found. */
+static long int * sat_problem_group_assumptions (struct sat_problem *sat, GSList *enable_groups, GSList *disable_groups)
+{
+    for (GSList *li = enable_groups; li != NULL; li = li->next) {
+        if (!g_hash_table_contains (sat->tbl_group_to_selector, li->data)) {
+            printf ("ERROR: group not found: %s\n", (const char *) li->data);
+            return NULL;
+        }
+    }
+    for (GSList *li = disable_groups; li != NULL; li = li->next) {
+        if (!g_hash_table_contains (sat->tbl_group_to_selector, li->data)) {
+            printf ("ERROR: group not found: %s\n", (const char *) li->data);
+            return NULL;
+        }
+    }
+
+    long int *result = g_new0 (long int, g_hash_table_size (sat->tbl_group_to_selector) + 1);
+
+    GHashTableIter iter;
+    gpointer key;
+    gpointer value;
+    g_hash_table_iter_init (&iter, sat->tbl_group_to_selector);
+
+    int i = 0;
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+        long int selector = GPOINTER_TO_SIZE (value);
+        bool enabled = true;
+
+        if ((enable_groups != NULL) && (g_slist_find_custom (enable_groups, key, (GCompareFunc) strcmp) == NULL)) enabled = false;
+        if (g_slist_find_custom (disable_groups, key, (GCompareFunc) strcmp) != NULL) enabled = false;
+
+        result[i] = (enabled ? selector : -selector);
+        i++;
+    }
+
+    return result;
+}
+
 /* solve current sat problem and return false on errors, true otherwise.
  * tmp_file_name: prefix for temporary files for solver,
  * solver_bin: binary to execute,
  * solution_on_stdout: if true, assume that solver prints result on stdout,
  *   otherwise to filename given as second argument,
  * cleanup: if true, temporary files will be removed afterwards,
- * cnf_gz: CNF file will be in gzipped dimacs, otherwise in plain dimacs. */
-bool sat_problem_solve (struct sat_problem *sat, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz)
+ * cnf_gz: CNF file will be in gzipped dimacs, otherwise in plain dimacs,
+ * assumptions: GSList of literals (const char *) assumed only for this run or NULL,
+ *   if not satisfiable, a subset of them responsible for it can be obtained
+ *   with sat_problem_failed_assumptions,
+ * enable_groups: GSList of group names (const char *) enabled for this run, NULL for all groups,
+ * disable_groups: GSList of group names (const char *) disabled for this run or NULL,
+ *   if not satisfiable, enabled groups responsible for it can be obtained with sat_problem_failed_groups,
+ * cube_and_conquer: if true, the problem is split into cubes by lookahead solved by concurrent solver runs,
+ * cube_depth: maximum number of decisions per cube (0: depending on n_threads),
+ * n_threads: number of concurrent solver runs for cube_and_conquer (0: number of processors). */
+bool sat_problem_solve (struct sat_problem *sat, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                        GSList *assumptions, GSList *enable_groups, GSList *disable_groups,
+                        bool cube_and_conquer, unsigned int cube_depth, unsigned int n_threads, bool verify)
+{
+    if (sat == NULL) return false;
+    if (tmp_file_name == NULL) return false;
+
+    sat_problem_clear_solution (sat);
+
+    /* group selectors */
+    long int *group_array = sat_problem_group_assumptions (sat, enable_groups, disable_groups);
+    if (group_array == NULL) return false;
+
+    /* assumptions + group selectors */
+    size_t n_assumptions = g_slist_length (assumptions) + g_hash_table_size (sat->tbl_group_to_selector);
+    long int *assumption_array = g_new0 (long int, n_assumptions + 1);
+
+    int i = 0;
+    for (GSList *li = assumptions; li != NULL; li = li->next, i++) {
+        const char *lit_str = li->data;
+        long int literal = sat_problem_get_varnumber_from_name (sat, lit_str);
+        if (literal == 0) {
+            printf ("ERROR: variable not found: %s\n", lit_str);
+            g_free (group_array);
+            g_free (assumption_array);
+            return false;
+        }
+        assumption_array[i] = literal;
+    }
+    for (int j = 0; group_array[j] != 0; j++, i++) {
+        assumption_array[i] = group_array[j];
+    }
+    g_free (group_array);
+
+    bool run_success;
+    if (cube_and_conquer) {
+        run_success = base_cnf_solve_cube_and_conquer (sat->cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumption_array,
+                                                       cube_depth, n_threads);
+    } else {
+        run_success = base_cnf_solve (sat->cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumption_array);
+    }
+
+    if (run_success == false) {
+        g_free (assumption_array);
+        return false;
+    }
+
+    GSList *solution = base_cnf_solution (sat->cnf);
+
+    if (solution == NULL) {
+        /* reduce assumptions to those responsible */
+        if (n_assumptions > 0) {
+            run_success = base_cnf_reduce_failed_assumptions (sat->cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumption_array);
+            if (run_success == false) {
+                g_free (assumption_array);
+                return false;
+            }
+            for (i = 0; assumption_array[i] != 0; i++) {
+                long int literal = assumption_array[i];
+                const char *group = NULL;
+                if (literal > 0) group = g_hash_table_lookup (sat->tbl_selector_to_group, GSIZE_TO_POINTER (literal));
+
+                if (group != NULL) {
+                    sat->failed_groups = g_slist_prepend (sat->failed_groups, (gpointer) group);
+                } else {
+                    sat->failed_assumptions = g_slist_prepend (sat->failed_assumptions, GSIZE_TO_POINTER (literal));
+                }
+            }
+            sat->failed_assumptions = g_slist_reverse (sat->failed_assumptions);
+            sat->failed_groups      = g_slist_reverse (sat->failed_groups);
+        }
+        g_free (assumption_array);
+
+        sat->solver_run  = true;
+        sat->satisfiable = false;
+        return true;
+    }
+
+    if (verify && !sat_problem_verify_solution (sat, solution, assumption_array, n_threads)) {
+        g_free (assumption_array);
+        return false;
+    }
+    g_free (assumption_array);
+
+    sat_problem_set_solution (sat, solution);
+
+    return true;
+}
+
+/* solve sat with all groups enabled by a solver run stopped after timeout seconds (0: no limit) without printing
+ * solver output and without changing the solution of sat. *seconds is set to the duration of the run, *timed_out
+ * to true if it has been stopped, otherwise *satisfiable to the result. other arguments are the same as for
+ * sat_problem_solve. returns false on errors. */
+bool sat_problem_solve_timed (struct sat_problem *sat, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                              double timeout, double *seconds, bool *timed_out, bool *satisfiable)
 {
     if (sat == NULL) return false;
     if (tmp_file_name == NULL) return false;
 
-    bool run_success = base_cnf_solve (sat->cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz);
+    *seconds     = 0;
+    *timed_out   = false;
+    *satisfiable = false;
+
+    long int *assumption_array = sat_problem_group_assumptions (sat, NULL, NULL);
+
+    base_cnf_set_solver_timeout (sat->cnf, timeout);
+
+    GSList *solution = NULL;
+    gint64 start = g_get_monotonic_time ();
+    bool run_success = base_cnf_solve_assuming (sat->cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                                assumption_array, false, &solution);
+    *seconds = (double) (g_get_monotonic_time () - start) / G_USEC_PER_SEC;
+
+    bool run_timed_out = base_cnf_solver_timed_out (sat->cnf);
+
+    base_cnf_set_solver_timeout (sat->cnf, 0);
+    g_free (assumption_array);
+
+    if (!run_success) {
+        if (run_timed_out) {
+            *timed_out = true;
+            return true;
+        }
+        return false;
+    }
+
+    *satisfiable = (solution != NULL);
+    g_slist_free (solution);
+
+    return true;
+}
+
+/* set *n_vars to the number of variables and *n_clauses to the number of clauses of sat
+ * (including clauses of encodings stored as descriptors) */
+void sat_problem_size (struct sat_problem *sat, unsigned long int *n_vars, unsigned long int *n_clauses)
+{
+    *n_vars    = 0;
+    *n_clauses = 0;
+    if (sat == NULL) return;
+
+    *n_vars    = base_cnf_max_var (sat->cnf);
+    *n_clauses = base_cnf_num_clauses (sat->cnf) + base_cnf_num_lazy_clauses (sat->cnf);
+}
 
-    if (run_success == false) return false;
+/* invalidate current solution to obtain a different one on next solve */
+void sat_problem_cancel_solution (struct sat_problem *sat)
+{
+    base_cnf_cancel_solution (sat->cnf);
+    sat_problem_clear_solution (sat);
+}
 
-    sat->solver_run = true;
+/* check model given as GSList of literals (long int) against all clauses and XOR constraints of cnf
+ * and 0-terminated array of assumptions (long int) or NULL. returns true if all of them are satisfied,
+ * otherwise the first violated one is printed with named literals. */
+static bool sat_problem_verify_solution (struct sat_problem *sat, GSList *solution, const long int *assumptions, unsigned int n_threads)
+{
+    bool is_xor = false;
+    long int *violated = base_cnf_verify_model (sat->cnf, solution, n_threads, &is_xor);
+
+    /* assumptions are checked after all constraints */
+    long int violated_assumption[2] = {0, 0};
+    if ((violated == NULL) && (assumptions != NULL) && (assumptions[0] != 0)) {
+        unsigned long int max_var = base_cnf_max_var (sat->cnf);
+        signed char *value = g_new0 (signed char, max_var + 1);
+
+        for (GSList *li = solution; li != NULL; li = li->next) {
+            long int lit = GPOINTER_TO_SIZE (li->data);
+            unsigned long int var = (lit > 0 ? lit : -lit);
+            if (var <= max_var) value[var] = (lit > 0 ? 1 : -1);
+        }
+        for (unsigned int i = 0; assumptions[i] != 0; i++) {
+            unsigned long int var = (assumptions[i] > 0 ? assumptions[i] : -assumptions[i]);
+            if ((var > max_var) || (value[var] != (assumptions[i] > 0 ? 1 : -1))) {
+                violated_assumption[0] = assumptions[i];
+                break;
+            }
+        }
 
-    GSList *solution = base_cnf_solution (sat->cnf);
+        g_free (value);
+    }
 
-    if (solution == NULL) {
-        sat->satisfiable = false;
+    if ((violated == NULL) && (violated_assumption[0] == 0)) {
+        printf ("INFO: model satisfies %lu clauses and %lu XOR constraints\n",
+                base_cnf_num_clauses (sat->cnf) + base_cnf_num_lazy_clauses (sat->cnf), base_cnf_num_xors (sat->cnf));
         return true;
     }
-    sat->satisfiable = true;
-
-    for (GSList *li = solution; li != NULL; li = li->next) {
-        long int i_result = GPOINTER_TO_SIZE (li->data);
-
-        bool var_result = (i_result > 0 ? true     : false);
-        long int var    = (i_result > 0 ? i_result : -i_result);
-        char *var_name  = g_hash_table_lookup (sat->tbl_lit_int_to_name, GSIZE_TO_POINTER (var));
-
-        if (var_name == NULL) continue;
 
-        g_hash_table_insert (sat->tbl_var_result, var_name, GSIZE_TO_POINTER (var_result));
+    const long int *literals = (violated != NULL ? violated : violated_assumption);
+    const char *kind = (violated == NULL ? "assumption" : (is_xor ? "XOR constraint" : "clause"));
+
+    printf ("ERROR: model violates %s:", kind);
+    for (unsigned int i = 0; literals[i] != 0; i++) {
+        long int var = (literals[i] > 0 ? literals[i] : -literals[i]);
+        const char *name = sat_problem_get_varname_from_number (sat, var);
+        if (name != NULL) {
+            printf (" %s%s", (literals[i] < 0 ? "-" : ""), name);
+        } else {
+            printf (" %ld", literals[i]);
+        }
     }
+    printf ("\n");
 
-    return true;
+    g_free (violated);
+    return false;
 }
 
-/* invalidate current solution to obtain a different one on next solve */
-void sat_problem_cancel_solution (struct sat_problem *sat)
+/* check model of last solver run against all clauses and XOR constraints and return true if all of them
+ * are satisfied, the first violated one is reported with named literals. n_threads: number of concurrent
+ * jobs (0: number of processors). In case of errors (e.g. not solved, not satisfiable) *error is set to true. */
+bool sat_problem_verify_model (struct sat_problem *sat, unsigned int n_threads, bool *error)
 {
-    base_cnf_cancel_solution (sat->cnf);
-    sat_problem_clear_solution (sat);
+    if (sat == NULL) {
+        if (error != NULL) *error = true;
+        return false;
+    }
+    if (!sat->solver_run) {
+        if (error != NULL) *error = true;
+        printf ("ERROR: problem not yet solved\n");
+        return false;
+    }
+    if (!sat->satisfiable) {
+        if (error != NULL) *error = true;
+        printf ("ERROR: problem not satisfiable\n");
+        return false;
+    }
+
+    if (error != NULL) *error = false;
+    return sat_problem_verify_solution (sat, base_cnf_solution (sat->cnf), NULL, n_threads);
 }
 
 /* return true, if problem is satisfiable. *error is set to true in
@@ -739,6 +2432,151 @@ bool sat_problem_var_result (struct sat_problem *sat, const char *var, bool *err
     return (bool) GPOINTER_TO_SIZE (result);
 }
 
+/* obtain value of bit-vector name as decimal string (two's complement if is_signed is true) to be freed
+ * with g_free. Bits not occurring in the solution are assumed to be false. In case of errors
+ * (e.g. unknown bit-vector, not satisfiable, ...) *error is set to true and NULL is returned. */
+char * sat_problem_bitvector_result (struct sat_problem *sat, const char *name, bool is_signed, bool *error)
+{
+    if (error != NULL) *error = true;
+
+    bool sat_error = false;
+    if (!sat_problem_satisfiable (sat, &sat_error) || sat_error) {
+        if (!sat_error) printf ("ERROR: problem not satisfiable\n");
+        return NULL;
+    }
+
+    unsigned int width = sat_problem_bitvector_width (sat, name);
+    if (width == 0) {
+        printf ("ERROR: bit-vector not found: %s\n", name);
+        return NULL;
+    }
+
+    bool *bits = g_new (bool, width);
+    GString *temp_str = g_string_new (NULL);
+    for (unsigned int i = 0; i < width; i++) {
+        g_string_printf (temp_str, "%s_%u", name, i);
+        bits[i] = (bool) GPOINTER_TO_SIZE (g_hash_table_lookup (sat->tbl_var_result, temp_str->str));
+    }
+
+    /* magnitude of negative values: invert and add 1 */
+    bool negative = is_signed && bits[width - 1];
+    if (negative) {
+        bool carry = true;
+        for (unsigned int i = 0; i < width; i++) {
+            bool bit = !bits[i];
+            bits[i] = (bit != carry);
+            carry   = bit && carry;
+        }
+    }
+
+    /* decimal digits, least significant first: double and add each bit from the most significant one,
+     * width bits need less than width / 3 + 1 digits */
+    guint8 *digits        = g_new0 (guint8, width / 3 + 2);
+    unsigned int n_digits = 1;
+    for (unsigned int i = width; i > 0; i--) {
+        unsigned int carry = (bits[i - 1] ? 1 : 0);
+        for (unsigned int d = 0; d < n_digits; d++) {
+            unsigned int digit = digits[d] * 2 + carry;
+            digits[d] = digit % 10;
+            carry     = digit / 10;
+        }
+        if (carry != 0) digits[n_digits++] = carry;
+    }
+
+    g_string_truncate (temp_str, 0);
+    if (negative) g_string_append_c (temp_str, '-');
+    for (unsigned int d = n_digits; d > 0; d--) g_string_append_c (temp_str, '0' + digits[d - 1]);
+
+    g_free (digits);
+    g_free (bits);
+
+    if (error != NULL) *error = false;
+    return g_string_free (temp_str, false);
+}
+
+/* obtain value of integer variable name. Literals not occurring in the solution are assumed to be false.
+ * In case of errors (e.g. unknown variable, not satisfiable, ...) *error is set to true. */
+long int sat_problem_int_result (struct sat_problem *sat, const char *name, bool *error)
+{
+    if (error != NULL) *error = true;
+
+    bool sat_error = false;
+    if (!sat_problem_satisfiable (sat, &sat_error) || sat_error) {
+        if (!sat_error) printf ("ERROR: problem not satisfiable\n");
+        return 0;
+    }
+
+    struct sat_problem_int *x = g_hash_table_lookup (sat->tbl_ints, name);
+    if (x == NULL) {
+        printf ("ERROR: integer variable not found: %s\n", name);
+        return 0;
+    }
+
+    unsigned int n_lits = sat_int_num_lits (x->encoding, x->min, x->max);
+    bool *value = g_new (bool, n_lits + 1);
+
+    GString *temp_str = g_string_new (NULL);
+    for (unsigned int i = 0; i < n_lits; i++) {
+        sat_problem_int_lit_name (temp_str, name, x, i);
+        value[i] = (bool) GPOINTER_TO_SIZE (g_hash_table_lookup (sat->tbl_var_result, temp_str->str));
+    }
+    g_string_free (temp_str, true);
+
+    long int result = sat_int_decode (x->encoding, x->min, x->max, value);
+    g_free (value);
+
+    if (error != NULL) *error = false;
+    return result;
+}
+
+/* obtain a GSList of assumption literals (long int) of last solver run that are responsible
+ * for the problem not being satisfiable. The result should not be modified.
+ * In case of errors (e.g. not solved, satisfiable, ...) *error is set to true. */
+GSList *sat_problem_failed_assumptions (struct sat_problem *sat, bool *error)
+{
+    if (sat == NULL) {
+        if (error != NULL) *error = true;
+        return NULL;
+    }
+    if (!sat->solver_run) {
+        if (error != NULL) *error = true;
+        printf ("ERROR: problem not yet solved\n");
+        return NULL;
+    }
+    if (sat->satisfiable) {
+        if (error != NULL) *error = true;
+        printf ("ERROR: problem is satisfiable\n");
+        return NULL;
+    }
+
+    if (error != NULL) *error = false;
+    return sat->failed_assumptions;
+}
+
+/* obtain a GSList of names (const char *) of enabled groups of last solver run that are responsible
+ * for the problem not being satisfiable. The result should not be modified.
+ * In case of errors (e.g. not solved, satisfiable, ...) *error is set to true. */
+GSList *sat_problem_failed_groups (struct sat_problem *sat, bool *error)
+{
+    if (sat == NULL) {
+        if (error != NULL) *error = true;
+        return NULL;
+    }
+    if (!sat->solver_run) {
+        if (error != NULL) *error = true;
+        printf ("ERROR: problem not yet solved\n");
+        return NULL;
+    }
+    if (sat->satisfiable) {
+        if (error != NULL) *error = true;
+        printf ("ERROR: problem is satisfiable\n");
+        return NULL;
+    }
+
+    if (error != NULL) *error = false;
+    return sat->failed_groups;
+}
+
 /* iterator function for generating result list for sat_problem_var_result_list
  * from GHashTable */
 static void sat_problem_var_result_list_gen_func (gpointer key, gpointer value, gpointer user_data)
@@ -779,3 +2617,426 @@ GSList *sat_problem_var_result_list (struct sat_problem *sat, bool var_assignmen
 
     return iter_data.result;
 }
+
+/* thread pool function for checking backbone candidate variable (long int) */
+static void sat_problem_backbone_check_func (gpointer data, gpointer user_data)
+{
+    long int var = GPOINTER_TO_SIZE (data);
+    struct sat_problem_backbone_data *bb = user_data;
+
+    /* still a candidate? */
+    g_mutex_lock (&bb->mutex);
+    if ((bb->error) || (bb->state[var] != SAT_PROBLEM_BACKBONE_CANDIDATE)) {
+        g_mutex_unlock (&bb->mutex);
+        return;
+    }
+    bb->state[var] = SAT_PROBLEM_BACKBONE_PENDING;
+    bb->n_solver_runs++;
+    long int *assumptions = g_new0 (long int, bb->n_group_assumptions + 2);
+    memcpy (assumptions, bb->group_assumptions, sizeof (long int) * bb->n_group_assumptions);
+    assumptions[bb->n_group_assumptions] = -bb->literal[var];
+    g_mutex_unlock (&bb->mutex);
+
+    /* solve with inverted candidate */
+    char *tmp_file_name = g_strdup_printf ("%s_bb_%ld", bb->tmp_file_name, var);
+    GSList *solution = NULL;
+
+    bool success = base_cnf_solve_assuming (bb->sat->cnf, tmp_file_name, bb->solver_bin, bb->solution_on_stdout,
+                                            bb->cleanup, bb->cnf_gz, assumptions, false, &solution);
+    g_free (tmp_file_name);
+    g_free (assumptions);
+
+    g_mutex_lock (&bb->mutex);
+    if (!success) {
+        bb->error = true;
+    } else if (solution == NULL) {
+        /* inverted candidate not satisfiable: fixed */
+        bb->state[var] = SAT_PROBLEM_BACKBONE_FIXED;
+    } else {
+        /* filter all candidates by new solution */
+        bb->state[var] = SAT_PROBLEM_BACKBONE_NONE;
+        for (GSList *li = solution; li != NULL; li = li->next) {
+            long int lit  = GPOINTER_TO_SIZE (li->data);
+            long int ivar = (lit > 0 ? lit : -lit);
+            if (ivar >= bb->n_vars) continue;
+            if (bb->state[ivar] == SAT_PROBLEM_BACKBONE_FIXED) continue;
+            if (bb->literal[ivar] != lit) bb->state[ivar] = SAT_PROBLEM_BACKBONE_NONE;
+        }
+    }
+    g_mutex_unlock (&bb->mutex);
+
+    g_slist_free (solution);
+}
+
+/* compute backbone of sat restricted to named variables and return it as a GSList of literals (long int)
+ * that have the same value in every solution. After an initial solution each remaining candidate is checked
+ * by a solver run assuming its inverted value, new solutions remove candidates with differing values.
+ * n_threads: number of solver runs executed concurrently (0: number of processors),
+ * other arguments are the same as for sat_problem_solve.
+ * In case of errors (e.g. not satisfiable, ...) *error is set to true. */
+GSList *sat_problem_backbone (struct sat_problem *sat, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                              GSList *enable_groups, GSList *disable_groups, unsigned int n_threads, bool *error)
+{
+    if (error != NULL) *error = true;
+    if (sat == NULL) return NULL;
+    if (tmp_file_name == NULL) return NULL;
+
+    long int *group_assumptions = sat_problem_group_assumptions (sat, enable_groups, disable_groups);
+    if (group_assumptions == NULL) return NULL;
+
+    /* initial solution */
+    GSList *solution = NULL;
+    if (!base_cnf_solve_assuming (sat->cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz, group_assumptions, true, &solution)) {
+        g_free (group_assumptions);
+        return NULL;
+    }
+    if (solution == NULL) {
+        printf ("ERROR: problem not satisfiable\n");
+        g_free (group_assumptions);
+        return NULL;
+    }
+
+    /* candidates */
+    struct sat_problem_backbone_data bb;
+
+    bb.sat                 = sat;
+    bb.tmp_file_name       = tmp_file_name;
+    bb.solver_bin          = solver_bin;
+    bb.solution_on_stdout  = solution_on_stdout;
+    bb.cleanup             = cleanup;
+    bb.cnf_gz              = cnf_gz;
+    bb.group_assumptions   = group_assumptions;
+    bb.n_group_assumptions = g_hash_table_size (sat->tbl_group_to_selector);
+    bb.n_vars              = base_cnf_max_var (sat->cnf) + 1;
+    bb.literal             = g_new0 (long int, bb.n_vars);
+    bb.state               = g_new0 (unsigned char, bb.n_vars);
+    bb.n_solver_runs       = 1;
+    bb.error               = false;
+    g_mutex_init (&bb.mutex);
+
+    for (GSList *li = solution; li != NULL; li = li->next) {
+        long int lit = GPOINTER_TO_SIZE (li->data);
+        long int var = (lit > 0 ? lit : -lit);
+        if (var >= bb.n_vars) continue;
+
+        const char *var_name = g_hash_table_lookup (sat->tbl_lit_int_to_name, GSIZE_TO_POINTER (var));
+        if (sat_problem_varname_is_internal (var_name)) continue;
+
+        bb.literal[var] = lit;
+        bb.state[var]   = SAT_PROBLEM_BACKBONE_CANDIDATE;
+    }
+    g_slist_free (solution);
+
+    /* check candidates */
+    if (n_threads == 0) n_threads = g_get_num_processors ();
+    printf ("INFO: checking backbone candidates (%u threads)...\n", n_threads);
+
+    GThreadPool *pool = g_thread_pool_new (sat_problem_backbone_check_func, &bb, n_threads, false, NULL);
+    for (long int var = 1; var < bb.n_vars; var++) {
+        if (bb.state[var] != SAT_PROBLEM_BACKBONE_CANDIDATE) continue;
+        g_thread_pool_push (pool, GSIZE_TO_POINTER (var), NULL);
+    }
+    g_thread_pool_free (pool, false, true);
+
+    /* result */
+    GSList *result = NULL;
+    if (!bb.error) {
+        for (long int var = bb.n_vars - 1; var > 0; var--) {
+            if (bb.state[var] != SAT_PROBLEM_BACKBONE_FIXED) continue;
+            result = g_slist_prepend (result, GSIZE_TO_POINTER (bb.literal[var]));
+        }
+        printf ("INFO: backbone: %u literals, %lu solver runs\n", g_slist_length (result), bb.n_solver_runs);
+        if (error != NULL) *error = false;
+    }
+
+    g_mutex_clear (&bb.mutex);
+    g_free (bb.literal);
+    g_free (bb.state);
+    g_free (group_assumptions);
+
+    return result;
+}
+
+/* enumerate solutions of sat projected onto named variables without modifying sat.
+ * var_list: GSList of variable names (const char *) to project on, NULL for all named variables,
+ * limit: maximum number of solutions, 0 for no limit,
+ * solution_func: called for each solution with a 0-terminated array of literals (long int)
+ *   in order of var_list, enumeration is stopped if it returns false,
+ * other arguments are the same as for sat_problem_solve.
+ * returns the number of solutions or -1 on errors (e.g. unknown variable). */
+long int sat_problem_enumerate_solutions (struct sat_problem *sat, GSList *var_list, unsigned long int limit,
+                                          const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                          GSList *enable_groups, GSList *disable_groups,
+                                          SatProblemSolutionFunc solution_func, gpointer user_data)
+{
+    if (sat == NULL) return -1;
+    if (tmp_file_name == NULL) return -1;
+
+    long int *group_assumptions = sat_problem_group_assumptions (sat, enable_groups, disable_groups);
+    if (group_assumptions == NULL) return -1;
+
+    GArray *vars = g_array_new (true, true, sizeof (long int));
+
+    if (var_list != NULL) {
+        for (GSList *li = var_list; li != NULL; li = li->next) {
+            const char *var_name = li->data;
+            gpointer lookup_val = g_hash_table_lookup (sat->tbl_lit_name_to_int, var_name);
+            if (lookup_val == NULL) {
+                printf ("ERROR: variable not found: %s\n", var_name);
+                g_array_free (vars, true);
+                g_free (group_assumptions);
+                return -1;
+            }
+            long int var = GPOINTER_TO_SIZE (lookup_val);
+            g_array_append_val (vars, var);
+        }
+    } else {
+        for (long int var = 1; var <= sat->last_var; var++) {
+            const char *var_name = g_hash_table_lookup (sat->tbl_lit_int_to_name, GSIZE_TO_POINTER (var));
+            if (sat_problem_varname_is_internal (var_name)) continue;
+            g_array_append_val (vars, var);
+        }
+    }
+
+    long int result = base_cnf_enumerate_solutions (sat->cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                                    group_assumptions, (long int *) vars->data, limit, solution_func, user_data);
+
+    g_array_free (vars, true);
+    g_free (group_assumptions);
+
+    return result;
+}
+
+/* return index of objective name, which is created if create is true, -1 if it does not exist */
+static gint sat_problem_objective_index (struct sat_problem *sat, const char *name, bool create)
+{
+    for (guint i = 0; i < sat->objectives->len; i++) {
+        if (strcmp (g_ptr_array_index (sat->objectives, i), name) == 0) return i;
+    }
+    if (!create) return -1;
+
+    g_ptr_array_add (sat->objectives, g_string_chunk_insert_const (sat->str_literals, name));
+
+    return sat->objectives->len - 1;
+}
+
+/* add a soft clause (GSList of literals (const char *)) with positive weight counted in objective (NULL: "cost")
+ * if violated and return true on success. */
+bool sat_problem_add_soft_clause (struct sat_problem *sat, GSList *clause, long int weight, const char *objective)
+{
+    if (sat == NULL) return false;
+
+    if (weight <= 0) {
+        printf ("ERROR: weight of soft clause must be positive\n");
+        return false;
+    }
+    for (GSList *li = clause; li != NULL; li = li->next) {
+        const char *lit_str = li->data;
+        if ((strlen (lit_str) == 0) || (strcmp (lit_str, "-") == 0)) {
+            printf ("ERROR: invalid literal in soft clause\n");
+            return false;
+        }
+    }
+
+    struct sat_problem_soft soft;
+    soft.objective = sat_problem_objective_index (sat, (objective != NULL ? objective : "cost"), true);
+    soft.weight    = weight;
+
+    if ((clause != NULL) && (clause->next == NULL)) {
+        /* a single literal is relaxed by itself */
+        soft.lit = -sat_problem_encode_literal (sat, clause->data);
+    } else {
+        guint len = g_slist_length (clause);
+        long int *relaxed = g_new (long int, len + 2);
+
+        guint i = 0;
+        for (GSList *li = clause; li != NULL; li = li->next, i++) {
+            relaxed[i] = sat_problem_encode_literal (sat, li->data);
+        }
+        soft.lit = sat_problem_new_aux_vars (sat, 1);
+        relaxed[len]     = soft.lit;
+        relaxed[len + 1] = 0;
+
+        sat_problem_add_encoded_clause_array (sat, relaxed);
+        g_free (relaxed);
+    }
+
+    g_array_append_val (sat->softs, soft);
+
+    sat_problem_clear_solution (sat);
+
+    return true;
+}
+
+/* return names of objectives (const char *) in order of their first soft clause as GSList to be freed with g_slist_free */
+GSList * sat_problem_objectives (struct sat_problem *sat)
+{
+    if (sat == NULL) return NULL;
+
+    GSList *result = NULL;
+    for (guint i = sat->objectives->len; i > 0; i--) {
+        result = g_slist_prepend (result, g_ptr_array_index (sat->objectives, i - 1));
+    }
+
+    return result;
+}
+
+/* free n objectives created by sat_problem_objectives_new */
+static void sat_problem_objectives_free (struct base_cnf_objective *objectives, guint n)
+{
+    for (guint i = 0; i < n; i++) {
+        g_free ((long int *) objectives[i].lits);
+        g_free ((long int *) objectives[i].weights);
+    }
+    g_free (objectives);
+}
+
+/* return array of the objectives named in objective_list (struct base_cnf_objective) in this order with their
+ * literals and weights to be freed by sat_problem_objectives_free, NULL on errors (unknown objective, sum of
+ * weights out of range). */
+static struct base_cnf_objective * sat_problem_objectives_new (struct sat_problem *sat, GSList *objective_list)
+{
+    guint n_objectives = g_slist_length (objective_list);
+    struct base_cnf_objective *result = g_new0 (struct base_cnf_objective, n_objectives + 1);
+
+    guint level = 0;
+    for (GSList *li = objective_list; li != NULL; li = li->next, level++) {
+        gint index = sat_problem_objective_index (sat, li->data, false);
+        if (index < 0) {
+            printf ("ERROR: objective not found: %s\n", (const char *) li->data);
+            sat_problem_objectives_free (result, n_objectives);
+            return NULL;
+        }
+
+        long int *lits    = g_new (long int, sat->softs->len + 1);
+        long int *weights = g_new (long int, sat->softs->len + 1);
+        long int total    = 0;
+        unsigned int n    = 0;
+
+        for (guint i = 0; i < sat->softs->len; i++) {
+            const struct sat_problem_soft *soft = &g_array_index (sat->softs, struct sat_problem_soft, i);
+            if (soft->objective != (guint) index) continue;
+
+            if (soft->weight > G_MAXLONG - total) {
+                printf ("ERROR: weights of objective %s are too large\n", (const char *) li->data);
+                g_free (lits);
+                g_free (weights);
+                sat_problem_objectives_free (result, n_objectives);
+                return NULL;
+            }
+            total += soft->weight;
+
+            lits[n]    = soft->lit;
+            weights[n] = soft->weight;
+            n++;
+        }
+
+        result[level].lits    = lits;
+        result[level].weights = weights;
+        result[level].n       = n;
+    }
+
+    return result;
+}
+
+/* minimize objectives (GSList of names (const char *)) in lexicographic order with all groups enabled and
+ * keep the best model as solution. returns false on errors. */
+bool sat_problem_optimize (struct sat_problem *sat, GSList *objective_list, const char *tmp_file_name, const char *solver_bin,
+                           bool solution_on_stdout, bool cleanup, bool cnf_gz, double timeout, long int *costs, bool *optimal)
+{
+    if (sat == NULL) return false;
+    if (tmp_file_name == NULL) return false;
+
+    sat_problem_clear_solution (sat);
+
+    guint n_objectives = g_slist_length (objective_list);
+    struct base_cnf_objective *objectives = sat_problem_objectives_new (sat, objective_list);
+    if (objectives == NULL) return false;
+
+    long int *assumption_array = sat_problem_group_assumptions (sat, NULL, NULL);
+
+    bool run_success = base_cnf_optimize (sat->cnf, tmp_file_name, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                          assumption_array, objectives, n_objectives, timeout, costs, optimal);
+
+    g_free (assumption_array);
+    sat_problem_objectives_free (objectives, n_objectives);
+
+    if (!run_success) return false;
+
+    GSList *solution = base_cnf_solution (sat->cnf);
+
+    if (solution == NULL) {
+        if (!*optimal) {
+            printf ("ERROR: no model found within time budget\n");
+            return false;
+        }
+        sat->solver_run  = true;
+        sat->satisfiable = false;
+        return true;
+    }
+
+    sat_problem_set_solution (sat, solution);
+
+    return true;
+}
+
+/* write sat with all groups enabled as weighted cnf with the soft clauses of objectives (GSList of names
+ * (const char *)) to file_name, lexicographic order by scaled weights. returns true on success. */
+bool sat_problem_write_wcnf (struct sat_problem *sat, GSList *objective_list, const char *file_name)
+{
+    if (sat == NULL) return false;
+    if (file_name == NULL) return false;
+
+    guint n_objectives = g_slist_length (objective_list);
+    struct base_cnf_objective *objectives = sat_problem_objectives_new (sat, objective_list);
+    if (objectives == NULL) return false;
+
+    /* each objective outweighs all following ones */
+    long int *factors = g_new (long int, n_objectives + 1);
+    long int sum = 0;
+    bool success = true;
+
+    for (guint level = n_objectives; success && (level > 0); level--) {
+        const struct base_cnf_objective *objective = &(objectives[level - 1]);
+        factors[level - 1] = (sum < G_MAXLONG ? sum + 1 : G_MAXLONG);
+
+        for (unsigned int i = 0; i < objective->n; i++) {
+            if ((sum == G_MAXLONG) || (objective->weights[i] > (G_MAXLONG - sum) / factors[level - 1])) {
+                printf ("ERROR: weights of lexicographic objectives are too large for a single objective\n");
+                success = false;
+                break;
+            }
+            sum += objective->weights[i] * factors[level - 1];
+        }
+    }
+
+    if (success) {
+        GArray *soft_lits    = g_array_new (false, false, sizeof (long int));
+        GArray *soft_weights = g_array_new (false, false, sizeof (long int));
+
+        for (guint level = 0; level < n_objectives; level++) {
+            const struct base_cnf_objective *objective = &(objectives[level]);
+
+            for (unsigned int i = 0; i < objective->n; i++) {
+                long int lit    = -objective->lits[i];
+                long int weight = objective->weights[i] * factors[level];
+                g_array_append_val (soft_lits, lit);
+                g_array_append_val (soft_weights, weight);
+            }
+        }
+
+        long int *assumption_array = sat_problem_group_assumptions (sat, NULL, NULL);
+
+        success = base_cnf_write_wcnf (sat->cnf, file_name, assumption_array,
+                                       (long int *) soft_lits->data, (long int *) soft_weights->data, soft_lits->len);
+
+        g_free (assumption_array);
+        g_array_free (soft_lits, true);
+        g_array_free (soft_weights, true);
+    }
+
+    g_free (factors);
+    sat_problem_objectives_free (objectives, n_objectives);
+
+    return success;
+}
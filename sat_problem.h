@@ -22,8 +22,19 @@
 #include <glib.h>
 #include <stdbool.h>
 
+#include "sat_preprocess.h"
+#include "sat_cardinality.h"
+#include "sat_pb.h"
+#include "sat_bitvector.h"
+#include "sat_int.h"
+#include "sat_graph.h"
+
 typedef struct sat_problem *SatProblem;
 
+/* function called for each enumerated solution given as 0-terminated array of literals as (long int),
+ * enumeration is stopped if it returns false */
+typedef bool (*SatProblemSolutionFunc) (const long int *solution, gpointer user_data);
+
 /* allocate and return a new sat_problem */
 SatProblem sat_problem_new ();
 
@@ -35,10 +46,81 @@ void sat_problem_add_clause_array  (SatProblem sat, const char *const *clause);
 /* add a clause to sat represented as a GSList of variables (const char *) */
 void sat_problem_add_clause_gslist (SatProblem sat, GSList *clause);
 
+/* set group of clauses added afterwards, NULL for clauses not belonging to any group.
+ * clauses of a group are guarded by a hidden selector variable, so the group can be
+ * enabled or disabled for each run of sat_problem_solve, sat_problem_backbone and
+ * sat_problem_enumerate_solutions. Other solver runs enable all groups. */
+void sat_problem_set_group (SatProblem sat, const char *group);
+
+/* allocate n new auxiliary variables for an encoding and return the first of them, the others follow
+ * consecutively. auxiliary variables are not entered into the name tables, their names (_int_aux_<number>_)
+ * are only created on demand by sat_problem_get_varname_from_number. */
+long int sat_problem_new_aux_vars (SatProblem sat, unsigned long int n);
+
 /* apply 1 of n order encoding to literals (const char *) in lit_list. */
 void sat_problem_add_1ofn_order_encoding (SatProblem sat, GSList *lit_list);
 /* apply (at least/most) m of n direct encoding to literals (const char *) in lit_list. */
 void sat_problem_add_mofn_direct_encoding (SatProblem sat, GSList *lit_list, unsigned int m, bool atleast, bool atmost);
+/* apply (at least/most) m of n encoding to literals (const char *) in lit_list using given cardinality encoding,
+ * SAT_CARDINALITY_AUTO chooses the encoding with least clauses and auxiliary variables depending on n and m. */
+void sat_problem_add_mofn_encoding (SatProblem sat, GSList *lit_list, unsigned int m, bool atleast, bool atmost, SatCardinalityEncoding encoding);
+/* apply pseudo-Boolean encoding sum (weights[i] * literal i) >= bound (atleast) and/or <= bound (atmost) to
+ * literals (const char *) in lit_list using given encoding. BDD nodes are shared between encodings outside of groups. */
+void sat_problem_add_pb_encoding (SatProblem sat, GSList *lit_list, const long int *weights, long int bound,
+                                  bool atleast, bool atmost, SatPbEncoding encoding);
+/* add XOR constraint over literals (const char *) in lit_list: an odd number of them has to be true. */
+void sat_problem_add_xor_encoding (SatProblem sat, GSList *lit_list);
+
+/* declare bit-vector name with width bits named <name>_0 (least significant) ... <name>_<width - 1>
+ * and return true on success. Declaring an existing bit-vector again with the same width has no effect. */
+bool sat_problem_declare_bitvector (SatProblem sat, const char *name, unsigned int width);
+/* return number of bits of bit-vector name, 0 if not declared */
+unsigned int sat_problem_bitvector_width (SatProblem sat, const char *name);
+/* add bit-vector constraint result = op (operands) encoded directly as clauses and return true on success.
+ * operands: GSList of declared bit-vectors or integer constants (const char *),
+ * result: bit-vector, declared with the width of the operation if not yet declared. Predicates have a single
+ *   bit result, without result they are asserted, other operations need a result.
+ * width: bits of the operation or 0: width of result or widest operand, predicates always use the widest
+ *   operand. Narrower operands are zero-extended (sign-extended for signed operations), wider ones truncated,
+ *   shift amounts keep their width. */
+bool sat_problem_add_bitvector_constraint (SatProblem sat, SatBitvectorOp op, SatBitvectorMultiplier multiplier,
+                                           const char *result, GSList *operands, unsigned int width);
+
+/* declare integer variable name with values min ... max in encoding (auto: by domain size) and return true on success.
+ * Its literals are <name>_<value> (direct), <name>_ge_<value> for x >= value (order) or <name>_bit_<i> for
+ * the bits of x - min (log), the clauses restricting them to the domain do not belong to a group.
+ * Declaring an existing variable again with the same domain and the same encoding (or auto) has no effect. */
+bool sat_problem_declare_int (SatProblem sat, const char *name, long int min, long int max, SatIntEncoding encoding);
+/* set *min and *max to the domain of integer variable name and return true, false if not declared */
+bool sat_problem_int_domain (SatProblem sat, const char *name, long int *min, long int *max);
+/* constraints over operands (const char *) given as declared integer variables or integer constants, return true
+ * on success. Constraints except linear need literals for each value: they are defined once for order and log
+ * encoded variables, domains are limited to 2^20 values. */
+/* add all different constraint over operands in operand_list. */
+bool sat_problem_add_int_alldifferent (SatProblem sat, GSList *operand_list);
+/* add linear constraint sum (coefs[i] * operand i) >= bound (atleast) and/or <= bound (atmost) over operands in
+ * operand_list, encoded as pseudo-Boolean constraint over the literals of the variables using given encoding. */
+bool sat_problem_add_int_linear (SatProblem sat, GSList *operand_list, const long int *coefs, long int bound,
+                                 bool atleast, bool atmost, SatPbEncoding encoding);
+/* add element constraint result = entry (index) for the operands in entry_list counted from 0. */
+bool sat_problem_add_int_element (SatProblem sat, const char *index, GSList *entry_list, const char *result);
+/* add table constraint: the operands in operand_list (n) take the values of one of the n_tuples rows of tuples
+ * (n values each, row by row). */
+bool sat_problem_add_int_table (SatProblem sat, GSList *operand_list, const long int *tuples, unsigned int n_tuples);
+
+/* add constraint on the graph of the edges in edge_list (GSList of GSLists of node, node, edge literal (const char *),
+ * arcs from the first to the second node if directed is true) and return true on success. Nodes are identified by
+ * name. node_list: NULL or GSList of GSLists of node, literal naming the node literals of constraints path (node on
+ * path) and reachable (node reachable from source), source, target: nodes or NULL if not needed by constraint. */
+bool sat_problem_add_graph_constraint (SatProblem sat, SatGraphConstraint constraint, bool directed, GSList *edge_list,
+                                       GSList *node_list, const char *source, const char *target);
+
+/* add a soft clause (GSList of literals (const char *), NULL for the empty clause) to sat, whose positive weight is
+ * counted in objective (NULL: "cost") if it is violated, and return true on success. The clause is added relaxed
+ * by a new auxiliary variable (a single literal is relaxed by itself), so it does not restrict sat_problem_solve. */
+bool sat_problem_add_soft_clause (SatProblem sat, GSList *clause, long int weight, const char *objective);
+/* return names of objectives (const char *) in order of their first soft clause as GSList to be freed with g_slist_free */
+GSList * sat_problem_objectives (SatProblem sat);
 
 /* add a formula as mapping and return true on success.
  * formula: the formula represented as string with variables 1 ... n.
@@ -47,7 +129,7 @@ void sat_problem_add_mofn_direct_encoding (SatProblem sat, GSList *lit_list, uns
  * needs to be applied individually whereas parsing only needs to be done once. */
 bool sat_problem_add_formula_mapping (SatProblem sat, const char* formula, GSList *lit_mapping);
 
-/* lookup variable integer mapping and return mapped string */
+/* lookup variable integer mapping and return mapped string, names of auxiliary variables are created here */
 const char * sat_problem_get_varname_from_number (SatProblem sat, long int number);
 /* lookup variable string and return mapped integer */
 long int sat_problem_get_varnumber_from_name (SatProblem sat, const char *name);
@@ -55,6 +137,43 @@ long int sat_problem_get_varnumber_from_name (SatProblem sat, const char *name);
  * as a GQueue of 0-terminated literal (long int) arrays.
  * the result should not be modified. */
 GQueue *sat_problem_get_clauses_mapped (SatProblem sat);
+/* append the clauses of encodings stored as descriptors (see sat_problem_set_lazy_encodings) to clauses
+ * as 0-terminated literal (long int) arrays allocated by g_slice and return their number. */
+unsigned long int sat_problem_append_lazy_clauses_mapped (SatProblem sat, GQueue *clauses);
+
+/* create a checkpoint of clauses and variables of sat to be restored by sat_problem_pop
+ * and return the resulting number of checkpoints. */
+unsigned int sat_problem_push (SatProblem sat);
+/* restore sat to the checkpoint created by the n_levels-th last sat_problem_push.
+ * clauses and variables added afterwards are removed, cached parsed formulas are kept.
+ * returns false if there are less than n_levels checkpoints. */
+bool sat_problem_pop (SatProblem sat, unsigned int n_levels);
+/* return number of checkpoints created by sat_problem_push that are not yet restored */
+unsigned int sat_problem_scope_level (SatProblem sat);
+
+/* enable preprocessing of clauses before each solver run with given options
+ * or disable it if options is NULL. */
+void sat_problem_set_preprocess (SatProblem sat, const struct sat_preprocess_options *options);
+/* enable or disable simplification of clauses added afterwards by values implied
+ * by unit clauses and binary clauses. */
+void sat_problem_set_unit_simplification (SatProblem sat, bool enable);
+/* enable or disable solving variable-disjoint components by concurrent solver runs.
+ * n_threads: number of concurrent runs (0: number of processors),
+ * min_vars: components with less variables are solved together by one run. */
+void sat_problem_set_split_components (SatProblem sat, bool enable, unsigned int n_threads, unsigned long int min_vars);
+/* enable or disable adding symmetry-breaking clauses for symmetries found before each solver run.
+ * max_vertices: symmetry search is skipped if number of literals + clauses is greater,
+ * max_generators: maximum number of symmetry generators to break. */
+void sat_problem_set_symmetry_breaking (SatProblem sat, bool enable, unsigned long int max_vertices, unsigned int max_generators);
+/* enable or disable compacting and renumbering variables for locality before each solver run. */
+void sat_problem_set_renumber (SatProblem sat, bool enable);
+/* enable or disable storing cardinality encodings (m of n and 1 of n except order encoding) with at least
+ * min_clauses clauses as compact descriptors, which are expanded into clauses on solving: on writing the
+ * cnf file they are streamed into it, so memory scales with the number of constraints. */
+void sat_problem_set_lazy_encodings (SatProblem sat, bool enable, unsigned long int min_clauses);
+/* set encoding of XOR constraints: native XOR clauses for capable solvers or chains of XORs with at most cut
+ * literals encoded as clauses. gauss_max_bits: maximum matrix size of Gauss-Jordan elimination (0: disabled). */
+void sat_problem_set_xor (SatProblem sat, bool native, unsigned int cut, unsigned long int gauss_max_bits);
 
 /* solve current sat problem and return false on errors, true otherwise.
  * tmp_file_name: prefix for temporary files for solver,
@@ -62,21 +181,99 @@ GQueue *sat_problem_get_clauses_mapped (SatProblem sat);
  * solution_on_stdout: if true, assume that solver prints result on stdout,
  *   otherwise to filename given as second argument,
  * cleanup: if true, temporary files will be removed afterwards,
- * cnf_gz: CNF file will be in gzipped dimacs, otherwise in plain dimacs. */
-bool sat_problem_solve (SatProblem sat, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz);
+ * cnf_gz: CNF file will be in gzipped dimacs, otherwise in plain dimacs,
+ * assumptions: GSList of literals (const char *) assumed only for this run or NULL,
+ *   if not satisfiable, a subset of them responsible for it can be obtained
+ *   with sat_problem_failed_assumptions,
+ * enable_groups: GSList of group names (const char *) enabled for this run, NULL for all groups,
+ * disable_groups: GSList of group names (const char *) disabled for this run or NULL,
+ *   if not satisfiable, enabled groups responsible for it can be obtained with sat_problem_failed_groups,
+ * cube_and_conquer: if true, the problem is split into cubes (sets of assumptions) by lookahead
+ *   which are solved by concurrent solver runs until the first one is satisfiable,
+ * cube_depth: maximum number of decisions per cube (0: depending on n_threads),
+ * n_threads: number of concurrent solver runs for cube_and_conquer or verification jobs (0: number of processors),
+ * verify: if true, the model is checked against all clauses, XOR constraints and assumptions before
+ *   it is accepted, a violation is reported and treated as error. */
+bool sat_problem_solve (SatProblem sat, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                        GSList *assumptions, GSList *enable_groups, GSList *disable_groups,
+                        bool cube_and_conquer, unsigned int cube_depth, unsigned int n_threads, bool verify);
+/* solve sat with all groups enabled by a solver run stopped after timeout seconds (0: no limit) without printing
+ * solver output and without changing the solution of sat. *seconds is set to the duration of the run, *timed_out
+ * to true if it has been stopped, otherwise *satisfiable to the result. other arguments are the same as for
+ * sat_problem_solve. returns false on errors. runs on different problems may be executed concurrently
+ * if tmp_file_name differs. */
+bool sat_problem_solve_timed (SatProblem sat, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                              double timeout, double *seconds, bool *timed_out, bool *satisfiable);
+/* set *n_vars to the number of variables and *n_clauses to the number of clauses of sat
+ * (including clauses of encodings stored as descriptors) */
+void sat_problem_size (SatProblem sat, unsigned long int *n_vars, unsigned long int *n_clauses);
+/* enumerate solutions of sat projected onto named variables without modifying sat.
+ * var_list: GSList of variable names (const char *) to project on, NULL for all named variables,
+ * limit: maximum number of solutions, 0 for no limit,
+ * solution_func: called for each solution with a 0-terminated array of literals (long int)
+ *   in order of var_list, enumeration is stopped if it returns false,
+ * other arguments are the same as for sat_problem_solve.
+ * returns the number of solutions or -1 on errors (e.g. unknown variable). */
+long int sat_problem_enumerate_solutions (SatProblem sat, GSList *var_list, unsigned long int limit,
+                                          const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                                          GSList *enable_groups, GSList *disable_groups,
+                                          SatProblemSolutionFunc solution_func, gpointer user_data);
+/* minimize the sum of the weights of violated soft clauses of each objective in objective_list (GSList of names
+ * (const char *)) in lexicographic order with all groups enabled (see base_cnf_optimize), soft clauses of other
+ * objectives are ignored. Improved models are reported while searching.
+ * timeout: time budget in seconds (0: no limit), afterwards the best model found so far is kept,
+ * costs: set to the costs of the best model in order of objective_list,
+ * *optimal: set to true if the costs are optimal,
+ * other arguments are the same as for sat_problem_solve. The best model becomes the solution of sat.
+ * returns false on errors (e.g. no model found in time). */
+bool sat_problem_optimize (SatProblem sat, GSList *objective_list, const char *tmp_file_name, const char *solver_bin,
+                           bool solution_on_stdout, bool cleanup, bool cnf_gz, double timeout, long int *costs, bool *optimal);
+/* write sat with all groups enabled as weighted cnf (WCNF format of the MaxSAT evaluations) with the soft clauses of the
+ * objectives in objective_list (GSList of names (const char *)) to file_name and return true on success. Soft clauses
+ * are written as relaxation literals, weights of several objectives are scaled so that each one outweighs all following
+ * ones. */
+bool sat_problem_write_wcnf (SatProblem sat, GSList *objective_list, const char *file_name);
 /* invalidate current solution to obtain a different one on next solve */
 void sat_problem_cancel_solution (SatProblem sat);
 
 /* return true, if problem is satisfiable. *error is set to true in
  * case of errors: e.g. solver is not yet run. */
 bool sat_problem_satisfiable (SatProblem sat, bool *error);
+/* check model of last solver run against all clauses and XOR constraints and return true if all of them
+ * are satisfied, the first violated one is reported with named literals. n_threads: number of concurrent
+ * jobs (0: number of processors). In case of errors (e.g. not solved, not satisfiable) *error is set to true. */
+bool sat_problem_verify_model (SatProblem sat, unsigned int n_threads, bool *error);
 /* obtain assigned boolean value to variable var.
  * In case of errors (e.g. unknown variable, not satisfiable, ...)
  * *error is set to true. */
 bool sat_problem_var_result (SatProblem sat, const char *var, bool *error);
+/* obtain value of bit-vector name as decimal string (two's complement if is_signed is true) to be freed
+ * with g_free. Bits not occurring in the solution are assumed to be false. In case of errors
+ * (e.g. unknown bit-vector, not satisfiable, ...) *error is set to true and NULL is returned. */
+char * sat_problem_bitvector_result (SatProblem sat, const char *name, bool is_signed, bool *error);
+/* obtain value of integer variable name. Literals not occurring in the solution are assumed to be false.
+ * In case of errors (e.g. unknown variable, not satisfiable, ...) *error is set to true. */
+long int sat_problem_int_result (SatProblem sat, const char *name, bool *error);
 /* obtain a GList of all variables (const char *) assigned to var_assignment.
  * In case of errors (e.g. not satisfiable, ...)
  * *error is set to true. */
 GSList *sat_problem_var_result_list (SatProblem sat, bool var_assignment, bool *error);
+/* obtain a GSList of assumption literals (long int) of last solver run that are responsible
+ * for the problem not being satisfiable. The result should not be modified.
+ * In case of errors (e.g. not solved, satisfiable, ...) *error is set to true. */
+GSList *sat_problem_failed_assumptions (SatProblem sat, bool *error);
+/* obtain a GSList of names (const char *) of enabled groups of last solver run that are responsible
+ * for the problem not being satisfiable. The result should not be modified.
+ * In case of errors (e.g. not solved, satisfiable, ...) *error is set to true. */
+GSList *sat_problem_failed_groups (SatProblem sat, bool *error);
+
+/* compute backbone of sat restricted to named variables and return it as a GSList of literals (long int)
+ * that have the same value in every solution. After an initial solution each remaining candidate is checked
+ * by a solver run assuming its inverted value, new solutions remove candidates with differing values.
+ * n_threads: number of solver runs executed concurrently (0: number of processors),
+ * other arguments are the same as for sat_problem_solve.
+ * In case of errors (e.g. not satisfiable, ...) *error is set to true. */
+GSList *sat_problem_backbone (SatProblem sat, const char *tmp_file_name, const char *solver_bin, bool solution_on_stdout, bool cleanup, bool cnf_gz,
+                              GSList *enable_groups, GSList *disable_groups, unsigned int n_threads, bool *error);
 
 #endif
@@ -18,11 +18,14 @@
 
 #include "sat_shell.h"
 #include "sat_problem.h"
+#include "sat_tune.h"
 
 #include <tclln.h>
 #include <tcl.h>
 #include <glib.h>
+#include <stdio.h>
 #include <string.h>
+#include <limits.h>
 
 /* sat_shell data */
 struct sat_shell {
@@ -30,6 +33,16 @@ struct sat_shell {
     TclLN tclln;
     /* sat_problem data */
     SatProblem sat;
+    /* clause encodings of add_encoding per constraint class */
+    SatTuneProfile profile;
+
+    /* replay of a script by tune_encodings: add_encoding constraints are counted in record,
+     * solving commands and problems with more than replay_max_clauses clauses (0: no limit) stop the script */
+    bool                   replay;
+    struct sat_tune_record record;
+    unsigned long int      replay_max_clauses;
+    bool                   replay_stopped;
+    bool                   replay_too_large;
 };
 
 /* Tcl helper function for parsing boolean arguments */
@@ -38,17 +51,69 @@ static int sat_shell_tcl_bool_parse (ClientData client_data, Tcl_Obj *obj, void
 static int sat_shell_tcl_string_list_parse (ClientData client_data, Tcl_Obj *obj, void *dest_ptr);
 /* Tcl helper function for parsing lists of lists in GSLists of GSLists */
 static int sat_shell_tcl_string_list_list_parse (ClientData client_data, Tcl_Obj *obj, void *dest_ptr);
+/* Tcl helper function for parsing lists of integers in GArrays of long int */
+static int sat_shell_tcl_long_list_parse (ClientData client_data, Tcl_Obj *obj, void *dest_ptr);
+/* Tcl helper function for parsing lists of lists of integers in GSLists of GArrays of long int */
+static int sat_shell_tcl_long_list_list_parse (ClientData client_data, Tcl_Obj *obj, void *dest_ptr);
+/* Tcl helper function for parsing integers in long int */
+static int sat_shell_tcl_long_parse (ClientData client_data, Tcl_Obj *obj, void *dest_ptr);
 
 /* tcl commands */
 static int sat_shell_command_add_clause      (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_add_soft_clause (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 static int sat_shell_command_add_encoding    (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 static int sat_shell_command_add_formula     (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_declare_bitvector (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_add_bitvector_constraint (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_declare_int     (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_add_int_constraint (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_add_graph_constraint (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 static int sat_shell_command_solve           (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_set_preprocess  (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_set_unit_simplification (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_set_split_components (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_set_symmetry_breaking (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_set_renumber    (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_set_xor         (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_set_lazy_encodings (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 static int sat_shell_command_reset           (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_verify_model  (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 static int sat_shell_command_cancel_solution (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_push            (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_pop             (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 static int sat_shell_command_get_var_result  (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_get_bitvector_result (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_get_int_result  (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 static int sat_shell_command_get_var_mapping (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 static int sat_shell_command_get_clauses     (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_get_backbone    (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_get_unsat_core  (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_enumerate_solutions (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_optimize        (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_write_wcnf      (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_set_encoding_profile (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+static int sat_shell_command_tune_encodings  (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
+
+/* replay script on a new problem with clause encodings of profile for tune_encodings */
+static struct sat_shell * sat_shell_replay (const char *script, SatTuneProfile profile, unsigned long int max_clauses, bool *too_large);
+/* stop replay of a script at a solving command */
+static int sat_shell_replay_stop (struct sat_shell *shell, Tcl_Interp *interp);
+
+/* data for streaming enumerated solutions to a file and/or a Tcl command */
+struct sat_shell_enumerate_data {
+    Tcl_Interp *interp;
+    SatProblem sat;
+    /* output file or NULL */
+    FILE       *file;
+    /* Tcl command prefix called with list of literals of each solution or NULL */
+    Tcl_Obj    *command;
+    /* result code of last command evaluation */
+    int        command_result;
+    GString    *temp_str;
+};
+
+/* solution function for enumerate_solutions */
+static bool sat_shell_enumerate_solution_func (const long int *solution, gpointer user_data);
 static int sat_shell_command_help            (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 static int sat_shell_command_license         (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[]);
 
@@ -63,41 +128,184 @@ struct sat_shell_command_data {
 /* all commands and their data */
 static struct sat_shell_command_data sat_shell_command_data_list [] = {
     {"add_clause",
-        (const char * const []) {"-clause", "-list", "-help", NULL},
+        (const char * const []) {"-clause", "-list", "-group", "-help", NULL},
         sat_shell_command_add_clause,
-        "Add a clause or list of clauses to current sat problem."
+        "Add a clause or list of clauses to current sat problem.\n"
+        "Clauses added with a group can be enabled or disabled on each \"solve\"."
+    },
+    {"add_soft_clause",
+        (const char * const []) {"-clause", "-list", "-weight", "-objective", "-help", NULL},
+        sat_shell_command_add_soft_clause,
+        "Add a soft clause or list of soft clauses whose -weight (default: 1) is counted in -objective (default: \"cost\")\n"
+        "if violated. Soft clauses do not restrict \"solve\", their objectives are minimized by \"optimize\"."
     },
     {"add_encoding",
-        (const char * const []) {"-literals", "-encoding", "-parameter", NULL},
+        (const char * const []) {"-literals", "-encoding", "-parameter", "-cardinality", "-weights", "-relation", "-pb", "-group", NULL},
         sat_shell_command_add_encoding,
-        "Add special encoding (e.g. 1 of n order encoding) for a list of literals."
+        "Add special encoding (e.g. 1 of n order encoding) for a list of literals.\n"
+        "m of n encodings use the clause encoding given by -cardinality: \"direct\", \"seqcounter\", \"totalizer\",\n"
+        "\"modtotalizer\", \"cardnetwork\", \"sortnetwork\" or \"auto\" (default) choosing the smallest one for n and m,\n"
+        "for m = 1 also the at most one encodings \"commander\", \"product\", \"binary\", \"ladder\".\n"
+        "Exactly one encodings \"1ofn_auto\", \"1ofn_pairwise\", \"1ofn_commander\", \"1ofn_product\", \"1ofn_binary\",\n"
+        "\"1ofn_ladder\" select the at most one encoding directly, \"1ofn_auto\" by the number of literals.\n"
+        "Encoding \"pb\" adds the pseudo-Boolean constraint sum (weight * literal) <relation> parameter with\n"
+        "-weights (integers), -relation \"<=\" (default), \">=\" or \"=\" and the clause encoding given by -pb:\n"
+        "\"bdd\", \"gte\", \"adder\", \"sortnetwork\" or \"auto\" (default)."
     },
     {"add_formula",
-        (const char * const []) {"-formula", "-mapping", NULL},
+        (const char * const []) {"-formula", "-mapping", "-group", NULL},
         sat_shell_command_add_formula,
         "Add a formula with 1 ... n and map them to a list of literals in the current problem.\n"
         "Parsed formula strings are cached to make multiple usage of same formula string more efficient."
     },
+    {"declare_bitvector",
+        (const char * const []) {"-name", "-width", "-help", NULL},
+        sat_shell_command_declare_bitvector,
+        "Declare a bit-vector of -width bits represented by the variables <name>_0 (least significant) ... <name>_<width-1>."
+    },
+    {"add_bitvector_constraint",
+        (const char * const []) {"-op", "-operands", "-result", "-width", "-multiplier", "-group", "-help", NULL},
+        sat_shell_command_add_bitvector_constraint,
+        "Add result = op (operands) for bit-vectors (two's complement) encoded directly as clauses, operands are\n"
+        "bit-vectors or integers. Operations: \"add\", \"sub\", \"mul\" (modulo 2^width), \"and\", \"or\", \"xor\", \"not\",\n"
+        "\"shl\", \"lshr\", \"ashr\" (by second operand) and the predicates \"eq\", \"ne\", \"ult\", \"ule\", \"ugt\", \"uge\",\n"
+        "\"slt\", \"sle\", \"sgt\", \"sge\" with a 1 bit result, which are asserted without -result.\n"
+        "An undeclared result is declared with -width (default: widest operand). Multipliers: \"array\", \"wallace\" (default),\n"
+        "\"karatsuba\" (Wallace trees below 16 bits)."
+    },
+    {"declare_int",
+        (const char * const []) {"-name", "-min", "-max", "-encoding", "-help", NULL},
+        sat_shell_command_declare_int,
+        "Declare an integer variable with values -min ... -max. Encodings: \"direct\" (variables <name>_<value>),\n"
+        "\"order\" (<name>_ge_<value> for name >= value), \"log\" (<name>_bit_<i> for the bits of name - min)\n"
+        "or \"auto\" (default): direct up to 32 values, order up to 256 values, log above."
+    },
+    {"add_int_constraint",
+        (const char * const []) {"-constraint", "-operands", "-coefficients", "-relation", "-bound", "-index", "-result", "-tuples", "-pb", "-group", "-help", NULL},
+        sat_shell_command_add_int_constraint,
+        "Add a constraint over integer variables or constants given as -operands:\n"
+        "\"alldifferent\": pairwise different values,\n"
+        "\"linear\": sum (coefficient * operand) <relation> bound with -coefficients (default: 1), -relation \"<=\" (default),\n"
+        "\">=\" or \"=\" and -bound, encoded as pseudo-Boolean constraint (clause encoding given by -pb, see add_encoding),\n"
+        "\"element\": -result = operand with position -index (counted from 0),\n"
+        "\"table\": the operands take the values of one of the -tuples (list of lists of values)."
+    },
+    {"add_graph_constraint",
+        (const char * const []) {"-constraint", "-edges", "-directed", "-nodes", "-source", "-target", "-group", "-help", NULL},
+        sat_shell_command_add_graph_constraint,
+        "Add a constraint on the graph of the selected -edges (list of {node node literal}, arcs with -directed):\n"
+        "\"path\": simple path from -source to -target, \"hamiltonian_path\": path visiting all nodes (-source and -target optional),\n"
+        "\"hamiltonian_cycle\": cycle visiting all nodes, \"reachable\": -target (optional) is reachable from -source,\n"
+        "\"acyclic\": no cycles. -nodes (list of {node literal}) names literals for nodes on the path (\"path\")\n"
+        "or reachable from -source (\"reachable\"). Cycles are excluded by binary distance labels of the nodes."
+    },
     {"solve",
-        (const char * const []) {"-tempfile_keep", "-tempfile_clean", "-tempfile_base", "-compress_cnf", "-plain_cnf", "-solver_binary", "-solution_on_stdout", "-help", NULL},
+        (const char * const []) {"-tempfile_keep", "-tempfile_clean", "-tempfile_base", "-compress_cnf", "-plain_cnf", "-solver_binary", "-solution_on_stdout", "-assume", "-enable", "-disable", "-cube_and_conquer", "-cube_depth", "-threads", "-verify", "-help", NULL},
         sat_shell_command_solve,
-        "Solve current sat problem - return true if satisfiable."
+        "Solve current sat problem - return true if satisfiable.\n"
+        "Assumed literals are only valid for this run and are not added to the problem.\n"
+        "All groups are enabled unless restricted by -enable or excluded by -disable.\n"
+        "With -cube_and_conquer the problem is split into cubes by lookahead, which are solved by -threads concurrent solver runs.\n"
+        "With -verify the model is checked against all clauses and assumptions, a violation is reported as error."
+    },
+    {"set_preprocess",
+        (const char * const []) {"-enable", "-passes", "-elim_occurrences", "-elim_growth", "-elim_clause_length", "-steps", "-help", NULL},
+        sat_shell_command_set_preprocess,
+        "Enable or disable preprocessing of clauses before each solver run.\n"
+        "Passes: \"equivalence\", \"pure\", \"subsume\", \"eliminate\", \"blocked\", \"cardinality\" (default: all), unit clauses are always propagated.\n"
+        "Solutions are extended to all variables, the clauses of the problem are not modified."
+    },
+    {"set_unit_simplification",
+        (const char * const []) {"-enable", "-help", NULL},
+        sat_shell_command_set_unit_simplification,
+        "Enable or disable simplification of clauses added afterwards by values implied by unit and binary clauses.\n"
+        "Satisfied clauses are dropped and false literals are removed (visible with get_clauses),\n"
+        "solver runs are skipped if the problem is found to be unsatisfiable."
+    },
+    {"set_split_components",
+        (const char * const []) {"-enable", "-threads", "-min_vars", "-help", NULL},
+        sat_shell_command_set_split_components,
+        "Enable or disable solving variable-disjoint components by concurrent solver runs.\n"
+        "Components with less than -min_vars variables (default: 100) are solved together,\n"
+        "-threads 0 (default) uses the number of processors. Not applied with preprocessing or cube and conquer."
+    },
+    {"set_symmetry_breaking",
+        (const char * const []) {"-enable", "-max_vertices", "-max_generators", "-help", NULL},
+        sat_shell_command_set_symmetry_breaking,
+        "Enable or disable symmetry breaking: symmetries of clauses and assumptions are searched before each solver run\n"
+        "and lex-leader clauses are added excluding symmetric solutions. Found generators are reported.\n"
+        "The search is skipped for more than -max_vertices literals + clauses (default: 20000). Not applied with preprocessing."
+    },
+    {"set_renumber",
+        (const char * const []) {"-enable", "-help", NULL},
+        sat_shell_command_set_renumber,
+        "Enable or disable renumbering before each solver run: unused variables are left out,\n"
+        "variables are ordered by breadth-first search over clauses (Cuthill-McKee) and clauses by their variables.\n"
+        "Not applied with preprocessing."
+    },
+    {"set_xor",
+        (const char * const []) {"-native", "-cut", "-gauss", "-gauss_max_bits", "-help", NULL},
+        sat_shell_command_set_xor,
+        "Configure XOR constraints (encoding \"xor\" and xor/equal formulas): with -native they are passed to the solver\n"
+        "as \"x\" lines (CryptoMiniSat format), otherwise split into chains of at most -cut literals (default: 4) encoded as clauses.\n"
+        "Gauss-Jordan elimination before each solver run adds implied units and equivalences (-gauss, default: on)\n"
+        "unless the matrix needs more than -gauss_max_bits bits (default: 16777216)."
+    },
+    {"set_lazy_encodings",
+        (const char * const []) {"-enable", "-min_clauses", "-help", NULL},
+        sat_shell_command_set_lazy_encodings,
+        "Enable or disable lazy cardinality encodings: m of n and 1 of n encodings (except 1ofn_order) added afterwards with\n"
+        "at least -min_clauses clauses (default: 64) are stored as descriptors and only expanded into clauses on solving,\n"
+        "where they are streamed into the cnf file. Preprocessing, component splitting, renumbering, symmetry breaking,\n"
+        "XOR constraints, cube and conquer and model verification work on a temporarily expanded copy."
     },
     {"reset",
         (const char * const []) {"-help", NULL},
         sat_shell_command_reset,
         "Reset sat problem - deletes all currently added clauses and variables."
     },
+    {"verify_model",
+        (const char * const []) {"-threads", "-help", NULL},
+        sat_shell_command_verify_model,
+        "Check the current solution against all clauses and XOR constraints - return true if all are satisfied.\n"
+        "The first violated constraint is reported, -threads 0 (default) uses the number of processors."
+    },
     {"cancel_solution",
         (const char * const []) {"-help", NULL},
         sat_shell_command_cancel_solution,
         "Invalidate current solution - on next \"solve\" another solution must be generated if still satisfiable."
     },
+    {"push",
+        (const char * const []) {"-help", NULL},
+        sat_shell_command_push,
+        "Create a checkpoint of current clauses and variables - return number of checkpoints."
+    },
+    {"pop",
+        (const char * const []) {"-levels", "-help", NULL},
+        sat_shell_command_pop,
+        "Remove all clauses and variables added since last \"push\" (or given number of \"push\" levels)\n"
+        "- return number of remaining checkpoints."
+    },
     {"get_var_result",
         (const char * const []) {"-var", "-assignment", "-help", NULL},
         sat_shell_command_get_var_result,
         "Get assignment for variables after problem has been solved."
     },
+    {"get_bitvector_result",
+        (const char * const []) {"-name", "-signed", "-help", NULL},
+        sat_shell_command_get_bitvector_result,
+        "Get value of a bit-vector as decimal number after problem has been solved, -signed for two's complement."
+    },
+    {"get_int_result",
+        (const char * const []) {"-name", "-help", NULL},
+        sat_shell_command_get_int_result,
+        "Get value of an integer variable after problem has been solved."
+    },
+    {"get_unsat_core",
+        (const char * const []) {"-groups", "-help", NULL},
+        sat_shell_command_get_unsat_core,
+        "Get assumed literals (or enabled groups) responsible for last solve not being satisfiable."
+    },
     {"get_var_mapping",
         (const char * const []) {"-name", "-number", "-help", NULL},
         sat_shell_command_get_var_mapping,
@@ -108,6 +316,51 @@ static struct sat_shell_command_data sat_shell_command_data_list [] = {
         sat_shell_command_get_clauses,
         "Get all clauses of current sat problem."
     },
+    {"get_backbone",
+        (const char * const []) {"-tempfile_keep", "-tempfile_clean", "-tempfile_base", "-compress_cnf", "-plain_cnf", "-solver_binary", "-solution_on_stdout", "-enable", "-disable", "-threads", "-help", NULL},
+        sat_shell_command_get_backbone,
+        "Get all literals of named variables that have the same value in every solution of current sat problem.\n"
+        "Candidates are checked by concurrent solver runs.\n"
+        "All groups are enabled unless restricted by -enable or excluded by -disable."
+    },
+    {"enumerate_solutions",
+        (const char * const []) {"-vars", "-limit", "-file", "-command", "-tempfile_keep", "-tempfile_clean", "-tempfile_base", "-compress_cnf", "-plain_cnf", "-solver_binary", "-solution_on_stdout", "-enable", "-disable", "-help", NULL},
+        sat_shell_command_enumerate_solutions,
+        "Enumerate solutions projected onto given variables and write them to a file or pass them to a command.\n"
+        "All groups are enabled unless restricted by -enable or excluded by -disable.\n"
+        "The current sat problem is not modified - return number of solutions."
+    },
+    {"optimize",
+        (const char * const []) {"-objectives", "-timeout", "-tempfile_keep", "-tempfile_clean", "-tempfile_base", "-compress_cnf", "-plain_cnf", "-solver_binary", "-solution_on_stdout", "-help", NULL},
+        sat_shell_command_optimize,
+        "Minimize the weights of violated soft clauses per objective in lexicographic order of -objectives with all groups enabled.\n"
+        "Each objective is bounded by a totalizer built once, improved models only add unit clauses tightening the bound.\n"
+        "Objectives whose totalizer would exceed 1000000 clauses (e.g. by many distinct weights) get a new encoding per bound.\n"
+        "Improved models are reported, after -timeout seconds the best model found so far is kept and becomes the solution\n"
+        "- return dict of satisfiable, optimal and costs (per objective)."
+    },
+    {"write_wcnf",
+        (const char * const []) {"-file", "-objectives", "-help", NULL},
+        sat_shell_command_write_wcnf,
+        "Write current sat problem with all groups enabled and the soft clauses of -objectives as weighted cnf (MaxSAT\n"
+        "evaluation format) for external MaxSAT solvers. Weights of several objectives are scaled to preserve their priority."
+    },
+    {"set_encoding_profile",
+        (const char * const []) {"-clear", "-file", "-class", "-encoding", "-help", NULL},
+        sat_shell_command_set_encoding_profile,
+        "Set clause encodings used by add_encoding per constraint class instead of those given by the script:\n"
+        "\"1ofn\" (1ofn, 1ofn_*: \"order\" or a cardinality encoding), \"mofn\" (mofn, atleast_mofn, atmost_mofn, 2ofn:\n"
+        "a cardinality encoding) and \"pb\" (a pb encoding). Entries are read from a -file written by tune_encodings\n"
+        "or given by -class and -encoding (\"script\" removes the entry) - return profile as list of class, encoding."
+    },
+    {"tune_encodings",
+        (const char * const []) {"-script", "-timeout", "-threads", "-max_growth", "-profile", "-tempfile_base", "-solver_binary", "-solution_on_stdout", "-compress_cnf", "-plain_cnf", "-help", NULL},
+        sat_shell_command_tune_encodings,
+        "Replay -script until its first solving command on a new problem, counting the add_encoding constraints per class\n"
+        "(see set_encoding_profile), and again with each alternative clause encoding of each recorded class.\n"
+        "All variants are solved by -threads concurrent solver runs stopped after -timeout seconds and reported,\n"
+        "the fastest encoding per class is written to the -profile file - return tuned profile as list of class, encoding."
+    },
     {"help",
         (const char * const []) {"-help", NULL},
         sat_shell_command_help,
@@ -124,10 +377,12 @@ static struct sat_shell_command_data sat_shell_command_data_list [] = {
 /* allocate and return new sat_shell */
 struct sat_shell * sat_shell_new ()
 {
-    struct sat_shell *result = g_slice_new (struct sat_shell);
+    struct sat_shell *result = g_slice_new0 (struct sat_shell);
 
     if (result == NULL) return NULL;
 
+    result->profile = sat_tune_profile_new ();
+
     result->tclln = tclln_new ("sat-shell");
     if (result->tclln == NULL) {
         sat_shell_free (&result);
@@ -168,6 +423,8 @@ void sat_shell_free (struct sat_shell **sat)
         sat_problem_free (&(s->sat));
     }
 
+    sat_tune_profile_free (&(s->profile));
+
     g_slice_free (struct sat_shell, s);
     *sat = NULL;
 }
@@ -252,6 +509,94 @@ static int sat_shell_tcl_string_list_parse (ClientData client_data, Tcl_Obj *obj
     return 1;
 }
 
+/* Tcl helper function for parsing lists of integers in GArrays of long int */
+static int sat_shell_tcl_long_list_parse (ClientData client_data, Tcl_Obj *obj, void *dest_ptr)
+{
+    GArray **array_dest = (GArray **) dest_ptr;
+    if (dest_ptr == NULL) {
+        return 1;
+    }
+
+    if (obj == NULL) {
+        return 1;
+    }
+
+    int len = 0;
+    if (Tcl_ListObjLength (NULL, obj, &len) != TCL_OK) return -1;
+
+    GArray *result = g_array_sized_new (false, false, sizeof (long int), len);
+
+    for (int i = 0; i < len; i++) {
+        Tcl_Obj *elem;
+        long int value;
+        if ((Tcl_ListObjIndex (NULL, obj, i, &elem) != TCL_OK) || (elem == NULL) ||
+            (Tcl_GetLongFromObj (NULL, elem, &value) != TCL_OK)) {
+            g_array_free (result, true);
+            return -1;
+        }
+
+        g_array_append_val (result, value);
+    }
+
+    if (*array_dest != NULL) g_array_free (*array_dest, true);
+    *array_dest = result;
+    return 1;
+}
+
+/* Tcl helper function for parsing lists of lists of integers in GSLists of GArrays of long int */
+static int sat_shell_tcl_long_list_list_parse (ClientData client_data, Tcl_Obj *obj, void *dest_ptr)
+{
+    GSList **list_dest = (GSList **) dest_ptr;
+    if (dest_ptr == NULL) {
+        return 1;
+    }
+
+    if (obj == NULL) {
+        return 1;
+    }
+
+    int len = 0;
+    if (Tcl_ListObjLength (NULL, obj, &len) != TCL_OK) return -1;
+
+    GSList *result = NULL;
+
+    for (int i = 0; i < len; i++) {
+        Tcl_Obj *list_sub;
+        GArray *result_sub = NULL;
+
+        if ((Tcl_ListObjIndex (NULL, obj, i, &list_sub) != TCL_OK) || (list_sub == NULL) ||
+            (sat_shell_tcl_long_list_parse (client_data, list_sub, &result_sub) != 1)) {
+            g_slist_free_full (result, (GDestroyNotify) g_array_unref);
+            return -1;
+        }
+
+        result = g_slist_prepend (result, result_sub);
+    }
+
+    if (*list_dest != NULL) g_slist_free_full (*list_dest, (GDestroyNotify) g_array_unref);
+    *list_dest = g_slist_reverse (result);
+    return 1;
+}
+
+/* Tcl helper function for parsing integers in long int */
+static int sat_shell_tcl_long_parse (ClientData client_data, Tcl_Obj *obj, void *dest_ptr)
+{
+    long int *long_dest = (long int *) dest_ptr;
+    if (dest_ptr == NULL) {
+        return 1;
+    }
+
+    if (obj == NULL) {
+        return -1;
+    }
+
+    if (Tcl_GetLongFromObj (NULL, obj, long_dest) != TCL_OK) {
+        return -1;
+    }
+
+    return 1;
+}
+
 /* Tcl helper function for parsing lists of lists in GSLists of GSLists */
 static int sat_shell_tcl_string_list_list_parse (ClientData client_data, Tcl_Obj *obj, void *dest_ptr)
 {
@@ -315,16 +660,18 @@ string_list_list_parse_error_exit:
     return -1;
 }
 
-/* Tcl command for adding clauses: add_clause -clause <clause as list> | -list <list of clauses as lists> */
+/* Tcl command for adding clauses: add_clause -clause <clause as list> | -list <list of clauses as lists> [-group <group name>] */
 static int sat_shell_command_add_clause (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
 {
     GSList *clause = NULL;
     GSList *clist  = NULL;
+    const char *group = NULL;
     SatProblem sat = ((struct sat_shell *) client_data)->sat;
 
     Tcl_ArgvInfo arg_table [] = {
         {TCL_ARGV_FUNC,     "-clause", (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse,      (void*) &clause, "the clause as list of literals", NULL},
         {TCL_ARGV_FUNC,     "-list",   (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_list_parse, (void*) &clist,  "list of clauses as list of literals", NULL},
+        {TCL_ARGV_STRING,   "-group",  NULL,                                                             (void*) &group,  "group of the clauses to enable/disable them on solving", NULL},
         TCL_ARGV_AUTO_HELP,
         TCL_ARGV_TABLE_END
     };
@@ -337,6 +684,8 @@ static int sat_shell_command_add_clause (ClientData client_data, Tcl_Interp *int
         return TCL_ERROR;
     }
 
+    sat_problem_set_group (sat, group);
+
     if (clause != NULL) {
         sat_problem_add_clause_gslist (sat, clause);
 
@@ -352,80 +701,252 @@ static int sat_shell_command_add_clause (ClientData client_data, Tcl_Interp *int
         g_slist_free (clist);
     }
 
+    sat_problem_set_group (sat, NULL);
+
+    return TCL_OK;
+}
+
+/* Tcl command for adding soft clauses: add_soft_clause -clause <clause as list> | -list <list of clauses as lists> [-weight <weight>]
+ *                                                    [-objective <objective name>] */
+static int sat_shell_command_add_soft_clause (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    GSList *clause = NULL;
+    GSList *clist  = NULL;
+    long int weight = 1;
+    const char *objective = "cost";
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_FUNC,     "-clause",    (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse,      (void*) &clause,    "the soft clause as list of literals", NULL},
+        {TCL_ARGV_FUNC,     "-list",      (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_list_parse, (void*) &clist,     "list of soft clauses as list of literals", NULL},
+        {TCL_ARGV_FUNC,     "-weight",    (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_long_parse,             (void*) &weight,    "positive cost of violating each clause, default: 1", NULL},
+        {TCL_ARGV_STRING,   "-objective", NULL,                                                             (void*) &objective, "objective the cost is counted in, default: cost", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if ((clause == NULL) && (clist == NULL)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected a clause or a list of clauses", -1));
+        return TCL_ERROR;
+    }
+    if (weight <= 0) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: weight must be positive", -1));
+        g_slist_free (clause);
+        g_slist_free_full (clist, (GDestroyNotify) g_slist_free);
+        return TCL_ERROR;
+    }
+
+    bool success = true;
+
+    if (clause != NULL) {
+        success = sat_problem_add_soft_clause (sat, clause, weight, objective);
+
+        g_slist_free (clause);
+    }
+
+    if (clist != NULL) {
+        for (GSList *li = clist; li != NULL; li = li->next) {
+            GSList *i_clause = (GSList *) li->data;
+            if (success) success = sat_problem_add_soft_clause (sat, i_clause, weight, objective);
+            g_slist_free (i_clause);
+        }
+        g_slist_free (clist);
+    }
+
+    if (!success) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while adding soft clause", -1));
+        return TCL_ERROR;
+    }
+
     return TCL_OK;
 }
 
-/* Tcl command for adding encoding: add_encoding -literals <literals as list> -encoding (1ofn|mofn) [-parameter <parameter>] */
+/* Tcl command for adding encoding: add_encoding -literals <literals as list> -encoding (1ofn|mofn|xor|pb) [-parameter <parameter>] [-group <group name>] */
 static int sat_shell_command_add_encoding (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
 {
     GSList *lit_list = NULL;
-    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    struct sat_shell *shell = client_data;
+    SatProblem sat = shell->sat;
     const char *encoding = NULL;
-    int parameter = -1;
+    const char *group    = NULL;
+    const char *cardinality = "auto";
+    const char *pb          = "auto";
+    const char *relation    = "<=";
+    GArray *weights = NULL;
+    int parameter = INT_MIN;
 
     Tcl_ArgvInfo arg_table [] = {
         {TCL_ARGV_FUNC,     "-literals",  (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &lit_list,  "the list of literals to apply encoding to", NULL},
-        {TCL_ARGV_STRING,   "-encoding",  NULL,                                                        (void *) &encoding,  "the encoding to apply: one of \"mofn\", \"atleast_mofn\", \"atmost_mofn\" + parameter = m, \"1ofn_order\"", NULL},
+        {TCL_ARGV_STRING,   "-encoding",  NULL,                                                        (void *) &encoding,  "the encoding to apply: one of \"mofn\", \"atleast_mofn\", \"atmost_mofn\" + parameter = m, \"1ofn\", \"1ofn_auto\", \"1ofn_pairwise\", \"1ofn_commander\", \"1ofn_product\", \"1ofn_binary\", \"1ofn_ladder\", \"1ofn_order\", \"2ofn\", \"xor\", \"pb\" + weights, relation and parameter = bound", NULL},
         {TCL_ARGV_INT,      "-parameter", NULL,                                                        (void *) &parameter, "integer parameter for some encodings", NULL},
+        {TCL_ARGV_STRING,   "-cardinality", NULL,                                                      (void *) &cardinality, "clause encoding of m of n encodings, default: auto", NULL},
+        {TCL_ARGV_FUNC,     "-weights",   (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_long_list_parse,   (void *) &weights,   "integer weights of the literals of encoding pb", NULL},
+        {TCL_ARGV_STRING,   "-relation",  NULL,                                                        (void *) &relation,  "relation of encoding pb: <= (default), >= or =", NULL},
+        {TCL_ARGV_STRING,   "-pb",        NULL,                                                        (void *) &pb,        "clause encoding of encoding pb, default: auto", NULL},
+        {TCL_ARGV_STRING,   "-group",     NULL,                                                        (void *) &group,     "group of the encoding to enable/disable it on solving", NULL},
         TCL_ARGV_AUTO_HELP,
         TCL_ARGV_TABLE_END
     };
 
     int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
-    if (result != TCL_OK) return result;
+    if (result != TCL_OK) {
+        if (weights != NULL) g_array_free (weights, true);
+        return result;
+    }
+
+    SatCardinalityEncoding card_encoding;
+    if (!sat_cardinality_encoding_from_string (cardinality, &card_encoding)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: cardinality encoding has to be one of \"auto\", \"direct\", \"seqcounter\", \"totalizer\", \"modtotalizer\", \"cardnetwork\", \"sortnetwork\", \"commander\", \"product\", \"binary\", \"ladder\"", -1));
+        g_slist_free (lit_list);
+        if (weights != NULL) g_array_free (weights, true);
+        return TCL_ERROR;
+    }
+    SatPbEncoding pb_encoding;
+    if (!sat_pb_encoding_from_string (pb, &pb_encoding)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: pb encoding has to be one of \"auto\", \"bdd\", \"gte\", \"adder\", \"sortnetwork\"", -1));
+        g_slist_free (lit_list);
+        if (weights != NULL) g_array_free (weights, true);
+        return TCL_ERROR;
+    }
 
     if (lit_list == NULL) {
         Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected a list of literals", -1));
+        if (weights != NULL) g_array_free (weights, true);
         return TCL_ERROR;
     }
     if (encoding == NULL) {
         Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected an encoding", -1));
         g_slist_free (lit_list);
+        if (weights != NULL) g_array_free (weights, true);
         return TCL_ERROR;
     }
 
+    /* clause encoding of the constraint class given by the profile */
+    SatTuneClass tune_class;
+    if (sat_tune_class_of_encoding (encoding, &tune_class)) {
+        const char *tuned = sat_tune_profile_get (shell->profile, tune_class);
+
+        if (shell->replay) {
+            shell->record.n_constraints[tune_class]++;
+            shell->record.n_lits[tune_class] += g_slist_length (lit_list);
+        }
+
+        if (tuned == NULL) {
+            /* encodings chosen by the script */
+        } else if (tune_class == SAT_TUNE_1OFN) {
+            if (strcmp (tuned, "order") == 0) {
+                encoding = "1ofn_order";
+            } else {
+                encoding = "1ofn";
+                sat_cardinality_encoding_from_string (tuned, &card_encoding);
+            }
+        } else if (tune_class == SAT_TUNE_MOFN) {
+            sat_cardinality_encoding_from_string (tuned, &card_encoding);
+        } else {
+            sat_pb_encoding_from_string (tuned, &pb_encoding);
+        }
+    }
+
+    sat_problem_set_group (sat, group);
+
     if (strcmp (encoding, "1ofn") == 0) {
-        sat_problem_add_mofn_direct_encoding (sat, lit_list, 1, true, true);
+        sat_problem_add_mofn_encoding (sat, lit_list, 1, true, true, card_encoding);
     } else if (strcmp (encoding, "1ofn_order") == 0) {
         sat_problem_add_1ofn_order_encoding (sat, lit_list);
+    } else if (strcmp (encoding, "1ofn_auto") == 0) {
+        sat_problem_add_mofn_encoding (sat, lit_list, 1, true, true, SAT_CARDINALITY_AUTO);
+    } else if (strcmp (encoding, "1ofn_pairwise") == 0) {
+        sat_problem_add_mofn_encoding (sat, lit_list, 1, true, true, SAT_CARDINALITY_DIRECT);
+    } else if (strcmp (encoding, "1ofn_commander") == 0) {
+        sat_problem_add_mofn_encoding (sat, lit_list, 1, true, true, SAT_CARDINALITY_COMMANDER);
+    } else if (strcmp (encoding, "1ofn_product") == 0) {
+        sat_problem_add_mofn_encoding (sat, lit_list, 1, true, true, SAT_CARDINALITY_PRODUCT);
+    } else if (strcmp (encoding, "1ofn_binary") == 0) {
+        sat_problem_add_mofn_encoding (sat, lit_list, 1, true, true, SAT_CARDINALITY_BINARY);
+    } else if (strcmp (encoding, "1ofn_ladder") == 0) {
+        sat_problem_add_mofn_encoding (sat, lit_list, 1, true, true, SAT_CARDINALITY_LADDER);
+    } else if (strcmp (encoding, "xor") == 0) {
+        sat_problem_add_xor_encoding (sat, lit_list);
+    } else if (strcmp (encoding, "pb") == 0) {
+        const char *error = NULL;
+        bool atleast = (strcmp (relation, ">=") == 0) || (strcmp (relation, "=") == 0);
+        bool atmost  = (strcmp (relation, "<=") == 0) || (strcmp (relation, "=") == 0);
+
+        if ((weights == NULL) || (weights->len != g_slist_length (lit_list))) {
+            error = "error: encoding \"pb\" expects one weight per literal";
+        } else if (parameter == INT_MIN) {
+            error = "error: encoding \"pb\" expects the bound as parameter";
+        } else if (!atleast && !atmost) {
+            error = "error: relation has to be one of \"<=\", \">=\", \"=\"";
+        }
+        if (error != NULL) {
+            Tcl_SetObjResult (interp, Tcl_NewStringObj (error, -1));
+            sat_problem_set_group (sat, NULL);
+            g_slist_free (lit_list);
+            if (weights != NULL) g_array_free (weights, true);
+            return TCL_ERROR;
+        }
+
+        sat_problem_add_pb_encoding (sat, lit_list, (long int *) weights->data, parameter, atleast, atmost, pb_encoding);
     } else if (strcmp (encoding, "2ofn") == 0) {
-        sat_problem_add_mofn_direct_encoding (sat, lit_list, 2, true, true);
+        sat_problem_add_mofn_encoding (sat, lit_list, 2, true, true, card_encoding);
     } else if ((strcmp (encoding, "mofn") == 0) || (strcmp (encoding, "atleast_mofn") == 0) || (strcmp (encoding, "atmost_mofn") == 0)) {
         if (parameter > 0) {
             if (strcmp (encoding, "mofn") == 0) {
-                sat_problem_add_mofn_direct_encoding (sat, lit_list, parameter, true, true);
+                sat_problem_add_mofn_encoding (sat, lit_list, parameter, true, true, card_encoding);
             } else if (strcmp (encoding, "atleast_mofn") == 0) {
-                sat_problem_add_mofn_direct_encoding (sat, lit_list, parameter, true, false);
+                sat_problem_add_mofn_encoding (sat, lit_list, parameter, true, false, card_encoding);
             } else {
-                sat_problem_add_mofn_direct_encoding (sat, lit_list, parameter, false, true);
+                sat_problem_add_mofn_encoding (sat, lit_list, parameter, false, true, card_encoding);
             }
         } else {
             Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: encoding \"mofn\", \"atleast_mofn\", \"atmost_mofn\" expect m as parameter in range 1 ... n", -1));
+            sat_problem_set_group (sat, NULL);
             g_slist_free (lit_list);
+            if (weights != NULL) g_array_free (weights, true);
             return TCL_ERROR;
         }
     } else {
-        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: encoding has to be one of \"mofn\", \"atleast_mofn\", \"atmost_mofn\", \"1ofn_order\"", -1));
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: encoding has to be one of \"mofn\", \"atleast_mofn\", \"atmost_mofn\", \"1ofn\", \"1ofn_auto\", \"1ofn_pairwise\", \"1ofn_commander\", \"1ofn_product\", \"1ofn_binary\", \"1ofn_ladder\", \"1ofn_order\", \"2ofn\", \"xor\", \"pb\"", -1));
+        sat_problem_set_group (sat, NULL);
         g_slist_free (lit_list);
+        if (weights != NULL) g_array_free (weights, true);
         return TCL_ERROR;
     }
 
+    sat_problem_set_group (sat, NULL);
     g_slist_free (lit_list);
+    if (weights != NULL) g_array_free (weights, true);
+
+    if (shell->replay && (shell->replay_max_clauses > 0)) {
+        unsigned long int n_vars;
+        unsigned long int n_clauses;
+        sat_problem_size (sat, &n_vars, &n_clauses);
+        if (n_clauses > shell->replay_max_clauses) {
+            shell->replay_too_large = true;
+            return sat_shell_replay_stop (shell, interp);
+        }
+    }
 
     return TCL_OK;
 }
 
-/* Tcl command for adding formulas: add_formula -formula <formula string> -mapping <literal mapping as list> */
+/* Tcl command for adding formulas: add_formula -formula <formula string> -mapping <literal mapping as list> [-group <group name>] */
 static int sat_shell_command_add_formula (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
 {
     SatProblem sat = ((struct sat_shell *) client_data)->sat;
 
     GSList *mapping_list = NULL;
     const char *formula = NULL;
+    const char *group   = NULL;
 
     Tcl_ArgvInfo arg_table [] = {
         {TCL_ARGV_STRING,   "-formula", NULL,                                                        (void *) &formula,      "raw formula with variables from 1 to n which are mapped to the literals of the mapping list", NULL},
         {TCL_ARGV_FUNC,     "-mapping", (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &mapping_list, "the list of literals to map on the encoded formula", NULL},
+        {TCL_ARGV_STRING,   "-group",   NULL,                                                        (void *) &group,        "group of the formula to enable/disable it on solving", NULL},
         TCL_ARGV_AUTO_HELP,
         TCL_ARGV_TABLE_END
     };
@@ -443,7 +964,11 @@ static int sat_shell_command_add_formula (ClientData client_data, Tcl_Interp *in
         return TCL_ERROR;
     }
 
-    if (!sat_problem_add_formula_mapping (sat, formula, mapping_list)) {
+    sat_problem_set_group (sat, group);
+    bool success = sat_problem_add_formula_mapping (sat, formula, mapping_list);
+    sat_problem_set_group (sat, NULL);
+
+    if (!success) {
         g_slist_free (mapping_list);
         Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: encoding + mapping failed", -1));
         return TCL_ERROR;
@@ -454,28 +979,16 @@ static int sat_shell_command_add_formula (ClientData client_data, Tcl_Interp *in
     return TCL_OK;
 }
 
-/* Tcl command for solving problem: solve [-tempfile_base <prefix>] [-solver_binary <binary>] [-solution_on_stdout] [-tempfile_clean|-tempfile_keep]
- *                                        [-compress_cnf|-plain_cnf] */
-static int sat_shell_command_solve (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+/* Tcl command for declaring bit-vectors: declare_bitvector -name <name> -width <number of bits> */
+static int sat_shell_command_declare_bitvector (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
 {
-    SatProblem sat = ((struct sat_shell *) client_data)->sat;
-    const char *tmp_file_basename = "tmp_cnf";
-    const char *solver_bin        = "minisat";
-    int solution_on_stdout        = false;
-    int cleanup                   = true;
-    int cnf_gz                    = true;
-
-    int int_true  = true;
-    int int_false = false;
+    SatProblem sat   = ((struct sat_shell *) client_data)->sat;
+    const char *name = NULL;
+    int width        = 0;
 
     Tcl_ArgvInfo arg_table [] = {
-        {TCL_ARGV_STRING,   "-tempfile_base",      NULL,                        (void *) &tmp_file_basename,  "filenames for cnf and solution are based on this name +suffixes", NULL},
-        {TCL_ARGV_STRING,   "-solver_binary",      NULL,                        (void *) &solver_bin,         "executable of sat solver", NULL},
-        {TCL_ARGV_CONSTANT, "-solution_on_stdout", (void *) &int_true,          (void *) &solution_on_stdout, "solver prints solution to stdout instead of a file", NULL},
-        {TCL_ARGV_CONSTANT, "-tempfile_clean",     GINT_TO_POINTER (int_true),  (void *) &cleanup,            "remove temporary files after solving", NULL},
-        {TCL_ARGV_CONSTANT, "-tempfile_keep",      GINT_TO_POINTER (int_false), (void *) &cleanup,            "keep temporary files after solving", NULL},
-        {TCL_ARGV_CONSTANT, "-compress_cnf",       GINT_TO_POINTER (int_true),  (void *) &cnf_gz,             "compress cnf file", NULL},
-        {TCL_ARGV_CONSTANT, "-plain_cnf",          GINT_TO_POINTER (int_false), (void *) &cnf_gz,             "do not compress cnf file", NULL},
+        {TCL_ARGV_STRING,   "-name",  NULL, (void *) &name,  "name of the bit-vector", NULL},
+        {TCL_ARGV_INT,      "-width", NULL, (void *) &width, "number of bits", NULL},
         TCL_ARGV_AUTO_HELP,
         TCL_ARGV_TABLE_END
     };
@@ -483,27 +996,42 @@ static int sat_shell_command_solve (ClientData client_data, Tcl_Interp *interp,
     int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
     if (result != TCL_OK) return result;
 
-    sat_problem_solve (sat, tmp_file_basename, solver_bin, solution_on_stdout, cleanup, cnf_gz);
-
-    bool error = false;
-    bool satisfiable = sat_problem_satisfiable (sat, &error);
-
-    if (error) {
-        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while solving sat-problem", -1));
+    if (name == NULL) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected a name", -1));
+        return TCL_ERROR;
+    }
+    if (width <= 0) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected a positive width", -1));
         return TCL_ERROR;
     }
 
-    Tcl_SetObjResult (interp, Tcl_NewBooleanObj (satisfiable));
+    if (!sat_problem_declare_bitvector (sat, name, width)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while declaring bit-vector", -1));
+        return TCL_ERROR;
+    }
 
     return TCL_OK;
 }
 
-/* Tcl command for resetting problem: reset */
-static int sat_shell_command_reset (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+/* Tcl command for adding bit-vector constraints: add_bitvector_constraint -op <operation> -operands <list> [-result <bit-vector>]
+ * [-width <number of bits>] [-multiplier (array|wallace|karatsuba)] [-group <group name>] */
+static int sat_shell_command_add_bitvector_constraint (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
 {
-    struct sat_shell *shell = (struct sat_shell *) client_data;
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    GSList *operands = NULL;
+    const char *op_name    = NULL;
+    const char *result_bv  = NULL;
+    const char *multiplier = "wallace";
+    const char *group      = NULL;
+    int width = 0;
 
     Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-op",         NULL,                                                        (void *) &op_name,    "the operation: one of \"add\", \"sub\", \"mul\", \"and\", \"or\", \"xor\", \"not\", \"shl\", \"lshr\", \"ashr\", \"eq\", \"ne\", \"ult\", \"ule\", \"ugt\", \"uge\", \"slt\", \"sle\", \"sgt\", \"sge\"", NULL},
+        {TCL_ARGV_FUNC,     "-operands",   (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &operands,   "the list of operands: bit-vectors or integers", NULL},
+        {TCL_ARGV_STRING,   "-result",     NULL,                                                        (void *) &result_bv,  "bit-vector for the result, predicates are asserted without result", NULL},
+        {TCL_ARGV_INT,      "-width",      NULL,                                                        (void *) &width,      "number of bits of the operation, default: width of result or widest operand", NULL},
+        {TCL_ARGV_STRING,   "-multiplier", NULL,                                                        (void *) &multiplier, "multiplier circuit: \"array\", \"wallace\" (default), \"karatsuba\"", NULL},
+        {TCL_ARGV_STRING,   "-group",      NULL,                                                        (void *) &group,      "group of the constraint to enable/disable it on solving", NULL},
         TCL_ARGV_AUTO_HELP,
         TCL_ARGV_TABLE_END
     };
@@ -511,25 +1039,52 @@ static int sat_shell_command_reset (ClientData client_data, Tcl_Interp *interp,
     int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
     if (result != TCL_OK) return result;
 
-    if (shell->sat != NULL) {
-        sat_problem_free (&(shell->sat));
+    SatBitvectorOp op;
+    if (!sat_bitvector_op_from_string (op_name, &op)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: operation has to be one of \"add\", \"sub\", \"mul\", \"and\", \"or\", \"xor\", \"not\", \"shl\", \"lshr\", \"ashr\", \"eq\", \"ne\", \"ult\", \"ule\", \"ugt\", \"uge\", \"slt\", \"sle\", \"sgt\", \"sge\"", -1));
+        g_slist_free (operands);
+        return TCL_ERROR;
+    }
+    SatBitvectorMultiplier mul;
+    if (!sat_bitvector_multiplier_from_string (multiplier, &mul)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: multiplier has to be one of \"array\", \"wallace\", \"karatsuba\"", -1));
+        g_slist_free (operands);
+        return TCL_ERROR;
+    }
+    if (width < 0) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected a positive width", -1));
+        g_slist_free (operands);
+        return TCL_ERROR;
     }
-    shell->sat = sat_problem_new ();
 
-    if (shell->sat == NULL) {
-        Tcl_SetObjResult (interp, Tcl_NewStringObj ("internal allocation error", -1));
+    sat_problem_set_group (sat, group);
+    bool success = sat_problem_add_bitvector_constraint (sat, op, mul, result_bv, operands, width);
+    sat_problem_set_group (sat, NULL);
+
+    g_slist_free (operands);
+
+    if (!success) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while adding bit-vector constraint", -1));
         return TCL_ERROR;
     }
 
     return TCL_OK;
 }
 
-/* Tcl command for cancelling current solution: cancel_solution */
-static int sat_shell_command_cancel_solution (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+/* Tcl command for declaring integer variables: declare_int -name <name> -min <value> -max <value> [-encoding (auto|direct|order|log)] */
+static int sat_shell_command_declare_int (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
 {
-    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    SatProblem sat       = ((struct sat_shell *) client_data)->sat;
+    const char *name     = NULL;
+    const char *encoding = "auto";
+    long int min         = 0;
+    long int max         = LONG_MIN;
 
     Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-name",     NULL,                                                (void *) &name,     "name of the integer variable", NULL},
+        {TCL_ARGV_FUNC,     "-min",      (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_long_parse, (void *) &min,      "smallest value, default: 0", NULL},
+        {TCL_ARGV_FUNC,     "-max",      (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_long_parse, (void *) &max,      "greatest value", NULL},
+        {TCL_ARGV_STRING,   "-encoding", NULL,                                                (void *) &encoding, "encoding: \"auto\" (default), \"direct\", \"order\", \"log\"", NULL},
         TCL_ARGV_AUTO_HELP,
         TCL_ARGV_TABLE_END
     };
@@ -537,48 +1092,682 @@ static int sat_shell_command_cancel_solution (ClientData client_data, Tcl_Interp
     int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
     if (result != TCL_OK) return result;
 
-    sat_problem_cancel_solution (sat);
+    SatIntEncoding int_encoding;
+    if (!sat_int_encoding_from_string (encoding, &int_encoding)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: encoding has to be one of \"auto\", \"direct\", \"order\", \"log\"", -1));
+        return TCL_ERROR;
+    }
+    if (name == NULL) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected a name", -1));
+        return TCL_ERROR;
+    }
+    if (max == LONG_MIN) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected the greatest value as -max", -1));
+        return TCL_ERROR;
+    }
+
+    if (!sat_problem_declare_int (sat, name, min, max, int_encoding)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while declaring integer variable", -1));
+        return TCL_ERROR;
+    }
 
     return TCL_OK;
 }
 
-/* Tcl command for getting results of variables: get_var_result [-var <var name>] [-assignment <assignment>] */
-static int sat_shell_command_get_var_result (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+/* Tcl command for adding constraints over integer variables: add_int_constraint -constraint (alldifferent|linear|element|table)
+ * -operands <list> [-coefficients <list>] [-relation <relation>] [-bound <value>] [-index <operand>] [-result <operand>]
+ * [-tuples <list of lists>] [-pb <encoding>] [-group <group name>] */
+static int sat_shell_command_add_int_constraint (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
 {
-    SatProblem sat       = ((struct sat_shell *) client_data)->sat;
-    const char *var_name = NULL;
-    bool assignment      = true;
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    GSList *operands     = NULL;
+    GArray *coefficients = NULL;
+    GSList *tuples       = NULL;
+    const char *constraint = NULL;
+    const char *relation   = "<=";
+    const char *index      = NULL;
+    const char *result_int = NULL;
+    const char *pb         = "auto";
+    const char *group      = NULL;
+    long int bound         = LONG_MIN;
 
     Tcl_ArgvInfo arg_table [] = {
-        {TCL_ARGV_STRING,   "-var",        NULL,                                                 (void *) &var_name,   "var name to look up", NULL},
-        {TCL_ARGV_FUNC,     "-assignment", (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_bool_parse, (void *) &assignment, "return list of variables assigned to given value", NULL},
+        {TCL_ARGV_STRING,   "-constraint",   NULL,                                                          (void *) &constraint,   "the constraint: one of \"alldifferent\", \"linear\", \"element\", \"table\"", NULL},
+        {TCL_ARGV_FUNC,     "-operands",     (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse,    (void *) &operands,     "the list of operands: integer variables or integers", NULL},
+        {TCL_ARGV_FUNC,     "-coefficients", (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_long_list_parse,      (void *) &coefficients, "integer coefficients of the operands of constraint linear, default: 1", NULL},
+        {TCL_ARGV_STRING,   "-relation",     NULL,                                                          (void *) &relation,     "relation of constraint linear: <= (default), >= or =", NULL},
+        {TCL_ARGV_FUNC,     "-bound",        (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_long_parse,           (void *) &bound,        "right-hand side of constraint linear", NULL},
+        {TCL_ARGV_STRING,   "-index",        NULL,                                                          (void *) &index,        "index of constraint element", NULL},
+        {TCL_ARGV_STRING,   "-result",       NULL,                                                          (void *) &result_int,   "result of constraint element", NULL},
+        {TCL_ARGV_FUNC,     "-tuples",       (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_long_list_list_parse, (void *) &tuples,       "allowed tuples of constraint table", NULL},
+        {TCL_ARGV_STRING,   "-pb",           NULL,                                                          (void *) &pb,           "clause encoding of constraint linear, default: auto", NULL},
+        {TCL_ARGV_STRING,   "-group",        NULL,                                                          (void *) &group,        "group of the constraint to enable/disable it on solving", NULL},
         TCL_ARGV_AUTO_HELP,
         TCL_ARGV_TABLE_END
     };
 
     int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
-    if (result != TCL_OK) return result;
+    if (result != TCL_OK) {
+        if (coefficients != NULL) g_array_free (coefficients, true);
+        g_slist_free_full (tuples, (GDestroyNotify) g_array_unref);
+        return result;
+    }
 
-    if (var_name != NULL) {
-        bool error = false;
-        bool retval = sat_problem_var_result (sat, var_name, &error);
+    unsigned int n_operands = g_slist_length (operands);
+    const char *error = NULL;
+    bool success = false;
 
-        if (error) {
-            Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while looking up variable", -1));
-            return TCL_ERROR;
+    SatPbEncoding pb_encoding;
+    if (!sat_pb_encoding_from_string (pb, &pb_encoding)) {
+        error = "error: pb encoding has to be one of \"auto\", \"bdd\", \"gte\", \"adder\", \"sortnetwork\"";
+    } else if (constraint == NULL) {
+        error = "error: expected a constraint";
+    }
+
+    sat_problem_set_group (sat, group);
+
+    if (error != NULL) {
+        /* reported below */
+    } else if (strcmp (constraint, "alldifferent") == 0) {
+        success = sat_problem_add_int_alldifferent (sat, operands);
+    } else if (strcmp (constraint, "linear") == 0) {
+        bool atleast = (strcmp (relation, ">=") == 0) || (strcmp (relation, "=") == 0);
+        bool atmost  = (strcmp (relation, "<=") == 0) || (strcmp (relation, "=") == 0);
+
+        if ((coefficients != NULL) && (coefficients->len != n_operands)) {
+            error = "error: constraint \"linear\" expects one coefficient per operand";
+        } else if (bound == LONG_MIN) {
+            error = "error: constraint \"linear\" expects a bound";
+        } else if (!atleast && !atmost) {
+            error = "error: relation has to be one of \"<=\", \">=\", \"=\"";
+        } else {
+            if (coefficients == NULL) {
+                coefficients = g_array_sized_new (false, false, sizeof (long int), n_operands);
+                long int one = 1;
+                for (unsigned int i = 0; i < n_operands; i++) g_array_append_val (coefficients, one);
+            }
+            success = sat_problem_add_int_linear (sat, operands, (long int *) coefficients->data, bound, atleast, atmost, pb_encoding);
+        }
+    } else if (strcmp (constraint, "element") == 0) {
+        success = sat_problem_add_int_element (sat, index, operands, result_int);
+    } else if (strcmp (constraint, "table") == 0) {
+        /* rows in one array */
+        GArray *rows = g_array_new (false, false, sizeof (long int));
+        for (GSList *li = tuples; li != NULL; li = li->next) {
+            GArray *row = li->data;
+            if (row->len != n_operands) {
+                error = "error: constraint \"table\" expects tuples with one value per operand";
+                break;
+            }
+            g_array_append_vals (rows, row->data, row->len);
         }
 
-        Tcl_SetObjResult (interp, Tcl_NewBooleanObj (retval));
+        if ((error == NULL) && (n_operands == 0)) error = "error: expected a list of operands";
+        if (error == NULL) success = sat_problem_add_int_table (sat, operands, (long int *) rows->data, g_slist_length (tuples));
+
+        g_array_free (rows, true);
     } else {
-        bool error = false;
-        GSList *result_list = sat_problem_var_result_list (sat, assignment, &error);
+        error = "error: constraint has to be one of \"alldifferent\", \"linear\", \"element\", \"table\"";
+    }
 
-        if (error) {
-            Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while looking up results", -1));
-            return TCL_ERROR;
-        }
+    sat_problem_set_group (sat, NULL);
 
-        Tcl_Obj *retval = Tcl_NewListObj (0, NULL);
+    g_slist_free (operands);
+    if (coefficients != NULL) g_array_free (coefficients, true);
+    g_slist_free_full (tuples, (GDestroyNotify) g_array_unref);
+
+    if (error != NULL) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj (error, -1));
+        return TCL_ERROR;
+    }
+    if (!success) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while adding integer constraint", -1));
+        return TCL_ERROR;
+    }
+
+    return TCL_OK;
+}
+
+/* Tcl command for adding graph constraints: add_graph_constraint -constraint (path|hamiltonian_path|hamiltonian_cycle|reachable|acyclic)
+ * -edges <list of {node node literal}> [-directed] [-nodes <list of {node literal}>] [-source <node>] [-target <node>]
+ * [-group <group name>] */
+static int sat_shell_command_add_graph_constraint (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    GSList *edges  = NULL;
+    GSList *nodes  = NULL;
+    const char *constraint = NULL;
+    const char *source     = NULL;
+    const char *target     = NULL;
+    const char *group      = NULL;
+    int directed           = false;
+    int int_true           = true;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-constraint", NULL,                                                            (void *) &constraint, "the constraint: one of \"path\", \"hamiltonian_path\", \"hamiltonian_cycle\", \"reachable\", \"acyclic\"", NULL},
+        {TCL_ARGV_FUNC,     "-edges",      (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_list_parse, (void *) &edges,      "the edges as list of {node node literal}", NULL},
+        {TCL_ARGV_CONSTANT, "-directed",   GINT_TO_POINTER (int_true),                                      (void *) &directed,   "edges are arcs from the first to the second node", NULL},
+        {TCL_ARGV_FUNC,     "-nodes",      (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_list_parse, (void *) &nodes,      "literals of nodes as list of {node literal}", NULL},
+        {TCL_ARGV_STRING,   "-source",     NULL,                                                            (void *) &source,     "start node", NULL},
+        {TCL_ARGV_STRING,   "-target",     NULL,                                                            (void *) &target,     "end node", NULL},
+        {TCL_ARGV_STRING,   "-group",      NULL,                                                            (void *) &group,      "group of the constraint to enable/disable it on solving", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) {
+        g_slist_free_full (edges, (GDestroyNotify) g_slist_free);
+        g_slist_free_full (nodes, (GDestroyNotify) g_slist_free);
+        return result;
+    }
+
+    const char *error = NULL;
+    bool success = false;
+
+    SatGraphConstraint graph_constraint;
+    if (constraint == NULL) {
+        error = "error: expected a constraint";
+    } else if (!sat_graph_constraint_from_string (constraint, &graph_constraint)) {
+        error = "error: constraint has to be one of \"path\", \"hamiltonian_path\", \"hamiltonian_cycle\", \"reachable\", \"acyclic\"";
+    } else {
+        sat_problem_set_group (sat, group);
+        success = sat_problem_add_graph_constraint (sat, graph_constraint, directed, edges, nodes, source, target);
+        sat_problem_set_group (sat, NULL);
+    }
+
+    g_slist_free_full (edges, (GDestroyNotify) g_slist_free);
+    g_slist_free_full (nodes, (GDestroyNotify) g_slist_free);
+
+    if (error != NULL) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj (error, -1));
+        return TCL_ERROR;
+    }
+    if (!success) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while adding graph constraint", -1));
+        return TCL_ERROR;
+    }
+
+    return TCL_OK;
+}
+
+/* Tcl command for solving problem: solve [-tempfile_base <prefix>] [-solver_binary <binary>] [-solution_on_stdout] [-tempfile_clean|-tempfile_keep]
+ *                                        [-compress_cnf|-plain_cnf] [-assume <literals as list>]
+ *                                        [-enable <groups as list>] [-disable <groups as list>]
+ *                                        [-cube_and_conquer] [-cube_depth <number>] [-threads <number>] */
+static int sat_shell_command_solve (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    if (((struct sat_shell *) client_data)->replay) return sat_shell_replay_stop (client_data, interp);
+
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    const char *tmp_file_basename = "tmp_cnf";
+    const char *solver_bin        = "minisat";
+    int solution_on_stdout        = false;
+    int cleanup                   = true;
+    int cnf_gz                    = true;
+    GSList *assumptions           = NULL;
+    GSList *enable_groups         = NULL;
+    GSList *disable_groups        = NULL;
+    int cube_and_conquer          = false;
+    int cube_depth                = 0;
+    int n_threads                 = 0;
+    int verify                    = false;
+
+    int int_true  = true;
+    int int_false = false;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-tempfile_base",      NULL,                        (void *) &tmp_file_basename,  "filenames for cnf and solution are based on this name +suffixes", NULL},
+        {TCL_ARGV_STRING,   "-solver_binary",      NULL,                        (void *) &solver_bin,         "executable of sat solver", NULL},
+        {TCL_ARGV_CONSTANT, "-solution_on_stdout", (void *) &int_true,          (void *) &solution_on_stdout, "solver prints solution to stdout instead of a file", NULL},
+        {TCL_ARGV_CONSTANT, "-tempfile_clean",     GINT_TO_POINTER (int_true),  (void *) &cleanup,            "remove temporary files after solving", NULL},
+        {TCL_ARGV_CONSTANT, "-tempfile_keep",      GINT_TO_POINTER (int_false), (void *) &cleanup,            "keep temporary files after solving", NULL},
+        {TCL_ARGV_CONSTANT, "-compress_cnf",       GINT_TO_POINTER (int_true),  (void *) &cnf_gz,             "compress cnf file", NULL},
+        {TCL_ARGV_CONSTANT, "-plain_cnf",          GINT_TO_POINTER (int_false), (void *) &cnf_gz,             "do not compress cnf file", NULL},
+        {TCL_ARGV_FUNC,     "-assume",             (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &assumptions, "list of literals assumed only for this run", NULL},
+        {TCL_ARGV_FUNC,     "-enable",             (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &enable_groups,  "list of groups enabled for this run (default: all)", NULL},
+        {TCL_ARGV_FUNC,     "-disable",            (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &disable_groups, "list of groups disabled for this run", NULL},
+        {TCL_ARGV_CONSTANT, "-cube_and_conquer",   GINT_TO_POINTER (int_true),  (void *) &cube_and_conquer,   "split problem into cubes solved by concurrent solver runs", NULL},
+        {TCL_ARGV_INT,      "-cube_depth",         NULL,                        (void *) &cube_depth,         "maximum number of decisions per cube (0: depending on threads)", NULL},
+        {TCL_ARGV_INT,      "-threads",            NULL,                        (void *) &n_threads,          "number of concurrent solver runs (0: number of processors)", NULL},
+        {TCL_ARGV_CONSTANT, "-verify",             GINT_TO_POINTER (int_true),  (void *) &verify,             "check the model against all clauses before accepting it", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if ((cube_depth < 0) || (n_threads < 0)) {
+        g_slist_free (assumptions);
+        g_slist_free (enable_groups);
+        g_slist_free (disable_groups);
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: cube_depth and threads must not be negative", -1));
+        return TCL_ERROR;
+    }
+
+    sat_problem_solve (sat, tmp_file_basename, solver_bin, solution_on_stdout, cleanup, cnf_gz, assumptions, enable_groups, disable_groups,
+                       cube_and_conquer, cube_depth, n_threads, verify);
+
+    g_slist_free (assumptions);
+    g_slist_free (enable_groups);
+    g_slist_free (disable_groups);
+
+    bool error = false;
+    bool satisfiable = sat_problem_satisfiable (sat, &error);
+
+    if (error) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while solving sat-problem", -1));
+        return TCL_ERROR;
+    }
+
+    Tcl_SetObjResult (interp, Tcl_NewBooleanObj (satisfiable));
+
+    return TCL_OK;
+}
+
+/* Tcl command for configuring preprocessing: set_preprocess [-enable <bool>] [-passes <passes as list>] [-elim_occurrences <number>]
+ *                                                          [-elim_growth <number>] [-elim_clause_length <number>] [-steps <number>] */
+static int sat_shell_command_set_preprocess (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+
+    struct sat_preprocess_options options;
+    sat_preprocess_options_default (&options);
+
+    bool enable        = true;
+    GSList *pass_list  = NULL;
+    int elim_occ       = options.elim_max_occurrences;
+    int elim_growth    = options.elim_max_growth;
+    int elim_length    = options.elim_max_clause_length;
+    int steps          = options.max_steps;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_FUNC, "-enable",             (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_bool_parse,        (void *) &enable,      "enable or disable preprocessing", NULL},
+        {TCL_ARGV_FUNC, "-passes",             (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &pass_list,   "list of passes to run", NULL},
+        {TCL_ARGV_INT,  "-elim_occurrences",   NULL,                                                        (void *) &elim_occ,    "maximum number of occurrences of an eliminated variable", NULL},
+        {TCL_ARGV_INT,  "-elim_growth",        NULL,                                                        (void *) &elim_growth, "maximum increase of number of clauses by eliminating a variable", NULL},
+        {TCL_ARGV_INT,  "-elim_clause_length", NULL,                                                        (void *) &elim_length, "maximum length of resolvents of an eliminated variable", NULL},
+        {TCL_ARGV_INT,  "-steps",              NULL,                                                        (void *) &steps,       "maximum number of steps of each pass", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (!enable) {
+        g_slist_free (pass_list);
+        sat_problem_set_preprocess (sat, NULL);
+        return TCL_OK;
+    }
+
+    if ((elim_occ < 0) || (elim_growth < 0) || (elim_length < 0) || (steps < 0)) {
+        g_slist_free (pass_list);
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: budgets must not be negative", -1));
+        return TCL_ERROR;
+    }
+
+    if (pass_list != NULL) {
+        options.equivalent_literals  = false;
+        options.pure_literals        = false;
+        options.subsumption          = false;
+        options.variable_elimination = false;
+        options.blocked_clauses      = false;
+        options.cardinality          = false;
+
+        for (GSList *li = pass_list; li != NULL; li = li->next) {
+            const char *pass = li->data;
+
+            if (strcmp (pass, "equivalence") == 0) {
+                options.equivalent_literals = true;
+            } else if (strcmp (pass, "pure") == 0) {
+                options.pure_literals = true;
+            } else if (strcmp (pass, "subsume") == 0) {
+                options.subsumption = true;
+            } else if (strcmp (pass, "eliminate") == 0) {
+                options.variable_elimination = true;
+            } else if (strcmp (pass, "blocked") == 0) {
+                options.blocked_clauses = true;
+            } else if (strcmp (pass, "cardinality") == 0) {
+                options.cardinality = true;
+            } else {
+                g_slist_free (pass_list);
+                Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: passes have to be of \"equivalence\", \"pure\", \"subsume\", \"eliminate\", \"blocked\", \"cardinality\"", -1));
+                return TCL_ERROR;
+            }
+        }
+        g_slist_free (pass_list);
+    }
+
+    options.elim_max_occurrences   = elim_occ;
+    options.elim_max_growth        = elim_growth;
+    options.elim_max_clause_length = elim_length;
+    options.max_steps              = steps;
+
+    sat_problem_set_preprocess (sat, &options);
+
+    return TCL_OK;
+}
+
+/* Tcl command for configuring unit simplification: set_unit_simplification [-enable <bool>] */
+static int sat_shell_command_set_unit_simplification (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    bool enable    = true;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_FUNC, "-enable", (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_bool_parse, (void *) &enable, "enable or disable unit simplification", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    sat_problem_set_unit_simplification (sat, enable);
+
+    return TCL_OK;
+}
+
+/* Tcl command for configuring component splitting: set_split_components [-enable <bool>] [-threads <number>] [-min_vars <number>] */
+static int sat_shell_command_set_split_components (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    bool enable    = true;
+    int n_threads  = 0;
+    int min_vars   = 100;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_FUNC, "-enable",   (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_bool_parse, (void *) &enable,    "enable or disable splitting into components", NULL},
+        {TCL_ARGV_INT,  "-threads",  NULL,                                                 (void *) &n_threads, "number of concurrent solver runs (0: number of processors)", NULL},
+        {TCL_ARGV_INT,  "-min_vars", NULL,                                                 (void *) &min_vars,  "components with less variables are solved together", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if ((n_threads < 0) || (min_vars < 0)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: threads and min_vars must not be negative", -1));
+        return TCL_ERROR;
+    }
+
+    sat_problem_set_split_components (sat, enable, n_threads, min_vars);
+
+    return TCL_OK;
+}
+
+/* Tcl command for configuring symmetry breaking: set_symmetry_breaking [-enable <bool>] [-max_vertices <number>] [-max_generators <number>] */
+static int sat_shell_command_set_symmetry_breaking (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat     = ((struct sat_shell *) client_data)->sat;
+    bool enable        = true;
+    int max_vertices   = 20000;
+    int max_generators = 50;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_FUNC, "-enable",         (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_bool_parse, (void *) &enable,         "enable or disable symmetry breaking", NULL},
+        {TCL_ARGV_INT,  "-max_vertices",   NULL,                                                 (void *) &max_vertices,   "maximum number of literals + clauses for symmetry search", NULL},
+        {TCL_ARGV_INT,  "-max_generators", NULL,                                                 (void *) &max_generators, "maximum number of symmetry generators", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if ((max_vertices < 0) || (max_generators < 0)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: max_vertices and max_generators must not be negative", -1));
+        return TCL_ERROR;
+    }
+
+    sat_problem_set_symmetry_breaking (sat, enable, max_vertices, max_generators);
+
+    return TCL_OK;
+}
+
+/* Tcl command for configuring renumbering: set_renumber [-enable <bool>] */
+static int sat_shell_command_set_renumber (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    bool enable    = true;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_FUNC, "-enable", (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_bool_parse, (void *) &enable, "enable or disable renumbering", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    sat_problem_set_renumber (sat, enable);
+
+    return TCL_OK;
+}
+
+/* Tcl command for configuring XOR constraints: set_xor [-native <bool>] [-cut <number>] [-gauss <bool>] [-gauss_max_bits <number>] */
+static int sat_shell_command_set_xor (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat     = ((struct sat_shell *) client_data)->sat;
+    bool native        = false;
+    int cut            = 4;
+    bool gauss         = true;
+    int gauss_max_bits = 1 << 24;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_FUNC, "-native",         (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_bool_parse, (void *) &native,         "pass XOR constraints natively to the solver", NULL},
+        {TCL_ARGV_INT,  "-cut",            NULL,                                                 (void *) &cut,            "maximum number of literals per XOR encoded as clauses", NULL},
+        {TCL_ARGV_FUNC, "-gauss",          (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_bool_parse, (void *) &gauss,          "enable or disable Gauss-Jordan elimination", NULL},
+        {TCL_ARGV_INT,  "-gauss_max_bits", NULL,                                                 (void *) &gauss_max_bits, "maximum matrix size in bits for Gauss-Jordan elimination", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if ((cut < 3) || (gauss_max_bits < 0)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: cut must be at least 3 and gauss_max_bits must not be negative", -1));
+        return TCL_ERROR;
+    }
+
+    sat_problem_set_xor (sat, native, cut, (gauss ? gauss_max_bits : 0));
+
+    return TCL_OK;
+}
+
+/* Tcl command for configuring lazy encodings: set_lazy_encodings [-enable <bool>] [-min_clauses <number>] */
+static int sat_shell_command_set_lazy_encodings (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat  = ((struct sat_shell *) client_data)->sat;
+    bool enable     = true;
+    int min_clauses = 64;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_FUNC, "-enable",      (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_bool_parse, (void *) &enable,      "enable or disable lazy encodings", NULL},
+        {TCL_ARGV_INT,  "-min_clauses", NULL,                                                 (void *) &min_clauses, "minimum number of clauses of lazy encodings", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (min_clauses < 0) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: min_clauses must not be negative", -1));
+        return TCL_ERROR;
+    }
+
+    sat_problem_set_lazy_encodings (sat, enable, min_clauses);
+
+    return TCL_OK;
+}
+
+/* Tcl command for resetting problem: reset */
+static int sat_shell_command_reset (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    struct sat_shell *shell = (struct sat_shell *) client_data;
+
+    Tcl_ArgvInfo arg_table [] = {
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (shell->sat != NULL) {
+        sat_problem_free (&(shell->sat));
+    }
+    shell->sat = sat_problem_new ();
+
+    if (shell->sat == NULL) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("internal allocation error", -1));
+        return TCL_ERROR;
+    }
+
+    return TCL_OK;
+}
+
+/* Tcl command for verifying current solution: verify_model [-threads <number>] */
+static int sat_shell_command_verify_model (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    int n_threads  = 0;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_INT, "-threads", NULL, (void *) &n_threads, "number of concurrent verification jobs (0: number of processors)", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (n_threads < 0) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: threads must not be negative", -1));
+        return TCL_ERROR;
+    }
+
+    bool error = false;
+    bool verified = sat_problem_verify_model (sat, n_threads, &error);
+
+    if (error) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while verifying model", -1));
+        return TCL_ERROR;
+    }
+
+    Tcl_SetObjResult (interp, Tcl_NewBooleanObj (verified));
+
+    return TCL_OK;
+}
+
+/* Tcl command for cancelling current solution: cancel_solution */
+static int sat_shell_command_cancel_solution (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+
+    Tcl_ArgvInfo arg_table [] = {
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    sat_problem_cancel_solution (sat);
+
+    return TCL_OK;
+}
+
+/* Tcl command for creating checkpoint: push */
+static int sat_shell_command_push (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+
+    Tcl_ArgvInfo arg_table [] = {
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    unsigned int level = sat_problem_push (sat);
+
+    Tcl_SetObjResult (interp, Tcl_NewIntObj (level));
+    return TCL_OK;
+}
+
+/* Tcl command for restoring checkpoint: pop [-levels <number>] */
+static int sat_shell_command_pop (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    int levels     = 1;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_INT, "-levels", NULL, (void *) &levels, "number of checkpoints to restore", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (levels < 0) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("number of levels must not be negative", -1));
+        return TCL_ERROR;
+    }
+
+    if (!sat_problem_pop (sat, levels)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while restoring checkpoint", -1));
+        return TCL_ERROR;
+    }
+
+    Tcl_SetObjResult (interp, Tcl_NewIntObj (sat_problem_scope_level (sat)));
+    return TCL_OK;
+}
+
+/* Tcl command for getting results of variables: get_var_result [-var <var name>] [-assignment <assignment>] */
+static int sat_shell_command_get_var_result (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat       = ((struct sat_shell *) client_data)->sat;
+    const char *var_name = NULL;
+    bool assignment      = true;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-var",        NULL,                                                 (void *) &var_name,   "var name to look up", NULL},
+        {TCL_ARGV_FUNC,     "-assignment", (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_bool_parse, (void *) &assignment, "return list of variables assigned to given value", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (var_name != NULL) {
+        bool error = false;
+        bool retval = sat_problem_var_result (sat, var_name, &error);
+
+        if (error) {
+            Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while looking up variable", -1));
+            return TCL_ERROR;
+        }
+
+        Tcl_SetObjResult (interp, Tcl_NewBooleanObj (retval));
+    } else {
+        bool error = false;
+        GSList *result_list = sat_problem_var_result_list (sat, assignment, &error);
+
+        if (error) {
+            Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while looking up results", -1));
+            return TCL_ERROR;
+        }
+
+        Tcl_Obj *retval = Tcl_NewListObj (0, NULL);
 
         for (GSList *li = result_list; li != NULL; li = li->next) {
             const char *var_name = li->data;
@@ -586,25 +1775,420 @@ static int sat_shell_command_get_var_result (ClientData client_data, Tcl_Interp
             Tcl_ListObjAppendElement (interp, retval, var_obj);
         }
 
-        Tcl_SetObjResult (interp, retval);
+        Tcl_SetObjResult (interp, retval);
+
+        g_slist_free (result_list);
+    }
+
+    return TCL_OK;
+}
+
+/* Tcl command for getting values of bit-vectors: get_bitvector_result -name <bit-vector> [-signed] */
+static int sat_shell_command_get_bitvector_result (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat   = ((struct sat_shell *) client_data)->sat;
+    const char *name = NULL;
+    int is_signed    = false;
+    int int_true     = true;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-name",   NULL,               (void *) &name,      "bit-vector to look up", NULL},
+        {TCL_ARGV_CONSTANT, "-signed", GINT_TO_POINTER (int_true), (void *) &is_signed, "interpret value as two's complement", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (name == NULL) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected a name", -1));
+        return TCL_ERROR;
+    }
+
+    bool error  = false;
+    char *value = sat_problem_bitvector_result (sat, name, is_signed, &error);
+
+    if (error) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while looking up bit-vector", -1));
+        return TCL_ERROR;
+    }
+
+    Tcl_SetObjResult (interp, Tcl_NewStringObj (value, -1));
+    g_free (value);
+
+    return TCL_OK;
+}
+
+/* Tcl command for getting values of integer variables: get_int_result -name <integer variable> */
+static int sat_shell_command_get_int_result (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat   = ((struct sat_shell *) client_data)->sat;
+    const char *name = NULL;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-name", NULL, (void *) &name, "integer variable to look up", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (name == NULL) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected a name", -1));
+        return TCL_ERROR;
+    }
+
+    bool error     = false;
+    long int value = sat_problem_int_result (sat, name, &error);
+
+    if (error) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while looking up integer variable", -1));
+        return TCL_ERROR;
+    }
+
+    Tcl_SetObjResult (interp, Tcl_NewLongObj (value));
+
+    return TCL_OK;
+}
+
+/* Tcl command for getting assumptions responsible for unsatisfiability: get_unsat_core [-groups] */
+static int sat_shell_command_get_unsat_core (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    int groups     = false;
+
+    int int_true = true;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_CONSTANT, "-groups", GINT_TO_POINTER (int_true), (void *) &groups, "return enabled groups instead of assumed literals", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    bool error = false;
+
+    if (groups) {
+        GSList *group_core = sat_problem_failed_groups (sat, &error);
+
+        if (error) {
+            Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while looking up unsat core", -1));
+            return TCL_ERROR;
+        }
+
+        Tcl_Obj *retval = Tcl_NewListObj (0, NULL);
+        for (GSList *li = group_core; li != NULL; li = li->next) {
+            Tcl_ListObjAppendElement (interp, retval, Tcl_NewStringObj ((const char *) li->data, -1));
+        }
+
+        Tcl_SetObjResult (interp, retval);
+        return TCL_OK;
+    }
+
+    GSList *core = sat_problem_failed_assumptions (sat, &error);
+
+    if (error) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while looking up unsat core", -1));
+        return TCL_ERROR;
+    }
+
+    Tcl_Obj *retval   = Tcl_NewListObj (0, NULL);
+    GString *temp_str = g_string_new (NULL);
+
+    for (GSList *li = core; li != NULL; li = li->next) {
+        long int lit = GPOINTER_TO_SIZE (li->data);
+
+        if (lit < 0) {
+            g_string_printf (temp_str, "-%s", sat_problem_get_varname_from_number (sat, -lit));
+        } else {
+            g_string_printf (temp_str, "%s", sat_problem_get_varname_from_number (sat, lit));
+        }
+
+        Tcl_ListObjAppendElement (interp, retval, Tcl_NewStringObj (temp_str->str, -1));
+    }
+
+    g_string_free (temp_str, true);
+
+    Tcl_SetObjResult (interp, retval);
+    return TCL_OK;
+}
+
+/* Tcl command for obtaining mapping of variables: get_var_mapping [-name <var name>] [-number <var number>] */
+static int sat_shell_command_get_var_mapping (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+
+    const char *var_name   = NULL;
+    long int   var_number  = 0;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-name",   NULL, (void *) &var_name,   "var name to look up", NULL},
+        {TCL_ARGV_INT,      "-number", NULL, (void *) &var_number, "var number to look up", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (var_name != NULL) {
+        long int result = sat_problem_get_varnumber_from_name (sat, var_name);
+        if (result == 0) {
+            Tcl_SetObjResult (interp, Tcl_NewStringObj ("unknown variable", -1));
+            return TCL_ERROR;
+        }
+
+        Tcl_SetObjResult (interp, Tcl_NewLongObj (result));
+    } else if (var_number != 0) {
+        const char *result = sat_problem_get_varname_from_number (sat, var_number);
+        if (result == NULL) {
+            Tcl_SetObjResult (interp, Tcl_NewStringObj ("unknown variable", -1));
+            return TCL_ERROR;
+        }
+
+        Tcl_SetObjResult (interp, Tcl_NewStringObj (result, -1));
+    } else {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while lookup up variable", -1));
+        return TCL_ERROR;
+    }
+
+    return TCL_OK;
+}
+
+/* Tcl command for obtaining all clauses: get_clauses */
+static int sat_shell_command_get_clauses (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+
+    Tcl_ArgvInfo arg_table [] = {
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    /* start creating result */
+    Tcl_Obj *retval           = Tcl_NewListObj (0, NULL);
+    GString *temp_str         = g_string_new (NULL);
+    GHashTable *lit_to_tclobj = g_hash_table_new (g_direct_hash, g_direct_equal);
+    GQueue *clause_list        = sat_problem_get_clauses_mapped (sat);
+
+    /* clauses of lazy encodings are expanded temporarily */
+    GQueue *lazy_clause_list = g_queue_new ();
+    sat_problem_append_lazy_clauses_mapped (sat, lazy_clause_list);
+
+    GList *clause_heads[2] = {clause_list->head, lazy_clause_list->head};
+
+    for (int i_list = 0; i_list < 2; i_list++) {
+        for (GList *li = clause_heads[i_list]; li != NULL; li = li->next) {
+            long int *clause = (long int *) li->data;
+            if (clause == NULL) continue;
+
+            Tcl_Obj *tcl_clause = Tcl_NewListObj (0, NULL);
+            for (int i = 0; clause[i] != 0; i++) {
+                long int lit = clause[i];
+
+                Tcl_Obj *lit_obj = NULL;
+                bool exists = g_hash_table_lookup_extended (lit_to_tclobj, GSIZE_TO_POINTER (lit), NULL, (void *) &lit_obj);
+                if (!exists) {
+                    if (lit < 0) {
+                        const char *var_name = sat_problem_get_varname_from_number (sat, -lit);
+                        g_string_printf (temp_str, "-%s", var_name);
+                    } else {
+                        const char *var_name = sat_problem_get_varname_from_number (sat, lit);
+                        g_string_printf (temp_str, "%s", var_name);
+                    }
+                    lit_obj = Tcl_NewStringObj (temp_str->str, -1);
+                    g_hash_table_insert (lit_to_tclobj, GSIZE_TO_POINTER (lit), lit_obj);
+                }
+
+                Tcl_ListObjAppendElement (interp, tcl_clause, lit_obj);
+            }
+            Tcl_ListObjAppendElement (interp, retval, tcl_clause);
+        }
+    }
+
+    /* cleanup and return */
+    while (!g_queue_is_empty (lazy_clause_list)) {
+        long int *clause = g_queue_pop_head (lazy_clause_list);
+        int len = 0;
+        while (clause[len] != 0) len++;
+        g_slice_free1 (sizeof (long int) * (len + 1), clause);
+    }
+    g_queue_free (lazy_clause_list);
+    g_string_free (temp_str, true);
+    g_hash_table_destroy (lit_to_tclobj);
+
+    Tcl_SetObjResult (interp, retval);
+    return TCL_OK;
+}
+
+/* Tcl command for computing backbone: get_backbone [-tempfile_base <prefix>] [-solver_binary <binary>] [-solution_on_stdout] [-tempfile_clean|-tempfile_keep]
+ *                                                 [-compress_cnf|-plain_cnf] [-enable <groups>] [-disable <groups>] [-threads <n>] */
+static int sat_shell_command_get_backbone (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    if (((struct sat_shell *) client_data)->replay) return sat_shell_replay_stop (client_data, interp);
+
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    const char *tmp_file_basename = "tmp_cnf";
+    const char *solver_bin        = "minisat";
+    int solution_on_stdout        = false;
+    int cleanup                   = true;
+    int cnf_gz                    = true;
+    GSList *enable_groups         = NULL;
+    GSList *disable_groups        = NULL;
+    int n_threads                 = 0;
+
+    int int_true  = true;
+    int int_false = false;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-tempfile_base",      NULL,                        (void *) &tmp_file_basename,  "filenames for cnf and solution are based on this name +suffixes", NULL},
+        {TCL_ARGV_STRING,   "-solver_binary",      NULL,                        (void *) &solver_bin,         "executable of sat solver", NULL},
+        {TCL_ARGV_CONSTANT, "-solution_on_stdout", (void *) &int_true,          (void *) &solution_on_stdout, "solver prints solution to stdout instead of a file", NULL},
+        {TCL_ARGV_CONSTANT, "-tempfile_clean",     GINT_TO_POINTER (int_true),  (void *) &cleanup,            "remove temporary files after solving", NULL},
+        {TCL_ARGV_CONSTANT, "-tempfile_keep",      GINT_TO_POINTER (int_false), (void *) &cleanup,            "keep temporary files after solving", NULL},
+        {TCL_ARGV_CONSTANT, "-compress_cnf",       GINT_TO_POINTER (int_true),  (void *) &cnf_gz,             "compress cnf file", NULL},
+        {TCL_ARGV_CONSTANT, "-plain_cnf",          GINT_TO_POINTER (int_false), (void *) &cnf_gz,             "do not compress cnf file", NULL},
+        {TCL_ARGV_FUNC,     "-enable",             (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &enable_groups,  "list of groups enabled for this run (default: all)", NULL},
+        {TCL_ARGV_FUNC,     "-disable",            (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &disable_groups, "list of groups disabled for this run", NULL},
+        {TCL_ARGV_INT,      "-threads",            NULL,                        (void *) &n_threads,          "number of concurrent solver runs (default: number of processors)", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (n_threads < 0) {
+        g_slist_free (enable_groups);
+        g_slist_free (disable_groups);
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: number of threads must not be negative", -1));
+        return TCL_ERROR;
+    }
+
+    bool error = false;
+    GSList *backbone = sat_problem_backbone (sat, tmp_file_basename, solver_bin, solution_on_stdout, cleanup, cnf_gz, enable_groups, disable_groups,
+                                             n_threads, &error);
+
+    g_slist_free (enable_groups);
+    g_slist_free (disable_groups);
+
+    if (error) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while computing backbone", -1));
+        return TCL_ERROR;
+    }
+
+    Tcl_Obj *retval   = Tcl_NewListObj (0, NULL);
+    GString *temp_str = g_string_new (NULL);
+
+    for (GSList *li = backbone; li != NULL; li = li->next) {
+        long int lit = GPOINTER_TO_SIZE (li->data);
+
+        if (lit < 0) {
+            g_string_printf (temp_str, "-%s", sat_problem_get_varname_from_number (sat, -lit));
+        } else {
+            g_string_printf (temp_str, "%s", sat_problem_get_varname_from_number (sat, lit));
+        }
+
+        Tcl_ListObjAppendElement (interp, retval, Tcl_NewStringObj (temp_str->str, -1));
+    }
+
+    g_string_free (temp_str, true);
+    g_slist_free (backbone);
+
+    Tcl_SetObjResult (interp, retval);
+    return TCL_OK;
+}
+
+/* solution function for enumerate_solutions */
+static bool sat_shell_enumerate_solution_func (const long int *solution, gpointer user_data)
+{
+    struct sat_shell_enumerate_data *data = user_data;
+
+    Tcl_Obj *lit_list = NULL;
+    if (data->command != NULL) {
+        lit_list = Tcl_NewListObj (0, NULL);
+    }
+
+    for (int i = 0; solution[i] != 0; i++) {
+        long int lit = solution[i];
+
+        if (lit < 0) {
+            g_string_printf (data->temp_str, "-%s", sat_problem_get_varname_from_number (data->sat, -lit));
+        } else {
+            g_string_printf (data->temp_str, "%s", sat_problem_get_varname_from_number (data->sat, lit));
+        }
+
+        if (data->file != NULL) {
+            fprintf (data->file, (i == 0 ? "%s" : " %s"), data->temp_str->str);
+        }
+        if (lit_list != NULL) {
+            Tcl_ListObjAppendElement (data->interp, lit_list, Tcl_NewStringObj (data->temp_str->str, -1));
+        }
+    }
 
-        g_slist_free (result_list);
+    if (data->file != NULL) {
+        fprintf (data->file, "\n");
     }
 
-    return TCL_OK;
+    if (data->command != NULL) {
+        Tcl_Obj *cmd = Tcl_DuplicateObj (data->command);
+        Tcl_IncrRefCount (cmd);
+        Tcl_ListObjAppendElement (data->interp, cmd, lit_list);
+
+        data->command_result = Tcl_EvalObjEx (data->interp, cmd, TCL_EVAL_GLOBAL);
+        Tcl_DecrRefCount (cmd);
+
+        if (data->command_result != TCL_OK) return false;
+    }
+
+    return true;
 }
 
-/* Tcl command for obtaining mapping of variables: get_var_mapping [-name <var name>] [-number <var number>] */
-static int sat_shell_command_get_var_mapping (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+/* Tcl command for enumerating solutions: enumerate_solutions [-vars <list of variables>] [-limit <n>] [-file <filename>] [-command <command prefix>]
+ *                                                       [-tempfile_base <prefix>] [-solver_binary <binary>] [-solution_on_stdout]
+ *                                                       [-tempfile_clean|-tempfile_keep] [-compress_cnf|-plain_cnf]
+ *                                                       [-enable <groups>] [-disable <groups>] */
+static int sat_shell_command_enumerate_solutions (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
 {
+    if (((struct sat_shell *) client_data)->replay) return sat_shell_replay_stop (client_data, interp);
+
     SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    GSList *var_list              = NULL;
+    int limit                     = 0;
+    const char *file_name         = NULL;
+    const char *command           = NULL;
+    const char *tmp_file_basename = "tmp_cnf";
+    const char *solver_bin        = "minisat";
+    int solution_on_stdout        = false;
+    int cleanup                   = true;
+    int cnf_gz                    = true;
+    GSList *enable_groups         = NULL;
+    GSList *disable_groups        = NULL;
 
-    const char *var_name   = NULL;
-    long int   var_number  = 0;
+    int int_true  = true;
+    int int_false = false;
 
     Tcl_ArgvInfo arg_table [] = {
-        {TCL_ARGV_STRING,   "-name",   NULL, (void *) &var_name,   "var name to look up", NULL},
-        {TCL_ARGV_INT,      "-number", NULL, (void *) &var_number, "var number to look up", NULL},
+        {TCL_ARGV_FUNC,     "-vars",               (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &var_list, "variables to project solutions on (default: all named variables)", NULL},
+        {TCL_ARGV_INT,      "-limit",              NULL,                        (void *) &limit,              "maximum number of solutions (default: no limit)", NULL},
+        {TCL_ARGV_STRING,   "-file",               NULL,                        (void *) &file_name,          "file to write solutions to, one solution per line", NULL},
+        {TCL_ARGV_STRING,   "-command",            NULL,                        (void *) &command,            "command prefix called with list of literals of each solution - stops on break", NULL},
+        {TCL_ARGV_STRING,   "-tempfile_base",      NULL,                        (void *) &tmp_file_basename,  "filenames for cnf and solution are based on this name +suffixes", NULL},
+        {TCL_ARGV_STRING,   "-solver_binary",      NULL,                        (void *) &solver_bin,         "executable of sat solver", NULL},
+        {TCL_ARGV_CONSTANT, "-solution_on_stdout", (void *) &int_true,          (void *) &solution_on_stdout, "solver prints solution to stdout instead of a file", NULL},
+        {TCL_ARGV_CONSTANT, "-tempfile_clean",     GINT_TO_POINTER (int_true),  (void *) &cleanup,            "remove temporary files after solving", NULL},
+        {TCL_ARGV_CONSTANT, "-tempfile_keep",      GINT_TO_POINTER (int_false), (void *) &cleanup,            "keep temporary files after solving", NULL},
+        {TCL_ARGV_CONSTANT, "-compress_cnf",       GINT_TO_POINTER (int_true),  (void *) &cnf_gz,             "compress cnf file", NULL},
+        {TCL_ARGV_CONSTANT, "-plain_cnf",          GINT_TO_POINTER (int_false), (void *) &cnf_gz,             "do not compress cnf file", NULL},
+        {TCL_ARGV_FUNC,     "-enable",             (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &enable_groups,  "list of groups enabled for this run (default: all)", NULL},
+        {TCL_ARGV_FUNC,     "-disable",            (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &disable_groups, "list of groups disabled for this run", NULL},
         TCL_ARGV_AUTO_HELP,
         TCL_ARGV_TABLE_END
     };
@@ -612,36 +2196,365 @@ static int sat_shell_command_get_var_mapping (ClientData client_data, Tcl_Interp
     int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
     if (result != TCL_OK) return result;
 
-    if (var_name != NULL) {
-        long int result = sat_problem_get_varnumber_from_name (sat, var_name);
-        if (result == 0) {
-            Tcl_SetObjResult (interp, Tcl_NewStringObj ("unknown variable", -1));
+    if (limit < 0) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: limit must not be negative", -1));
+        g_slist_free (var_list);
+        g_slist_free (enable_groups);
+        g_slist_free (disable_groups);
+        return TCL_ERROR;
+    }
+
+    struct sat_shell_enumerate_data data = {interp, sat, NULL, NULL, TCL_OK, NULL};
+
+    if (command != NULL) {
+        data.command = Tcl_NewStringObj (command, -1);
+        Tcl_IncrRefCount (data.command);
+    }
+
+    if (file_name != NULL) {
+        data.file = fopen (file_name, "w");
+        if (data.file == NULL) {
+            Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: could not open output file", -1));
+            g_slist_free (var_list);
+            g_slist_free (enable_groups);
+            g_slist_free (disable_groups);
             return TCL_ERROR;
         }
+    }
+    data.temp_str = g_string_new (NULL);
 
-        Tcl_SetObjResult (interp, Tcl_NewLongObj (result));
-    } else if (var_number != 0) {
-        const char *result = sat_problem_get_varname_from_number (sat, var_number);
-        if (result == NULL) {
-            Tcl_SetObjResult (interp, Tcl_NewStringObj ("unknown variable", -1));
+    long int n_solutions = sat_problem_enumerate_solutions (sat, var_list, limit, tmp_file_basename, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                                            enable_groups, disable_groups, sat_shell_enumerate_solution_func, &data);
+
+    if (data.file != NULL) fclose (data.file);
+    if (data.command != NULL) Tcl_DecrRefCount (data.command);
+    g_string_free (data.temp_str, true);
+    g_slist_free (var_list);
+    g_slist_free (enable_groups);
+    g_slist_free (disable_groups);
+
+    if ((data.command_result != TCL_OK) && (data.command_result != TCL_BREAK)) {
+        return data.command_result;
+    }
+    if (n_solutions < 0) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while enumerating solutions", -1));
+        return TCL_ERROR;
+    }
+
+    Tcl_SetObjResult (interp, Tcl_NewLongObj (n_solutions));
+    return TCL_OK;
+}
+
+/* Tcl command for minimizing objectives: optimize [-objectives <objectives as list>] [-timeout <seconds>]
+ *                                                 [-tempfile_base <prefix>] [-solver_binary <binary>] [-solution_on_stdout]
+ *                                                 [-tempfile_clean|-tempfile_keep] [-compress_cnf|-plain_cnf] */
+static int sat_shell_command_optimize (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    if (((struct sat_shell *) client_data)->replay) return sat_shell_replay_stop (client_data, interp);
+
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    GSList *objective_list        = NULL;
+    double timeout                = 0;
+    const char *tmp_file_basename = "tmp_cnf";
+    const char *solver_bin        = "minisat";
+    int solution_on_stdout        = false;
+    int cleanup                   = true;
+    int cnf_gz                    = true;
+
+    int int_true  = true;
+    int int_false = false;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_FUNC,     "-objectives",         (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &objective_list, "objectives in order of priority (default: all in order of their first soft clause)", NULL},
+        {TCL_ARGV_FLOAT,    "-timeout",            NULL,                        (void *) &timeout,            "time budget in seconds, the best model found is kept (default: 0 - no limit)", NULL},
+        {TCL_ARGV_STRING,   "-tempfile_base",      NULL,                        (void *) &tmp_file_basename,  "filenames for cnf and solution are based on this name +suffixes", NULL},
+        {TCL_ARGV_STRING,   "-solver_binary",      NULL,                        (void *) &solver_bin,         "executable of sat solver", NULL},
+        {TCL_ARGV_CONSTANT, "-solution_on_stdout", (void *) &int_true,          (void *) &solution_on_stdout, "solver prints solution to stdout instead of a file", NULL},
+        {TCL_ARGV_CONSTANT, "-tempfile_clean",     GINT_TO_POINTER (int_true),  (void *) &cleanup,            "remove temporary files after solving", NULL},
+        {TCL_ARGV_CONSTANT, "-tempfile_keep",      GINT_TO_POINTER (int_false), (void *) &cleanup,            "keep temporary files after solving", NULL},
+        {TCL_ARGV_CONSTANT, "-compress_cnf",       GINT_TO_POINTER (int_true),  (void *) &cnf_gz,             "compress cnf file", NULL},
+        {TCL_ARGV_CONSTANT, "-plain_cnf",          GINT_TO_POINTER (int_false), (void *) &cnf_gz,             "do not compress cnf file", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (timeout < 0) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: timeout must not be negative", -1));
+        g_slist_free (objective_list);
+        return TCL_ERROR;
+    }
+    if (objective_list == NULL) objective_list = sat_problem_objectives (sat);
+
+    guint n_objectives = g_slist_length (objective_list);
+    long int *costs = g_new0 (long int, n_objectives + 1);
+    bool optimal = false;
+
+    bool success = sat_problem_optimize (sat, objective_list, tmp_file_basename, solver_bin, solution_on_stdout, cleanup, cnf_gz,
+                                         timeout, costs, &optimal);
+    g_slist_free (objective_list);
+
+    bool error = false;
+    bool satisfiable = (success ? sat_problem_satisfiable (sat, &error) : false);
+
+    if (!success || error) {
+        g_free (costs);
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while optimizing sat-problem", -1));
+        return TCL_ERROR;
+    }
+
+    Tcl_Obj *cost_list = Tcl_NewListObj (0, NULL);
+    for (guint i = 0; satisfiable && (i < n_objectives); i++) {
+        Tcl_ListObjAppendElement (interp, cost_list, Tcl_NewLongObj (costs[i]));
+    }
+    g_free (costs);
+
+    Tcl_Obj *retval = Tcl_NewDictObj ();
+    Tcl_DictObjPut (interp, retval, Tcl_NewStringObj ("satisfiable", -1), Tcl_NewBooleanObj (satisfiable));
+    Tcl_DictObjPut (interp, retval, Tcl_NewStringObj ("optimal", -1), Tcl_NewBooleanObj (optimal));
+    Tcl_DictObjPut (interp, retval, Tcl_NewStringObj ("costs", -1), cost_list);
+
+    Tcl_SetObjResult (interp, retval);
+    return TCL_OK;
+}
+
+/* Tcl command for writing weighted cnf: write_wcnf -file <filename> [-objectives <objectives as list>] */
+static int sat_shell_command_write_wcnf (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    GSList *objective_list = NULL;
+    const char *file_name  = NULL;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-file",       NULL,                                                        (void *) &file_name,      "file to write weighted cnf to", NULL},
+        {TCL_ARGV_FUNC,     "-objectives", (void*) (Tcl_ArgvFuncProc*) sat_shell_tcl_string_list_parse, (void *) &objective_list, "objectives in order of priority (default: all in order of their first soft clause)", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    if (file_name == NULL) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected a file", -1));
+        g_slist_free (objective_list);
+        return TCL_ERROR;
+    }
+    if (objective_list == NULL) objective_list = sat_problem_objectives (sat);
+
+    bool success = sat_problem_write_wcnf (sat, objective_list, file_name);
+    g_slist_free (objective_list);
+
+    if (!success) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while writing weighted cnf", -1));
+        return TCL_ERROR;
+    }
+
+    return TCL_OK;
+}
+
+/* variant of the clause encodings of a script timed by tune_encodings */
+struct sat_shell_tune_variant {
+    /* class using alternative, alternative NULL for the encodings chosen by the script */
+    SatTuneClass      tune_class;
+    const char        *alternative;
+    unsigned long int n_vars;
+    unsigned long int n_clauses;
+    /* replay stopped by the clause limit */
+    bool              too_large;
+};
+
+/* return profile as Tcl list of class, encoding pairs */
+static Tcl_Obj * sat_shell_profile_list (Tcl_Interp *interp, SatTuneProfile profile)
+{
+    Tcl_Obj *retval = Tcl_NewListObj (0, NULL);
+
+    for (SatTuneClass tune_class = 0; tune_class < SAT_TUNE_N_CLASSES; tune_class++) {
+        const char *encoding = sat_tune_profile_get (profile, tune_class);
+        if (encoding == NULL) continue;
+
+        Tcl_ListObjAppendElement (interp, retval, Tcl_NewStringObj (sat_tune_class_name (tune_class), -1));
+        Tcl_ListObjAppendElement (interp, retval, Tcl_NewStringObj (encoding, -1));
+    }
+
+    return retval;
+}
+
+/* stop replay of a script at a solving command */
+static int sat_shell_replay_stop (struct sat_shell *shell, Tcl_Interp *interp)
+{
+    shell->replay_stopped = true;
+
+    Tcl_SetObjResult (interp, Tcl_NewStringObj ("replay of script stopped by tune_encodings", -1));
+    return TCL_ERROR;
+}
+
+/* replay script in a new interpreter on a new problem with clause encodings of profile (NULL: encodings chosen
+ * by the script) until the first solving command and return the shell holding the problem. returns NULL if
+ * the script failed or the problem exceeded max_clauses clauses (0: no limit), in which case *too_large is set. */
+static struct sat_shell * sat_shell_replay (const char *script, SatTuneProfile profile, unsigned long int max_clauses, bool *too_large)
+{
+    *too_large = false;
+
+    struct sat_shell *shell = g_slice_new0 (struct sat_shell);
+
+    shell->sat     = sat_problem_new ();
+    shell->profile = sat_tune_profile_new ();
+    sat_tune_profile_copy (shell->profile, profile);
+
+    shell->replay             = true;
+    shell->replay_max_clauses = max_clauses;
+
+    Tcl_Interp *interp = Tcl_CreateInterp ();
+    Tcl_Init (interp);
+
+    for (struct sat_shell_command_data *di = &sat_shell_command_data_list[0]; di->command != NULL; di++) {
+        Tcl_CreateObjCommand (interp, di->command, di->proc, (ClientData) shell, NULL);
+    }
+
+    int result = Tcl_EvalFile (interp, script);
+    bool failed = ((result != TCL_OK) && !shell->replay_stopped);
+
+    if (failed) {
+        printf ("ERROR: script %s failed: %s\n", script, Tcl_GetStringResult (interp));
+    }
+    Tcl_DeleteInterp (interp);
+
+    *too_large = shell->replay_too_large;
+    if (failed || shell->replay_too_large) {
+        sat_shell_free (&shell);
+        return NULL;
+    }
+
+    return shell;
+}
+
+/* Tcl command for the clause encodings of add_encoding per constraint class:
+ * set_encoding_profile [-clear] [-file <profile file>] [-class <class> -encoding <encoding>] */
+static int sat_shell_command_set_encoding_profile (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    struct sat_shell *shell = client_data;
+    const char *file_name  = NULL;
+    const char *class_name = NULL;
+    const char *encoding   = NULL;
+    int clear              = false;
+
+    int int_true = true;
+
+    Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_CONSTANT, "-clear",    GINT_TO_POINTER (int_true), (void *) &clear,      "remove all entries: encodings chosen by scripts are used", NULL},
+        {TCL_ARGV_STRING,   "-file",     NULL,                       (void *) &file_name,  "read entries from profile file (e.g. written by tune_encodings)", NULL},
+        {TCL_ARGV_STRING,   "-class",    NULL,                       (void *) &class_name, "constraint class: \"1ofn\", \"mofn\" or \"pb\"", NULL},
+        {TCL_ARGV_STRING,   "-encoding", NULL,                       (void *) &encoding,   "clause encoding of the class or \"script\" for the encodings chosen by scripts", NULL},
+        TCL_ARGV_AUTO_HELP,
+        TCL_ARGV_TABLE_END
+    };
+
+    int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
+    if (result != TCL_OK) return result;
+
+    /* profile of a replayed script is given by tune_encodings */
+    if (shell->replay) {
+        Tcl_SetObjResult (interp, sat_shell_profile_list (interp, shell->profile));
+        return TCL_OK;
+    }
+
+    SatTuneClass tune_class = SAT_TUNE_1OFN;
+    if ((class_name != NULL) && !sat_tune_class_from_string (class_name, &tune_class)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: class has to be one of \"1ofn\", \"mofn\", \"pb\"", -1));
+        return TCL_ERROR;
+    }
+    if ((class_name == NULL) != (encoding == NULL)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected -class together with -encoding", -1));
+        return TCL_ERROR;
+    }
+    if ((encoding != NULL) && (strcmp (encoding, "script") != 0)) {
+        SatTuneProfile test = sat_tune_profile_new ();
+        bool valid = sat_tune_profile_set (test, tune_class, encoding);
+        sat_tune_profile_free (&test);
+
+        if (!valid) {
+            GString *error = g_string_new (NULL);
+            g_string_printf (error, "error: encoding of class \"%s\" has to be one of \"script\"", class_name);
+            for (const char * const *ai = sat_tune_class_alternatives (tune_class); *ai != NULL; ai++) {
+                g_string_append_printf (error, ", \"%s\"", *ai);
+            }
+            Tcl_SetObjResult (interp, Tcl_NewStringObj (error->str, -1));
+            g_string_free (error, true);
             return TCL_ERROR;
         }
+    }
 
-        Tcl_SetObjResult (interp, Tcl_NewStringObj (result, -1));
-    } else {
-        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while lookup up variable", -1));
+    if (clear) {
+        for (SatTuneClass ci = 0; ci < SAT_TUNE_N_CLASSES; ci++) sat_tune_profile_set (shell->profile, ci, NULL);
+    }
+    if ((file_name != NULL) && !sat_tune_profile_read (shell->profile, file_name)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while reading profile", -1));
         return TCL_ERROR;
     }
+    if (encoding != NULL) {
+        sat_tune_profile_set (shell->profile, tune_class, (strcmp (encoding, "script") == 0 ? NULL : encoding));
+    }
+
+    Tcl_SetObjResult (interp, sat_shell_profile_list (interp, shell->profile));
 
     return TCL_OK;
 }
 
-/* Tcl command for obtaining all clauses: get_clauses */
-static int sat_shell_command_get_clauses (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+/* print result line of a variant of tune_encodings */
+static void sat_shell_tune_print (const struct sat_shell_tune_variant *variant, const struct sat_tune_run *run)
 {
-    SatProblem sat = ((struct sat_shell *) client_data)->sat;
+    const char *class_name = (variant->alternative == NULL ? "-" : sat_tune_class_name (variant->tune_class));
+    const char *encoding   = (variant->alternative == NULL ? "script" : variant->alternative);
+
+    if (variant->too_large) {
+        printf ("INFO: %-5s %-13s too large\n", class_name, encoding);
+        return;
+    }
+
+    const char *status = "error";
+    if (!run->error) {
+        status = (run->timed_out ? "timeout" : (run->satisfiable ? "satisfiable" : "unsatisfiable"));
+    }
+
+    printf ("INFO: %-5s %-13s %10lu variables %10lu clauses   %-13s %8.3f s\n",
+            class_name, encoding, variant->n_vars, variant->n_clauses, status, run->seconds);
+}
+
+/* Tcl command for tuning clause encodings: tune_encodings -script <file> [-timeout <seconds>] [-threads <number>] [-max_growth <factor>]
+ *                                         [-profile <file>] [-tempfile_base <prefix>] [-solver_binary <binary>] [-solution_on_stdout]
+ *                                         [-compress_cnf|-plain_cnf] */
+static int sat_shell_command_tune_encodings (ClientData client_data, Tcl_Interp *interp, int objc, Tcl_Obj *const objv[])
+{
+    struct sat_shell *shell = client_data;
+    if (shell->replay) return sat_shell_replay_stop (shell, interp);
+
+    const char *script            = NULL;
+    double timeout                = 10;
+    int n_threads                 = 0;
+    int max_growth                = 8;
+    const char *profile_file      = NULL;
+    const char *tmp_file_basename = "tmp_cnf";
+    const char *solver_bin        = "minisat";
+    int solution_on_stdout        = false;
+    int cnf_gz                    = true;
+
+    int int_true  = true;
+    int int_false = false;
 
     Tcl_ArgvInfo arg_table [] = {
+        {TCL_ARGV_STRING,   "-script",             NULL,                        (void *) &script,             "script building the problem, replayed until its first solving command", NULL},
+        {TCL_ARGV_FLOAT,    "-timeout",            NULL,                        (void *) &timeout,            "solver runs are stopped after this number of seconds (default: 10, 0: no limit)", NULL},
+        {TCL_ARGV_INT,      "-threads",            NULL,                        (void *) &n_threads,          "number of concurrent solver runs (0: number of processors)", NULL},
+        {TCL_ARGV_INT,      "-max_growth",         NULL,                        (void *) &max_growth,         "alternatives with more than this factor of clauses are skipped (default: 8, 0: no limit)", NULL},
+        {TCL_ARGV_STRING,   "-profile",            NULL,                        (void *) &profile_file,       "write tuned profile to this file (see set_encoding_profile)", NULL},
+        {TCL_ARGV_STRING,   "-tempfile_base",      NULL,                        (void *) &tmp_file_basename,  "filenames for cnf and solution are based on this name +suffixes", NULL},
+        {TCL_ARGV_STRING,   "-solver_binary",      NULL,                        (void *) &solver_bin,         "executable of sat solver", NULL},
+        {TCL_ARGV_CONSTANT, "-solution_on_stdout", (void *) &int_true,          (void *) &solution_on_stdout, "solver prints solution to stdout instead of a file", NULL},
+        {TCL_ARGV_CONSTANT, "-compress_cnf",       GINT_TO_POINTER (int_true),  (void *) &cnf_gz,             "compress cnf file", NULL},
+        {TCL_ARGV_CONSTANT, "-plain_cnf",          GINT_TO_POINTER (int_false), (void *) &cnf_gz,             "do not compress cnf file", NULL},
         TCL_ARGV_AUTO_HELP,
         TCL_ARGV_TABLE_END
     };
@@ -649,45 +2562,159 @@ static int sat_shell_command_get_clauses (ClientData client_data, Tcl_Interp *in
     int result = Tcl_ParseArgsObjv (interp, arg_table, &objc, objv, NULL);
     if (result != TCL_OK) return result;
 
-    /* start creating result */
-    Tcl_Obj *retval           = Tcl_NewListObj (0, NULL);
-    GString *temp_str         = g_string_new (NULL);
-    GHashTable *lit_to_tclobj = g_hash_table_new (g_direct_hash, g_direct_equal);
-    GQueue *clause_list        = sat_problem_get_clauses_mapped (sat);
+    if (script == NULL) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: expected a script", -1));
+        return TCL_ERROR;
+    }
+    if ((timeout < 0) || (n_threads < 0) || (max_growth < 0)) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error: timeout, threads and max_growth must not be negative", -1));
+        return TCL_ERROR;
+    }
+    if (n_threads == 0) n_threads = g_get_num_processors ();
 
-    for (GList *li = clause_list->head; li != NULL; li = li->next) {
-        long int *clause = (long int *) li->data;
-        if (clause == NULL) continue;
-
-        Tcl_Obj *tcl_clause = Tcl_NewListObj (0, NULL);
-        for (int i = 0; clause[i] != 0; i++) {
-            long int lit = clause[i];
-
-            Tcl_Obj *lit_obj = NULL;
-            bool exists = g_hash_table_lookup_extended (lit_to_tclobj, GSIZE_TO_POINTER (lit), NULL, (void *) &lit_obj);
-            if (!exists) {
-                if (lit < 0) {
-                    const char *var_name = sat_problem_get_varname_from_number (sat, -lit);
-                    g_string_printf (temp_str, "-%s", var_name);
-                } else {
-                    const char *var_name = sat_problem_get_varname_from_number (sat, lit);
-                    g_string_printf (temp_str, "%s", var_name);
-                }
-                lit_obj = Tcl_NewStringObj (temp_str->str, -1);
-                g_hash_table_insert (lit_to_tclobj, GSIZE_TO_POINTER (lit), lit_obj);
+    /* recording run with the encodings chosen by the script */
+    bool too_large = false;
+    struct sat_shell *recorded = sat_shell_replay (script, NULL, 0, &too_large);
+    if (recorded == NULL) {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while replaying script", -1));
+        return TCL_ERROR;
+    }
+
+    struct sat_tune_record record = recorded->record;
+
+    GString *line = g_string_new (NULL);
+    g_string_printf (line, "tuning encodings of %s:", script);
+    for (SatTuneClass tune_class = 0; tune_class < SAT_TUNE_N_CLASSES; tune_class++) {
+        g_string_append_printf (line, "%s %s: %lu constraints (%lu literals)", (tune_class > 0 ? "," : ""),
+                                sat_tune_class_name (tune_class), record.n_constraints[tune_class], record.n_lits[tune_class]);
+    }
+    printf ("INFO: %s\n", line->str);
+
+    /* variants: encodings of the script, then each alternative of each recorded class */
+    GArray *variants = g_array_new (false, true, sizeof (struct sat_shell_tune_variant));
+    struct sat_shell_tune_variant variant = {SAT_TUNE_1OFN, NULL, 0, 0, false};
+    g_array_append_val (variants, variant);
+
+    for (SatTuneClass tune_class = 0; tune_class < SAT_TUNE_N_CLASSES; tune_class++) {
+        if (record.n_constraints[tune_class] == 0) continue;
+
+        for (const char * const *ai = sat_tune_class_alternatives (tune_class); *ai != NULL; ai++) {
+            variant.tune_class  = tune_class;
+            variant.alternative = *ai;
+            g_array_append_val (variants, variant);
+        }
+    }
+
+    unsigned long int n_vars;
+    unsigned long int n_clauses;
+    sat_problem_size (recorded->sat, &n_vars, &n_clauses);
+    unsigned long int max_clauses = (max_growth > 0 ? MAX (n_clauses, 1000UL) * max_growth : 0);
+
+    printf ("INFO: timing %u variants by %d concurrent solver runs", variants->len, n_threads);
+    if (timeout > 0) printf (" stopped after %g s", timeout);
+    printf ("...\n");
+
+    /* batches of concurrent runs */
+    struct sat_tune_run *runs = g_new0 (struct sat_tune_run, variants->len);
+    struct sat_shell **shells = g_new0 (struct sat_shell *, n_threads);
+    SatTuneProfile profile = sat_tune_profile_new ();
+
+    for (guint first = 0; first < variants->len; first += n_threads) {
+        guint n_batch = MIN ((guint) n_threads, variants->len - first);
+
+        for (guint i = 0; i < n_batch; i++) {
+            struct sat_shell_tune_variant *vi = &g_array_index (variants, struct sat_shell_tune_variant, first + i);
+
+            if (vi->alternative == NULL) {
+                shells[i] = recorded;
+                recorded  = NULL;
+            } else {
+                sat_tune_profile_set (profile, vi->tune_class, vi->alternative);
+                shells[i] = sat_shell_replay (script, profile, max_clauses, &(vi->too_large));
+                sat_tune_profile_set (profile, vi->tune_class, NULL);
             }
 
-            Tcl_ListObjAppendElement (interp, tcl_clause, lit_obj);
+            runs[first + i].sat   = (shells[i] != NULL ? shells[i]->sat : NULL);
+            runs[first + i].error = (shells[i] == NULL);
+            if (shells[i] != NULL) sat_problem_size (shells[i]->sat, &(vi->n_vars), &(vi->n_clauses));
+        }
+
+        sat_tune_solve (&(runs[first]), n_batch, tmp_file_basename, solver_bin, solution_on_stdout, cnf_gz, timeout, n_threads);
+
+        for (guint i = 0; i < n_batch; i++) {
+            sat_shell_tune_print (&g_array_index (variants, struct sat_shell_tune_variant, first + i), &(runs[first + i]));
+            runs[first + i].sat = NULL;
+            if (shells[i] != NULL) sat_shell_free (&(shells[i]));
         }
-        Tcl_ListObjAppendElement (interp, retval, tcl_clause);
     }
 
-    /* cleanup and return */
-    g_string_free (temp_str, true);
-    g_hash_table_destroy (lit_to_tclobj);
+    /* fastest alternative per class, results have to agree with the encodings of the script */
+    const struct sat_tune_run *script_run = &(runs[0]);
+    bool script_finished = !script_run->error && !script_run->timed_out;
 
-    Tcl_SetObjResult (interp, retval);
-    return TCL_OK;
+    GPtrArray *comments = g_ptr_array_new_with_free_func (g_free);
+    g_ptr_array_add (comments, g_strdup_printf ("encoding profile of %s written by tune_encodings", script));
+
+    g_string_assign (line, "tuned encodings:");
+    for (SatTuneClass tune_class = 0; tune_class < SAT_TUNE_N_CLASSES; tune_class++) {
+        if (record.n_constraints[tune_class] == 0) continue;
+
+        const struct sat_tune_run *best = (script_finished ? script_run : NULL);
+        const char *best_alternative = NULL;
+
+        for (guint i = 1; i < variants->len; i++) {
+            const struct sat_shell_tune_variant *vi = &g_array_index (variants, struct sat_shell_tune_variant, i);
+            const struct sat_tune_run *run = &(runs[i]);
+
+            if (vi->tune_class != tune_class) continue;
+            if (vi->too_large || run->error || run->timed_out) continue;
+            if (script_finished && (run->satisfiable != script_run->satisfiable)) {
+                printf ("ERROR: result of %s encoding %s differs from encodings of script\n", sat_tune_class_name (tune_class), vi->alternative);
+                continue;
+            }
+            if ((best == NULL) || (run->seconds < best->seconds)) {
+                best             = run;
+                best_alternative = vi->alternative;
+            }
+        }
+
+        sat_tune_profile_set (profile, tune_class, best_alternative);
+
+        char *result_str;
+        if (best == NULL) {
+            result_str = g_strdup_printf ("%s: script (no run finished)", sat_tune_class_name (tune_class));
+        } else if (script_finished) {
+            result_str = g_strdup_printf ("%s: %s (%.3f s, script: %.3f s)", sat_tune_class_name (tune_class),
+                                          (best_alternative == NULL ? "script" : best_alternative), best->seconds, script_run->seconds);
+        } else {
+            result_str = g_strdup_printf ("%s: %s (%.3f s, script: timeout)", sat_tune_class_name (tune_class),
+                                          best_alternative, best->seconds);
+        }
+        g_string_append_printf (line, "%s %s", (comments->len > 1 ? "," : ""), result_str);
+        g_ptr_array_add (comments, result_str);
+    }
+    printf ("INFO: %s\n", line->str);
+    g_ptr_array_add (comments, NULL);
+
+    bool success = true;
+    if (profile_file != NULL) {
+        success = sat_tune_profile_write (profile, profile_file, (const char * const *) comments->pdata);
+    }
+
+    if (success) {
+        Tcl_SetObjResult (interp, sat_shell_profile_list (interp, profile));
+    } else {
+        Tcl_SetObjResult (interp, Tcl_NewStringObj ("error while writing profile", -1));
+    }
+
+    g_ptr_array_free (comments, true);
+    g_string_free (line, true);
+    sat_tune_profile_free (&profile);
+    g_free (shells);
+    g_free (runs);
+    g_array_free (variants, true);
+
+    return (success ? TCL_OK : TCL_ERROR);
 }
 
 /* Tcl command for printing help */
@@ -0,0 +1,598 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sat_symmetry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* budget of the search in visited vertices + edges during refinement */
+#define SAT_SYMMETRY_MAX_WORK 200000000UL
+
+/* symmetry search data struct.
+ * the graph has a vertex for each literal (2 * (var - 1) positive, 2 * (var - 1) + 1 negative),
+ * followed by a vertex for each distinct clause. literals are connected to their negation
+ * and to the clauses containing them. */
+struct sat_symmetry {
+    unsigned long int max_var;
+
+    guint n_lit_vertices;
+    guint n_vertices;
+    /* neighbors of vertex u are adj[adj_offset[u]] ... adj[adj_offset[u + 1] - 1] */
+    guint *adj_offset;
+    guint *adj;
+
+    /* distinct sorted clauses as 0-terminated arrays of literals (long int *) and set of them */
+    GPtrArray  *clauses;
+    GHashTable *clause_set;
+    unsigned int max_clause_length;
+
+    /* refinement buffers: neighbor colors per vertex (same layout as adj) and vertex order */
+    guint  *nbr_colors;
+    GArray *order;
+    /* colors used by comparison of vertices */
+    const guint *sort_colors;
+    unsigned long int work;
+    bool exhausted;
+
+    /* first path: partitions (guint *) per level and individualized vertex (guint) + its cell (guint) */
+    GPtrArray *path_partitions;
+    GArray    *path_vertices;
+    GArray    *path_cells;
+
+    /* orbits of vertices under found generators as union-find forest */
+    guint *orbit;
+
+    GPtrArray    *generators;
+    unsigned int max_generators;
+};
+
+/* compare literals (long int) */
+static int sat_symmetry_lit_compare (const void *a, const void *b)
+{
+    long int lit_a = *((const long int *) a);
+    long int lit_b = *((const long int *) b);
+    return (lit_a < lit_b ? -1 : (lit_a > lit_b ? 1 : 0));
+}
+
+/* compare colors (guint) */
+static int sat_symmetry_color_compare (const void *a, const void *b)
+{
+    guint col_a = *((const guint *) a);
+    guint col_b = *((const guint *) b);
+    return (col_a < col_b ? -1 : (col_a > col_b ? 1 : 0));
+}
+
+/* hash function of 0-terminated arrays of literals */
+static guint sat_symmetry_clause_hash (gconstpointer key)
+{
+    const long int *clause = key;
+    guint hash = 5381;
+    for (unsigned int i = 0; clause[i] != 0; i++) hash = hash * 33 + (guint) clause[i];
+    return hash;
+}
+
+/* equality function of 0-terminated arrays of literals */
+static gboolean sat_symmetry_clause_equal (gconstpointer a, gconstpointer b)
+{
+    const long int *clause_a = a;
+    const long int *clause_b = b;
+
+    unsigned int i = 0;
+    while ((clause_a[i] != 0) && (clause_a[i] == clause_b[i])) i++;
+    return (clause_a[i] == clause_b[i]);
+}
+
+/* sort and remove duplicate literals of 0-terminated clause with len literals in place, returns new length */
+static unsigned int sat_symmetry_normalize (long int *clause, unsigned int len)
+{
+    qsort (clause, len, sizeof (long int), sat_symmetry_lit_compare);
+
+    unsigned int n = 0;
+    for (unsigned int i = 0; i < len; i++) {
+        if ((n > 0) && (clause[n - 1] == clause[i])) continue;
+        clause[n] = clause[i];
+        n++;
+    }
+    clause[n] = 0;
+
+    return n;
+}
+
+/* add a copy of clause with len literals if not yet contained */
+static void sat_symmetry_add_clause (struct sat_symmetry *s, const long int *lits, unsigned int len)
+{
+    long int *clause = g_new (long int, len + 1);
+    memcpy (clause, lits, sizeof (long int) * len);
+    len = sat_symmetry_normalize (clause, len);
+
+    if (g_hash_table_contains (s->clause_set, clause)) {
+        g_free (clause);
+        return;
+    }
+
+    g_hash_table_add (s->clause_set, clause);
+    g_ptr_array_add (s->clauses, clause);
+    if (len > s->max_clause_length) s->max_clause_length = len;
+}
+
+/* return vertex of literal */
+static inline guint sat_symmetry_lit_vertex (long int lit)
+{
+    return (lit > 0 ? 2 * (lit - 1) : 2 * (-lit - 1) + 1);
+}
+
+/* return literal of literal vertex */
+static inline long int sat_symmetry_vertex_lit (guint vertex)
+{
+    long int var = vertex / 2 + 1;
+    return ((vertex % 2) == 0 ? var : -var);
+}
+
+/* compare vertices (guint) by color and sorted neighbor colors */
+static gint sat_symmetry_vertex_compare (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    struct sat_symmetry *s = user_data;
+    guint u = *((const guint *) a);
+    guint v = *((const guint *) b);
+
+    if (s->sort_colors[u] != s->sort_colors[v]) return (s->sort_colors[u] < s->sort_colors[v] ? -1 : 1);
+
+    guint deg_u = s->adj_offset[u + 1] - s->adj_offset[u];
+    guint deg_v = s->adj_offset[v + 1] - s->adj_offset[v];
+    if (deg_u != deg_v) return (deg_u < deg_v ? -1 : 1);
+
+    const guint *nbr_u = &(s->nbr_colors[s->adj_offset[u]]);
+    const guint *nbr_v = &(s->nbr_colors[s->adj_offset[v]]);
+    for (guint i = 0; i < deg_u; i++) {
+        if (nbr_u[i] != nbr_v[i]) return (nbr_u[i] < nbr_v[i] ? -1 : 1);
+    }
+
+    return 0;
+}
+
+/* refine colors of vertices until vertices of the same color have the same number of neighbors
+ * of each color. resulting colors are 0 ... n - 1 and only depend on the graph and the
+ * input colors. returns the number of colors n. */
+static guint sat_symmetry_refine (struct sat_symmetry *s, guint *colors)
+{
+    guint n_colors = 0;
+    guint *new_colors = g_new (guint, s->n_vertices);
+
+    while (true) {
+        s->work += s->n_vertices + s->adj_offset[s->n_vertices];
+
+        for (guint u = 0; u < s->n_vertices; u++) {
+            for (guint i = s->adj_offset[u]; i < s->adj_offset[u + 1]; i++) {
+                s->nbr_colors[i] = colors[s->adj[i]];
+            }
+            qsort (&(s->nbr_colors[s->adj_offset[u]]), s->adj_offset[u + 1] - s->adj_offset[u], sizeof (guint), sat_symmetry_color_compare);
+        }
+
+        g_array_set_size (s->order, s->n_vertices);
+        for (guint u = 0; u < s->n_vertices; u++) g_array_index (s->order, guint, u) = u;
+
+        s->sort_colors = colors;
+        g_array_sort_with_data (s->order, sat_symmetry_vertex_compare, s);
+
+        guint n_new = 0;
+        for (guint i = 0; i < s->n_vertices; i++) {
+            guint u = g_array_index (s->order, guint, i);
+            if ((i > 0) && (sat_symmetry_vertex_compare (&g_array_index (s->order, guint, i - 1), &u, s) != 0)) n_new++;
+            new_colors[u] = n_new;
+        }
+        n_new++;
+
+        memcpy (colors, new_colors, sizeof (guint) * s->n_vertices);
+
+        if (n_new == n_colors) break;
+        n_colors = n_new;
+    }
+
+    g_free (new_colors);
+
+    if (s->work > SAT_SYMMETRY_MAX_WORK) s->exhausted = true;
+
+    return n_colors;
+}
+
+/* return newly allocated refined colors after individualizing vertex of colors */
+static guint * sat_symmetry_individualize (struct sat_symmetry *s, const guint *colors, guint vertex)
+{
+    guint *result = g_new (guint, s->n_vertices);
+
+    for (guint u = 0; u < s->n_vertices; u++) {
+        result[u] = 2 * colors[u] + (u == vertex ? 0 : 1);
+    }
+    sat_symmetry_refine (s, result);
+
+    return result;
+}
+
+/* return true if partitions given by colors a and b have the same cell sizes */
+static bool sat_symmetry_cells_match (struct sat_symmetry *s, const guint *a, const guint *b)
+{
+    guint *count = g_new0 (guint, s->n_vertices);
+    bool result = true;
+
+    for (guint u = 0; u < s->n_vertices; u++) count[a[u]]++;
+    for (guint u = 0; u < s->n_vertices; u++) {
+        if (count[b[u]] == 0) {
+            result = false;
+            break;
+        }
+        count[b[u]]--;
+    }
+
+    g_free (count);
+    return result;
+}
+
+/* return representative of vertex in orbit forest */
+static guint sat_symmetry_orbit_find (struct sat_symmetry *s, guint vertex)
+{
+    while (s->orbit[vertex] != vertex) {
+        s->orbit[vertex] = s->orbit[s->orbit[vertex]];
+        vertex = s->orbit[vertex];
+    }
+    return vertex;
+}
+
+/* check vertex permutation perm for being a symmetry of the clauses and record it as generator.
+ * returns true if it is a symmetry. */
+static bool sat_symmetry_check_candidate (struct sat_symmetry *s, const guint *perm)
+{
+    long int *map = g_new0 (long int, s->max_var + 1);
+    bool identity = true;
+
+    for (unsigned long int var = 1; var <= s->max_var; var++) {
+        guint pos_image = perm[sat_symmetry_lit_vertex (var)];
+        guint neg_image = perm[sat_symmetry_lit_vertex (-var)];
+
+        if ((pos_image >= s->n_lit_vertices) || (neg_image != sat_symmetry_lit_vertex (-sat_symmetry_vertex_lit (pos_image)))) {
+            g_free (map);
+            return false;
+        }
+
+        map[var] = sat_symmetry_vertex_lit (pos_image);
+        if (map[var] != (long int) var) identity = false;
+    }
+
+    long int *image = g_new (long int, s->max_clause_length + 1);
+    bool result = true;
+
+    for (guint i = 0; (i < s->clauses->len) && result; i++) {
+        const long int *clause = g_ptr_array_index (s->clauses, i);
+
+        unsigned int len = 0;
+        for (; clause[len] != 0; len++) {
+            image[len] = (clause[len] > 0 ? map[clause[len]] : -map[-clause[len]]);
+        }
+        sat_symmetry_normalize (image, len);
+
+        if (!g_hash_table_contains (s->clause_set, image)) result = false;
+    }
+    g_free (image);
+
+    if (result) {
+        for (guint u = 0; u < s->n_vertices; u++) {
+            guint root_u = sat_symmetry_orbit_find (s, u);
+            guint root_p = sat_symmetry_orbit_find (s, perm[u]);
+            if (root_u != root_p) s->orbit[root_p] = root_u;
+        }
+    }
+
+    /* symmetries only permuting duplicate-free clauses do not need to be broken */
+    if (result && !identity) {
+        g_ptr_array_add (s->generators, map);
+    } else {
+        g_free (map);
+    }
+
+    return result;
+}
+
+/* descend from partition colors at level of first path by individualizing vertices of the cell
+ * corresponding to the first path until a leaf is reached, which is mapped to the leaf of the first path.
+ * returns true if a symmetry has been found. */
+static bool sat_symmetry_search (struct sat_symmetry *s, guint level, const guint *colors)
+{
+    if (s->exhausted) return false;
+
+    if (level == s->path_vertices->len) {
+        const guint *leaf = g_ptr_array_index (s->path_partitions, level);
+
+        guint *inv_colors = g_new (guint, s->n_vertices);
+        guint *perm       = g_new (guint, s->n_vertices);
+
+        for (guint u = 0; u < s->n_vertices; u++) inv_colors[colors[u]] = u;
+        for (guint u = 0; u < s->n_vertices; u++) perm[u] = inv_colors[leaf[u]];
+
+        bool result = sat_symmetry_check_candidate (s, perm);
+
+        g_free (perm);
+        g_free (inv_colors);
+        return result;
+    }
+
+    guint cell = g_array_index (s->path_cells, guint, level);
+    const guint *next_partition = g_ptr_array_index (s->path_partitions, level + 1);
+
+    for (guint w = 0; (w < s->n_vertices) && !s->exhausted; w++) {
+        if (colors[w] != cell) continue;
+
+        guint *w_colors = sat_symmetry_individualize (s, colors, w);
+        bool found = false;
+
+        if (sat_symmetry_cells_match (s, w_colors, next_partition)) {
+            found = sat_symmetry_search (s, level + 1, w_colors);
+        }
+        g_free (w_colors);
+
+        if (found) return true;
+    }
+
+    return false;
+}
+
+/* find generators of the symmetry group of clauses, returns NULL if the graph is too large */
+GPtrArray * sat_symmetry_find (GQueue *clauses, const long int *units, unsigned long int max_var,
+                               unsigned long int max_vertices, unsigned int max_generators)
+{
+    if (clauses == NULL) return NULL;
+
+    struct sat_symmetry s;
+
+    s.max_var           = max_var;
+    s.clauses           = g_ptr_array_new_with_free_func (g_free);
+    s.clause_set        = g_hash_table_new (sat_symmetry_clause_hash, sat_symmetry_clause_equal);
+    s.max_clause_length = 1;
+
+    for (GList *cl = clauses->head; cl != NULL; cl = cl->next) {
+        const long int *clause = cl->data;
+        unsigned int len = 0;
+        while (clause[len] != 0) len++;
+        sat_symmetry_add_clause (&s, clause, len);
+    }
+    for (unsigned int i = 0; (units != NULL) && (units[i] != 0); i++) {
+        sat_symmetry_add_clause (&s, &(units[i]), 1);
+    }
+
+    s.n_lit_vertices = 2 * max_var;
+    s.n_vertices     = s.n_lit_vertices + s.clauses->len;
+
+    if ((unsigned long int) s.n_lit_vertices + s.clauses->len > max_vertices) {
+        g_hash_table_destroy (s.clause_set);
+        g_ptr_array_free (s.clauses, true);
+        return NULL;
+    }
+
+    /* graph in compressed adjacency form */
+    bool *used = g_new0 (bool, max_var + 1);
+    guint *degree = g_new0 (guint, s.n_vertices + 1);
+
+    for (guint u = 0; u < s.n_lit_vertices; u++) degree[u] = 1;
+    for (guint i = 0; i < s.clauses->len; i++) {
+        const long int *clause = g_ptr_array_index (s.clauses, i);
+        for (unsigned int j = 0; clause[j] != 0; j++) {
+            degree[sat_symmetry_lit_vertex (clause[j])]++;
+            degree[s.n_lit_vertices + i]++;
+            used[clause[j] > 0 ? clause[j] : -clause[j]] = true;
+        }
+    }
+
+    s.adj_offset = g_new (guint, s.n_vertices + 1);
+    s.adj_offset[0] = 0;
+    for (guint u = 0; u < s.n_vertices; u++) s.adj_offset[u + 1] = s.adj_offset[u] + degree[u];
+
+    s.adj = g_new (guint, s.adj_offset[s.n_vertices]);
+    for (guint u = 0; u < s.n_vertices; u++) degree[u] = s.adj_offset[u];
+
+    for (guint u = 0; u < s.n_lit_vertices; u++) s.adj[degree[u]++] = (u ^ 1);
+    for (guint i = 0; i < s.clauses->len; i++) {
+        const long int *clause = g_ptr_array_index (s.clauses, i);
+        guint c_vertex = s.n_lit_vertices + i;
+        for (unsigned int j = 0; clause[j] != 0; j++) {
+            guint l_vertex = sat_symmetry_lit_vertex (clause[j]);
+            s.adj[degree[l_vertex]++] = c_vertex;
+            s.adj[degree[c_vertex]++] = l_vertex;
+        }
+    }
+    g_free (degree);
+
+    s.nbr_colors     = g_new (guint, s.adj_offset[s.n_vertices] + 1);
+    s.order          = g_array_new (false, false, sizeof (guint));
+    s.sort_colors    = NULL;
+    s.work           = 0;
+    s.exhausted      = false;
+    s.orbit          = g_new (guint, s.n_vertices);
+    s.generators     = g_ptr_array_new_with_free_func (g_free);
+    s.max_generators = max_generators;
+
+    s.path_partitions = g_ptr_array_new_with_free_func (g_free);
+    s.path_vertices   = g_array_new (false, false, sizeof (guint));
+    s.path_cells      = g_array_new (false, false, sizeof (guint));
+
+    for (guint u = 0; u < s.n_vertices; u++) s.orbit[u] = u;
+
+    /* initial colors: literals, clauses, unused variables are fixed */
+    guint *colors = g_new (guint, s.n_vertices);
+    for (guint u = 0; u < s.n_vertices; u++) {
+        if (u >= s.n_lit_vertices) {
+            colors[u] = 1;
+        } else if (!used[u / 2 + 1]) {
+            colors[u] = 2 + u;
+        } else {
+            colors[u] = 0;
+        }
+    }
+    g_free (used);
+
+    guint n_colors = sat_symmetry_refine (&s, colors);
+    g_ptr_array_add (s.path_partitions, colors);
+
+    /* first path: individualize first vertex of first non-singleton cell until discrete */
+    guint *cell_size = g_new (guint, s.n_vertices);
+    while ((n_colors < s.n_vertices) && !s.exhausted) {
+        memset (cell_size, 0, sizeof (guint) * s.n_vertices);
+        for (guint u = 0; u < s.n_vertices; u++) cell_size[colors[u]]++;
+
+        guint cell = 0;
+        while (cell_size[cell] < 2) cell++;
+
+        guint vertex = 0;
+        while (colors[vertex] != cell) vertex++;
+
+        g_array_append_val (s.path_cells, cell);
+        g_array_append_val (s.path_vertices, vertex);
+
+        colors = sat_symmetry_individualize (&s, colors, vertex);
+        g_ptr_array_add (s.path_partitions, colors);
+
+        n_colors = 0;
+        for (guint u = 0; u < s.n_vertices; u++) {
+            if (colors[u] + 1 > n_colors) n_colors = colors[u] + 1;
+        }
+    }
+    g_free (cell_size);
+
+    /* generators fixing the first path up to level are searched deepest first */
+    for (guint level = s.path_vertices->len; (level > 0) && !s.exhausted; level--) {
+        guint i_level = level - 1;
+
+        const guint *partition      = g_ptr_array_index (s.path_partitions, i_level);
+        const guint *next_partition = g_ptr_array_index (s.path_partitions, level);
+        guint cell   = g_array_index (s.path_cells, guint, i_level);
+        guint vertex = g_array_index (s.path_vertices, guint, i_level);
+
+        for (guint w = 0; (w < s.n_vertices) && !s.exhausted; w++) {
+            if (s.generators->len >= s.max_generators) break;
+            if ((partition[w] != cell) || (w == vertex)) continue;
+            if (sat_symmetry_orbit_find (&s, w) == sat_symmetry_orbit_find (&s, vertex)) continue;
+
+            guint *w_colors = sat_symmetry_individualize (&s, partition, w);
+            if (sat_symmetry_cells_match (&s, w_colors, next_partition)) {
+                sat_symmetry_search (&s, level, w_colors);
+            }
+            g_free (w_colors);
+        }
+        if (s.generators->len >= s.max_generators) break;
+    }
+
+    GPtrArray *result = s.generators;
+
+    g_ptr_array_free (s.path_partitions, true);
+    g_array_free (s.path_vertices, true);
+    g_array_free (s.path_cells, true);
+    g_array_free (s.order, true);
+    g_free (s.nbr_colors);
+    g_free (s.orbit);
+    g_free (s.adj);
+    g_free (s.adj_offset);
+    g_hash_table_destroy (s.clause_set);
+    g_ptr_array_free (s.clauses, true);
+
+    return result;
+}
+
+/* append lex-leader symmetry-breaking clauses for generators to str and return their number */
+unsigned long int sat_symmetry_append_breaking (GPtrArray *generators, unsigned long int max_var, unsigned int max_length,
+                                                unsigned long int *next_var, GString *str)
+{
+    if (generators == NULL) return 0;
+
+    unsigned long int n_clauses = 0;
+
+    for (guint i = 0; i < generators->len; i++) {
+        const long int *map = g_ptr_array_index (generators, i);
+
+        /* x <= map (x) lexicographically: prev is true while all former positions are equal */
+        long int prev = 0;
+        unsigned int n_positions = 0;
+
+        for (unsigned long int var = 1; (var <= max_var) && (n_positions < max_length); var++) {
+            long int x = var;
+            long int y = map[var];
+            if (y == x) continue;
+            n_positions++;
+
+            if (prev != 0) g_string_append_printf (str, "%ld ", -prev);
+            g_string_append_printf (str, "%ld %ld 0\n", -x, y);
+            n_clauses++;
+
+            if ((y == -x) || (n_positions == max_length)) break;
+
+            long int next = *next_var;
+            (*next_var)++;
+
+            if (prev != 0) g_string_append_printf (str, "%ld ", -prev);
+            g_string_append_printf (str, "%ld %ld 0\n", -x, next);
+            if (prev != 0) g_string_append_printf (str, "%ld ", -prev);
+            g_string_append_printf (str, "%ld %ld 0\n", y, next);
+            n_clauses += 2;
+
+            prev = next;
+        }
+    }
+
+    return n_clauses;
+}
+
+/* print generators in cycle notation as info */
+void sat_symmetry_print_generators (GPtrArray *generators, unsigned long int max_var)
+{
+    if (generators == NULL) return;
+
+    bool *visited = g_new (bool, max_var + 1);
+    GString *str = g_string_new (NULL);
+
+    for (guint i = 0; i < generators->len; i++) {
+        const long int *map = g_ptr_array_index (generators, i);
+
+        memset (visited, 0, sizeof (bool) * (max_var + 1));
+        g_string_assign (str, "");
+        unsigned int n_cycles = 0;
+
+        for (unsigned long int var = 1; var <= max_var; var++) {
+            if (visited[var] || (map[var] == (long int) var)) continue;
+
+            if (n_cycles == 16) {
+                g_string_append (str, "...");
+                break;
+            }
+
+            g_string_append_c (str, '(');
+            long int lit = var;
+            do {
+                if (lit != (long int) var) g_string_append_c (str, ' ');
+                g_string_append_printf (str, "%ld", lit);
+                visited[lit > 0 ? lit : -lit] = true;
+                lit = (lit > 0 ? map[lit] : -map[-lit]);
+            } while ((lit != (long int) var) && (lit != -((long int) var)));
+            if (lit != (long int) var) g_string_append (str, " ~");
+            g_string_append_c (str, ')');
+            n_cycles++;
+        }
+
+        printf ("INFO: symmetry generator %u: %s\n", i + 1, str->str);
+    }
+
+    g_string_free (str, true);
+    g_free (visited);
+}
@@ -0,0 +1,47 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __sat_symmetry_h__
+#define __sat_symmetry_h__
+
+#include <stdbool.h>
+#include <glib.h>
+
+/* find generators of the symmetry group of clauses by individualization and refinement on the
+ * colored graph of literals and clauses. Each generator is returned as array of literals (long int)
+ * indexed by variable 0 ... max_var, mapping each variable to its image, freed with the GPtrArray.
+ * Only verified symmetries are returned, the search may be incomplete when the budget is exhausted.
+ * clauses: GQueue of 0-terminated arrays of literals (long int), not modified,
+ * units: 0-terminated array of literals (long int) added as unit clauses or NULL,
+ * max_var: greatest variable in clauses and units,
+ * max_vertices: returns NULL if the graph has more vertices,
+ * max_generators: search is stopped after this number of generators. */
+GPtrArray * sat_symmetry_find (GQueue *clauses, const long int *units, unsigned long int max_var,
+                               unsigned long int max_vertices, unsigned int max_generators);
+
+/* append lex-leader symmetry-breaking clauses in DIMACS format for generators to str and return
+ * their number. Variables are ordered by number, at most max_length variables of the support of
+ * each generator are constrained. Auxiliary variables are numbered starting at *next_var, which
+ * is incremented accordingly. */
+unsigned long int sat_symmetry_append_breaking (GPtrArray *generators, unsigned long int max_var, unsigned int max_length,
+                                                unsigned long int *next_var, GString *str);
+
+/* print generators in cycle notation as info */
+void sat_symmetry_print_generators (GPtrArray *generators, unsigned long int max_var);
+
+#endif
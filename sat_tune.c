@@ -0,0 +1,273 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sat_tune.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* names of classes indexed by SatTuneClass */
+static const char * const sat_tune_class_names[] = {
+    "1ofn",
+    "mofn",
+    "pb",
+    NULL
+};
+
+/* alternative clause encodings per class */
+static const char * const sat_tune_1ofn_alternatives[] = {
+    "order", "auto", "direct", "seqcounter", "totalizer", "commander", "product", "binary", "ladder", NULL
+};
+static const char * const sat_tune_mofn_alternatives[] = {
+    "auto", "seqcounter", "totalizer", "modtotalizer", "cardnetwork", "sortnetwork", NULL
+};
+static const char * const sat_tune_pb_alternatives[] = {
+    "auto", "bdd", "gte", "adder", "sortnetwork", NULL
+};
+
+/* profile data: entries point to the alternatives above */
+struct sat_tune_profile {
+    const char *encoding[SAT_TUNE_N_CLASSES];
+};
+
+/* data of concurrent runs of sat_tune_solve */
+struct sat_tune_solve_data {
+    struct sat_tune_run *runs;
+    const char          *tmp_file_name;
+    const char          *solver_bin;
+    bool                solution_on_stdout;
+    bool                cnf_gz;
+    double              timeout;
+};
+
+/* set *tune_class to the class with given name (e.g. "1ofn") and return true, false for unknown names */
+bool sat_tune_class_from_string (const char *name, SatTuneClass *tune_class)
+{
+    if (name == NULL) return false;
+
+    for (int i = 0; sat_tune_class_names[i] != NULL; i++) {
+        if (strcmp (name, sat_tune_class_names[i]) == 0) {
+            if (tune_class != NULL) *tune_class = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* return name of tune_class */
+const char * sat_tune_class_name (SatTuneClass tune_class)
+{
+    if (tune_class >= SAT_TUNE_N_CLASSES) return NULL;
+    return sat_tune_class_names[tune_class];
+}
+
+/* set *tune_class to the class of encoding (as given to add_encoding) and return true,
+ * false if the encoding has no alternatives */
+bool sat_tune_class_of_encoding (const char *encoding, SatTuneClass *tune_class)
+{
+    if (encoding == NULL) return false;
+
+    if ((strcmp (encoding, "1ofn") == 0) || (strncmp (encoding, "1ofn_", 5) == 0)) {
+        *tune_class = SAT_TUNE_1OFN;
+    } else if ((strcmp (encoding, "mofn") == 0) || (strcmp (encoding, "atleast_mofn") == 0) ||
+               (strcmp (encoding, "atmost_mofn") == 0) || (strcmp (encoding, "2ofn") == 0)) {
+        *tune_class = SAT_TUNE_MOFN;
+    } else if (strcmp (encoding, "pb") == 0) {
+        *tune_class = SAT_TUNE_PB;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+/* return NULL-terminated list of the alternative clause encodings of tune_class */
+const char * const * sat_tune_class_alternatives (SatTuneClass tune_class)
+{
+    switch (tune_class) {
+        case SAT_TUNE_1OFN: return sat_tune_1ofn_alternatives;
+        case SAT_TUNE_MOFN: return sat_tune_mofn_alternatives;
+        case SAT_TUNE_PB:   return sat_tune_pb_alternatives;
+    }
+
+    return NULL;
+}
+
+/* returns a newly allocated empty profile */
+struct sat_tune_profile * sat_tune_profile_new ()
+{
+    struct sat_tune_profile *result = g_slice_new0 (struct sat_tune_profile);
+
+    return result;
+}
+
+/* frees profile and sets the referenced pointer to NULL */
+void sat_tune_profile_free (struct sat_tune_profile **profile)
+{
+    if (profile == NULL) return;
+    if (*profile == NULL) return;
+
+    g_slice_free (struct sat_tune_profile, *profile);
+    *profile = NULL;
+}
+
+/* copy all entries of profile src into dest */
+void sat_tune_profile_copy (struct sat_tune_profile *dest, struct sat_tune_profile *src)
+{
+    if ((dest == NULL) || (src == NULL)) return;
+
+    *dest = *src;
+}
+
+/* set clause encoding of tune_class to alternative (NULL: none) and return true, false if alternative
+ * is not one of sat_tune_class_alternatives */
+bool sat_tune_profile_set (struct sat_tune_profile *profile, SatTuneClass tune_class, const char *alternative)
+{
+    if (profile == NULL) return false;
+    if (tune_class >= SAT_TUNE_N_CLASSES) return false;
+
+    if (alternative == NULL) {
+        profile->encoding[tune_class] = NULL;
+        return true;
+    }
+
+    for (const char * const *ai = sat_tune_class_alternatives (tune_class); *ai != NULL; ai++) {
+        if (strcmp (alternative, *ai) == 0) {
+            profile->encoding[tune_class] = *ai;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* return clause encoding of tune_class or NULL */
+const char * sat_tune_profile_get (struct sat_tune_profile *profile, SatTuneClass tune_class)
+{
+    if (profile == NULL) return NULL;
+    if (tune_class >= SAT_TUNE_N_CLASSES) return NULL;
+
+    return profile->encoding[tune_class];
+}
+
+/* read entries from file with lines "<class> <encoding>" (# starts a comment) into profile and return true,
+ * on errors profile is not modified and false is returned */
+bool sat_tune_profile_read (struct sat_tune_profile *profile, const char *file_name)
+{
+    if (profile == NULL) return false;
+    if (file_name == NULL) return false;
+
+    char *content = NULL;
+    if (!g_file_get_contents (file_name, &content, NULL, NULL)) {
+        printf ("ERROR: could not open file %s\n", file_name);
+        return false;
+    }
+
+    struct sat_tune_profile result = *profile;
+    bool success = true;
+
+    char **lines = g_strsplit (content, "\n", -1);
+    for (int i = 0; success && (lines[i] != NULL); i++) {
+        char *comment = strchr (lines[i], '#');
+        if (comment != NULL) *comment = '\0';
+
+        char class_name[32];
+        char encoding[32];
+        char rest[2];
+        int n_fields = sscanf (lines[i], "%31s %31s %1s", class_name, encoding, rest);
+        if (n_fields <= 0) continue;
+
+        SatTuneClass tune_class;
+        if (n_fields != 2) {
+            printf ("ERROR: %s:%d: expected \"<class> <encoding>\"\n", file_name, i + 1);
+            success = false;
+        } else if (!sat_tune_class_from_string (class_name, &tune_class)) {
+            printf ("ERROR: %s:%d: unknown class %s\n", file_name, i + 1, class_name);
+            success = false;
+        } else if (!sat_tune_profile_set (&result, tune_class, encoding)) {
+            printf ("ERROR: %s:%d: unknown encoding %s for class %s\n", file_name, i + 1, encoding, class_name);
+            success = false;
+        }
+    }
+    g_strfreev (lines);
+    g_free (content);
+
+    if (success) *profile = result;
+
+    return success;
+}
+
+/* write profile to file preceded by comment lines (NULL-terminated array or NULL) and return true on success */
+bool sat_tune_profile_write (struct sat_tune_profile *profile, const char *file_name, const char * const *comments)
+{
+    if (profile == NULL) return false;
+    if (file_name == NULL) return false;
+
+    FILE *file = fopen (file_name, "w");
+    if (file == NULL) {
+        printf ("ERROR: could not open file %s\n", file_name);
+        return false;
+    }
+
+    for (int i = 0; (comments != NULL) && (comments[i] != NULL); i++) {
+        fprintf (file, "# %s\n", comments[i]);
+    }
+    for (int i = 0; i < SAT_TUNE_N_CLASSES; i++) {
+        if (profile->encoding[i] == NULL) continue;
+        fprintf (file, "%s %s\n", sat_tune_class_names[i], profile->encoding[i]);
+    }
+
+    fclose (file);
+
+    return true;
+}
+
+/* thread pool function for timing run (gpointer index + 1 into runs of struct sat_tune_solve_data) */
+static void sat_tune_solve_func (gpointer data, gpointer user_data)
+{
+    struct sat_tune_solve_data *sd = user_data;
+    guint index = GPOINTER_TO_UINT (data) - 1;
+    struct sat_tune_run *run = &(sd->runs[index]);
+
+    char *tmp_file_name = g_strdup_printf ("%s_tune_%u", sd->tmp_file_name, index);
+
+    run->error = !sat_problem_solve_timed (run->sat, tmp_file_name, sd->solver_bin, sd->solution_on_stdout, true, sd->cnf_gz,
+                                           sd->timeout, &(run->seconds), &(run->timed_out), &(run->satisfiable));
+
+    g_free (tmp_file_name);
+}
+
+/* solve the problems of the n_runs runs by up to n_threads (0: number of processors) concurrent solver runs,
+ * each stopped after timeout seconds (0: no limit), and set their results. runs without problem are skipped. */
+void sat_tune_solve (struct sat_tune_run *runs, unsigned int n_runs, const char *tmp_file_name, const char *solver_bin,
+                     bool solution_on_stdout, bool cnf_gz, double timeout, unsigned int n_threads)
+{
+    if ((runs == NULL) || (n_runs == 0)) return;
+
+    struct sat_tune_solve_data sd = {runs, tmp_file_name, solver_bin, solution_on_stdout, cnf_gz, timeout};
+
+    if (n_threads == 0) n_threads = g_get_num_processors ();
+
+    GThreadPool *pool = g_thread_pool_new (sat_tune_solve_func, &sd, n_threads, false, NULL);
+    for (unsigned int i = 0; i < n_runs; i++) {
+        if (runs[i].sat == NULL) continue;
+        g_thread_pool_push (pool, GUINT_TO_POINTER (i + 1), NULL);
+    }
+    g_thread_pool_free (pool, false, true);
+}
@@ -0,0 +1,95 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __sat_tune_h__
+#define __sat_tune_h__
+
+#include <stdbool.h>
+#include <glib.h>
+
+#include "sat_problem.h"
+
+/* classes of constraints whose clause encoding can be chosen by a profile */
+enum sat_tune_class_t {
+    /* exactly one of n: encodings 1ofn, 1ofn_order, 1ofn_<at most one encoding> */
+    SAT_TUNE_1OFN,
+    /* (at least/most) m of n: encodings mofn, atleast_mofn, atmost_mofn, 2ofn */
+    SAT_TUNE_MOFN,
+    /* pseudo-Boolean: encoding pb */
+    SAT_TUNE_PB
+};
+
+typedef enum sat_tune_class_t SatTuneClass;
+
+#define SAT_TUNE_N_CLASSES 3
+
+/* constraints counted per class */
+struct sat_tune_record {
+    unsigned long int n_constraints[SAT_TUNE_N_CLASSES];
+    unsigned long int n_lits[SAT_TUNE_N_CLASSES];
+};
+
+/* profile: clause encoding per class or none (encodings chosen by the script are kept) */
+typedef struct sat_tune_profile *SatTuneProfile;
+
+/* set *tune_class to the class with given name (e.g. "1ofn") and return true, false for unknown names */
+bool sat_tune_class_from_string (const char *name, SatTuneClass *tune_class);
+/* return name of tune_class */
+const char * sat_tune_class_name (SatTuneClass tune_class);
+/* set *tune_class to the class of encoding (as given to add_encoding, e.g. "1ofn_ladder") and return true,
+ * false if the encoding has no alternatives (e.g. "xor") */
+bool sat_tune_class_of_encoding (const char *encoding, SatTuneClass *tune_class);
+/* return NULL-terminated list of the alternative clause encodings of tune_class: "order" and cardinality
+ * encodings for 1ofn, cardinality encodings for mofn (except direct, "auto" chooses it if it is small),
+ * pb encodings for pb */
+const char * const * sat_tune_class_alternatives (SatTuneClass tune_class);
+
+/* returns a newly allocated empty profile */
+SatTuneProfile sat_tune_profile_new ();
+/* frees profile and sets the referenced pointer to NULL */
+void sat_tune_profile_free (SatTuneProfile *profile);
+/* copy all entries of profile src into dest */
+void sat_tune_profile_copy (SatTuneProfile dest, SatTuneProfile src);
+/* set clause encoding of tune_class to alternative (NULL: none) and return true, false if alternative
+ * is not one of sat_tune_class_alternatives */
+bool sat_tune_profile_set (SatTuneProfile profile, SatTuneClass tune_class, const char *alternative);
+/* return clause encoding of tune_class or NULL */
+const char * sat_tune_profile_get (SatTuneProfile profile, SatTuneClass tune_class);
+/* read entries from file with lines "<class> <encoding>" (# starts a comment) into profile and return true,
+ * on errors profile is not modified and false is returned */
+bool sat_tune_profile_read (SatTuneProfile profile, const char *file_name);
+/* write profile to file preceded by comment lines (NULL-terminated array or NULL) and return true on success */
+bool sat_tune_profile_write (SatTuneProfile profile, const char *file_name, const char * const *comments);
+
+/* variant of a problem timed by sat_tune_solve */
+struct sat_tune_run {
+    SatProblem sat;
+    /* results */
+    bool       error;
+    bool       timed_out;
+    bool       satisfiable;
+    double     seconds;
+};
+
+/* solve the problems of the n_runs runs by up to n_threads (0: number of processors) concurrent solver runs,
+ * each stopped after timeout seconds (0: no limit), and set their results, runs whose sat is NULL are skipped.
+ * temporary files are prefixed with tmp_file_name and the index of the run, other arguments as for sat_problem_solve. */
+void sat_tune_solve (struct sat_tune_run *runs, unsigned int n_runs, const char *tmp_file_name, const char *solver_bin,
+                     bool solution_on_stdout, bool cnf_gz, double timeout, unsigned int n_threads);
+
+#endif
@@ -0,0 +1,271 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sat_xor.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* compare function for sorting literals (long int) */
+static int sat_xor_lit_compare (const void *a, const void *b)
+{
+    long int lit_a = *((const long int *) a);
+    long int lit_b = *((const long int *) b);
+
+    if (lit_a < lit_b) return -1;
+    if (lit_a > lit_b) return 1;
+    return 0;
+}
+
+/* normalize XOR constraint of n literals lits in place into sorted positive variables */
+unsigned int sat_xor_normalize (long int *lits, unsigned int n, const signed char *value, unsigned long int max_var, bool *parity)
+{
+    bool result_parity = true;
+    unsigned int size  = 0;
+
+    for (unsigned int i = 0; i < n; i++) {
+        long int lit = lits[i];
+        long int var = (lit > 0 ? lit : -lit);
+
+        /* -x is x xor true */
+        if (lit < 0) result_parity = !result_parity;
+
+        if ((value != NULL) && (var <= max_var) && (value[var] != 0)) {
+            if (value[var] > 0) result_parity = !result_parity;
+            continue;
+        }
+
+        lits[size] = var;
+        size++;
+    }
+
+    qsort (lits, size, sizeof (long int), sat_xor_lit_compare);
+
+    /* x xor x is false */
+    unsigned int j = 0;
+    for (unsigned int i = 0; i < size; i++) {
+        if ((i + 1 < size) && (lits[i] == lits[i + 1])) {
+            i++;
+            continue;
+        }
+        lits[j] = lits[i];
+        j++;
+    }
+
+    *parity = result_parity;
+
+    return j;
+}
+
+/* append the 2^(n - 1) clauses of the XOR constraint of n literals lits to clauses and return their number:
+ * every clause with an even number of inverted literals excludes an assignment with even parity */
+static unsigned long int sat_xor_expand (const long int *lits, unsigned int n, GQueue *clauses)
+{
+    unsigned long int n_clauses = 0;
+
+    for (unsigned long int mask = 0; mask < (1UL << n); mask++) {
+        if (__builtin_popcountl (mask) % 2 != 0) continue;
+
+        long int *clause = g_slice_alloc (sizeof (long int) * (n + 1));
+        for (unsigned int i = 0; i < n; i++) {
+            clause[i] = ((mask & (1UL << i)) ? -lits[i] : lits[i]);
+        }
+        clause[n] = 0;
+
+        g_queue_push_tail (clauses, clause);
+        n_clauses++;
+    }
+
+    return n_clauses;
+}
+
+/* append clauses of XOR constraint xor to clauses as cut chain and return their number */
+unsigned long int sat_xor_append_clauses (const long int *xor, unsigned int cut, unsigned long int *next_var, GQueue *clauses)
+{
+    if (xor == NULL) return 0;
+    if (cut < 3) cut = 3;
+
+    unsigned int n = 0;
+    while (xor[n] != 0) n++;
+
+    long int *chunk = g_new (long int, cut);
+    unsigned long int n_clauses = 0;
+
+    /* literal carrying the parity of the literals already encoded */
+    long int carry = 0;
+    unsigned int i = 0;
+
+    while (true) {
+        unsigned int size = 0;
+        if (carry != 0) {
+            chunk[0] = carry;
+            size = 1;
+        }
+
+        if (n - i + size <= cut) {
+            while (i < n) chunk[size++] = xor[i++];
+            n_clauses += sat_xor_expand (chunk, size, clauses);
+            break;
+        }
+
+        /* t == chunk literals is chunk literals xor -t */
+        while (size < cut - 1) chunk[size++] = xor[i++];
+        long int aux = *next_var;
+        (*next_var)++;
+
+        chunk[size++] = -aux;
+        n_clauses += sat_xor_expand (chunk, size, clauses);
+
+        carry = aux;
+    }
+
+    g_free (chunk);
+
+    return n_clauses;
+}
+
+/* Gauss-Jordan elimination over GF(2) on xors deriving units and equivalences */
+bool sat_xor_gauss (GQueue *xors, const signed char *value, unsigned long int max_var, unsigned long int max_bits,
+                    GArray *units, GArray *equivalences)
+{
+    if (xors == NULL) return true;
+
+    /* columns of unassigned variables */
+    guint *column = g_new0 (guint, max_var + 1);
+    GArray *column_var = g_array_new (false, false, sizeof (long int));
+
+    GArray *lits = g_array_new (false, false, sizeof (long int));
+
+    for (GList *li = xors->head; li != NULL; li = li->next) {
+        const long int *xor = li->data;
+        for (unsigned int i = 0; xor[i] != 0; i++) {
+            long int var = (xor[i] > 0 ? xor[i] : -xor[i]);
+            if ((value != NULL) && (value[var] != 0)) continue;
+            if (column[var] != 0) continue;
+
+            g_array_append_val (column_var, var);
+            column[var] = column_var->len;
+        }
+    }
+
+    guint n_rows = g_queue_get_length (xors);
+    guint n_cols = column_var->len;
+
+    if ((unsigned long int) n_rows * (n_cols + 1) > max_bits) {
+        g_array_free (lits, true);
+        g_array_free (column_var, true);
+        g_free (column);
+        return true;
+    }
+
+    /* rows as bit sets of columns with the parity in bit n_cols */
+    guint n_words = (n_cols + 1 + 63) / 64;
+    guint64 *matrix = g_new0 (guint64, (gsize) n_rows * n_words);
+
+    guint row = 0;
+    for (GList *li = xors->head; li != NULL; li = li->next) {
+        const long int *xor = li->data;
+
+        g_array_set_size (lits, 0);
+        for (unsigned int i = 0; xor[i] != 0; i++) g_array_append_val (lits, xor[i]);
+
+        bool parity;
+        unsigned int size = sat_xor_normalize ((long int *) lits->data, lits->len, value, max_var, &parity);
+
+        guint64 *r = &matrix[(gsize) row * n_words];
+        for (unsigned int i = 0; i < size; i++) {
+            guint col = column[g_array_index (lits, long int, i)] - 1;
+            r[col / 64] |= ((guint64) 1 << (col % 64));
+        }
+        if (parity) r[n_cols / 64] |= ((guint64) 1 << (n_cols % 64));
+
+        row++;
+    }
+
+    /* reduced row echelon form */
+    guint rank = 0;
+    for (guint col = 0; (col < n_cols) && (rank < n_rows); col++) {
+        guint word     = col / 64;
+        guint64 bit    = ((guint64) 1 << (col % 64));
+
+        guint pivot = rank;
+        while ((pivot < n_rows) && !(matrix[(gsize) pivot * n_words + word] & bit)) pivot++;
+        if (pivot == n_rows) continue;
+
+        guint64 *p = &matrix[(gsize) pivot * n_words];
+        guint64 *q = &matrix[(gsize) rank * n_words];
+        if (pivot != rank) {
+            for (guint w = 0; w < n_words; w++) {
+                guint64 temp = p[w];
+                p[w] = q[w];
+                q[w] = temp;
+            }
+        }
+
+        for (guint r = 0; r < n_rows; r++) {
+            if (r == rank) continue;
+            guint64 *other = &matrix[(gsize) r * n_words];
+            if (!(other[word] & bit)) continue;
+            for (guint w = word; w < n_words; w++) other[w] ^= q[w];
+        }
+
+        rank++;
+    }
+
+    /* rows with no, one or two variables */
+    bool consistent = true;
+
+    for (guint r = 0; (r < n_rows) && consistent; r++) {
+        const guint64 *row_bits = &matrix[(gsize) r * n_words];
+        bool parity = ((row_bits[n_cols / 64] >> (n_cols % 64)) & 1);
+
+        long int found[2];
+        unsigned int n_found = 0;
+
+        for (guint w = 0; (w < n_words) && (n_found <= 2); w++) {
+            guint64 bits = row_bits[w];
+            if (w == n_cols / 64) bits &= (((guint64) 1 << (n_cols % 64)) - 1);
+
+            while ((bits != 0) && (n_found <= 2)) {
+                guint col = w * 64 + __builtin_ctzll (bits);
+                bits &= bits - 1;
+                if (n_found < 2) found[n_found] = g_array_index (column_var, long int, col);
+                n_found++;
+            }
+        }
+
+        if (n_found == 0) {
+            if (parity) consistent = false;
+        } else if (n_found == 1) {
+            long int lit = (parity ? found[0] : -found[0]);
+            g_array_append_val (units, lit);
+        } else if (n_found == 2) {
+            /* a xor b == parity: a == b or a == -b */
+            long int lit = (parity ? -found[1] : found[1]);
+            g_array_append_val (equivalences, found[0]);
+            g_array_append_val (equivalences, lit);
+        }
+    }
+
+    g_free (matrix);
+    g_array_free (lits, true);
+    g_array_free (column_var, true);
+    g_free (column);
+
+    return consistent;
+}
@@ -0,0 +1,47 @@
+/*
+ *  sat-shell is an interactive tcl-shell for solving satisfiability problems.
+ *  Copyright (C) 2016  Andreas Dixius
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __sat_xor_h__
+#define __sat_xor_h__
+
+#include <stdbool.h>
+#include <glib.h>
+
+/* XOR constraints are represented as 0-terminated arrays of literals (long int) whose exclusive or is true,
+ * e.g. {1, -2, 3, 0} is x1 xor -x2 xor x3. */
+
+/* normalize XOR constraint of n literals lits in place into sorted positive variables: variables occurring
+ * twice cancel each other and literals of variables assigned by value (indexed by variable 0 ... max_var:
+ * 1 true, -1 false, 0 unassigned, or NULL) are removed. Returns the number of remaining variables,
+ * *parity is set to the value their exclusive or has to take. */
+unsigned int sat_xor_normalize (long int *lits, unsigned int n, const signed char *value, unsigned long int max_var, bool *parity);
+
+/* append clauses of XOR constraint xor to clauses (GQueue of 0-terminated arrays of literals (long int)
+ * allocated by g_slice) and return their number. XOR constraints with more than cut literals are split
+ * into a chain of constraints with cut literals connected by auxiliary variables numbered from *next_var on,
+ * each expanded into 2^(cut - 1) clauses. */
+unsigned long int sat_xor_append_clauses (const long int *xor, unsigned int cut, unsigned long int *next_var, GQueue *clauses);
+
+/* run Gauss-Jordan elimination over GF(2) on xors (GQueue of XOR constraints) with variables assigned by
+ * value (see sat_xor_normalize) and append implied unit literals (long int) to units and implied equivalences
+ * as pairs of literals (long int) a, b with a == b to equivalences. Nothing is derived if the matrix
+ * would have more than max_bits bits. Returns false if the constraints are inconsistent. */
+bool sat_xor_gauss (GQueue *xors, const signed char *value, unsigned long int max_var, unsigned long int max_bits,
+                    GArray *units, GArray *equivalences);
+
+#endif